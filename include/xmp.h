@@ -38,6 +38,7 @@ extern "C" {
 #endif
 
 #define XMP_NAME_SIZE		64	/* Size of module name and type */
+#define XMP_ARCHIVE_NAME_SIZE	256	/* Size of archive member names */
 
 #define XMP_KEY_OFF		0x81	/* Note number for key off event */
 #define XMP_KEY_CUT		0x82	/* Note number for key cut event */
@@ -65,6 +66,9 @@ extern "C" {
 #define XMP_PLAYER_MODE 	11	/* Player personality */
 #define XMP_PLAYER_MIXER_TYPE	12	/* Current mixer (read only) */
 #define XMP_PLAYER_VOICES	13	/* Maximum number of mixer voices */
+#define XMP_PLAYER_CPU_BUDGET	14	/* Mixer time budget, us per second */
+#define XMP_PLAYER_QUALITY	15	/* Quality reduction level (read only) */
+#define XMP_PLAYER_CULLED	16	/* Voices culled for budget (read only) */
 
 /* interpolation types */
 #define XMP_INTERP_NEAREST	0	/* Nearest neighbor */
@@ -99,6 +103,14 @@ extern "C" {
 #define XMP_MODE_IT		9	/* Play using IT quirks */
 #define XMP_MODE_ITSMP		10	/* Play using IT sample mode quirks */
 
+/* player events */
+#define XMP_EVENT_ROW		(1 << 0) /* New row */
+#define XMP_EVENT_ORDER		(1 << 1) /* New position in order list */
+#define XMP_EVENT_LOOP		(1 << 2) /* Module looped */
+#define XMP_EVENT_NOTE		(1 << 3) /* New note in channel */
+#define XMP_EVENT_ALL		(XMP_EVENT_ROW | XMP_EVENT_ORDER | \
+				 XMP_EVENT_LOOP | XMP_EVENT_NOTE)
+
 /* mixer types */
 #define XMP_MIXER_STANDARD	0	/* Standard mixer */
 #define XMP_MIXER_A500		1	/* Amiga 500 */
@@ -106,6 +118,11 @@ extern "C" {
 
 /* sample flags */
 #define XMP_SMPCTL_SKIP		(1 << 0) /* Don't load samples */
+#define XMP_SMPCTL_SHARE	(1 << 1) /* Share identical sample data */
+#define XMP_SMPCTL_RESAMPLE	(1 << 2) /* Resample smix samples to output rate */
+
+/* stem rendering flags */
+#define XMP_STEMS_NOMIX		(1 << 0) /* Don't render the main output */
 
 /* limits */
 #define XMP_MAX_KEYS		121	/* Number of valid keys */
@@ -114,6 +131,7 @@ extern "C" {
 #define XMP_MAX_CHANNELS	64	/* Max number of channels in module */
 #define XMP_MAX_SRATE		49170	/* max sampling rate (Hz) */
 #define XMP_MIN_SRATE		4000	/* min sampling rate (Hz) */
+#define XMP_SMIX_MAX_PRIORITY	15	/* Max smix voice priority */
 #define XMP_MIN_BPM		20	/* min BPM */
 /* frame rate = (50 * bpm / 125) Hz */
 /* frame size = (sampling rate * channels * size) / frame rate */
@@ -275,6 +293,12 @@ struct xmp_test_info {
 	char type[XMP_NAME_SIZE];	/* Module format */
 };
 
+struct xmp_archive_entry {
+	char name[XMP_ARCHIVE_NAME_SIZE];	/* Member file name */
+	long size;			/* Unpacked size in bytes */
+	long offset;			/* Member position in the archive */
+};
+
 struct xmp_module_info {
 	unsigned char md5[16];		/* MD5 message digest */
 	int vol_base;			/* Volume scale */
@@ -320,6 +344,54 @@ struct xmp_frame_info {			/* Current frame information */
 	struct xmp_channel_info channel_info[XMP_MAX_CHANNELS];		/* Current channel information */
 };
 
+struct xmp_frame_status {		/* Current frame, without channels */
+	int pos;			/* Current position */
+	int pattern;			/* Current pattern */
+	int row;			/* Current row in pattern */
+	int num_rows;			/* Number of rows in current pattern */
+	int frame;			/* Current frame */
+	int speed;			/* Current replay speed */
+	int bpm;			/* Current bpm */
+	int time;			/* Current module time in ms */
+	int total_time;			/* Estimated replay time in ms*/
+	int frame_time;			/* Frame replay time in us */
+	void *buffer;			/* Pointer to sound buffer */
+	int buffer_size;		/* Used buffer size */
+	int total_size;			/* Total buffer size */
+	int volume;			/* Current master volume */
+	int loop_count;			/* Loop counter */
+	int virt_channels;		/* Number of virtual channels */
+	int virt_used;			/* Used virtual channels */
+	int sequence;			/* Current sequence */
+
+	unsigned int changed[XMP_MAX_CHANNELS / 32];	/* Channels changed since last call */
+};
+
+struct xmp_player_event {		/* Player event information */
+	int type;			/* Event type */
+	int offset;			/* Offset in samples in output buffer */
+	int pos;			/* Current position */
+	int row;			/* Current row in pattern */
+	int loop_count;			/* Loop counter */
+	int channel;			/* Channel number, or -1 */
+	int note;			/* Note number, or -1 */
+	int instrument;			/* Instrument number, or -1 */
+};
+
+struct xmp_profile {			/* Player profiling counters */
+	double read_time;		/* Time reading rows and events in ns */
+	double play_time;		/* Time processing channels in ns */
+	double mix_time;		/* Time mixing voices in ns */
+	double downmix_time;		/* Time converting the output in ns */
+	double samples;			/* Number of samples interpolated */
+	unsigned long frames;		/* Number of frames played */
+	unsigned long voices_mixed;	/* Voices mixed, summed over frames */
+	unsigned long voices_skipped;	/* Active voices not mixed */
+	unsigned long anticlick;	/* Anticlick ramps */
+};
+
+typedef void (*xmp_event_callback)(const struct xmp_player_event *, void *);
+
 struct xmp_callbacks {
 	unsigned long	(*read_func)(void *dest, unsigned long len,
 				     unsigned long nmemb, void *priv);
@@ -328,6 +400,22 @@ struct xmp_callbacks {
 	int		(*close_func)(void *priv);
 };
 
+struct xmp_allocator {
+	void		*(*malloc_func)(unsigned long size, void *priv);
+	void		*(*realloc_func)(void *ptr, unsigned long size,
+					 void *priv);
+	void		(*free_func)(void *ptr, void *priv);
+	void		*priv;
+};
+
+struct xmp_memory_info {		/* Memory used by a context in bytes */
+	long context;			/* Context structure and settings */
+	long module;			/* Patterns, instruments and samples */
+	long player;			/* Player and mixer state */
+	long smix;			/* Sound effect samples and voices */
+	long total;			/* Sum of the above */
+};
+
 typedef char *xmp_context;
 
 LIBXMP_EXPORT_VAR extern const char *xmp_version;
@@ -336,17 +424,21 @@ LIBXMP_EXPORT_VAR extern const unsigned int xmp_vercode;
 LIBXMP_EXPORT int         xmp_syserrno        (void);
 
 LIBXMP_EXPORT xmp_context xmp_create_context  (void);
+LIBXMP_EXPORT xmp_context xmp_create_context_with_allocator(const struct xmp_allocator *);
 LIBXMP_EXPORT void        xmp_free_context    (xmp_context);
+LIBXMP_EXPORT int         xmp_get_memory_info (xmp_context, struct xmp_memory_info *);
 
 LIBXMP_EXPORT int         xmp_load_module     (xmp_context, const char *);
 LIBXMP_EXPORT int         xmp_load_module_from_memory (xmp_context, const void *, long);
 LIBXMP_EXPORT int         xmp_load_module_from_file (xmp_context, void *, long);
 LIBXMP_EXPORT int         xmp_load_module_from_callbacks (xmp_context, void *, struct xmp_callbacks);
+LIBXMP_EXPORT int         xmp_load_module_from_archive (xmp_context, const char *, long);
 
 LIBXMP_EXPORT int         xmp_test_module     (const char *, struct xmp_test_info *);
 LIBXMP_EXPORT int         xmp_test_module_from_memory (const void *, long, struct xmp_test_info *);
 LIBXMP_EXPORT int         xmp_test_module_from_file (void *, struct xmp_test_info *);
 LIBXMP_EXPORT int         xmp_test_module_from_callbacks (void *, struct xmp_callbacks, struct xmp_test_info *);
+LIBXMP_EXPORT int         xmp_list_archive    (const char *, struct xmp_archive_entry *, int);
 
 LIBXMP_EXPORT void        xmp_scan_module     (xmp_context);
 LIBXMP_EXPORT void        xmp_release_module  (xmp_context);
@@ -355,6 +447,11 @@ LIBXMP_EXPORT int         xmp_start_player    (xmp_context, int, int);
 LIBXMP_EXPORT int         xmp_play_frame      (xmp_context);
 LIBXMP_EXPORT int         xmp_play_buffer     (xmp_context, void *, int, int);
 LIBXMP_EXPORT void        xmp_get_frame_info  (xmp_context, struct xmp_frame_info *);
+LIBXMP_EXPORT void        xmp_get_frame_status(xmp_context, struct xmp_frame_status *);
+LIBXMP_EXPORT int         xmp_get_channel_info(xmp_context, int, struct xmp_channel_info *);
+LIBXMP_EXPORT int         xmp_set_event_callback(xmp_context, int, xmp_event_callback, void *);
+LIBXMP_EXPORT int         xmp_get_profile     (xmp_context, struct xmp_profile *);
+LIBXMP_EXPORT void        xmp_reset_profile   (xmp_context);
 LIBXMP_EXPORT void        xmp_end_player      (xmp_context);
 LIBXMP_EXPORT void        xmp_inject_event    (xmp_context, int, struct xmp_event *);
 LIBXMP_EXPORT void        xmp_get_module_info (xmp_context, struct xmp_module_info *);
@@ -372,6 +469,17 @@ LIBXMP_EXPORT int         xmp_channel_vol     (xmp_context, int, int);
 LIBXMP_EXPORT int         xmp_set_player      (xmp_context, int, int);
 LIBXMP_EXPORT int         xmp_get_player      (xmp_context, int);
 LIBXMP_EXPORT int         xmp_set_instrument_path (xmp_context, const char *);
+LIBXMP_EXPORT int         xmp_start_stems     (xmp_context, int, const int *, int);
+LIBXMP_EXPORT void        xmp_end_stems       (xmp_context);
+LIBXMP_EXPORT void       *xmp_get_stem_buffer (xmp_context, int);
+LIBXMP_EXPORT int         xmp_start_render_ahead(xmp_context, int);
+LIBXMP_EXPORT void        xmp_end_render_ahead(xmp_context);
+LIBXMP_EXPORT int         xmp_read_render_ahead(xmp_context, void *, int);
+LIBXMP_EXPORT int         xmp_render_ahead_latency(xmp_context);
+LIBXMP_EXPORT void        xmp_lock_render_ahead(xmp_context);
+LIBXMP_EXPORT void        xmp_unlock_render_ahead(xmp_context);
+LIBXMP_EXPORT int         xmp_start_command_queue(xmp_context, int);
+LIBXMP_EXPORT void        xmp_end_command_queue(xmp_context);
 
 /* External sample mixer API */
 LIBXMP_EXPORT int         xmp_start_smix       (xmp_context, int, int);
@@ -380,7 +488,11 @@ LIBXMP_EXPORT int         xmp_smix_play_instrument(xmp_context, int, int, int, i
 LIBXMP_EXPORT int         xmp_smix_play_sample (xmp_context, int, int, int, int);
 LIBXMP_EXPORT int         xmp_smix_channel_pan (xmp_context, int, int);
 LIBXMP_EXPORT int         xmp_smix_load_sample (xmp_context, int, const char *);
+LIBXMP_EXPORT int         xmp_smix_load_sample_from_memory (xmp_context, int, const void *, long);
+LIBXMP_EXPORT int         xmp_smix_load_sample_from_callbacks (xmp_context, int, void *, struct xmp_callbacks);
 LIBXMP_EXPORT int         xmp_smix_release_sample (xmp_context, int);
+LIBXMP_EXPORT int         xmp_smix_play_voice  (xmp_context, int, int, int, int);
+LIBXMP_EXPORT int         xmp_smix_stop_voice  (xmp_context, int);
 
 #ifdef __cplusplus
 }
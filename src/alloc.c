@@ -0,0 +1,212 @@
+/* Extended Module Player
+ * Copyright (C) 1996-2021 Claudio Matsuoka and Hipolito Carraro Jr
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/* Memory allocation. Every allocation in the library goes through these
+ * functions, which use the allocator of the context being worked on.
+ * Public functions that allocate or free memory select the context
+ * allocator with libxmp_enter_allocator() and restore the previous one
+ * with libxmp_leave_allocator() before returning. Code that runs without
+ * a context, such as xmp_test_module(), uses the C library.
+ *
+ * Each block starts with a header holding its size and the class it was
+ * charged to, so that xmp_get_memory_info() can report the bytes really
+ * in use and blocks are always freed by the allocator that created them.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "common.h"
+
+#if defined(_MSC_VER)
+#define THREAD_LOCAL __declspec(thread)
+#elif defined(HAVE_THREAD_LOCAL)
+#define THREAD_LOCAL __thread
+#else
+#define THREAD_LOCAL
+#endif
+
+/* Worker threads may free blocks of the same class concurrently */
+#if defined(__GNUC__) || defined(__clang__)
+#define ADD_RELAXED(x,v)	__atomic_add_fetch(&(x), (v), __ATOMIC_RELAXED)
+#else
+#define ADD_RELAXED(x,v)	((x) += (v))
+#endif
+
+union alloc_header {
+	struct {
+		size_t size;
+		struct alloc_class *owner;
+	} h;
+	double align;
+};
+
+#define HEADER_SIZE sizeof(union alloc_header)
+
+static THREAD_LOCAL struct alloc_class *current;
+
+struct alloc_class *libxmp_enter_allocator(struct context_data *ctx, int type)
+{
+	struct alloc_class *old = current;
+
+	current = &ctx->mem[type];
+
+	return old;
+}
+
+void libxmp_leave_allocator(struct alloc_class *old)
+{
+	current = old;
+}
+
+struct alloc_class *libxmp_get_allocator(void)
+{
+	return current;
+}
+
+static int has_allocator(const struct alloc_class *c)
+{
+	return c != NULL && c->ctx->alloc.malloc_func != NULL;
+}
+
+int libxmp_custom_allocator(void)
+{
+	return has_allocator(current);
+}
+
+void *libxmp_malloc(size_t size)
+{
+	union alloc_header *hdr;
+
+	if (size > (size_t)-1 - HEADER_SIZE) {
+		return NULL;
+	}
+
+	if (has_allocator(current)) {
+		const struct xmp_allocator *a = &current->ctx->alloc;
+		hdr = (union alloc_header *)a->malloc_func(size + HEADER_SIZE,
+								a->priv);
+	} else {
+		hdr = (union alloc_header *)malloc(size + HEADER_SIZE);
+	}
+
+	if (hdr == NULL) {
+		return NULL;
+	}
+
+	hdr->h.size = size;
+	hdr->h.owner = current;
+	if (current != NULL) {
+		ADD_RELAXED(current->used, (long)(size + HEADER_SIZE));
+	}
+
+	return hdr + 1;
+}
+
+void *libxmp_calloc(size_t num, size_t size)
+{
+	void *ptr;
+
+	if (size != 0 && num > (size_t)-1 / size) {
+		return NULL;
+	}
+
+	ptr = libxmp_malloc(num * size);
+	if (ptr != NULL) {
+		memset(ptr, 0, num * size);
+	}
+
+	return ptr;
+}
+
+void *libxmp_realloc(void *ptr, size_t size)
+{
+	union alloc_header *hdr;
+	struct alloc_class *owner;
+	size_t old_size;
+
+	if (ptr == NULL) {
+		return libxmp_malloc(size);
+	}
+
+	if (size > (size_t)-1 - HEADER_SIZE) {
+		return NULL;
+	}
+
+	hdr = (union alloc_header *)ptr - 1;
+	owner = hdr->h.owner;
+	old_size = hdr->h.size;
+
+	if (has_allocator(owner)) {
+		const struct xmp_allocator *a = &owner->ctx->alloc;
+		hdr = (union alloc_header *)a->realloc_func(hdr,
+					size + HEADER_SIZE, a->priv);
+	} else {
+		hdr = (union alloc_header *)realloc(hdr, size + HEADER_SIZE);
+	}
+
+	if (hdr == NULL) {
+		return NULL;
+	}
+
+	hdr->h.size = size;
+	if (owner != NULL) {
+		ADD_RELAXED(owner->used, (long)size - (long)old_size);
+	}
+
+	return hdr + 1;
+}
+
+void libxmp_free(void *ptr)
+{
+	union alloc_header *hdr;
+	struct alloc_class *owner;
+
+	if (ptr == NULL) {
+		return;
+	}
+
+	hdr = (union alloc_header *)ptr - 1;
+	owner = hdr->h.owner;
+
+	if (owner != NULL) {
+		ADD_RELAXED(owner->used, -(long)(hdr->h.size + HEADER_SIZE));
+	}
+
+	if (has_allocator(owner)) {
+		owner->ctx->alloc.free_func(hdr, owner->ctx->alloc.priv);
+		return;
+	}
+
+	free(hdr);
+}
+
+char *libxmp_strdup(const char *s)
+{
+	size_t len = strlen(s) + 1;
+	char *ptr = (char *)libxmp_malloc(len);
+
+	if (ptr != NULL) {
+		memcpy(ptr, s, len);
+	}
+
+	return ptr;
+}
@@ -157,7 +157,7 @@ static inline CBFILE *cbopen(void *priv, struct xmp_callbacks callbacks)
 	    callbacks.seek_func == NULL || callbacks.tell_func == NULL)
 		goto err;
 
-	f = (CBFILE *)calloc(1, sizeof(CBFILE));
+	f = (CBFILE *)libxmp_calloc(1, sizeof(CBFILE));
 	if (f == NULL)
 		goto err;
 
@@ -179,7 +179,7 @@ static inline int cbclose(CBFILE *f)
 	if (f->callbacks.close_func != NULL)
 		r = f->callbacks.close_func(f->priv);
 
-	free(f);
+	libxmp_free(f);
 	return r;
 }
 
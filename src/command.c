@@ -0,0 +1,221 @@
+/* Extended Module Player
+ * Copyright (C) 1996-2021 Claudio Matsuoka and Hipolito Carraro Jr
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/* Control command queue. When enabled, control functions called from
+ * other threads don't touch the player state: they post a command to a
+ * bounded multiple producer, single consumer queue that the player
+ * drains before rendering. Each slot has a sequence number telling
+ * whether it is free for the producer holding that position or ready
+ * for the consumer, so neither side ever waits for the other.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "common.h"
+#include "command.h"
+
+#if defined(__GNUC__) || defined(__clang__)
+#define COMMAND_QUEUE_ATOMICS
+#define LOAD_ACQUIRE(x)		__atomic_load_n(&(x), __ATOMIC_ACQUIRE)
+#define LOAD_RELAXED(x)		__atomic_load_n(&(x), __ATOMIC_RELAXED)
+#define STORE_RELEASE(x,v)	__atomic_store_n(&(x), (v), __ATOMIC_RELEASE)
+#define CAS(x,o,n)		__atomic_compare_exchange_n(&(x), &(o), (n), \
+					0, __ATOMIC_RELAXED, __ATOMIC_RELAXED)
+#elif defined(_WIN32)
+#include <windows.h>
+#define COMMAND_QUEUE_ATOMICS
+#define LOAD_ACQUIRE(x)		((uint32)InterlockedCompareExchange( \
+					(volatile LONG *)&(x), 0, 0))
+#define LOAD_RELAXED(x)		LOAD_ACQUIRE(x)
+#define STORE_RELEASE(x,v)	InterlockedExchange((volatile LONG *)&(x), (v))
+#define CAS(x,o,n)		((uint32)InterlockedCompareExchange( \
+					(volatile LONG *)&(x), (n), (o)) == (o))
+#endif
+
+#define MAX_QUEUE_SIZE		65536
+
+struct command_slot {
+	uint32 seq;
+	struct command cmd;
+};
+
+struct command_queue {
+	struct command_slot *slot;
+	uint32 mask;
+	uint32 head;		/* next position to write, shared by producers */
+	uint32 tail;		/* next position to read, player only */
+};
+
+static int start_command_queue(xmp_context opaque, int size)
+{
+#ifdef COMMAND_QUEUE_ATOMICS
+	struct context_data *ctx = (struct context_data *)opaque;
+	struct player_data *p = &ctx->p;
+	struct command_queue *q;
+	uint32 i, n;
+
+	if (ctx->state < XMP_STATE_PLAYING) {
+		return -XMP_ERROR_STATE;
+	}
+
+	if (p->cmd_queue != NULL || size < 1 || size > MAX_QUEUE_SIZE) {
+		return -XMP_ERROR_INVALID;
+	}
+
+	for (n = 1; n < (uint32)size; n <<= 1);
+
+	q = libxmp_malloc(sizeof(struct command_queue));
+	if (q == NULL) {
+		return -XMP_ERROR_SYSTEM;
+	}
+
+	q->slot = libxmp_malloc(n * sizeof(struct command_slot));
+	if (q->slot == NULL) {
+		libxmp_free(q);
+		return -XMP_ERROR_SYSTEM;
+	}
+
+	for (i = 0; i < n; i++) {
+		q->slot[i].seq = i;
+	}
+	q->mask = n - 1;
+	q->head = 0;
+	q->tail = 0;
+
+	p->cmd_queue = q;
+
+	return 0;
+#else
+	return -XMP_ERROR_SYSTEM;
+#endif
+}
+
+int xmp_start_command_queue(xmp_context opaque, int size)
+{
+	struct context_data *ctx = (struct context_data *)opaque;
+	struct alloc_class *old;
+	int ret;
+
+	old = libxmp_enter_allocator(ctx, ALLOC_PLAYER);
+	ret = start_command_queue(opaque, size);
+	libxmp_leave_allocator(old);
+
+	return ret;
+}
+
+static void end_command_queue(xmp_context opaque)
+{
+	struct context_data *ctx = (struct context_data *)opaque;
+	struct player_data *p = &ctx->p;
+	struct command_queue *q = p->cmd_queue;
+
+	if (q == NULL) {
+		return;
+	}
+
+	/* Commands still queued are applied, not lost */
+	libxmp_drain_commands(ctx);
+
+	p->cmd_queue = NULL;
+	libxmp_free(q->slot);
+	libxmp_free(q);
+}
+
+void xmp_end_command_queue(xmp_context opaque)
+{
+	struct context_data *ctx = (struct context_data *)opaque;
+	struct alloc_class *old;
+
+	old = libxmp_enter_allocator(ctx, ALLOC_PLAYER);
+	end_command_queue(opaque);
+	libxmp_leave_allocator(old);
+}
+
+int libxmp_queue_command(struct context_data *ctx, int type, int parm,
+			 int val, struct xmp_event *e)
+{
+#ifdef COMMAND_QUEUE_ATOMICS
+	struct command_queue *q = ctx->p.cmd_queue;
+	struct command_slot *slot;
+	uint32 pos, seq;
+	int32 diff;
+
+	pos = LOAD_RELAXED(q->head);
+	for (;;) {
+		slot = &q->slot[pos & q->mask];
+		seq = LOAD_ACQUIRE(slot->seq);
+		diff = (int32)(seq - pos);
+
+		if (diff == 0) {
+			/* Slot is free, try to claim the position */
+			if (CAS(q->head, pos, pos + 1)) {
+				break;
+			}
+		} else if (diff < 0) {
+			/* Queue full */
+			return -XMP_ERROR_SYSTEM;
+		} else {
+			/* Another producer took it */
+			pos = LOAD_RELAXED(q->head);
+		}
+	}
+
+	slot->cmd.type = type;
+	slot->cmd.parm = parm;
+	slot->cmd.val = val;
+	if (e != NULL) {
+		memcpy(&slot->cmd.event, e, sizeof(struct xmp_event));
+	}
+
+	STORE_RELEASE(slot->seq, pos + 1);
+
+	return 0;
+#else
+	return -XMP_ERROR_SYSTEM;
+#endif
+}
+
+/* Apply all commands posted so far, called from the player */
+void libxmp_drain_commands(struct context_data *ctx)
+{
+#ifdef COMMAND_QUEUE_ATOMICS
+	struct command_queue *q = ctx->p.cmd_queue;
+	struct command_slot *slot;
+
+	if (q == NULL) {
+		return;
+	}
+
+	for (;;) {
+		slot = &q->slot[q->tail & q->mask];
+		if (LOAD_ACQUIRE(slot->seq) != q->tail + 1) {
+			break;
+		}
+
+		libxmp_apply_command(ctx, &slot->cmd);
+
+		/* Hand the slot to the producer one lap ahead */
+		STORE_RELEASE(slot->seq, q->tail + q->mask + 1);
+		q->tail++;
+	}
+#endif
+}
@@ -0,0 +1,26 @@
+#ifndef LIBXMP_COMMAND_H
+#define LIBXMP_COMMAND_H
+
+#include "common.h"
+
+#define CMD_SET_POSITION	0
+#define CMD_CHANNEL_MUTE	1
+#define CMD_CHANNEL_VOL		2
+#define CMD_SET_PLAYER		3
+#define CMD_INJECT_EVENT	4
+
+struct command {
+	int type;
+	int parm;
+	int val;
+	struct xmp_event event;
+};
+
+#define QUEUE_COMMANDS(ctx)	((ctx)->p.cmd_queue != NULL)
+
+int	libxmp_queue_command	(struct context_data *, int, int, int,
+				 struct xmp_event *);
+void	libxmp_drain_commands	(struct context_data *);
+void	libxmp_apply_command	(struct context_data *, struct command *);
+
+#endif /* LIBXMP_COMMAND_H */
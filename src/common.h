@@ -270,12 +270,36 @@ struct ord_data {
 
 /* Context */
 
+#define SMIX_PRIORITIES	(XMP_SMIX_MAX_PRIORITY + 1)
+
+struct smix_voice {
+	int handle;		/* Handle returned to the application */
+	int state;		/* Free, waiting for its event or playing */
+	int priority;
+	int prev, next;		/* Links in the priority list */
+};
+
+struct smix_sample {
+	int rate;		/* Sampling rate of the data played */
+	int src_rate;		/* Sampling rate of the loaded data */
+	struct xmp_sample src;	/* Loaded data, kept when resampling */
+};
+
 struct smix_data {
 	int chn;
 	int ins;
 	int smp;
 	struct xmp_instrument *xxi;
 	struct xmp_sample *xxs;
+	struct smix_sample *xtra;
+
+	/* Voice pool for xmp_smix_play_voice() */
+	struct smix_voice *voice;
+	int *free_voice;	/* Stack of free pool channels */
+	int num_free;
+	int first[SMIX_PRIORITIES];	/* Oldest voice of each priority */
+	int last[SMIX_PRIORITIES];	/* Newest voice of each priority */
+	int serial;
 };
 
 /* This will be added to the sample structure in the next API revision */
@@ -283,6 +307,24 @@ struct extra_sample_data {
 	double c5spd;
 };
 
+/* Envelope segment slopes, built at load time. The slope of each
+ * segment is kept as the quotient and remainder of |y2 - y1| / (x2 - x1)
+ * so the player can advance the interpolation without dividing.
+ */
+struct envelope_slopes {
+	int ok;				/* node positions don't decrease */
+	int q[XMP_MAX_ENV_POINTS];
+	int r[XMP_MAX_ENV_POINTS];
+};
+
+struct instrument_slopes {
+	struct envelope_slopes aei;
+	struct envelope_slopes pei;
+	struct envelope_slopes fei;
+};
+
+struct synth_info;
+
 struct module_data {
 	struct xmp_module mod;
 
@@ -313,13 +355,16 @@ struct module_data {
 	int period_type;
 	int smpctl;			/* sample control flags */
 	int defpan;			/* default pan setting */
-	struct ord_data xxo_info[XMP_MAX_MOD_LENGTH];
+	struct ord_data *xxo_info;	/* order data, sized by the module length */
 	int num_sequences;
-	struct xmp_sequence seq_data[MAX_SEQUENCES];
+	struct xmp_sequence *seq_data;
 	char *instrument_path;
 	void *extra;			/* format-specific extra fields */
 	uint8 **scan_cnt;		/* scan counters */
 	struct extra_sample_data *xtra;
+	uint8 *shared;			/* samples held in the sample store */
+	struct instrument_slopes *env_slopes;
+	const struct synth_info *synth;	/* driver for synth samples */
 #ifndef LIBXMP_CORE_DISABLE_IT
 	struct xmp_sample *xsmp;	/* sustain loop samples */
 #endif
@@ -376,7 +421,7 @@ struct player_data {
 
 	int loop_count;
 	int sequence;
-	unsigned char sequence_control[XMP_MAX_MOD_LENGTH];
+	unsigned char *sequence_control;	/* sequence of each order */
 
 	int smix_vol;			/* SFX volume */
 	int master_vol;			/* Music volume */
@@ -400,10 +445,21 @@ struct player_data {
 		struct virt_channel *virt_channel;
 
 		struct mixer_voice *voice_array;
+		uint32 *free_map;	/* Bitmap of free voices */
 	} virt;
 
 	struct xmp_event inject_event[XMP_MAX_CHANNELS];
 
+	/* Channels with changed info, for xmp_get_frame_status() */
+	unsigned int channel_changed[XMP_MAX_CHANNELS / 32];
+
+	struct {
+		xmp_event_callback func;
+		void *priv;
+		int mask;		/* Events to report */
+		int offset;		/* Frame offset in output buffer */
+	} event_callback;
+
 	struct {
 		int consumed;
 		int in_size;
@@ -414,6 +470,13 @@ struct player_data {
 	int st26_speed;			/* For IceTracker speed effect */
 #endif
 	int filter;			/* Amiga led filter */
+
+#ifndef LIBXMP_CORE_DISABLE_IT
+	struct filter_coef *filter_coef; /* Resonant filter coefficients */
+#endif
+
+	struct render_ahead *render_ahead; /* Player thread, if running */
+	struct command_queue *cmd_queue;   /* Control commands, if queued */
 };
 
 struct mixer_data {
@@ -425,11 +488,51 @@ struct mixer_data {
 	int dsp;		/* dsp effect flags */
 	char* buffer;		/* output buffer */
 	int32* buf32;		/* temporary buffer for 32 bit samples */
+	int framesize;		/* size of the tick buffers in samples */
 	int numvoc;		/* default softmixer voices number */
 	int ticksize;
 	int dtright;		/* anticlick control, right channel */
 	int dtleft;		/* anticlick control, left channel */
 	double pbase;		/* period base */
+	int num_stems;		/* number of stem buffers, 0 if disabled */
+	int stem_flags;
+	int *stem_map;		/* stem for each module channel, or -1 */
+	int32 *stem32;		/* 32 bit samples for each stem */
+	int32 *mix32;		/* main output with all stems added */
+	char *stem_buffer;	/* output buffer for each stem */
+	int cpu_budget;		/* mixer time in us per second, 0 if unlimited */
+	double cpu_load;	/* smoothed mixer time, same unit */
+	int quality;		/* quality reduction level */
+	int quality_hold;	/* ticks before the level can change again */
+	int culled;		/* voices culled to meet the budget */
+	void *synth_chip;	/* synth driver state */
+	struct mixer_voice *tick_voice;	/* voices as mixed in this tick */
+	int *tick_offset;	/* sample offset each voice was mixed from */
+	struct paula_state *tick_paula;	/* Paula state of the voices */
+	int32 *undo32;		/* replayed output of restarted voices */
+	int undo;		/* mixing into undo32 */
+};
+
+#ifdef LIBXMP_PROFILE
+struct profile_data {
+	double read_time;	/* Start times of the current stages */
+	double play_time;
+	double mix_time;
+	double downmix_time;
+	struct xmp_profile data;
+};
+#endif
+
+/* Allocations are charged to a class of the context that made them */
+#define ALLOC_CONTEXT	0
+#define ALLOC_MODULE	1
+#define ALLOC_PLAYER	2
+#define ALLOC_SMIX	3
+#define ALLOC_CLASSES	4
+
+struct alloc_class {
+	struct context_data *ctx;
+	long used;		/* bytes currently allocated */
 };
 
 struct context_data {
@@ -438,11 +541,26 @@ struct context_data {
 	struct module_data m;
 	struct smix_data smix;
 	int state;
+	struct xmp_allocator alloc;	/* all zero for the C library */
+	struct alloc_class mem[ALLOC_CLASSES];
+#ifdef LIBXMP_PROFILE
+	struct profile_data prof;
+#endif
 };
 
 
 /* Prototypes */
 
+void	*libxmp_malloc		(size_t);
+void	*libxmp_calloc		(size_t, size_t);
+void	*libxmp_realloc		(void *, size_t);
+void	libxmp_free		(void *);
+char	*libxmp_strdup		(const char *);
+struct alloc_class *libxmp_enter_allocator(struct context_data *, int);
+void	libxmp_leave_allocator	(struct alloc_class *);
+struct alloc_class *libxmp_get_allocator(void);
+int	libxmp_custom_allocator	(void);
+
 char	*libxmp_adjust_string	(char *);
 int	libxmp_prepare_scan	(struct context_data *);
 void	libxmp_free_scan	(struct context_data *);
@@ -476,5 +594,9 @@ uint32	readmem32b		(const uint8 *);
 
 struct xmp_instrument *libxmp_get_instrument(struct context_data *, int);
 struct xmp_sample *libxmp_get_sample(struct context_data *, int);
+void	libxmp_smix_reset_voices(struct context_data *);
+void	libxmp_smix_resample	(struct context_data *);
+void	libxmp_smix_voice_start	(struct context_data *, int);
+void	libxmp_smix_voice_end	(struct context_data *, int);
 
 #endif /* LIBXMP_COMMON_H */
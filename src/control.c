@@ -23,19 +23,43 @@
 #include "format.h"
 #include "virtual.h"
 #include "mixer.h"
+#include "command.h"
 
 const char *xmp_version LIBXMP_EXPORT_VAR = XMP_VERSION;
 const unsigned int xmp_vercode LIBXMP_EXPORT_VAR = XMP_VERCODE;
 
 xmp_context xmp_create_context(void)
+{
+	return xmp_create_context_with_allocator(NULL);
+}
+
+xmp_context xmp_create_context_with_allocator(const struct xmp_allocator *alloc)
 {
 	struct context_data *ctx;
+	int i;
+
+	if (alloc == NULL) {
+		ctx = calloc(1, sizeof(struct context_data));
+	} else {
+		if (alloc->malloc_func == NULL || alloc->realloc_func == NULL ||
+		    alloc->free_func == NULL) {
+			return NULL;
+		}
+		ctx = alloc->malloc_func(sizeof(struct context_data), alloc->priv);
+		if (ctx != NULL) {
+			memset(ctx, 0, sizeof(struct context_data));
+			ctx->alloc = *alloc;
+		}
+	}
 
-	ctx = calloc(1, sizeof(struct context_data));
 	if (ctx == NULL) {
 		return NULL;
 	}
 
+	for (i = 0; i < ALLOC_CLASSES; i++) {
+		ctx->mem[i].ctx = ctx;
+	}
+
 	ctx->state = XMP_STATE_UNLOADED;
 	ctx->m.defpan = 100;
 	ctx->s.numvoc = SMIX_NUMVOC;
@@ -47,12 +71,21 @@ void xmp_free_context(xmp_context opaque)
 {
 	struct context_data *ctx = (struct context_data *)opaque;
 	struct module_data *m = &ctx->m;
+	struct alloc_class *old;
 
 	if (ctx->state > XMP_STATE_UNLOADED)
 		xmp_release_module(opaque);
 
-	free(m->instrument_path);
-	free(opaque);
+	old = libxmp_enter_allocator(ctx, ALLOC_CONTEXT);
+	libxmp_free(m->instrument_path);
+	libxmp_leave_allocator(old);
+
+	/* The context itself is allocated without a block header */
+	if (ctx->alloc.free_func != NULL) {
+		ctx->alloc.free_func(ctx, ctx->alloc.priv);
+	} else {
+		free(ctx);
+	}
 }
 
 static void set_position(struct context_data *ctx, int pos, int dir)
@@ -172,6 +205,11 @@ int xmp_set_position(xmp_context opaque, int pos)
 	if (pos >= m->mod.len)
 		return -XMP_ERROR_INVALID;
 
+	if (QUEUE_COMMANDS(ctx)) {
+		int ret = libxmp_queue_command(ctx, CMD_SET_POSITION, 0, pos, NULL);
+		return ret < 0 ? ret : pos;
+	}
+
 	set_position(ctx, pos, 0);
 
 	return p->pos;
@@ -263,6 +301,15 @@ int xmp_seek_time(xmp_context opaque, int time)
 	return p->pos < 0 ? 0 : p->pos;
 }
 
+static void channel_mute(struct player_data *p, int chn, int status)
+{
+	if (status >= 2) {
+		p->channel_mute[chn] = !p->channel_mute[chn];
+	} else if (status >= 0) {
+		p->channel_mute[chn] = status;
+	}
+}
+
 int xmp_channel_mute(xmp_context opaque, int chn, int status)
 {
 	struct context_data *ctx = (struct context_data *)opaque;
@@ -278,12 +325,13 @@ int xmp_channel_mute(xmp_context opaque, int chn, int status)
 
 	ret = p->channel_mute[chn];
 
-	if (status >= 2) {
-		p->channel_mute[chn] = !p->channel_mute[chn];
-	} else if (status >= 0) {
-		p->channel_mute[chn] = status;
+	if (status >= 0 && QUEUE_COMMANDS(ctx)) {
+		int err = libxmp_queue_command(ctx, CMD_CHANNEL_MUTE, chn, status, NULL);
+		return err < 0 ? err : ret;
 	}
 
+	channel_mute(p, chn, status);
+
 	return ret;
 }
 
@@ -303,80 +351,139 @@ int xmp_channel_vol(xmp_context opaque, int chn, int vol)
 	ret = p->channel_vol[chn];
 
 	if (vol >= 0 && vol <= 100) {
+		if (QUEUE_COMMANDS(ctx)) {
+			int err = libxmp_queue_command(ctx, CMD_CHANNEL_VOL, chn, vol, NULL);
+			return err < 0 ? err : ret;
+		}
 		p->channel_vol[chn] = vol;
 	}
 
 	return ret;
 }
 
-#ifdef USE_VERSIONED_SYMBOLS
-LIBXMP_EXPORT_VERSIONED extern int xmp_set_player_v40__(xmp_context, int, int);
-LIBXMP_EXPORT_VERSIONED extern int xmp_set_player_v41__(xmp_context, int, int)
-			__attribute__((alias("xmp_set_player_v40__")));
-LIBXMP_EXPORT_VERSIONED extern int xmp_set_player_v43__(xmp_context, int, int)
-			__attribute__((alias("xmp_set_player_v40__")));
-LIBXMP_EXPORT_VERSIONED extern int xmp_set_player_v44__(xmp_context, int, int)
-			__attribute__((alias("xmp_set_player_v40__")));
+static int start_stems(xmp_context opaque, int num, const int *map, int flags)
+{
+	struct context_data *ctx = (struct context_data *)opaque;
 
-asm(".symver xmp_set_player_v40__, xmp_set_player@XMP_4.0");
-asm(".symver xmp_set_player_v41__, xmp_set_player@XMP_4.1");
-asm(".symver xmp_set_player_v43__, xmp_set_player@XMP_4.3");
-asm(".symver xmp_set_player_v44__, xmp_set_player@@XMP_4.4");
+	if (ctx->state < XMP_STATE_PLAYING)
+		return -XMP_ERROR_STATE;
 
-#define xmp_set_player__ xmp_set_player_v40__
-#else
-#define xmp_set_player__ xmp_set_player
-#endif
+	if (num < 1 || num > XMP_MAX_CHANNELS) {
+		return -XMP_ERROR_INVALID;
+	}
 
-int xmp_set_player__(xmp_context opaque, int parm, int val)
+	if (libxmp_mixer_start_stems(ctx, num, map, flags) < 0) {
+		return -XMP_ERROR_SYSTEM;
+	}
+
+	return 0;
+}
+
+int xmp_start_stems(xmp_context opaque, int num, const int *map, int flags)
+{
+	struct context_data *ctx = (struct context_data *)opaque;
+	struct alloc_class *old;
+	int ret;
+
+	old = libxmp_enter_allocator(ctx, ALLOC_PLAYER);
+	ret = start_stems(opaque, num, map, flags);
+	libxmp_leave_allocator(old);
+
+	return ret;
+}
+
+static void end_stems(xmp_context opaque)
 {
 	struct context_data *ctx = (struct context_data *)opaque;
+
+	if (ctx->state < XMP_STATE_PLAYING)
+		return;
+
+	libxmp_mixer_end_stems(ctx);
+}
+
+void xmp_end_stems(xmp_context opaque)
+{
+	struct context_data *ctx = (struct context_data *)opaque;
+	struct alloc_class *old;
+
+	old = libxmp_enter_allocator(ctx, ALLOC_PLAYER);
+	end_stems(opaque);
+	libxmp_leave_allocator(old);
+}
+
+void *xmp_get_stem_buffer(xmp_context opaque, int stem)
+{
+	struct context_data *ctx = (struct context_data *)opaque;
+	struct mixer_data *s = &ctx->s;
+
+	if (ctx->state < XMP_STATE_PLAYING)
+		return NULL;
+
+	if (stem < 0 || stem >= s->num_stems) {
+		return NULL;
+	}
+
+	return s->stem_buffer + stem * s->framesize * 2;
+}
+
+/* Check a player parameter and its value, so that invalid settings are
+ * rejected before they are queued for the player.
+ */
+static int check_player(int parm, int val)
+{
+	switch (parm) {
+	case XMP_PLAYER_AMP:
+		return val >= 0 && val <= 3;
+	case XMP_PLAYER_MIX:
+		return val >= -100 && val <= 100;
+	case XMP_PLAYER_INTERP:
+		return val >= XMP_INTERP_NEAREST && val <= XMP_INTERP_SPLINE;
+	case XMP_PLAYER_VOLUME:
+	case XMP_PLAYER_SMIX_VOLUME:
+		return val >= 0 && val <= 200;
+	case XMP_PLAYER_DEFPAN:
+		return val >= 0 && val <= 100;
+	case XMP_PLAYER_CPU_BUDGET:
+		return val >= 0 && val <= 1000000;
+	case XMP_PLAYER_DSP:
+	case XMP_PLAYER_FLAGS:
+	case XMP_PLAYER_CFLAGS:
+	case XMP_PLAYER_SMPCTL:
+	case XMP_PLAYER_MODE:
+	case XMP_PLAYER_VOICES:
+		return 1;
+	}
+
+	return 0;
+}
+
+static int set_player(struct context_data *ctx, int parm, int val)
+{
 	struct player_data *p = &ctx->p;
 	struct module_data *m = &ctx->m;
 	struct mixer_data *s = &ctx->s;
-	int ret = -XMP_ERROR_INVALID;
-
+	int ret = 0;
 
-	if (parm == XMP_PLAYER_SMPCTL || parm == XMP_PLAYER_DEFPAN) {
-		/* these should be set before loading the module */
-		if (ctx->state >= XMP_STATE_LOADED) {
-			return -XMP_ERROR_STATE;
-		}
-	} else if (parm == XMP_PLAYER_VOICES) {
-		/* these should be set before start playing */
-		if (ctx->state >= XMP_STATE_PLAYING) {
-			return -XMP_ERROR_STATE;
-		}
-	} else if (ctx->state < XMP_STATE_PLAYING) {
-		return -XMP_ERROR_STATE;
+	if (!check_player(parm, val)) {
+		return -XMP_ERROR_INVALID;
 	}
 
 	switch (parm) {
 	case XMP_PLAYER_AMP:
-		if (val >= 0 && val <= 3) {
-			s->amplify = val;
-			ret = 0;
-		}
+		s->amplify = val;
 		break;
 	case XMP_PLAYER_MIX:
-		if (val >= -100 && val <= 100) {
-			s->mix = val;
-			ret = 0;
-		}
+		s->mix = val;
 		break;
 	case XMP_PLAYER_INTERP:
-		if (val >= XMP_INTERP_NEAREST && val <= XMP_INTERP_SPLINE) {
-			s->interp = val;
-			ret = 0;
-		}
+		s->interp = val;
 		break;
 	case XMP_PLAYER_DSP:
 		s->dsp = val;
-		ret = 0;
 		break;
 	case XMP_PLAYER_FLAGS: {
 		p->player_flags = val;
-		ret = 0;
 		break; }
 
 	/* 4.1 */
@@ -385,31 +492,20 @@ int xmp_set_player__(xmp_context opaque, int parm, int val)
 		p->flags = val;
 		if (vblank != (p->flags & XMP_FLAGS_VBLANK))
 			libxmp_scan_sequences(ctx);
-		ret = 0;
 		break; }
 	case XMP_PLAYER_SMPCTL:
 		m->smpctl = val;
-		ret = 0;
 		break;
 	case XMP_PLAYER_VOLUME:
-		if (val >= 0 && val <= 200) {
-			p->master_vol = val;
-			ret = 0;
-		}
+		p->master_vol = val;
 		break;
 	case XMP_PLAYER_SMIX_VOLUME:
-		if (val >= 0 && val <= 200) {
-			p->smix_vol = val;
-			ret = 0;
-		}
+		p->smix_vol = val;
 		break;
 
 	/* 4.3 */
 	case XMP_PLAYER_DEFPAN:
-		if (val >= 0 && val <= 100) {
-			m->defpan = val;
-			ret = 0;
-		}
+		m->defpan = val;
 		break;
 
 	/* 4.4 */
@@ -417,13 +513,77 @@ int xmp_set_player__(xmp_context opaque, int parm, int val)
 		p->mode = val;
 		libxmp_set_player_mode(ctx);
 		libxmp_scan_sequences(ctx);
-		ret = 0;
 		break;
 	case XMP_PLAYER_VOICES:
 		s->numvoc = val;
+		ret = -XMP_ERROR_INVALID;	/* as returned by earlier versions */
 		break;
+
+	/* 4.6 */
+	case XMP_PLAYER_CPU_BUDGET:
+		s->cpu_budget = val;
+		s->cpu_load = 0;
+		s->culled = 0;
+		if (val == 0) {
+			s->quality = 0;
+		}
+		break;
+	}
+
+	return ret;
+}
+
+#ifdef USE_VERSIONED_SYMBOLS
+LIBXMP_EXPORT_VERSIONED extern int xmp_set_player_v40__(xmp_context, int, int);
+LIBXMP_EXPORT_VERSIONED extern int xmp_set_player_v41__(xmp_context, int, int)
+			__attribute__((alias("xmp_set_player_v40__")));
+LIBXMP_EXPORT_VERSIONED extern int xmp_set_player_v43__(xmp_context, int, int)
+			__attribute__((alias("xmp_set_player_v40__")));
+LIBXMP_EXPORT_VERSIONED extern int xmp_set_player_v44__(xmp_context, int, int)
+			__attribute__((alias("xmp_set_player_v40__")));
+
+asm(".symver xmp_set_player_v40__, xmp_set_player@XMP_4.0");
+asm(".symver xmp_set_player_v41__, xmp_set_player@XMP_4.1");
+asm(".symver xmp_set_player_v43__, xmp_set_player@XMP_4.3");
+asm(".symver xmp_set_player_v44__, xmp_set_player@@XMP_4.4");
+
+#define xmp_set_player__ xmp_set_player_v40__
+#else
+#define xmp_set_player__ xmp_set_player
+#endif
+
+int xmp_set_player__(xmp_context opaque, int parm, int val)
+{
+	struct context_data *ctx = (struct context_data *)opaque;
+	struct alloc_class *old;
+	int ret;
+
+	if (parm == XMP_PLAYER_SMPCTL || parm == XMP_PLAYER_DEFPAN) {
+		/* these should be set before loading the module */
+		if (ctx->state >= XMP_STATE_LOADED) {
+			return -XMP_ERROR_STATE;
+		}
+	} else if (parm == XMP_PLAYER_VOICES) {
+		/* these should be set before start playing */
+		if (ctx->state >= XMP_STATE_PLAYING) {
+			return -XMP_ERROR_STATE;
+		}
+	} else if (ctx->state < XMP_STATE_PLAYING) {
+		return -XMP_ERROR_STATE;
 	}
 
+	if (ctx->state >= XMP_STATE_PLAYING && QUEUE_COMMANDS(ctx)) {
+		if (!check_player(parm, val)) {
+			return -XMP_ERROR_INVALID;
+		}
+		return libxmp_queue_command(ctx, CMD_SET_PLAYER, parm, val, NULL);
+	}
+
+	/* Rescanning may reallocate sequence data */
+	old = libxmp_enter_allocator(ctx, ALLOC_PLAYER);
+	ret = set_player(ctx, parm, val);
+	libxmp_leave_allocator(old);
+
 	return ret;
 }
 
@@ -525,6 +685,17 @@ int xmp_get_player__(xmp_context opaque, int parm)
 	case XMP_PLAYER_VOICES:
 		ret = s->numvoc;
 		break;
+
+	/* 4.6 */
+	case XMP_PLAYER_CPU_BUDGET:
+		ret = s->cpu_budget;
+		break;
+	case XMP_PLAYER_QUALITY:
+		ret = s->quality;
+		break;
+	case XMP_PLAYER_CULLED:
+		ret = s->culled;
+		break;
 	}
 
 	return ret;
@@ -543,19 +714,52 @@ void xmp_inject_event(xmp_context opaque, int channel, struct xmp_event *e)
 	if (ctx->state < XMP_STATE_PLAYING)
 		return;
 
+	if (QUEUE_COMMANDS(ctx)) {
+		libxmp_queue_command(ctx, CMD_INJECT_EVENT, channel, 0, e);
+		return;
+	}
+
 	memcpy(&p->inject_event[channel], e, sizeof(struct xmp_event));
 	p->inject_event[channel]._flag = 1;
 }
 
-int xmp_set_instrument_path(xmp_context opaque, const char *path)
+/* Called by the player when draining the command queue */
+void libxmp_apply_command(struct context_data *ctx, struct command *cmd)
+{
+	struct player_data *p = &ctx->p;
+
+	switch (cmd->type) {
+	case CMD_SET_POSITION:
+		if (cmd->val < ctx->m.mod.len) {
+			set_position(ctx, cmd->val, 0);
+		}
+		break;
+	case CMD_CHANNEL_MUTE:
+		channel_mute(p, cmd->parm, cmd->val);
+		break;
+	case CMD_CHANNEL_VOL:
+		p->channel_vol[cmd->parm] = cmd->val;
+		break;
+	case CMD_SET_PLAYER:
+		set_player(ctx, cmd->parm, cmd->val);
+		break;
+	case CMD_INJECT_EVENT:
+		memcpy(&p->inject_event[cmd->parm], &cmd->event,
+					sizeof(struct xmp_event));
+		p->inject_event[cmd->parm]._flag = 1;
+		break;
+	}
+}
+
+static int set_instrument_path(xmp_context opaque, const char *path)
 {
 	struct context_data *ctx = (struct context_data *)opaque;
 	struct module_data *m = &ctx->m;
 
 	if (m->instrument_path != NULL)
-		free(m->instrument_path);
+		libxmp_free(m->instrument_path);
 
-	m->instrument_path = strdup(path);
+	m->instrument_path = libxmp_strdup(path);
 	if (m->instrument_path == NULL) {
 		return -XMP_ERROR_SYSTEM;
 	}
@@ -563,10 +767,22 @@ int xmp_set_instrument_path(xmp_context opaque, const char *path)
 	return 0;
 }
 
+int xmp_set_instrument_path(xmp_context opaque, const char *path)
+{
+	struct context_data *ctx = (struct context_data *)opaque;
+	struct alloc_class *old;
+	int ret;
+
+	old = libxmp_enter_allocator(ctx, ALLOC_CONTEXT);
+	ret = set_instrument_path(opaque, path);
+	libxmp_leave_allocator(old);
+
+	return ret;
+}
+
 int xmp_set_tempo_factor(xmp_context opaque, double val)
 {
 	struct context_data *ctx = (struct context_data *)opaque;
-	struct player_data *p = &ctx->p;
 	struct module_data *m = &ctx->m;
 	struct mixer_data *s = &ctx->s;
 	int ticksize;
@@ -576,9 +792,15 @@ int xmp_set_tempo_factor(xmp_context opaque, double val)
 	}
 
 	val *= 10;
-	ticksize = s->freq * val * m->rrate / p->bpm / 1000 * sizeof(int);
-	if (ticksize > XMP_MAX_FRAMESIZE) {
-		return -1;
+
+	/* Ticks at any tempo the module can reach must fit in the mixer
+	 * buffers, which are sized for the time factor when the player
+	 * starts */
+	if (ctx->state >= XMP_STATE_PLAYING) {
+		ticksize = libxmp_mixer_max_ticksize(ctx, s->freq, val) * 2;
+		if (ticksize > s->framesize) {
+			return -1;
+		}
 	}
 	m->time_factor = val;
 
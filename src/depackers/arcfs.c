@@ -25,18 +25,16 @@ struct archived_file_header_tag {
 };
 
 
-static int read_file_header(FILE *in, struct archived_file_header_tag *hdrp)
+static int read_archive_header(FILE *in, int *hlen, int *start)
 {
-	int hlen, start /*, ver*/;
-	int i;
 	int error;
 
 	if (fseek(in, 8, SEEK_CUR) < 0)		/* skip magic */
 		return -1;
-	hlen = read32l(in, &error) / 36;
+	*hlen = read32l(in, &error) / 36;
 	if (error != 0) return -1;
-	if (hlen < 1) return -1;
-	start = read32l(in, &error);
+	if (*hlen < 1) return -1;
+	*start = read32l(in, &error);
 	if (error != 0) return -1;
 	/*ver =*/ read32l(in, &error);
 	if (error != 0) return -1;
@@ -49,43 +47,72 @@ static int read_file_header(FILE *in, struct archived_file_header_tag *hdrp)
 	if (fseek(in, 68, SEEK_CUR) < 0)	/* reserved */
 		return -1;
 
-	for (i = 0; i < hlen; i++) {
-		int x = read8(in, &error);
-		if (error != 0) return -1;
+	return 0;
+}
 
-		if (x == 0)			/* end? */
-			break;
+/* Read one directory entry. Returns 0 at the end of the directory, 1 if
+ * an entry was read, or -1 on error. Deleted files and directories are
+ * returned with method 0.
+ */
+static int read_entry(FILE *in, int start, struct archived_file_header_tag *hdrp)
+{
+	int x;
+	int error;
 
-		hdrp->method = x & 0x7f;
-		if (fread(hdrp->name, 1, 11, in) != 11) {
-			return -1;
-		}
-		hdrp->name[12] = 0;
-		hdrp->orig_size = read32l(in, &error);
-		if (error != 0) return -1;
-		read32l(in, &error);
-		if (error != 0) return -1;
-		read32l(in, &error);
-		if (error != 0) return -1;
-		x = read32l(in, &error);
-		if (error != 0) return -1;
-		hdrp->compressed_size = read32l(in, &error);
-		if (error != 0) return -1;
-		hdrp->offset = read32l(in, &error);
-		if (error != 0) return -1;
-
-		if (x == 1)			/* deleted */
-			continue;
+	x = read8(in, &error);
+	if (error != 0) return -1;
 
-		if (hdrp->offset & 0x80000000)		/* directory */
-			continue;
+	if (x == 0)			/* end? */
+		return 0;
 
-		hdrp->crc = x >> 16;
-		hdrp->bits = (x & 0xff00) >> 8;
-		hdrp->offset &= 0x7fffffff;
-		hdrp->offset += start;
+	hdrp->method = x & 0x7f;
+	if (fread(hdrp->name, 1, 11, in) != 11) {
+		return -1;
+	}
+	hdrp->name[11] = 0;
+	hdrp->orig_size = read32l(in, &error);
+	if (error != 0) return -1;
+	read32l(in, &error);
+	if (error != 0) return -1;
+	read32l(in, &error);
+	if (error != 0) return -1;
+	x = read32l(in, &error);
+	if (error != 0) return -1;
+	hdrp->compressed_size = read32l(in, &error);
+	if (error != 0) return -1;
+	hdrp->offset = read32l(in, &error);
+	if (error != 0) return -1;
 
-		break;
+	if (x == 1 ||				/* deleted */
+	    (hdrp->offset & 0x80000000)) {	/* directory */
+		hdrp->method = 0;
+		return 1;
+	}
+
+	hdrp->crc = x >> 16;
+	hdrp->bits = (x & 0xff00) >> 8;
+	hdrp->offset &= 0x7fffffff;
+	hdrp->offset += start;
+
+	return 1;
+}
+
+static int read_file_header(FILE *in, struct archived_file_header_tag *hdrp)
+{
+	int hlen, start;
+	int i, ret;
+
+	memset(hdrp, 0, sizeof(struct archived_file_header_tag));
+
+	if (read_archive_header(in, &hlen, &start) < 0)
+		return -1;
+
+	for (i = 0; i < hlen; i++) {
+		ret = read_entry(in, start, hdrp);
+		if (ret < 0)
+			return -1;
+		if (ret == 0 || hdrp->method != 0)
+			break;
 	}
 
 	return 0;
@@ -102,7 +129,7 @@ static unsigned char *read_file_data(FILE *in,
 	unsigned char *data;
 	int siz = hdrp->compressed_size;
 
-	if (siz <= 0 || (data = malloc(siz)) == NULL) {
+	if (siz <= 0 || (data = libxmp_malloc(siz)) == NULL) {
 		goto err;
 	}
 	if (fseek(in, hdrp->offset, SEEK_SET) < 0) {
@@ -115,20 +142,18 @@ static unsigned char *read_file_data(FILE *in,
 	return data;
 
     err2:
-	free(data);
+	libxmp_free(data);
     err:
 	return NULL;
 }
 
-static int arcfs_extract(FILE *in, FILE *out)
+static int arcfs_extract_file(FILE *in, FILE *out,
+			      struct archived_file_header_tag *hdrp)
 {
-	struct archived_file_header_tag hdr;
+	struct archived_file_header_tag hdr = *hdrp;
 	unsigned char *data, *orig_data;
 	int exitval = 0;
 
-	if (read_file_header(in, &hdr) < 0)
-		return -1;
-
 	if (hdr.method == 0)
 		return -1;
 
@@ -146,7 +171,7 @@ static int arcfs_extract(FILE *in, FILE *out)
 	switch (hdr.method) {
 	case 2:		/* no compression */
 		if (hdr.orig_size != hdr.compressed_size) {
-			free(data);
+			libxmp_free(data);
 			return -1;
 		}
 		orig_data = data;
@@ -169,12 +194,12 @@ static int arcfs_extract(FILE *in, FILE *out)
 		break;
 
 	default:
-		free(data);
+		libxmp_free(data);
 		return -1;
 	}
 
 	if (orig_data == NULL) {
-		free(data);
+		libxmp_free(data);
 		return -1;
 	}
 
@@ -182,13 +207,58 @@ static int arcfs_extract(FILE *in, FILE *out)
 		exitval = -1;
 
 	if (orig_data != data)	/* don't free uncompressed stuff twice :-) */
-		free(orig_data);
+		libxmp_free(orig_data);
 
-	free(data);
+	libxmp_free(data);
 
 	return exitval;
 }
 
+static int arcfs_extract(FILE *in, FILE *out)
+{
+	struct archived_file_header_tag hdr;
+
+	if (read_file_header(in, &hdr) < 0)
+		return -1;
+
+	return arcfs_extract_file(in, out, &hdr);
+}
+
+static int list_arcfs(FILE *in, struct xmp_archive_entry *entries, int max)
+{
+	struct archived_file_header_tag hdr;
+	long offset;
+	int hlen, start;
+	int i, ret;
+	int num = 0;
+
+	if (read_archive_header(in, &hlen, &start) < 0)
+		return -1;
+
+	for (i = 0; i < hlen; i++) {
+		if ((offset = ftell(in)) < 0)
+			return -1;
+		ret = read_entry(in, start, &hdr);
+		if (ret < 0)
+			return -1;
+		if (ret == 0)
+			break;
+		if (hdr.method == 0)
+			continue;
+
+		if (num < max) {
+			strncpy(entries[num].name, hdr.name,
+				XMP_ARCHIVE_NAME_SIZE - 1);
+			entries[num].name[XMP_ARCHIVE_NAME_SIZE - 1] = 0;
+			entries[num].size = hdr.orig_size;
+			entries[num].offset = offset;
+		}
+		num++;
+	}
+
+	return num;
+}
+
 static int test_arcfs(unsigned char *b)
 {
 	return !memcmp(b, "Archive\0", 8);
@@ -208,7 +278,30 @@ static int decrunch_arcfs(FILE * f, FILE * fo)
 	return 0;
 }
 
+/* The member offset is the position of its directory entry */
+static int decrunch_arcfs_member(FILE *f, FILE *fo, long offset)
+{
+	struct archived_file_header_tag hdr;
+	int hlen, start;
+
+	if (fo == NULL)
+		return -1;
+
+	if (read_archive_header(f, &hlen, &start) < 0)
+		return -1;
+
+	if (fseek(f, offset, SEEK_SET) < 0)
+		return -1;
+
+	if (read_entry(f, start, &hdr) <= 0)
+		return -1;
+
+	return arcfs_extract_file(f, fo, &hdr);
+}
+
 struct depacker libxmp_depacker_arcfs = {
 	test_arcfs,
-	decrunch_arcfs
+	decrunch_arcfs,
+	list_arcfs,
+	decrunch_arcfs_member
 };
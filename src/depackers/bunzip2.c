@@ -519,7 +519,7 @@ static int start_bunzip(bunzip_data **bdp, FILE *in, char *inbuf, int len)
 	i=sizeof(bunzip_data);
 	if(in!=NULL) i+=IOBUF_SIZE;
 	/* Allocate bunzip_data.  Most fields initialize to zero. */
-	if(!(bd=*bdp=malloc(i))) return RETVAL_OUT_OF_MEMORY;
+	if(!(bd=*bdp=libxmp_malloc(i))) return RETVAL_OUT_OF_MEMORY;
 	memset(bd,0,sizeof(bunzip_data));
 	/* Setup input buffer */
 	if(NULL==(bd->in=in)) {
@@ -549,7 +549,7 @@ static int start_bunzip(bunzip_data **bdp, FILE *in, char *inbuf, int len)
 	   uncompressed data.  Allocate intermediate buffer for block. */
 	bd->dbufSize=100000*(i-BZh0);
 
-	if(!(bd->dbuf=malloc(bd->dbufSize * sizeof(unsigned int))))
+	if(!(bd->dbuf=libxmp_malloc(bd->dbufSize * sizeof(unsigned int))))
 		return RETVAL_OUT_OF_MEMORY;
 	return RETVAL_OK;
 }
@@ -569,7 +569,7 @@ static int decrunch_bzip2(FILE *src, FILE *dst)
 
 	libxmp_crc32_init_B();
 
-	if(!(outbuf=malloc(IOBUF_SIZE))) return RETVAL_OUT_OF_MEMORY;
+	if(!(outbuf=libxmp_malloc(IOBUF_SIZE))) return RETVAL_OUT_OF_MEMORY;
 	if(!(i=start_bunzip(&bd,src,0,0))) {
 		for(;;) {
 			if((i=read_bunzip(bd,outbuf,IOBUF_SIZE)) <= 0) break;
@@ -581,9 +581,9 @@ static int decrunch_bzip2(FILE *src, FILE *dst)
 	}
 	/* Check CRC and release memory */
 	if(i==RETVAL_LAST_BLOCK && bd->headerCRC==bd->totalCRC) i=RETVAL_OK;
-	if(bd->dbuf) free(bd->dbuf);
-	free(bd);
-	free(outbuf);
+	if(bd->dbuf) libxmp_free(bd->dbuf);
+	libxmp_free(bd);
+	libxmp_free(outbuf);
 	return i == 0 ? 0 : -1;
 }
 
@@ -52,6 +52,7 @@
 #endif
 
 #define BUFLEN 16384
+#define MAX_LAYERS 8	/* maximum depth of nested packed files */
 
 static struct depacker *depacker_list[] = {
 #if defined LIBXMP_AMIGA && !defined __AROS__
@@ -74,8 +75,6 @@ static struct depacker *depacker_list[] = {
 	NULL
 };
 
-int test_oxm		(FILE *);
-
 #if defined(HAVE_FORK) && defined(HAVE_PIPE) && defined(HAVE_EXECVP) && \
     defined(HAVE_DUP2) && defined(HAVE_WAIT)
 #define DECRUNCH_USE_FORK
@@ -199,13 +198,202 @@ static int execute_command(const char * const cmd[], FILE *t)
 }
 #endif /* USE_FORK */
 
+/* Depacked data is kept in memory if the C library can open memory
+ * streams, or in temporary files otherwise
+ */
+#if defined(HAVE_FMEMOPEN) && defined(HAVE_OPEN_MEMSTREAM)
+#define DECRUNCH_IN_MEMORY
+#endif
+
+struct layer {
+	FILE *f;
+	char *temp;		/* temporary file name */
+	char *buf;		/* memory stream buffer */
+	size_t size;
+};
+
+static int open_layer(struct layer *l)
+{
+	memset(l, 0, sizeof(struct layer));
+#ifdef DECRUNCH_IN_MEMORY
+	l->f = open_memstream(&l->buf, &l->size);
+#else
+	l->f = make_temp_file(&l->temp);
+#endif
+	return (l->f == NULL)? -1 : 0;
+}
+
+/* Finish writing the data produced by the depacker */
+static int finish_layer(struct layer *l)
+{
+#ifdef DECRUNCH_IN_MEMORY
+	int ret = fclose(l->f);
+	l->f = NULL;
+	return ret;
+#else
+	long size;
+
+	if (fseek(l->f, 0, SEEK_END) < 0 || (size = ftell(l->f)) < 0) {
+		return -1;
+	}
+	l->size = size;
+	return fseek(l->f, 0, SEEK_SET);
+#endif
+}
+
+static int read_layer_header(struct layer *l, unsigned char *b, int len)
+{
+#ifdef DECRUNCH_IN_MEMORY
+	if ((size_t)len > l->size) {
+		len = l->size;
+	}
+	memcpy(b, l->buf, len);
+	return len;
+#else
+	len = fread(b, 1, len, l->f);
+	if (fseek(l->f, 0, SEEK_SET) < 0) {
+		return -1;
+	}
+	return len;
+#endif
+}
+
+/* Get a stream to read the layer data from, to depack it again */
+static FILE *layer_input(struct layer *l)
+{
+#ifdef DECRUNCH_IN_MEMORY
+	l->f = fmemopen(l->buf, l->size, "rb");
+#endif
+	return l->f;
+}
+
+static void close_layer(struct layer *l)
+{
+	if (l->f != NULL) {
+		fclose(l->f);
+	}
+	free(l->buf);		/* allocated by open_memstream() */
+	unlink_temp_file(l->temp);
+}
+
+#ifdef DECRUNCH_IN_MEMORY
+
+/* Loaders of modules with companion files, such as MFP and ALM, only look
+ * for them when reading from a file. Check the header loosely, a false
+ * match only costs a temporary file.
+ */
+static int has_companion_files(struct layer *l)
+{
+	const uint8 *b = (const uint8 *)l->buf;
+
+	if (l->size >= 7 && (!memcmp(b, "ALEYMOD", 7) ||
+			     !memcmp(b, "ALEY MO", 7))) {
+		return 1;
+	}
+
+	if (l->size >= 384 && b[249] == 0x7f &&
+	    b[248] == readmem16b(b + 378) &&
+	    readmem16b(b + 378) == readmem16b(b + 380)) {
+		return 1;
+	}
+
+	return 0;
+}
+
+#endif
+
+/* Open the depacked module for the loaders. The data stays in memory,
+ * unless the module was loaded from a path and needs its companion files.
+ */
+static HIO_HANDLE *open_layer_handle(struct layer *l, const char *filename,
+				     char **temp)
+{
+#ifdef DECRUNCH_IN_MEMORY
+	char *buf = l->buf;
+	int spill = filename != NULL && has_companion_files(l);
+	FILE *f;
+
+	if (l->f != NULL) {
+		fclose(l->f);
+	}
+	l->f = NULL;
+	l->buf = NULL;
+
+	if (spill && (f = make_temp_file(temp)) != NULL) {
+		if (fwrite(buf, 1, l->size, f) == l->size &&
+		    fseek(f, 0, SEEK_SET) == 0) {
+			free(buf);
+			return hio_open_file2(f);
+		}
+		fclose(f);
+		unlink_temp_file(*temp);
+		*temp = NULL;
+	}
+
+	return hio_open_mem2(buf, l->size);
+#else
+	(void) filename;
+	*temp = l->temp;
+	return hio_open_file2(l->f);
+#endif
+}
+
+static struct depacker *find_depacker(unsigned char *b)
+{
+	int i;
+
+	for (i = 0; depacker_list[i] != NULL; i++) {
+		if (depacker_list[i]->test(b)) {
+			D_(D_INFO "Use depacker %d", i);
+			return depacker_list[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* List the members of an archive without depacking them. Returns the
+ * number of members, filling up to max entries, or -1 if the file is
+ * not an archive we can list.
+ */
+int libxmp_list_archive(FILE *f, struct xmp_archive_entry *entries, int max)
+{
+	unsigned char b[1024];
+	struct depacker *depacker;
+
+	if (fread(b, 1, 1024, f) < 100) {
+		return -1;
+	}
+
+	depacker = find_depacker(b);
+	if (depacker == NULL || depacker->list == NULL) {
+		return -1;
+	}
+
+	if (fseek(f, 0, SEEK_SET) < 0) {
+		return -1;
+	}
+
+	return depacker->list(f, entries, max);
+}
+
 int libxmp_decrunch(HIO_HANDLE **h, const char *filename, char **temp)
+{
+	return libxmp_decrunch_member(h, filename, -1, temp);
+}
+
+/* Depack a file, or only the archive member at the given offset if
+ * offset is not negative.
+ */
+int libxmp_decrunch_member(HIO_HANDLE **h, const char *filename, long offset,
+			   char **temp)
 {
 	unsigned char b[1024];
 	const char *cmd[32];
-	FILE *f, *t;
+	struct layer layer, next;
+	FILE *f;
 	int headersize;
-	int i;
+	int i, depth;
 	struct depacker *depacker = NULL;
 
 	cmd[0] = NULL;
@@ -214,16 +402,15 @@ int libxmp_decrunch(HIO_HANDLE **h, const char *filename, char **temp)
 
 	headersize = fread(b, 1, 1024, f);
 	if (headersize < 100) {	/* minimum valid file size */
-		return 0;
+		return offset < 0 ? 0 : -1;
 	}
 
 	/* Check built-in depackers */
-	for (i = 0; depacker_list[i] != NULL; i++) {
-		if (depacker_list[i]->test(b)) {
-			depacker = depacker_list[i];
-			D_(D_INFO "Use depacker %d", i);
-			break;
-		}
+	depacker = find_depacker(b);
+
+	if (offset >= 0 && (depacker == NULL || depacker->depack_member == NULL)) {
+		D_(D_CRIT "can't extract archive members");
+		return -1;
 	}
 
 	/* Check external commands */
@@ -252,10 +439,6 @@ int libxmp_decrunch(HIO_HANDLE **h, const char *filename, char **temp)
 			cmd[i++] = "-x*.com";
 			cmd[i++] = filename;
 			cmd[i++] = NULL;
-		} else if (test_oxm(f) == 0) {
-			/* oggmod */
-			D_(D_INFO "oggmod");
-			depacker = &libxmp_depacker_oxm;
 		}
 	}
 
@@ -284,39 +467,86 @@ int libxmp_decrunch(HIO_HANDLE **h, const char *filename, char **temp)
 
 	D_(D_WARN "Depacking file... ");
 
-	if ((t = make_temp_file(temp)) == NULL) {
+	if (open_layer(&layer) < 0) {
 		goto err;
 	}
 
 	/* Depack file */
 	if (cmd[0]) {
 		D_(D_INFO "External depacker: %s", cmd[0]);
-		if (execute_command(cmd, t) < 0) {
+		if (execute_command(cmd, layer.f) < 0) {
+			D_(D_CRIT "failed");
+			goto err2;
+		}
+	} else if (offset >= 0) {
+		D_(D_INFO "Internal depacker, member at %ld", offset);
+		if (depacker->depack_member(f, layer.f, offset) < 0) {
 			D_(D_CRIT "failed");
 			goto err2;
 		}
 	} else if (depacker) {
 		D_(D_INFO "Internal depacker");
-		if (depacker->depack(f, t) < 0) {
+		if (depacker->depack(f, layer.f) < 0) {
 			D_(D_CRIT "failed");
 			goto err2;
 		}
 	}
 
-	D_(D_INFO "done");
-
-	if (fseek(t, 0, SEEK_SET) < 0) {
-		D_(D_CRIT "fseek error");
+	if (finish_layer(&layer) < 0) {
+		D_(D_CRIT "write error");
 		goto err2;
 	}
 
+	/* Depack nested files, such as a gzipped LHA archive or a packed
+	 * module stored in an archive
+	 */
+	for (depth = 1; ; depth++) {
+		memset(b, 0, sizeof(b));
+		headersize = read_layer_header(&layer, b, 1024);
+		if (headersize < 0) {
+			goto err2;
+		}
+		if (headersize < 100 || (depacker = find_depacker(b)) == NULL) {
+			break;
+		}
+		if (depth >= MAX_LAYERS) {
+			D_(D_CRIT "too many nested packed files");
+			goto err2;
+		}
+
+		D_(D_INFO "Nested packed file, depth %d", depth);
+		if ((f = layer_input(&layer)) == NULL) {
+			goto err2;
+		}
+		if (open_layer(&next) < 0) {
+			goto err2;
+		}
+		if (depacker->depack(f, next.f) < 0 ||
+		    finish_layer(&next) < 0 || next.size == 0) {
+			/* Signature matched but the data isn't really packed,
+			 * leave it to the loaders
+			 */
+			D_(D_WARN "failed, using previous layer");
+			close_layer(&next);
+			if (fseek(f, 0, SEEK_SET) < 0) {
+				goto err2;
+			}
+			break;
+		}
+
+		close_layer(&layer);
+		layer = next;
+	}
+
+	D_(D_INFO "done");
+
 	hio_close(*h);
-	*h = hio_open_file2(t);
+	*h = open_layer_handle(&layer, filename, temp);
 
 	return (*h == NULL)? -1 : 0;
 
     err2:
-	fclose(t);
+	close_layer(&layer);
     err:
 	return -1;
 }
@@ -19,14 +19,24 @@ extern struct depacker libxmp_depacker_muse;
 extern struct depacker libxmp_depacker_lzx;
 extern struct depacker libxmp_depacker_s404;
 extern struct depacker libxmp_depacker_xfd;
-extern struct depacker libxmp_depacker_oxm;
 
+/* Archive depackers may also list their members and extract a single
+ * member given the offset reported by list(). Both are optional.
+ *
+ * The input may be a memory stream without a file descriptor, and the
+ * output should be written sequentially.
+ */
 struct depacker {
 	int (*const test)(unsigned char *);
 	int (*const depack)(FILE *, FILE *);
+	int (*const list)(FILE *, struct xmp_archive_entry *, int);
+	int (*const depack_member)(FILE *, FILE *, long);
 };
 
 int	libxmp_decrunch		(HIO_HANDLE **h, const char *filename, char **temp);
+int	libxmp_decrunch_member	(HIO_HANDLE **h, const char *filename, long offset,
+				 char **temp);
+int	libxmp_list_archive	(FILE *, struct xmp_archive_entry *, int);
 int	libxmp_exclude_match	(const char *);
 
 #endif /* LIBXMP_DEPACKER_H */
@@ -1,1232 +1,710 @@
+/* Extended Module Player
+ * Copyright (C) 1996-2021 Claudio Matsuoka and Hipolito Carraro Jr
+ *
+ * This file is part of the Extended Module Player and is distributed
+ * under the terms of the GNU Lesser General Public License. See COPYING.LIB
+ * for more information.
+ */
+
+/* Deflate decoder (see RFC1950 and RFC1951)
+ *
+ * Huffman codes are decoded with two level lookup tables indexed by the
+ * next input bits: codes up to the root size resolve in a single lookup
+ * and longer codes go through a subtable. Input is read in blocks into a
+ * 64-bit bit buffer, and output goes to a flat buffer holding at least
+ * the 32 KB window, so matches are plain copies without wrapping. The
+ * same decoder inflates from and to files or memory buffers.
+ */
+
 #include "common.h"
 #include "inflate.h"
 #include "crc32.h"
 
-#define read_int_b(x) read32b(x, NULL)
-#define read_word(x) read16l(x, NULL)
-
-#define ZIP
-#undef DEBUG
-
-/*
-
-This code is Copyright 2005-2006 by Michael Kohn
-
-Modified for xmp by Claudio Matsuoka, Jul 2009
-
-This package is licensed under the LGPL. You are free to use this library
-in both commercial and non-commercial applications as long as you dynamically
-link to it. If you statically link this library you must also release your
-software under the LGPL. If you need more flexibility in the license email
-me and we can work something out.
+#define WINDOW_SIZE	32768
+#define OUTBUF_SIZE	(WINDOW_SIZE * 2)
+#define INBUF_SIZE	16384
+#define MAX_BITS	15
+
+/* Root table sizes and the largest tables they can produce for valid
+ * codes, as computed by zlib's enough utility
+ */
+#define LEN_ROOT	9
+#define DIST_ROOT	6
+#define LEN_TABLE_SIZE	852
+#define DIST_TABLE_SIZE	592
+
+#define NUM_LENS	288
+#define NUM_DISTS	32
+
+struct huff_entry {
+	uint16 val;		/* symbol, or subtable offset */
+	uint8 len;		/* code length, 0 if not a valid code */
+	uint8 sub;		/* subtable index bits, 0 for symbols */
+};
 
-Michael Kohn <mike@mikekohn.net>
+struct inflate_state {
+	/* Input */
+	FILE *in_file;
+	const uint8 *in;
+	long in_pos;
+	long in_end;
+	uint64 bitbuf;
+	int bitcnt;
+
+	/* Output */
+	FILE *out_file;
+	uint8 *out;
+	long out_pos;
+	long out_size;
+	long out_flushed;
+	uint32 crc;
+
+	struct huff_entry len_table[LEN_TABLE_SIZE];
+	struct huff_entry dist_table[DIST_TABLE_SIZE];
+	uint8 inbuf[INBUF_SIZE];
+};
 
-*/
+static const uint16 length_base[29] = {
+	3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+	35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
 
-#define WINDOW_SIZE 32768
+static const uint8 length_extra[29] = {
+	0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+	3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
 
-struct bitstream_t
-{
-  unsigned int holding;
-  int bitptr;
+static const uint16 dist_base[30] = {
+	1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+	257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+	8193, 12289, 16385, 24577
 };
 
-struct huffman_t
-{
-  unsigned char window[WINDOW_SIZE];
-  int window_ptr;
-  unsigned int checksum;
-  int len[288];
-  int dist_len[33];
-  int dist_huff_count;
+static const uint8 dist_extra[30] = {
+	0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+	7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
 };
 
-struct huffman_tree_t
-{
-  unsigned short int code;
-  short int left;
-  short int right;
+/* Order of the code length code lengths */
+static const uint8 clen_order[19] = {
+	16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15
 };
 
-#define DIST_CODES_SIZE 30
-#define LENGTH_CODES_SIZE 29
-#define HUFFMAN_TREE_SIZE 1024
-#define DYN_HUFF_TRANS_SIZE 19
-
-static const int length_codes[LENGTH_CODES_SIZE] = {
-                         3,4,5,6,7,8,9,10,11,13,15,17,19,
-                         23,27,31,35,43,51,59,67,83,99,115,
-                         131,163,195,227,258 };
-
-static const int length_extra_bits[29] = { 0,0,0,0,0,0,0,0,1,1,1,1,
-                              2,2,2,2,3,3,3,3,4,4,4,4,
-                              5,5,5,5,0 };
-
-static const int dist_codes[DIST_CODES_SIZE] = { 1,2,3,4,5,7,9,13,17,25,
-                             33,49,65,97,129,193,257,385,513,769,
-                             1025,1537,2049,3073,4097,6145,8193,
-                             12289,16385,24577 };
-
-static const int dist_extra_bits[30] = { 0,0,0,0,1,1,2,2,3,3,
-                            4,4,5,5,6,6,7,7,8,8,
-                            9,9,10,10,11,11,12,12,13,13 };
-
-static const int dyn_huff_trans[DYN_HUFF_TRANS_SIZE] = {
-                           16, 17, 18, 0, 8, 7, 9, 6, 10, 5,
-                           11, 4, 12, 3, 13, 2, 14, 1, 15 };
-
-static const unsigned char reverse[256] = {
-0, 128, 64, 192, 32, 160, 96, 224, 16, 144, 80, 208, 48, 176, 112, 240,
-8, 136, 72, 200, 40, 168, 104, 232, 24, 152, 88, 216, 56, 184, 120, 248,
-4, 132, 68, 196, 36, 164, 100, 228, 20, 148, 84, 212, 52, 180, 116, 244,
-12, 140, 76, 204, 44, 172, 108, 236, 28, 156, 92, 220, 60, 188, 124, 252,
-2, 130, 66, 194, 34, 162, 98, 226, 18, 146, 82, 210, 50, 178, 114, 242,
-10, 138, 74, 202, 42, 170, 106, 234, 26, 154, 90, 218, 58, 186, 122, 250,
-6, 134, 70, 198, 38, 166, 102, 230, 22, 150, 86, 214, 54, 182, 118, 246,
-14, 142, 78, 206, 46, 174, 110, 238, 30, 158, 94, 222, 62, 190, 126, 254,
-1, 129, 65, 193, 33, 161, 97, 225, 17, 145, 81, 209, 49, 177, 113, 241,
-9, 137, 73, 201, 41, 169, 105, 233, 25, 153, 89, 217, 57, 185, 121, 249,
-5, 133, 69, 197, 37, 165, 101, 229, 21, 149, 85, 213, 53, 181, 117, 245,
-13, 141, 77, 205, 45, 173, 109, 237, 29, 157, 93, 221, 61, 189, 125, 253,
-3, 131, 67, 195, 35, 163, 99, 227, 19, 147, 83, 211, 51, 179, 115, 243,
-11, 139, 75, 203, 43, 171, 107, 235, 27, 155, 91, 219, 59, 187, 123, 251,
-7, 135, 71, 199, 39, 167, 103, 231, 23, 151, 87, 215, 55, 183, 119, 247,
-15, 143, 79, 207, 47, 175, 111, 239, 31, 159, 95, 223, 63, 191, 127, 255 };
-
-#ifdef DEBUG
-int print_binary(int b, int l)
+/*
+ * Input
+ */
+
+static void read_input(struct inflate_state *st)
 {
-  if ((l-1)!=0)
-  { print_binary(b>>1,l-1); }
+	size_t n;
 
-  printf("%d",(b&1));
+	if (st->in_file == NULL) {
+		return;
+	}
 
-  return 0;
+	n = fread(st->inbuf, 1, INBUF_SIZE, st->in_file);
+	st->in = st->inbuf;
+	st->in_pos = 0;
+	st->in_end = n;
 }
-#endif
 
-#if 0
-static int kunzip_inflate_free(struct inflate_data *data)
+/* Fill the bit buffer with as many whole bytes as it can hold */
+static int fill_bits(struct inflate_state *st)
 {
-  if (data->huffman_tree_len_static!=0)
-  { free(data->huffman_tree_len_static); }
-
-  return 0;
+	while (st->bitcnt <= 56) {
+		if (st->in_pos >= st->in_end) {
+			read_input(st);
+			if (st->in_pos >= st->in_end) {
+				break;
+			}
+		}
+		st->bitbuf |= (uint64)st->in[st->in_pos++] << st->bitcnt;
+		st->bitcnt += 8;
+	}
+
+	return st->bitcnt;
 }
-#endif
 
-#if 0
-static unsigned int get_alder(FILE *out)
+static int get_bits(struct inflate_state *st, int n)
 {
-  unsigned int s1,s2;
-  unsigned int adler;
-  int len,t,value;
+	int val;
+
+	if (st->bitcnt < n && fill_bits(st) < n) {
+		return -1;
+	}
 
-  len=ftell(out);
-  fseek(out,0,SEEK_SET);
+	val = st->bitbuf & ((1 << n) - 1);
+	st->bitbuf >>= n;
+	st->bitcnt -= n;
 
-  adler=1;
+	return val;
+}
 
-  s1=adler&0xffff;
-  s2=(adler>>16);
+/* Put back the whole bytes left in the bit buffer */
+static void unread_bits(struct inflate_state *st)
+{
+	st->bitbuf >>= st->bitcnt & 7;
+	st->bitcnt &= ~7;
+
+	if (st->in_file != NULL) {
+		long n = st->in_end - st->in_pos + st->bitcnt / 8;
+		if (n > 0) {
+			fseek(st->in_file, -n, SEEK_CUR);
+		}
+	} else {
+		st->in_pos -= st->bitcnt / 8;
+	}
+
+	st->bitbuf = 0;
+	st->bitcnt = 0;
+}
 
-  for (t=0; t<len; t++)
-  {
-    value=getc(out);
+/*
+ * Output
+ */
 
-    s1=(s1+value)%65521;
-    s2=(s2+s1)%65521;
-  }
-  adler=(s2<<16)+s1;
+static int flush_output(struct inflate_state *st)
+{
+	long len = st->out_pos - st->out_flushed;
 
-  fseek(out,len,SEEK_SET);
+	if (fwrite(st->out + st->out_flushed, 1, len, st->out_file)
+							!= (size_t)len) {
+		return -1;
+	}
+	st->crc = libxmp_crc32_A2(st->out + st->out_flushed, len, st->crc);
+	st->out_flushed = st->out_pos;
 
-  return adler;
+	return 0;
 }
-#endif
 
-static int reverse_bitstream(struct bitstream_t *bitstream)
+/* Make room for n more bytes, keeping the window behind the output */
+static int need_output(struct inflate_state *st, long n)
 {
-  unsigned int i;
+	uint8 *buf;
+	long size;
+
+	if (st->out_pos + n <= st->out_size) {
+		return 0;
+	}
+
+	if (st->out_file != NULL) {
+		if (flush_output(st) < 0) {
+			return -1;
+		}
+		if (st->out_pos > WINDOW_SIZE) {
+			memmove(st->out, st->out + st->out_pos - WINDOW_SIZE,
+								WINDOW_SIZE);
+			st->out_pos = st->out_flushed = WINDOW_SIZE;
+		}
+		return 0;
+	}
+
+	for (size = st->out_size; size < st->out_pos + n; size *= 2);
+	buf = (uint8 *)libxmp_realloc(st->out, size);
+	if (buf == NULL) {
+		return -1;
+	}
+	st->out = buf;
+	st->out_size = size;
+
+	return 0;
+}
 
-  i=reverse[((bitstream->holding>>24)&255)]|
-    (reverse[((bitstream->holding>>16)&255)]<<8)|
-    (reverse[((bitstream->holding>>8)&255)]<<16)|
-    (reverse[(bitstream->holding&255)]<<24);
+/*
+ * Huffman tables
+ */
 
-  i=i>>(32-bitstream->bitptr);
-  bitstream->holding=i;
+static unsigned int reverse_bits(unsigned int code, int len)
+{
+	unsigned int rev = 0;
 
-  return 0;
-}
+	while (len--) {
+		rev = (rev << 1) | (code & 1);
+		code >>= 1;
+	}
 
+	return rev;
+}
 
-static int add_static_codes_to_tree(struct huffman_tree_t *huffman_tree, int code_len, int count, int start_code, int start_uncomp_code, int next_leaf)
+/* Build the lookup table for a canonical Huffman code. Incomplete codes
+ * are accepted (their unused entries are invalid), but not codes that
+ * are oversubscribed or too sparse to fit in the table.
+ */
+static int build_table(struct huff_entry *table, int size, int root,
+		       const uint8 *lens, int num)
 {
-  struct huffman_tree_t *curr_huffman_leaf;
-  int t,x,r;
-
-  // code_len=code_len-1;
-
-  for (t=0; t<count; t++)
-  {
-    curr_huffman_leaf=huffman_tree;
-    x=1<<(code_len-1);
-    for (r=0; r<code_len; r++)
-    {
-      if ((start_code&x)==0)
-      {
-        if (curr_huffman_leaf->left==0)
-        {
-          next_leaf++;
-          curr_huffman_leaf->left=next_leaf;
-          huffman_tree[next_leaf].left=0;
-          huffman_tree[next_leaf].right=0;
-        }
-
-        curr_huffman_leaf=&huffman_tree[curr_huffman_leaf->left];
-      }
-        else
-      {
-        if (curr_huffman_leaf->right==0)
-        {
-          next_leaf++;
-          curr_huffman_leaf->right=next_leaf;
-          huffman_tree[next_leaf].left=0;
-          huffman_tree[next_leaf].right=0;
-        }
-
-        curr_huffman_leaf=&huffman_tree[curr_huffman_leaf->right];
-      }
-
-      x=x>>1;
-    }
-
-    curr_huffman_leaf->code=start_uncomp_code++;
-    start_code++;
-  }
-
-
-  return next_leaf;
+	int count[MAX_BITS + 1];
+	unsigned int next[MAX_BITS + 1];
+	uint16 rev[NUM_LENS];
+	uint8 sub[1 << LEN_ROOT];
+	unsigned int code, mask = (1 << root) - 1;
+	struct huff_entry e, *t;
+	int i, j, len, left, pos;
+
+	memset(count, 0, sizeof(count));
+	for (i = 0; i < num; i++) {
+		count[lens[i]]++;
+	}
+	count[0] = 0;
+
+	left = 1;
+	for (len = 1; len <= MAX_BITS; len++) {
+		left <<= 1;
+		left -= count[len];
+		if (left < 0) {
+			return -1;
+		}
+	}
+
+	code = 0;
+	for (len = 1; len <= MAX_BITS; len++) {
+		code = (code + count[len - 1]) << 1;
+		next[len] = code;
+	}
+
+	memset(table, 0, (1 << root) * sizeof(struct huff_entry));
+	memset(sub, 0, 1 << root);
+
+	/* Deflate sends codes starting from the most significant bit, so
+	 * reverse them to index the table with the bit buffer. Short codes
+	 * go to the root table, long codes set the size of the subtable
+	 * for their first root bits.
+	 */
+	for (i = 0; i < num; i++) {
+		len = lens[i];
+		if (len == 0) {
+			continue;
+		}
+		rev[i] = reverse_bits(next[len]++, len);
+		if (len <= root) {
+			e.val = i;
+			e.len = len;
+			e.sub = 0;
+			for (j = rev[i]; j <= (int)mask; j += 1 << len) {
+				table[j] = e;
+			}
+		} else if (len - root > sub[rev[i] & mask]) {
+			sub[rev[i] & mask] = len - root;
+		}
+	}
+
+	pos = 1 << root;
+	for (i = 0; i <= (int)mask; i++) {
+		if (sub[i] == 0) {
+			continue;
+		}
+		if (pos + (1 << sub[i]) > size) {
+			return -1;
+		}
+		table[i].val = pos;
+		table[i].len = root;
+		table[i].sub = sub[i];
+		memset(table + pos, 0, (1 << sub[i]) * sizeof(struct huff_entry));
+		pos += 1 << sub[i];
+	}
+
+	for (i = 0; i < num; i++) {
+		len = lens[i];
+		if (len <= root) {
+			continue;
+		}
+		t = &table[rev[i] & mask];
+		e.val = i;
+		e.len = len;
+		e.sub = 0;
+		for (j = rev[i] >> root; j < 1 << t->sub; j += 1 << (len - root)) {
+			table[t->val + j] = e;
+		}
+	}
+
+	return 0;
 }
 
-static int load_fixed_huffman(struct huffman_t *huffman, struct huffman_tree_t **huffman_tree_ptr)
+/* Decode a symbol, the bit buffer must be filled if possible */
+static int decode(struct inflate_state *st, const struct huff_entry *table,
+		  int root)
 {
-  struct huffman_tree_t *huffman_tree;
-  int next_leaf;
-  /*
-  int t;
-  int code;
-  */
+	const struct huff_entry *e;
 
-#ifdef DEBUG
-printf("load_fixed_huffman()\n");
-#endif
+	e = &table[st->bitbuf & ((1 << root) - 1)];
+	if (e->sub) {
+		e = &table[e->val + ((st->bitbuf >> root) & ((1 << e->sub) - 1))];
+	}
 
-/*
-  code=0x30;   // 0011 0000
-  for (t=0; t<=143; t++)
-  {
-    huffman->len[t]=8;
-    huffman->code[t]=code;
-    code++;
-  }
-
-  code=0x190;  // 1 1001 0000
-  for (t=144; t<=255; t++)
-  {
-    huffman->len[t]=9;
-    huffman->code[t]=code;
-    code++;
-  }
-
-  code=0x00;   // 0000000
-  for (t=256; t<=279; t++)
-  {
-    huffman->len[t]=7;
-    huffman->code[t]=code;
-    code++;
-  }
-
-  code=0xc0;   // 1100 0000
-  for (t=280; t<=287; t++)
-  {
-    huffman->len[t]=8;
-    huffman->code[t]=code;
-    code++;
-  }
-
-*/
-
-  huffman->dist_huff_count=0;
-
-  huffman_tree=malloc(600*sizeof(struct huffman_tree_t));
-  if (huffman_tree == NULL)
-    return -1;
-
-  *huffman_tree_ptr=huffman_tree;
-
-  huffman_tree->left=0;
-  huffman_tree->right=0;
-
-/* printf("adding static\n"); */
-  next_leaf=0;
-  next_leaf=add_static_codes_to_tree(huffman_tree,8,144,0x30,0,next_leaf);
-  next_leaf=add_static_codes_to_tree(huffman_tree,9,112,0x190,144,next_leaf);
-  next_leaf=add_static_codes_to_tree(huffman_tree,7,24,0x00,256,next_leaf);
-  next_leaf=add_static_codes_to_tree(huffman_tree,8,8,0xc0,280,next_leaf);
-/* printf("next_leaf=%d\n",next_leaf); */
-
-  return 0;
+	if (e->len == 0 || e->len > st->bitcnt) {
+		return -1;
+	}
+
+	st->bitbuf >>= e->len;
+	st->bitcnt -= e->len;
+
+	return e->val;
 }
 
-static int load_codes(FILE *in, struct bitstream_t *bitstream, int *lengths, int len_size, int count, int *hclen_code_length, int *hclen_code, struct huffman_tree_t *huffman_tree)
+static int fixed_tables(struct inflate_state *st)
 {
-  int r,t,c,x,b;
-  int code,curr_code;
-  int bl_count[512];
-  int next_code[512];
-  int bits,max_bits;
-  int next_leaf,curr_leaf;
-
-#ifdef DEBUG
-  printf("Entering load_codes()\n");
-#endif
-
-  r=0;
-  while (r<count)
-  {
-    for (t=0; t<19; t++)
-    {
-      if (hclen_code_length[t]==0) continue;
-      while (bitstream->bitptr<hclen_code_length[t])
-      {
-        b = getc(in);
-        if (b < 0)
-          return -1;
-
-        bitstream->holding=reverse[b]+(bitstream->holding<<8);
-        bitstream->bitptr+=8;
-      }
-
-      curr_code=(bitstream->holding>>(bitstream->bitptr-hclen_code_length[t]));
-
-#ifdef DEBUG
-  /*
-  print_binary(curr_code,hclen_code_length[t]);
-  printf(" ");
-  print_binary(hclen_code[t],hclen_code_length[t]);
-  printf("\n");
-  */
-#endif
-
-      if (curr_code==hclen_code[t])
-      {
-        bitstream->bitptr-=hclen_code_length[t];
-        bitstream->holding=bitstream->holding&((1<<bitstream->bitptr)-1);
-        break;
-      }
-    }
-
-    if (t<=15)
-    {
-      /* Sanity check */
-      if (r >= len_size)
-        return -1;
-
-      lengths[r++]=t;
-    }
-      else
-    if (t==16)
-    {
-      if (r!=0)
-      { code=lengths[r-1]; }
-        else
-      { code=0; }
-
-      if (bitstream->bitptr<2)
-      {
-        b = getc(in);
-        if (b < 0)
-          return -1;
-
-        bitstream->holding=reverse[b]+(bitstream->holding<<8);
-        bitstream->bitptr+=8;
-      }
-
-      x=reverse[bitstream->holding>>(bitstream->bitptr-2)]>>6;
-      bitstream->bitptr-=2;
-      bitstream->holding=bitstream->holding&((1<<bitstream->bitptr)-1);
-
-      /* Sanity check */
-      if (r + x + 3 >= len_size)
-        return -1;
-
-      for (c=0; c<x+3; c++)
-      { lengths[r++]=code; }
-    }
-      else
-    if (t==17)
-    {
-      if (bitstream->bitptr<3)
-      {
-        b = getc(in);
-        if (b < 0)
-          return -1;
-
-        bitstream->holding=reverse[b]+(bitstream->holding<<8);
-        bitstream->bitptr+=8;
-      }
-
-      x=reverse[bitstream->holding>>(bitstream->bitptr-3)]>>5;
-      bitstream->bitptr-=3;
-      bitstream->holding=bitstream->holding&((1<<bitstream->bitptr)-1);
-
-      c=x+3;
-
-      /* Sanity check */
-      if (r + c >= len_size)
-        return -1;
-
-      memset(&lengths[r],0,sizeof(int)*c);
-      r=r+c;
-    }
-      else
-    if (t==18)
-    {
-      if (bitstream->bitptr<7)
-      {
-        b = getc(in);
-        if (b < 0)
-          return -1;
-
-        bitstream->holding=reverse[b]+(bitstream->holding<<8);
-        bitstream->bitptr+=8;
-      }
-
-      x=reverse[bitstream->holding>>(bitstream->bitptr-7)]>>1;
-      bitstream->bitptr-=7;
-      bitstream->holding=bitstream->holding&((1<<bitstream->bitptr)-1);
-
-      c=x+11;
-
-      /* Sanity check */
-      if (r + c >= len_size)
-        return -1;
-
-      memset(&lengths[r],0,sizeof(int)*c);
-      r=r+c;
-
-    }
-      else
-    {
-#ifdef DEBUG
-      fprintf(stderr, "inflate: error in bitstream reading in literal code length %d\n",t);
-#endif
-      return -1;
-    }
-  }
-
-#ifdef DEBUG
-  printf("r=%d count=%d\n",r,count);
-#endif
-
-  /* time to load the codes */
-
-  memset(bl_count,0,count*sizeof(int));
-  /* memset(next_code,0,count*sizeof(int)); */
-
-  max_bits=0;
-  for (t=0; t<count; t++)
-  {
-    /* CM: workaround for crash with whacke.zip */
-    if (lengths[t] >= count) {
-      /* fprintf(stderr, "unzip: decompression error\n"); */
-      return -1;
-    }
-
-    bl_count[lengths[t]]++;
-    if (max_bits<lengths[t]) max_bits=lengths[t];
-  }
-
-  code=0;
-  bl_count[0]=0;
-  for (bits=1; bits<=max_bits; bits++)
-  {
-    code=(code+bl_count[bits-1])<<1;
-    next_code[bits]=code;
-  }
-
-  huffman_tree->left=0;
-  huffman_tree->right=0;
-  next_leaf=0;
-
-  for (t=0; t<count; t++)
-  {
-    if (lengths[t]!=0)
-    {
-#ifdef DEBUG
-  printf(">> %d %d %d    next_leaf=%d\n",t,lengths[t],codes[t],next_leaf);
-#endif
-
-      code=next_code[lengths[t]];
-
-      curr_leaf=0;
-
-      x=1<<(lengths[t]-1);
-      for (r=0; r<lengths[t]; r++)
-      {
-        if ((code&x)==0)
-        {
-          if (huffman_tree[curr_leaf].left==0)
-          {
-            next_leaf++;
-            huffman_tree[curr_leaf].left=next_leaf;
-            huffman_tree[next_leaf].left=0;
-            huffman_tree[next_leaf].right=0;
-          }
-
-          curr_leaf=huffman_tree[curr_leaf].left;
-        }
-          else
-        {
-          if (huffman_tree[curr_leaf].right==0)
-          {
-            next_leaf++;
-            huffman_tree[curr_leaf].right=next_leaf;
-            huffman_tree[next_leaf].left=0;
-            huffman_tree[next_leaf].right=0;
-          }
-
-          curr_leaf=huffman_tree[curr_leaf].right;
-        }
-
-        x=x>>1;
-      }
-
-      huffman_tree[curr_leaf].code=t;
-
-      next_code[lengths[t]]++;
-    }
-  }
-
-#ifdef DEBUG
-  printf("Leaving load_codes()\n");
-#endif
-
-  return 0;
+	uint8 lens[NUM_LENS];
+
+	memset(lens, 8, 144);
+	memset(lens + 144, 9, 112);
+	memset(lens + 256, 7, 24);
+	memset(lens + 280, 8, 8);
+	if (build_table(st->len_table, LEN_TABLE_SIZE, LEN_ROOT,
+							lens, NUM_LENS) < 0) {
+		return -1;
+	}
+
+	memset(lens, 5, NUM_DISTS);
+	return build_table(st->dist_table, DIST_TABLE_SIZE, DIST_ROOT,
+							lens, NUM_DISTS);
 }
 
-static int load_dynamic_huffman(FILE *in, struct huffman_t *huffman, struct bitstream_t *bitstream, struct huffman_tree_t *huffman_tree_len, struct huffman_tree_t *huffman_tree_dist)
+static int dynamic_tables(struct inflate_state *st)
 {
-  int hlit,hdist,hclen;
-  int hclen_code_lengths[19];
-  int hclen_code[19];
-  int bl_count[19];
-  int next_code[19];
-  int code,bits;
-  int t;
-  int b;
-  int res;
-
-  while (bitstream->bitptr<14)
-  {
-    b = getc(in);
-    if (b < 0)
-      return -1;
-
-    bitstream->holding=reverse[b]+(bitstream->holding<<8);
-    bitstream->bitptr+=8;
-  }
-
-  hlit=(bitstream->holding>>(bitstream->bitptr-5));
-  bitstream->bitptr-=5;
-  bitstream->holding=bitstream->holding&((1<<bitstream->bitptr)-1);
-
-  hdist=(bitstream->holding>>(bitstream->bitptr-5));
-  bitstream->bitptr-=5;
-  bitstream->holding=bitstream->holding&((1<<bitstream->bitptr)-1);
-
-  hclen=(bitstream->holding>>(bitstream->bitptr-4));
-  bitstream->bitptr-=4;
-  bitstream->holding=bitstream->holding&((1<<bitstream->bitptr)-1);
-
-  hlit=(reverse[hlit]>>3)+257;
-  hdist=(reverse[hdist]>>3)+1;
-  hclen=(reverse[hclen]>>4)+4;
-
-  /* Sanity check */
-  if (hclen > DYN_HUFF_TRANS_SIZE)
-    return -1;
-
-/* printf("%d %d %d\n",hclen,sizeof(struct huffman_tree_t),hclen*sizeof(struct huffman_tree_t)); */
-
-#ifdef DEBUG
-  printf("hlit: %d\n",hlit);
-  printf("hdist: %d\n",hdist);
-  printf("hclen: %d\n",hclen);
-#endif
-
-  memset(hclen_code_lengths,0,19*sizeof(int));
-  memset(hclen_code,0,19*sizeof(int));
-  memset(bl_count,0,19*sizeof(int));
-  /* memset(next_code,0,19*sizeof(int)); */
-
-  /* load the first huffman table */
-
-  for (t=0; t<hclen; t++)
-  {
-    int len;
-
-    if (bitstream->bitptr<3)
-    {
-      b = getc(in);
-      if (b < 0)
-        return -1;
-
-      bitstream->holding=reverse[b]+(bitstream->holding<<8);
-      bitstream->bitptr+=8;
-    }
-
-    len = bitstream->holding >> (bitstream->bitptr-3);
-    hclen_code_lengths[dyn_huff_trans[t]] = reverse[len] >> 5;
-    bitstream->bitptr -= 3;
-    bitstream->holding = bitstream->holding&((1<<bitstream->bitptr)-1);
-  }
-
-#ifdef DEBUG
-  printf("\nCode Lengths\n");
-  printf("------------------\n");
-  for (t=0; t<19; t++)
-  {
-    printf("%d %d\n",t,hclen_code_lengths[t]);
-  }
-  printf("\n\n");
-#endif
-
-  for (t=0; t<19; t++)
-  {
-    bl_count[hclen_code_lengths[t]]++;
-  }
-
-#ifdef DEBUG
-  printf("\nbl_count[]\n");
-  printf("------------------\n");
-  for (t=0; t<8; t++)
-  {
-    printf("%d  %d\n",t,bl_count[t]);
-  }
-  printf("\n");
-#endif
-
-  code=0;
-  bl_count[0]=0;
-  for (bits=1; bits<=7; bits++)
-  {
-    code=(code+bl_count[bits-1])<<1;
-    next_code[bits]=code;
-  }
-
-#ifdef DEBUG
-  printf("next_code[]\n");
-  printf("------------------\n");
-  for (t=0; t<bits; t++)
-  {
-    printf("%d  %d ",t,next_code[t]);
-    if (t!=0) print_binary(next_code[t],t);
-    printf("\n");
-  }
-  printf("\n");
-#endif
-
-  for (t=0; t<19; t++)
-  {
-    if (hclen_code_lengths[t]!=0)
-    {
-      hclen_code[t]=next_code[hclen_code_lengths[t]];
-      next_code[hclen_code_lengths[t]]++;
-    }
-  }
-
-#ifdef DEBUG
-  printf("Huffman1 Table\n");
-  printf("------------------\n");
-  for (t=0; t<19; t++)
-  {
-    printf("%d  %d %d ",t,hclen_code[t],hclen_code_lengths[t]);
-    if (hclen_code_lengths[t]!=0) print_binary(hclen_code[t],hclen_code_lengths[t]);
-    printf("\n");
-  }
-  printf("\n");
-#endif
-
-  /* load literal tables */
-
-  memset(huffman->len,0,288*sizeof(int));
-  /* memset(huffman->code,0,288*sizeof(int)); */
-
-  res = load_codes(in,bitstream,huffman->len,288,hlit,hclen_code_lengths,hclen_code,huffman_tree_len);
-  if (res < 0)
-    return -1;
-
-#ifdef DEBUG
-  printf("\nLiteral Table\n");
-  printf("------------------\n");
-  for (t=0; t<hlit; t++)
-  {
-    if (huffman->len[t]!=0)
-    {
-      printf("%d  %d %d  ",t,huffman->code[t],huffman->len[t]);
-      if (huffman->len[t]!=0) print_binary(huffman->code[t],huffman->len[t]);
-      printf("\n");
-    }
-  }
-#endif
-
-  /* load distant tables */
-
-  if (hdist==0)
-  {
-    huffman->dist_huff_count=0;
-  }
-    else
-  {
-    huffman->dist_huff_count=hdist;
-
-    memset(huffman->dist_len,0,33*sizeof(int));
-    /* memset(huffman->dist_code,0,33*sizeof(int)); */
-
-    res = load_codes(in,bitstream,huffman->dist_len,33,hdist,hclen_code_lengths,hclen_code,huffman_tree_dist);
-    if (res < 0)
-      return -1;
-
-  }
-
-  return 0;
+	uint8 lens[NUM_LENS + NUM_DISTS];
+	int hlit, hdist, hclen;
+	int i, sym, len, rep;
+
+	hlit = get_bits(st, 5);
+	hdist = get_bits(st, 5);
+	hclen = get_bits(st, 4);
+	if (hclen < 0) {
+		return -1;
+	}
+	hlit += 257;
+	hdist += 1;
+	hclen += 4;
+	if (hlit > 286 || hdist > 30) {
+		return -1;
+	}
+
+	/* Code length code, decoded with the distance table */
+	memset(lens, 0, 19);
+	for (i = 0; i < hclen; i++) {
+		len = get_bits(st, 3);
+		if (len < 0) {
+			return -1;
+		}
+		lens[clen_order[i]] = len;
+	}
+	if (build_table(st->dist_table, DIST_TABLE_SIZE, 7, lens, 19) < 0) {
+		return -1;
+	}
+
+	for (i = 0; i < hlit + hdist; ) {
+		if (st->bitcnt < MAX_BITS) {
+			fill_bits(st);
+		}
+		sym = decode(st, st->dist_table, 7);
+		if (sym < 0) {
+			return -1;
+		}
+
+		if (sym < 16) {
+			lens[i++] = sym;
+			continue;
+		}
+
+		len = 0;
+		if (sym == 16) {
+			if (i == 0) {
+				return -1;
+			}
+			len = lens[i - 1];
+			rep = get_bits(st, 2);
+			rep += rep < 0 ? 0 : 3;
+		} else if (sym == 17) {
+			rep = get_bits(st, 3);
+			rep += rep < 0 ? 0 : 3;
+		} else {
+			rep = get_bits(st, 7);
+			rep += rep < 0 ? 0 : 11;
+		}
+		if (rep < 0 || i + rep > hlit + hdist) {
+			return -1;
+		}
+		memset(lens + i, len, rep);
+		i += rep;
+	}
+
+	/* The end of block code must be present */
+	if (lens[256] == 0) {
+		return -1;
+	}
+
+	if (build_table(st->len_table, LEN_TABLE_SIZE, LEN_ROOT,
+							lens, hlit) < 0) {
+		return -1;
+	}
+
+	return build_table(st->dist_table, DIST_TABLE_SIZE, DIST_ROOT,
+							lens + hlit, hdist);
 }
 
-int decompress(FILE *in, struct huffman_t *huffman, struct bitstream_t *bitstream, struct huffman_tree_t *huffman_tree_len, struct huffman_tree_t *huffman_tree_dist, FILE *out, struct inflate_data *data)
-{
-  int code=0,len,dist;
-  int t,r;
-  unsigned char *window;
-  struct huffman_tree_t *curr_huffman_leaf;
-  int window_ptr;
-  int curr_leaf;
-
-#ifdef DEBUG
-  printf("decompress()\n");
-  printf("holding=%d bitptr=%d\n",bitstream->holding,bitstream->bitptr);
-#endif
-
-  /* printf("bitstream: %08x  %d\n",bitstream->holding,bitstream->bitptr); */
-  reverse_bitstream(bitstream);
-  /* printf("bitstream: %08x  %d\n",bitstream->holding,bitstream->bitptr); */
-
-  window_ptr=huffman->window_ptr;
-  window=huffman->window;
-
-  while(1)
-  {
-    curr_huffman_leaf=huffman_tree_len;
-    curr_leaf=0;
-
-    while(1)
-    {
-      if (bitstream->bitptr<=0)
-      {
-        /* bitstream->holding+=(getc(in)<<bitstream->bitptr); */
-        /* bitstream->bitptr+=8; */
-        int x = getc(in);
-        if (x == EOF) {
-          return -1;
-        }
-        bitstream->holding=x;
-        bitstream->bitptr=8;
-      }
-#ifdef DEBUG
-  printf("%d  (%c)  %d %d   (holding=%d  bitptr=%d)\n",curr_leaf,huffman_tree_len[curr_leaf].code,huffman_tree_len[curr_leaf].left,huffman_tree_len[curr_leaf].right,bitstream->holding,bitstream->bitptr);
-  fflush(stdout);
-#endif
-
-      if ((bitstream->holding&1)==0)
-      {
-        if (huffman_tree_len[curr_leaf].left==0)
-        {
-          code=huffman_tree_len[curr_leaf].code;
-          break;
-        }
-        curr_leaf=huffman_tree_len[curr_leaf].left;
-      }
-        else
-      {
-        if (huffman_tree_len[curr_leaf].right==0)
-        {
-          code=huffman_tree_len[curr_leaf].code;
-          break;
-        }
-        curr_leaf=huffman_tree_len[curr_leaf].right;
-      }
-
-      /* Sanity check */
-      if (curr_leaf >= HUFFMAN_TREE_SIZE) {
-#ifdef DEBUG
-	fprintf(stderr, "inflate: corrupt huffman tree\n");
-#endif
-	return -1;
-      }
-
-      bitstream->bitptr-=1;
-      bitstream->holding>>=1;
-    }
-
-    /* if (t==288) { printf("Unknown huffman code\n"); return -1; } */
-
-#ifdef DEBUG
-  printf("------------------------\n");
-  printf("code=%d\n",code);
-#endif
-
-    if (code<256)
-    {
-      /* putc(code,out); */
-#ifdef DEBUG
-  if (code>=32 && code<=128)
-  { printf("output %d %c\n",code,code); }
-    else
-  { printf("output %d\n",code); }
-#endif
-      window[window_ptr++]=code;
-      if (window_ptr>=WINDOW_SIZE)
-      {
-        fwrite(window,1,WINDOW_SIZE,out);
-        huffman->checksum=libxmp_crc32_A2(huffman->window,WINDOW_SIZE,huffman->checksum);
-        window_ptr=0;
-      }
-    }
-      else
-    if (code==256)
-    {
-#ifdef DEBUG
-  printf("end-of-block %d\n",code);
-#endif
-      break;
-    }
-      else
-    {
-#ifdef DEBUG
-  printf("LZ77 TIME %d\n",code);
-  fflush(stdout);
-#endif
-      code=code-257;
-
-      /* Sanity check */
-      if (code >= LENGTH_CODES_SIZE)
-        return -1;
-
-      len=length_codes[code];
-      if (length_extra_bits[code]!=0)
-      {
-        while (bitstream->bitptr<length_extra_bits[code])
-        {
-          int x = getc(in);
-          if (x < 0)
-            return -1;
-
-          bitstream->holding+=(x<<bitstream->bitptr);
-          bitstream->bitptr+=8;
-        }
-
-#ifdef DEBUG
-  printf("len=%d  extra_bits=%d  extra bits value=%d\n",len,length_extra_bits[code],bitstream->holding>>(bitstream->bitptr-length_extra_bits[code]));
-  fflush(stdout);
-#endif
-
-        len=len+(bitstream->holding&((1<<length_extra_bits[code])-1));
-        bitstream->bitptr-=length_extra_bits[code];
-        bitstream->holding>>=length_extra_bits[code];
-      }
-
-      if (huffman_tree_dist == 0 || huffman->dist_huff_count==0)
-      {
-        if (bitstream->bitptr<5)
-        {
-          int x = getc(in);
-          if (x < 0)
-            return -1;
-
-          bitstream->holding+=(x<<bitstream->bitptr);
-          bitstream->bitptr+=8;
-        }
-
-        code=(bitstream->holding&0x1f);
-        code=reverse[code&255]>>3;
-        bitstream->bitptr-=5;
-        bitstream->holding>>=5;
-#ifdef DEBUG
-  printf("DIST code=%d\n",code);
-  fflush(stdout);
-#endif
-      }
-        else
-      {
-        curr_huffman_leaf=huffman_tree_len;
-        curr_leaf=0;
-
-        while(1)
-        {
-          if (bitstream->bitptr<=0)
-          {
-            /* bitstream->holding+=(getc(in)<<bitstream->bitptr); */
-            /* bitstream->bitptr+=8; */
-            int x = getc(in);
-            if (x < 0)
-              return -1;
-
-            bitstream->holding=x;
-            bitstream->bitptr=8;
-          }
-#ifdef DEBUG
-  printf("%d  (%c)  %d %d   (holding=%d  bitptr=%d)\n",curr_leaf,huffman_tree_len[curr_leaf].code,huffman_tree_len[curr_leaf].left,huffman_tree_len[curr_leaf].right,bitstream->holding,bitstream->bitptr);
-  fflush(stdout);
-#endif
-
-          if ((bitstream->holding&1)==0)
-          {
-            if (huffman_tree_dist[curr_leaf].left==0)
-            {
-              code=huffman_tree_dist[curr_leaf].code;
-              break;
-            }
-            curr_leaf=huffman_tree_dist[curr_leaf].left;
-          }
-            else
-          {
-            if (huffman_tree_dist[curr_leaf].right==0)
-            {
-              code=huffman_tree_dist[curr_leaf].code;
-              break;
-            }
-            curr_leaf=huffman_tree_dist[curr_leaf].right;
-          }
-
-          /* Sanity check */
-          if (curr_leaf >= HUFFMAN_TREE_SIZE) {
-#ifdef DEBUG
-	    fprintf(stderr, "inflate: corrupt huffman tree\n");
-#endif
-	    return -1;
-          }
-
-          bitstream->bitptr-=1;
-          bitstream->holding>>=1;
-        }
-      }
-
-      /* Sanity check */
-      if (code >= DIST_CODES_SIZE) {
-#ifdef DEBUG
-	fprintf(stderr, "inflate: corrupt input\n");
-#endif
-        return -1;
-      }
-
-      dist=dist_codes[code];
-
-      if (dist_extra_bits[code]!=0)
-      {
-        while (bitstream->bitptr<dist_extra_bits[code])
-        {
-          int x = getc(in);
-          if (x < 0)
-            return -1;
-
-          bitstream->holding+=(x<<bitstream->bitptr);
-          bitstream->bitptr+=8;
-        }
-
-#ifdef DEBUG
-  printf("code=%d  distance=%d  num_extra_bits=%d extra_bits=%d\n",code,dist_codes[code],dist_extra_bits[code],(bitstream->holding>>(bitstream->bitptr-dist_extra_bits[code])
-  ));
-#endif
-
-        dist=dist+(bitstream->holding&((1<<dist_extra_bits[code])-1));
-
-        bitstream->bitptr-=dist_extra_bits[code];
-        bitstream->holding>>=dist_extra_bits[code];
-      }
-
-#ifdef DEBUG
-  printf("len: %d dist: %d\n",len,dist);
-#endif
-/*
-if (dist<0 || len>dist)
+/* Decode a compressed block. At most 48 bits are needed for a length
+ * and distance pair, so the bit buffer is filled once per symbol.
+ */
+static int inflate_codes(struct inflate_state *st)
 {
-printf(">> OOPS! dist=%d  len=%d  (%d) ftell=%d\n",dist,len,huffman->dist_huff_count,ftell(out));
-exit(0);
-
+	uint8 *out;
+	int sym, len, dist, n;
+
+	for (;;) {
+		if (st->bitcnt < 48) {
+			fill_bits(st);
+		}
+
+		sym = decode(st, st->len_table, LEN_ROOT);
+		if (sym < 256) {
+			if (sym < 0) {
+				return -1;
+			}
+			if (st->out_pos >= st->out_size && need_output(st, 1) < 0) {
+				return -1;
+			}
+			st->out[st->out_pos++] = sym;
+			continue;
+		}
+
+		if (sym == 256) {
+			return 0;
+		}
+
+		sym -= 257;
+		if (sym >= 29) {
+			return -1;
+		}
+		len = length_base[sym];
+		n = length_extra[sym];
+		if (n > 0) {
+			if (st->bitcnt < n) {
+				return -1;
+			}
+			len += st->bitbuf & ((1 << n) - 1);
+			st->bitbuf >>= n;
+			st->bitcnt -= n;
+		}
+
+		sym = decode(st, st->dist_table, DIST_ROOT);
+		if (sym < 0 || sym >= 30) {
+			return -1;
+		}
+		dist = dist_base[sym];
+		n = dist_extra[sym];
+		if (n > 0) {
+			if (st->bitcnt < n) {
+				return -1;
+			}
+			dist += st->bitbuf & ((1 << n) - 1);
+			st->bitbuf >>= n;
+			st->bitcnt -= n;
+		}
+
+		if (need_output(st, len) < 0) {
+			return -1;
+		}
+
+		out = st->out + st->out_pos;
+		if (dist >= len && dist <= st->out_pos) {
+			memcpy(out, out - dist, len);
+		} else {
+			/* Overlapping copy repeats the last dist bytes, and
+			 * distances before the start of the output read zeros
+			 * from the initially empty window
+			 */
+			for (n = 0; n < len; n++) {
+				out[n] = n - dist < -st->out_pos ? 0 : out[n - dist];
+			}
+		}
+		st->out_pos += len;
+	}
 }
-*/
-
-
-/* HERE */
 
-      r=window_ptr-dist;
-
-/* I would have thought the memcpy (which gets called most of the time)
-   would have been a huge speed up.  I was wrong.  Maybe I'll try writing
-   some inline assembly later for x86 for this */
-
-      if (r>=0 && (window_ptr+len<WINDOW_SIZE && r+len<window_ptr))
-      /* if (r>=0 && (window_ptr+len<WINDOW_SIZE)) */
-      {
-        memcpy(window+window_ptr,window+r,len);
-        window_ptr=window_ptr+len;
-      }
-        else
-      {
-        if (r<0) r=r+WINDOW_SIZE;
-
-        for (t=0; t<len; t++)
-        {
-          window[window_ptr++]=window[r++];
-          if (r>=WINDOW_SIZE) r=0;
-
-          if (window_ptr>=WINDOW_SIZE)
-          {
-            fwrite(window,1,WINDOW_SIZE,out);
-            huffman->checksum=libxmp_crc32_A2(huffman->window,WINDOW_SIZE,huffman->checksum);
-            window_ptr=0;
-          }
-        }
-      }
-
-#ifdef DEBUG
-  printf("\n");
-#endif
-    }
-  }
-
-  huffman->window_ptr=window_ptr;
-
-  reverse_bitstream(bitstream);
+static int inflate_stored(struct inflate_state *st)
+{
+	int len, nlen, n;
+
+	/* Skip to a byte boundary */
+	st->bitbuf >>= st->bitcnt & 7;
+	st->bitcnt &= ~7;
+
+	len = get_bits(st, 16);
+	nlen = get_bits(st, 16);
+	if (nlen < 0 || len != (nlen ^ 0xffff)) {
+		return -1;
+	}
+
+	/* Bytes already in the bit buffer */
+	for (; len > 0 && st->bitcnt > 0; len--) {
+		if (need_output(st, 1) < 0) {
+			return -1;
+		}
+		st->out[st->out_pos++] = st->bitbuf & 0xff;
+		st->bitbuf >>= 8;
+		st->bitcnt -= 8;
+	}
+
+	while (len > 0) {
+		if (st->in_pos >= st->in_end) {
+			read_input(st);
+			if (st->in_pos >= st->in_end) {
+				return -1;
+			}
+		}
+		n = st->in_end - st->in_pos;
+		if (n > len) {
+			n = len;
+		}
+		if (need_output(st, n) < 0) {
+			return -1;
+		}
+		memcpy(st->out + st->out_pos, st->in + st->in_pos, n);
+		st->in_pos += n;
+		st->out_pos += n;
+		len -= n;
+	}
+
+	return 0;
+}
 
-  return 0;
+static int inflate_stream(struct inflate_state *st, int is_zip)
+{
+	int cmf, flg, last, type;
+
+	/* zlib header */
+	if (!is_zip) {
+		cmf = get_bits(st, 8);
+		flg = get_bits(st, 8);
+		if (flg < 0 || (cmf & 0x0f) != 8 || (cmf * 256 + flg) % 31 != 0) {
+			return -1;
+		}
+		if (flg & 0x20) {
+			/* Preset dictionary id, ignored */
+			get_bits(st, 16);
+			if (get_bits(st, 16) < 0) {
+				return -1;
+			}
+		}
+	}
+
+	do {
+		last = get_bits(st, 1);
+		type = get_bits(st, 2);
+
+		switch (type) {
+		case 0:
+			if (inflate_stored(st) < 0) {
+				return -1;
+			}
+			break;
+		case 1:
+			if (fixed_tables(st) < 0 || inflate_codes(st) < 0) {
+				return -1;
+			}
+			break;
+		case 2:
+			if (dynamic_tables(st) < 0 || inflate_codes(st) < 0) {
+				return -1;
+			}
+			break;
+		default:
+			return -1;
+		}
+	} while (!last);
+
+	unread_bits(st);
+
+	return 0;
 }
 
 int libxmp_inflate(FILE *in, FILE *out, uint32 *checksum, int is_zip)
 {
-/* #ifndef ZIP */
-  unsigned char CMF, FLG;
-  unsigned int DICT;
-/* #endif */
-  struct bitstream_t bitstream;
-  struct huffman_t huffman;
-  int comp_method;
-  int block_len,bfinal;
-  int t;
-  struct huffman_tree_t *huffman_tree_len = NULL;
-  struct huffman_tree_t *huffman_tree_dist = NULL;
-  struct inflate_data data;
-  int res;
-
-  memset(&huffman, 0, sizeof(struct huffman_t));
-  huffman.checksum=0xffffffff;
-
-  data.huffman_tree_len_static = NULL;
-
-  huffman_tree_len=malloc(HUFFMAN_TREE_SIZE * sizeof(struct huffman_tree_t));
-  if (huffman_tree_len == NULL)
-    goto err;
-
-  memset(huffman_tree_len, 0xff, HUFFMAN_TREE_SIZE * sizeof(struct huffman_tree_t));
-
-  huffman_tree_dist=malloc(HUFFMAN_TREE_SIZE * sizeof(struct huffman_tree_t));
-  if (huffman_tree_dist == NULL)
-    goto err;
-
-  memset(huffman_tree_dist, 0xff, HUFFMAN_TREE_SIZE * sizeof(struct huffman_tree_t));
-
-  huffman.window_ptr=0;
-
-#ifdef DEBUG
-  printf("\nStarting at %d 0x%x\n",(int)ftell(in),(int)ftell(in));
-#endif
-
-if (!is_zip) {
-  int x = getc(in);
-  if (x < 0) {
-    goto err;
-  }
-  CMF=x;
-
-  x = getc(in);
-  if (x < 0) {
-    goto err;
-  }
-  FLG=x;
-
-#ifdef DEBUG
-  printf("   CMF: %d\n",CMF);
-  printf("   FLG: %d\n",FLG);
-  printf("    CM: %d\n",CMF&15);
-  printf(" CINFO: %d\n",(CMF>>4)&15);
-  printf("FCHECK: %d\n",FLG&31);
-  printf(" FDICT: %d\n",(FLG>5)&1);
-  printf("FLEVEL: %d\n\n",(FLG>6)&3);
-#endif
-
-  if ((CMF&15)!=8)
-  {
-    /* printf("Unsupported compression used.\n"); */
-    goto err;
-  }
-
-  if ((FLG&32)!=0)
-  {
-    DICT=read_int_b(in);
-  }
-
-  if (((CMF*256+FLG)%31)!=0)
-  {
-    /* printf("FCHECK fails.\n"); */
-    goto err;
-  }
+	struct inflate_state *st;
+	int ret = -1;
+
+	st = (struct inflate_state *)libxmp_malloc(sizeof(struct inflate_state));
+	if (st == NULL) {
+		return -1;
+	}
+
+	st->out = (uint8 *)libxmp_malloc(OUTBUF_SIZE);
+	if (st->out == NULL) {
+		goto err;
+	}
+
+	st->in_file = in;
+	st->in = st->inbuf;
+	st->in_pos = 0;
+	st->in_end = 0;
+	st->bitbuf = 0;
+	st->bitcnt = 0;
+	st->out_file = out;
+	st->out_pos = 0;
+	st->out_size = OUTBUF_SIZE;
+	st->out_flushed = 0;
+	st->crc = 0xffffffff;
+
+	if (inflate_stream(st, is_zip) < 0) {
+		goto err1;
+	}
+
+	if (flush_output(st) < 0) {
+		goto err1;
+	}
+
+	*checksum = st->crc ^ 0xffffffff;
+	ret = 0;
+
+    err1:
+	libxmp_free(st->out);
+    err:
+	libxmp_free(st);
+	return ret;
 }
 
-  /* kunzip_inflate_init(&data); */
-
-  bitstream.holding=0;
-  bitstream.bitptr=0;
-
-  while(1)
-  {
-    if (bitstream.bitptr<3)
-    {
-      res = getc(in);
-      if (res < 0) {
-        goto err;
-      }
-
-      bitstream.holding=reverse[res]+(bitstream.holding<<8);
-      bitstream.bitptr+=8;
-    }
-
-#ifdef DEBUG
-  printf("holding=%d\n",bitstream.holding);
-#endif
-
-    bfinal=bitstream.holding>>(bitstream.bitptr-1);
-    comp_method=(bitstream.holding>>(bitstream.bitptr-3))&3;
-
-    bitstream.bitptr-=3;
-    bitstream.holding=bitstream.holding&((1<<bitstream.bitptr)-1);
-
-#ifdef DEBUG
-  printf("comp_method=%d  bfinal=%d\n",comp_method,bfinal);
-#endif
-
-    if (comp_method==0)
-    {
-      /* No Compression */
-      bitstream.holding=0;
-      bitstream.bitptr=0;
-
-      block_len=read_word(in);
-
-      t=read_word(in)^0xffff;
-
-      if (block_len!=t)
-      {
-        /* printf("Error: LEN and NLEN don't match (%d %d)\n",block_len,t); */
-        break;
-      }
-
-      for (t=0; t<block_len; t++)
-      {
-        res = getc(in);
-        if (res < 0) {
-          goto err;
-        }
-        huffman.window[huffman.window_ptr++]=res;
-
-        if (huffman.window_ptr>=WINDOW_SIZE)
-        {
-          fwrite(huffman.window,1,WINDOW_SIZE,out);
-          huffman.checksum=libxmp_crc32_A2(huffman.window,WINDOW_SIZE,huffman.checksum);
-          huffman.window_ptr=0;
-        }
-      }
-    }
-      else
-    if (comp_method==2)
-    {
-      /* Fixed Huffman */
-      if (data.huffman_tree_len_static == NULL) {
-	if (load_fixed_huffman(&huffman, &data.huffman_tree_len_static) < 0)
-	  goto err;
-      }
-
-      if (decompress(in, &huffman, &bitstream, data.huffman_tree_len_static, 0, out, &data) < 0) {
-          goto err;
-      }
-/*
-      free(huffman_tree_len);
-      huffman_tree_len=0;
-*/
-    }
-      else
-    if (comp_method==1)
-    {
-      /* Dynamic Huffman */
-      res = load_dynamic_huffman(in,&huffman,&bitstream,huffman_tree_len,huffman_tree_dist);
-      if (res < 0) {
-        goto err;
-      }
-
-      if (decompress(in, &huffman, &bitstream, huffman_tree_len, huffman_tree_dist, out, &data) < 0) {
-        goto err;
-      }
-
-    }
-      else
-    if (comp_method==3)
-    {
-      /* Error */
-      /* printf("Error (inflate): unknown compression type\n"); */
-      break;
-    }
-
-    if (bfinal==1) { break; }
-  }
-
-
-  if (huffman.window_ptr!=0)
-  {
-    fwrite(huffman.window,1,huffman.window_ptr,out);
-    huffman.checksum=libxmp_crc32_A2(huffman.window,huffman.window_ptr,huffman.checksum);
-  }
-
-
-  free(huffman_tree_dist);
-  free(huffman_tree_len);
-
-  *checksum=huffman.checksum^0xffffffff;
-
-  free(data.huffman_tree_len_static);
-
-  /* for gzip */
-  if (bitstream.bitptr == 8) {
-    reverse_bitstream(&bitstream);
-    ungetc(bitstream.holding, in);
-  }
-
-  return 0;
-
- err:
-  free(data.huffman_tree_len_static);
-  free(huffman_tree_dist);
-  free(huffman_tree_len);
-  return -1;
+/* Inflate a memory buffer to a newly allocated buffer. Returns the number
+ * of input bytes used, or -1 on error.
+ */
+int libxmp_inflate_mem(const uint8 *in, long in_size, uint8 **out,
+		       long *out_size, uint32 *checksum, int is_zip)
+{
+	struct inflate_state *st;
+	int ret = -1;
+
+	st = (struct inflate_state *)libxmp_malloc(sizeof(struct inflate_state));
+	if (st == NULL) {
+		return -1;
+	}
+
+	/* Start with room for a typical compression ratio */
+	st->out_size = in_size < WINDOW_SIZE ? OUTBUF_SIZE : in_size * 4;
+	st->out = (uint8 *)libxmp_malloc(st->out_size);
+	if (st->out == NULL) {
+		goto err;
+	}
+
+	st->in_file = NULL;
+	st->in = in;
+	st->in_pos = 0;
+	st->in_end = in_size;
+	st->bitbuf = 0;
+	st->bitcnt = 0;
+	st->out_file = NULL;
+	st->out_pos = 0;
+	st->out_flushed = 0;
+
+	if (inflate_stream(st, is_zip) < 0) {
+		libxmp_free(st->out);
+		goto err;
+	}
+
+	*out = st->out;
+	*out_size = st->out_pos;
+	*checksum = libxmp_crc32_A2(st->out, st->out_pos, 0xffffffff) ^
+								0xffffffff;
+	ret = st->in_pos;
+
+    err:
+	libxmp_free(st);
+	return ret;
 }
@@ -33,6 +33,8 @@
 #define MMCMP_ABS16	0x0200
 #define MMCMP_ENDIAN	0x0400
 
+#define MAX_FILESIZE	0x10000000
+
 struct header {
 	int version;
 	int nblocks;
@@ -100,30 +102,33 @@ static uint32 get_bits(FILE *f, int n, struct bit_buffer *bb)
 	return bits;
 }
 
-static void block_copy(struct block *block, struct sub_block *sub,
-		       FILE *in, FILE *out)
+static int block_copy(struct block *block, struct sub_block *sub,
+		      FILE *in, uint8 *out)
 {
 	int i;
 
 	for (i = 0; i < block->sub_blk; i++, sub++) {
-		move_data(out, in, sub->unpk_size);
+		if (fread(out + sub->unpk_pos, 1, sub->unpk_size, in) !=
+							sub->unpk_size) {
+			return -1;
+		}
 	}
+
+	return 0;
 }
 
 static int block_unpack_16bit(struct block *block, struct sub_block *sub,
-			       FILE *in, FILE *out)
+			       FILE *in, uint8 *out)
 {
 	struct bit_buffer bb;
 	uint32 pos = 0;
 	uint32 numbits = block->num_bits;
 	uint32 j, oldval = 0;
+	uint8 *dest = out + sub->unpk_pos;
 
 	bb.count = 0;
 	bb.buffer = 0;
 
-	if (fseek(out, sub->unpk_pos, SEEK_SET) < 0) {
-		return -1;
-	}
 	if (fseek(in, block->tt_entries, SEEK_SET) < 0) {
 		return -1;
 	}
@@ -167,8 +172,11 @@ static int block_unpack_16bit(struct block *block, struct sub_block *sub,
 				newval ^= 0x8000;
 			}
 
+			if (pos < size) {
+				dest[pos * 2] = newval & 0xff;
+				dest[pos * 2 + 1] = (newval >> 8) & 0xff;
+			}
 			pos++;
-			write16l(out, newval);
 		}
 
 		if (pos >= size) {
@@ -176,9 +184,7 @@ static int block_unpack_16bit(struct block *block, struct sub_block *sub,
 				break;
 
 			pos = 0;
-			if (fseek(out, sub[j].unpk_pos, SEEK_SET) < 0) {
-				return -1;
-			}
+			dest = out + sub[j].unpk_pos;
 		}
 	}
 
@@ -186,13 +192,14 @@ static int block_unpack_16bit(struct block *block, struct sub_block *sub,
 }
 
 static int block_unpack_8bit(struct block *block, struct sub_block *sub,
-			      FILE *in, FILE *out)
+			      FILE *in, uint8 *out)
 {
 	struct bit_buffer bb;
 	uint32 pos = 0;
 	uint32 numbits = block->num_bits;
 	uint32 j, oldval = 0;
 	uint8 ptable[0x100];
+	uint8 *dest = out + sub->unpk_pos;
 
 	if (fread(ptable, 1, 0x100, in) != 0x100) {
 		return -1;
@@ -201,9 +208,6 @@ static int block_unpack_8bit(struct block *block, struct sub_block *sub,
 	bb.count = 0;
 	bb.buffer = 0;
 
-	if (fseek(out, sub->unpk_pos, SEEK_SET) < 0) {
-		return -1;
-	}
 	if (fseek(in, block->tt_entries, SEEK_SET) < 0) {
 		return -1;
 	}
@@ -240,8 +244,10 @@ static int block_unpack_8bit(struct block *block, struct sub_block *sub,
 				oldval = n;
 			}
 
+			if (pos < size) {
+				dest[pos] = n;
+			}
 			pos++;
-			write8(out, n);
 		}
 
 		if (pos >= size) {
@@ -249,9 +255,7 @@ static int block_unpack_8bit(struct block *block, struct sub_block *sub,
 				break;
 
 			pos = 0;
-			if (fseek(out, sub[j].unpk_pos, SEEK_SET) < 0) {
-				return -1;
-			}
+			dest = out + sub[j].unpk_pos;
 		}
 	}
 
@@ -263,10 +267,14 @@ static int test_mmcmp(unsigned char *b)
 	return memcmp(b, "ziRCONia", 8) == 0;
 }
 
+/* Blocks are unpacked to a buffer holding the whole file, since
+ * sub-blocks may be stored in any order
+ */
 static int decrunch_mmcmp(FILE *in, FILE *out)
 {
 	struct header h;
 	uint32 *table;
+	uint8 *data;
 	uint32 i, j;
 	int error;
 
@@ -294,13 +302,15 @@ static int decrunch_mmcmp(FILE *in, FILE *out)
 
 	if (h.nblocks == 0)
 		goto err;
+	if (h.filesize <= 0 || h.filesize > MAX_FILESIZE)
+		goto err;
 
 	/* Block table */
 	if (fseek(in, h.blktable, SEEK_SET) < 0) {
 		goto err;
 	}
 
-	if ((table = malloc(h.nblocks * 4)) == NULL) {
+	if ((table = libxmp_malloc(h.nblocks * 4)) == NULL) {
 		goto err;
 	}
 
@@ -309,17 +319,21 @@ static int decrunch_mmcmp(FILE *in, FILE *out)
 		if (error != 0) goto err2;
 	}
 
+	if ((data = libxmp_calloc(1, h.filesize)) == NULL) {
+		goto err2;
+	}
+
 	for (i = 0; i < h.nblocks; i++) {
 		struct block block;
 		struct sub_block *sub_block;
 		uint8 buf[20];
 
 		if (fseek(in, table[i], SEEK_SET) < 0) {
-			goto err2;
+			goto err3;
 		}
 
 		if (fread(buf, 1, 20, in) != 20) {
-			goto err2;
+			goto err3;
 		}
 
 		block.unpk_size  = readmem32l(buf);
@@ -332,33 +346,33 @@ static int decrunch_mmcmp(FILE *in, FILE *out)
 
                 /* Sanity check */
 		if (block.unpk_size <= 0 || block.pk_size <= 0)
-			goto err2;
+			goto err3;
 		if (block.tt_entries < 0 || block.pk_size <= block.tt_entries)
-			goto err2;
+			goto err3;
 		if (block.sub_blk <= 0)
-			goto err2;
+			goto err3;
 		if (block.flags & MMCMP_COMP) {
 			if (block.flags & MMCMP_16BIT) {
 				if (block.num_bits >= 16) {
-					goto err2;
+					goto err3;
 				}
 			} else {
 				if (block.num_bits >= 8) {
-					goto err2;
+					goto err3;
 				}
 			}
 		}
 
-		sub_block = malloc(block.sub_blk * sizeof (struct sub_block));
+		sub_block = libxmp_malloc(block.sub_blk * sizeof (struct sub_block));
 		if (sub_block == NULL)
-			goto err2;
+			goto err3;
 
 		for (j = 0; j < block.sub_blk; j++) {
 			uint8 buf[8];
 
 			if (fread(buf, 1, 8, in) != 8) {
-				free(sub_block);
-				goto err2;
+				libxmp_free(sub_block);
+				goto err3;
 			}
 
 			sub_block[j].unpk_pos  = readmem32l(buf);
@@ -366,9 +380,11 @@ static int decrunch_mmcmp(FILE *in, FILE *out)
 
 	                /* Sanity check */
 			if (sub_block[j].unpk_pos < 0 ||
-			    sub_block[j].unpk_size < 0) {
-				free(sub_block);
-				goto err2;
+			    sub_block[j].unpk_size < 0 ||
+			    sub_block[j].unpk_size > h.filesize -
+						sub_block[j].unpk_pos) {
+				libxmp_free(sub_block);
+				goto err3;
 			}
 		}
 
@@ -376,29 +392,39 @@ static int decrunch_mmcmp(FILE *in, FILE *out)
 
 		if (~block.flags & MMCMP_COMP) {
 			/* Data is not packed */
-			block_copy(&block, sub_block, in, out);
+			if (block_copy(&block, sub_block, in, data) < 0) {
+				libxmp_free(sub_block);
+				goto err3;
+			}
 		} else if (block.flags & MMCMP_16BIT) {
 			/* Data is 16-bit packed */
-			if (block_unpack_16bit(&block, sub_block, in, out) < 0) {
-				free(sub_block);
-				goto err2;
+			if (block_unpack_16bit(&block, sub_block, in, data) < 0) {
+				libxmp_free(sub_block);
+				goto err3;
 			}
 		} else {
 			/* Data is 8-bit packed */
-			if (block_unpack_8bit(&block, sub_block, in, out) < 0) {
-				free(sub_block);
-				goto err2;
+			if (block_unpack_8bit(&block, sub_block, in, data) < 0) {
+				libxmp_free(sub_block);
+				goto err3;
 			}
 		}
 
-		free(sub_block);
+		libxmp_free(sub_block);
+	}
+
+	if (fwrite(data, 1, h.filesize, out) != h.filesize) {
+		goto err3;
 	}
 
-	free(table);
+	libxmp_free(data);
+	libxmp_free(table);
 	return 0;
 
+    err3:
+	libxmp_free(data);
     err2:
-	free(table);
+	libxmp_free(table);
     err:
 	return -1;
 }
@@ -17,7 +17,6 @@
  * - decryption code removed
  */
 
-#include <sys/stat.h>
 #include "common.h"
 #include "depacker.h"
 
@@ -144,7 +143,7 @@ static int ppdepack(uint8 *data, size_t len, FILE *fo)
 
   /* fprintf(stderr, "decrunched length = %u bytes\n", outlen); */
 
-  output = (uint8 *) malloc(outlen);
+  output = (uint8 *) libxmp_malloc(outlen);
   if (output == NULL) {
     /*fprintf(stderr, "out of memory!\n");*/
     return -1;
@@ -161,7 +160,7 @@ static int ppdepack(uint8 *data, size_t len, FILE *fo)
   /*} else {
     success=-1;
   }*/
-  free(output);
+  libxmp_free(output);
   return success;
 }
 
@@ -173,16 +172,17 @@ static int test_pp(unsigned char *b)
 static int decrunch_pp(FILE *f, FILE *fo)
 {
     uint8 *packed /*, *unpacked */;
-    int plen, unplen;
-    struct stat st;
+    long plen;
+    int unplen;
 
     if (fo == NULL)
         goto err;
 
-    if (fstat(fileno(f), &st) < 0)
+    /* The input may be a memory stream with no file descriptor */
+    if (fseek(f, 0, SEEK_END) < 0 || (plen = ftell(f)) < 0)
+	goto err;
+    if (fseek(f, 0, SEEK_SET) < 0)
 	goto err;
-
-    plen = st.st_size;
     //counter = 0;
 
     /* Amiga longwords are only on even addresses.
@@ -197,7 +197,7 @@ static int decrunch_pp(FILE *f, FILE *fo)
          goto err;
     }
 
-    packed = malloc(plen);
+    packed = libxmp_malloc(plen);
     if (packed == NULL) {
 	 /*fprintf(stderr, "can't allocate memory for packed data\n");*/
 	 goto err;
@@ -239,12 +239,12 @@ static int decrunch_pp(FILE *f, FILE *fo)
          goto err1;
     }
      
-    free (packed);
+    libxmp_free (packed);
 
     return 0;
 
 err1:
-    free(packed);
+    libxmp_free(packed);
 err:
     return -1;
 }
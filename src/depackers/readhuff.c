@@ -76,7 +76,7 @@ unsigned char *convert_huff(unsigned char *data_in,
 	struct rledata rd;
 	struct data_in_out io;
 
-	if ((data_out = malloc(orig_len)) == NULL) {
+	if ((data_out = libxmp_malloc(orig_len)) == NULL) {
 	/*  fprintf(stderr,"nomarch: out of memory!\n");*/
 	    return NULL;
 	}
@@ -89,13 +89,13 @@ unsigned char *convert_huff(unsigned char *data_in,
 	READ_WORD(nodes,&io);
 
 	if (!nodes) {
-	    free(data_out);
+	    libxmp_free(data_out);
 	    return NULL;
 	}
 
-	if ((nodearr = malloc(sizeof(struct huff_node_tag)*nodes)) == NULL) {
+	if ((nodearr = libxmp_malloc(sizeof(struct huff_node_tag)*nodes)) == NULL) {
 	/*  fprintf(stderr,"nomarch: out of memory!\n");*/
-	    free(data_out);
+	    libxmp_free(data_out);
 	    return NULL;
 	}
 
@@ -122,8 +122,8 @@ unsigned char *convert_huff(unsigned char *data_in,
 	    while ((f & 0x8000) == 0) {
 		if (f >= nodes) {
 		    /* must be corrupt */
-		    free(nodearr);
-		    free(data_out);
+		    libxmp_free(nodearr);
+		    libxmp_free(data_out);
 		    return NULL;
 		}
 
@@ -146,7 +146,7 @@ unsigned char *convert_huff(unsigned char *data_in,
 	}
 	while (f != HUFF_EOF);
 
-	free(nodearr);
+	libxmp_free(nodearr);
 
 	return data_out;
 }
@@ -84,7 +84,7 @@ static unsigned char *convert_lzw_dynamic(unsigned char *data_in,
 	    return NULL;
 	}
 
-	if ((data_out = calloc(1, orig_len)) == NULL) {
+	if ((data_out = libxmp_calloc(1, orig_len)) == NULL) {
 	/*  fprintf(stderr,"nomarch: out of memory!\n");*/
 	    return NULL;
 	}
@@ -116,7 +116,7 @@ static unsigned char *convert_lzw_dynamic(unsigned char *data_in,
 
 	/* XXX */
 	if (data->maxstr > (1 << max_bits)) {
-	    free(data_out);
+	    libxmp_free(data_out);
 	    return NULL;
 	}
 
@@ -204,7 +204,7 @@ static unsigned char *convert_lzw_dynamic(unsigned char *data_in,
 	if (~data->quirk & NOMARCH_QUIRK_NOCHK) {
 	    /* junk it on error */
 	    if (data->io.data_in_point != data->io.data_in_max) {
-		free(data_out);
+		libxmp_free(data_out);
 		return NULL;
 	    }
 	}
@@ -220,7 +220,7 @@ unsigned char *libxmp_convert_lzw_dynamic(unsigned char *data_in,
 	struct local_data *data;
 	unsigned char *d;
 
-	if ((data = malloc(sizeof (struct local_data))) == NULL) {
+	if ((data = libxmp_malloc(sizeof (struct local_data))) == NULL) {
 		goto err;
 	}
 
@@ -232,19 +232,19 @@ unsigned char *libxmp_convert_lzw_dynamic(unsigned char *data_in,
 		goto err2;
 	}
 	if (d + orig_len != data->io.data_out_point) {
-		free(d);
+		libxmp_free(d);
 		goto err2;
 	}
 
-	free(data);
+	libxmp_free(data);
 
 	return d;
 
-err2:	free(data);
+err2:	libxmp_free(data);
 err:	return NULL;
 }
 
-unsigned char *libxmp_read_lzw_dynamic(FILE *f, uint8 *buf, int max_bits,int use_rle,
+unsigned char *libxmp_read_lzw_dynamic(HIO_HANDLE *f, uint8 *buf, int max_bits,int use_rle,
 			unsigned long in_len, unsigned long orig_len, int q)
 {
 	uint8 *buf2, *b;
@@ -253,17 +253,17 @@ unsigned char *libxmp_read_lzw_dynamic(FILE *f, uint8 *buf, int max_bits,int use
 	struct local_data *data;
 	size_t read_len;
 
-	if ((data = malloc(sizeof (struct local_data))) == NULL) {
+	if ((data = libxmp_malloc(sizeof (struct local_data))) == NULL) {
 		goto err;
 	}
 
-	if ((buf2 = malloc(in_len)) == NULL) {
+	if ((buf2 = libxmp_malloc(in_len)) == NULL) {
 		//perror("read_lzw_dynamic");
 		goto err2;
 	}
 
-	pos = ftell(f);
-	if ((read_len = fread(buf2, 1, in_len, f)) != in_len) {
+	pos = hio_tell(f);
+	if ((read_len = hio_read(buf2, 1, in_len, f)) != in_len) {
 		if (~q & XMP_LZW_QUIRK_DSYM) {
 			goto err3;
 		}
@@ -273,18 +273,18 @@ unsigned char *libxmp_read_lzw_dynamic(FILE *f, uint8 *buf, int max_bits,int use
 	memcpy(buf, b, orig_len);
 	size = q & NOMARCH_QUIRK_ALIGN4 ? ALIGN4(data->nomarch_input_size) :
 						data->nomarch_input_size;
-	if (fseek(f, pos + size, SEEK_SET) < 0) {
+	if (hio_seek(f, pos + size, SEEK_SET) < 0) {
 		goto err4;
 	}
-	free(b);
-	free(buf2);
-	free(data);
+	libxmp_free(b);
+	libxmp_free(buf2);
+	libxmp_free(data);
 
 	return buf;
 
-err4:	free(b);
-err3:	free(buf2);
-err2:	free(data);
+err4:	libxmp_free(b);
+err3:	libxmp_free(buf2);
+err2:	libxmp_free(data);
 err:	return NULL;
 }
 
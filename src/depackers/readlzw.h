@@ -9,6 +9,8 @@
 #ifndef LIBXMP_READLZW_H
 #define LIBXMP_READLZW_H
 
+#include "hio.h"
+
 #define ALIGN4(x) (((x) + 3) & ~3L)
 
 /* Digital Symphony LZW quirk */
@@ -31,7 +33,7 @@ uint8	*libxmp_convert_lzw_dynamic(unsigned char *data_in,
 				    unsigned long orig_len,
 				    int q);
 
-uint8	*libxmp_read_lzw_dynamic(FILE *f, uint8 *buf, int max_bits,int use_rle,
+uint8	*libxmp_read_lzw_dynamic(HIO_HANDLE *f, uint8 *buf, int max_bits,int use_rle,
 				 unsigned long in_len, unsigned long orig_len, int q);
 
 #endif
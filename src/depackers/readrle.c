@@ -61,7 +61,7 @@ unsigned char *data_out;
 struct rledata rd;
 struct data_in_out io;
 
-if((data_out=malloc(orig_len))==NULL)
+if((data_out=libxmp_malloc(orig_len))==NULL)
   fprintf(stderr,"nomarch: out of memory!\n"),exit(1);
 
 io.data_in_point=data_in; io.data_in_max=data_in+in_len;
@@ -13,7 +13,6 @@
 */
 
 /* #include <assert.h> */
-#include <sys/stat.h>
 #include "common.h"
 #include "depacker.h"
 
@@ -372,17 +371,20 @@ static int decrunch_s404(FILE *in, /* size_t s, */ FILE *out)
 {
   int32 oLen, sLen, pLen;
   uint8 *dst = NULL;
-  struct stat st;
+  long size;
   uint8 *buf, *src;
 
-  if (fstat(fileno(in), &st))
+  /* The input may be a memory stream with no file descriptor */
+  if (fseek(in, 0, SEEK_END) < 0 || (size = ftell(in)) < 0)
     return -1;
-  if (st.st_size <= 16)
+  if (fseek(in, 0, SEEK_SET) < 0)
     return -1;
-  src = buf = malloc(st.st_size);
+  if (size <= 16)
+    return -1;
+  src = buf = libxmp_malloc(size);
   if (src == NULL)
     return -1;
-  if (fread(buf, 1, st.st_size, in) != st.st_size) {
+  if (fread(buf, 1, size, in) != size) {
     goto error;
   }
 
@@ -392,11 +394,11 @@ static int decrunch_s404(FILE *in, /* size_t s, */ FILE *out)
   }
 
   /* Sanity check */
-  if (pLen > st.st_size - 18) {
+  if (pLen > size - 18) {
     goto error;
   }
 
-  if ((dst = malloc(oLen)) == NULL) {
+  if ((dst = libxmp_malloc(oLen)) == NULL) {
     /*fprintf(stderr,"S404 Error: malloc(%d) failed..\n", oLen);*/
     goto error;
   }
@@ -411,14 +413,14 @@ static int decrunch_s404(FILE *in, /* size_t s, */ FILE *out)
       goto error1;
   }
 
-  free(dst);
-  free(src);
+  libxmp_free(dst);
+  libxmp_free(src);
   return 0;
 
  error1:
-  free(dst);
+  libxmp_free(dst);
  error:
-  free(src);
+  libxmp_free(src);
   return -1;
 }
 
@@ -160,11 +160,11 @@ static unsigned char *read_file_data(FILE * in,
 	unsigned char *data;
 	int siz = hdrp->compressed_size;
 
-	if ((data = malloc(siz)) == NULL)
+	if ((data = libxmp_malloc(siz)) == NULL)
 		return NULL;
 
 	if (fread(data, 1, siz, in) != siz) {
-		free(data);
+		libxmp_free(data);
 		data = NULL;
 	}
 
@@ -186,28 +186,14 @@ static int skip_file_data(FILE *in,struct archived_file_header_tag *hdrp)
 }
 #endif
 
-static int arc_extract(FILE *in, FILE *out)
+/* extract a single file, assuming its header has just been read */
+static int arc_extract_file(FILE *in, FILE *out,
+			    struct archived_file_header_tag *hdrp)
 {
-	struct archived_file_header_tag hdr;
-	/* int done = 0; */
+	struct archived_file_header_tag hdr = *hdrp;
 	unsigned char *data, *orig_data;
 	int exitval = 0;
 
-	if (!skip_sfx_header(in) || !read_file_header(in, &hdr))
-		return -1;
-
-#if 0
-	/* We don't files named 'From?' */
-	while (!strcmp(hdr.name, "From?") || *hdr.name == '!') {
-		if (!skip_file_data(in,&hdr))
-			return -1;
-		if (!read_file_header(in, &hdr))
-			return -1;
-	}
-#endif
-
-	/* extract a single file */
-	/* do { */
 	if (hdr.method == 0) {	/* EOF */
 		/* done = 1;
 		continue; */
@@ -281,7 +267,7 @@ static int arc_extract(FILE *in, FILE *out)
 		break;
 
 	default:
-		free(data);
+		libxmp_free(data);
 		return -1;
 	}
 
@@ -290,7 +276,7 @@ static int arc_extract(FILE *in, FILE *out)
 	 */
 
 	if (orig_data == NULL) {
-		free(data);
+		libxmp_free(data);
 		return -1;
 	}
 
@@ -298,13 +284,33 @@ static int arc_extract(FILE *in, FILE *out)
 		exitval = -1;
 
 	if (orig_data != data)	/* don't free uncompressed stuff twice :-) */
-		free(orig_data);
+		libxmp_free(orig_data);
 
-	free(data);
+	libxmp_free(data);
 
 	return exitval;
 }
 
+static int arc_extract(FILE *in, FILE *out)
+{
+	struct archived_file_header_tag hdr;
+
+	if (!skip_sfx_header(in) || !read_file_header(in, &hdr))
+		return -1;
+
+#if 0
+	/* We don't files named 'From?' */
+	while (!strcmp(hdr.name, "From?") || *hdr.name == '!') {
+		if (!skip_file_data(in,&hdr))
+			return -1;
+		if (!read_file_header(in, &hdr))
+			return -1;
+	}
+#endif
+
+	return arc_extract_file(in, out, &hdr);
+}
+
 static int test_arc(unsigned char *b)
 {
 	if (b[0] == 0x1a) {
@@ -343,12 +349,55 @@ static int test_arc(unsigned char *b)
 	return 0;
 }
 
+static int list_arc(FILE *in, struct xmp_archive_entry *entries, int max)
+{
+	struct archived_file_header_tag hdr;
+	long offset;
+	int num = 0;
+
+	if (!skip_sfx_header(in))
+		return -1;
+
+	while (1) {
+		if ((offset = ftell(in)) < 0)
+			return -1;
+		if (!read_file_header(in, &hdr) || hdr.method == 0)
+			break;
+
+		if (num < max) {
+			strncpy(entries[num].name, hdr.name,
+				XMP_ARCHIVE_NAME_SIZE - 1);
+			entries[num].name[XMP_ARCHIVE_NAME_SIZE - 1] = 0;
+			entries[num].size = hdr.orig_size;
+			entries[num].offset = offset;
+		}
+		num++;
+
+		if (fseek(in, hdr.compressed_size, SEEK_CUR) < 0)
+			return -1;
+	}
+
+	return num;
+}
+
 static int decrunch_arc(FILE *f, FILE *fo)
 {
 	return arc_extract(f, fo);
 }
 
+static int decrunch_arc_member(FILE *f, FILE *fo, long offset)
+{
+	struct archived_file_header_tag hdr;
+
+	if (fseek(f, offset, SEEK_SET) < 0 || !read_file_header(f, &hdr))
+		return -1;
+
+	return arc_extract_file(f, fo, &hdr);
+}
+
 struct depacker libxmp_depacker_arc = {
 	test_arc,
-	decrunch_arc
+	decrunch_arc,
+	list_arc,
+	decrunch_arc_member
 };
@@ -40,6 +40,7 @@
 #define LARC4_METHOD            0x2D6C7A34      /* -lz4- */
 #define PMARC0_METHOD           0x2D706D30      /* -pm0- */
 #define PMARC2_METHOD           0x2D706D32      /* -pm2- */
+#define LZHDIRS_METHOD          0x2D6C6864      /* -lhd- */
 
 #undef UCHAR_MAX
 #define UCHAR_MAX       ((1<<(sizeof(uint8)*8))-1)
@@ -1403,7 +1404,7 @@ static int32 LhA_Decrunch(FILE *in, FILE *out, int size, uint32 Method)
   struct LhADecrData *dd;
   int32 err = 0;
 
-  if((dd = calloc(sizeof(struct LhADecrData), 1))) {
+  if((dd = libxmp_calloc(sizeof(struct LhADecrData), 1))) {
     int (*DecodeStart)(struct LhADecrData *);
     int (*DecodeC)(struct LhADecrData *);
     uint16 (*DecodeP)(struct LhADecrData *);
@@ -1495,7 +1496,7 @@ static int32 LhA_Decrunch(FILE *in, FILE *out, int size, uint32 Method)
       offset = 0x100 - 3;
 #endif
 
-      if((text = dd->text = calloc(dicsiz, 1)))
+      if((text = dd->text = libxmp_calloc(dicsiz, 1)))
       {
 /*      if(Method == LZHUFF1_METHOD || Method == LZHUFF2_METHOD || Method == LZHUFF3_METHOD ||
         Method == LZHUFF6_METHOD || Method == LARC_METHOD || Method == LARC5_METHOD)
@@ -1550,20 +1551,20 @@ static int32 LhA_Decrunch(FILE *in, FILE *out, int size, uint32 Method)
           }
         }
         err = dd->error;
-        free(text);
+        libxmp_free(text);
       }
       else
         err = -1;
     }
-    free(dd);
+    libxmp_free(dd);
   }
   else
     err = -1;
   return err;
 
 error:
-  free(dd->text);
-  free(dd);
+  libxmp_free(dd->text);
+  libxmp_free(dd);
   return -1;
 }
 
@@ -1854,7 +1855,56 @@ static int decrunch_lha(FILE *in, FILE *out)
 	return -1;
 }
 
+static int list_lha(FILE *in, struct xmp_archive_entry *entries, int max)
+{
+	struct lha_data data;
+	long offset;
+	int num = 0;
+
+	while (1) {
+		offset = ftell(in);
+		if (offset < 0) {
+			return -1;
+		}
+		if (get_header(in, &data) < 0)
+			break;
+
+		if (data.method != LZHDIRS_METHOD) {
+			if (num < max) {
+				strncpy(entries[num].name, data.name,
+					XMP_ARCHIVE_NAME_SIZE - 1);
+				entries[num].name[XMP_ARCHIVE_NAME_SIZE - 1] = 0;
+				entries[num].size = data.original_size;
+				entries[num].offset = offset;
+			}
+			num++;
+		}
+
+		if (fseek(in, data.packed_size, SEEK_CUR) < 0) {
+			return -1;
+		}
+	}
+
+	return num;
+}
+
+static int decrunch_lha_member(FILE *in, FILE *out, long offset)
+{
+	struct lha_data data;
+
+	if (fseek(in, offset, SEEK_SET) < 0) {
+		return -1;
+	}
+	if (get_header(in, &data) < 0) {
+		return -1;
+	}
+
+	return LhA_Decrunch(in, out, data.original_size, data.method);
+}
+
 struct depacker libxmp_depacker_lha = {
 	test_lha,
-	decrunch_lha
+	decrunch_lha,
+	list_lha,
+	decrunch_lha_member
 };
@@ -119,6 +119,7 @@ struct LZXDecrData {
     FILE *outfile;
 
     struct filename_node *filename_list;
+    struct filename_node *target;	/* only extract this file if set */
 
     uint8 *src;
     uint8 *dest;
@@ -832,7 +833,8 @@ static int extract_normal(FILE * in_file, struct LZXDecrData *decr)
 	/*printf("Extracting \"%s\"...", node->filename);
 	   fflush(stdout); */
 
-	if (libxmp_exclude_match(node->filename)) {
+	if (decr->target ? node != decr->target :
+	    libxmp_exclude_match(node->filename)) {
 	    out_file = NULL;
 	} else {
 	    out_file = decr->outfile;
@@ -941,156 +943,255 @@ static int extract_normal(FILE * in_file, struct LZXDecrData *decr)
 
 /* ---------------------------------------------------------------------- */
 
-static int extract_archive(FILE * in_file, struct LZXDecrData *decr)
+/* Read the header of an archive entry. Returns 1 if an entry was read,
+ * 0 at the end of the archive or -1 on error.
+ */
+static int read_entry_header(FILE * in_file, struct LZXDecrData *decr)
 {
     uint32 temp;
-    struct filename_node **filename_next;
-    struct filename_node *node;
-    struct filename_node *temp_node;
     int actual;
-    int abort;
-    int result = 1;		/* assume an error */
 
-    decr->filename_list = 0;	/* clear the list */
-    filename_next = &decr->filename_list;
+    actual = fread(decr->archive_header, 1, 31, in_file);
+    if (ferror(in_file)) {
+	/* perror("FRead(Archive_Header)"); */
+	return -1;
+    }
 
-    do {
-	abort = 1;		/* assume an error */
-	actual = fread(decr->archive_header, 1, 31, in_file);
-	if (ferror(in_file)) {
-	    /* perror("FRead(Archive_Header)"); */
-	    continue;
-	}
+    if (actual == 0) {	/* 0 is normal and means EOF */
+	return 0;
+    }
 
-	if (actual == 0) {	/* 0 is normal and means EOF */
-	    result = 0;		/* normal termination */
-	    continue;
-	}
+    if (actual != 31) {
+	/* fprintf(stderr, "EOF: Archive_Header\n"); */
+	return -1;
+    }
 
-	if (actual != 31) {
-	    /* fprintf(stderr, "EOF: Archive_Header\n"); */
-	    continue;
-	}
+    decr->sum = 0;		/* reset CRC */
+    decr->crc = readmem32l(decr->archive_header + 26);
 
-	decr->sum = 0;		/* reset CRC */
-	decr->crc = readmem32l(decr->archive_header + 26);
+    /* Must set the field to 0 before calculating the crc */
+    memset(decr->archive_header + 26, 0, 4);
+    decr->sum = libxmp_crc32_A1(decr->archive_header, 31, decr->sum);
+    temp = decr->archive_header[30];	/* filename length */
+    actual = fread(decr->header_filename, 1, temp, in_file);
 
-	/* Must set the field to 0 before calculating the crc */
-	memset(decr->archive_header + 26, 0, 4);
-	decr->sum = libxmp_crc32_A1(decr->archive_header, 31, decr->sum);
-	temp = decr->archive_header[30];	/* filename length */
-	actual = fread(decr->header_filename, 1, temp, in_file);
+    if (ferror(in_file)) {
+	/* perror("FRead(Header_Filename)"); */
+	return -1;
+    }
 
-	if (ferror(in_file)) {
-	    /* perror("FRead(Header_Filename)"); */
-	    continue;
-	}
+    if (actual != temp) {
+	/* fprintf(stderr, "EOF: Header_Filename\n"); */
+	return -1;
+    }
 
-	if (actual != temp) {
-	    /* fprintf(stderr, "EOF: Header_Filename\n"); */
-	    continue;
-	}
+    decr->header_filename[temp] = 0;
+    decr->sum = libxmp_crc32_A1(decr->header_filename, temp, decr->sum);
+    temp = decr->archive_header[14];	/* comment length */
+    actual = fread(decr->header_comment, 1, temp, in_file);
 
-	decr->header_filename[temp] = 0;
-	decr->sum = libxmp_crc32_A1(decr->header_filename, temp, decr->sum);
-	temp = decr->archive_header[14];	/* comment length */
-	actual = fread(decr->header_comment, 1, temp, in_file);
+    if (ferror(in_file)) {
+	/* perror("FRead(Header_Comment)"); */
+	return -1;
+    }
 
-	if (ferror(in_file)) {
-	    /* perror("FRead(Header_Comment)"); */
-	    continue;
-	}
+    if (actual != temp) {
+	/* fprintf(stderr, "EOF: Header_Comment\n"); */
+	return -1;
+    }
 
-	if (actual != temp) {
-	    /* fprintf(stderr, "EOF: Header_Comment\n"); */
-	    continue;
-	}
+    decr->header_comment[temp] = 0;
+    decr->sum = libxmp_crc32_A1(decr->header_comment, temp, decr->sum);
 
-	decr->header_comment[temp] = 0;
-	decr->sum = libxmp_crc32_A1(decr->header_comment, temp, decr->sum);
+    if (decr->sum != decr->crc) {
+	/* fprintf(stderr, "CRC: Archive_Header\n"); */
+	return -1;
+    }
 
-	if (decr->sum != decr->crc) {
-	    /* fprintf(stderr, "CRC: Archive_Header\n"); */
-	    continue;
-	}
+    decr->unpack_size = readmem32l(decr->archive_header + 2);
+    decr->pack_size = readmem32l(decr->archive_header + 6);
+    decr->pack_mode = decr->archive_header[11];
+    decr->crc = readmem32l(decr->archive_header + 22);
 
-	decr->unpack_size = readmem32l(decr->archive_header + 2);
-	decr->pack_size = readmem32l(decr->archive_header + 6);
-	decr->pack_mode = decr->archive_header[11];
-	decr->crc = readmem32l(decr->archive_header + 22);
+    return 1;
+}
 
-	/* allocate a filename node */
-	node = malloc(sizeof(struct filename_node));
-	if (node == NULL) {
-	    /* fprintf(stderr, "MAlloc(Filename_node)\n"); */
-	    continue;
-	}
+/* Allocate a filename node for the entry just read */
+static struct filename_node *new_filename_node(struct LZXDecrData *decr)
+{
+    struct filename_node *node;
+    uint32 temp;
 
-	*filename_next = node;	/* add this node to the list */
-	filename_next = &(node->next);
-	node->next = 0;
-	node->length = decr->unpack_size;
-	node->crc = decr->crc;
-	for (temp = 0; ; temp++) {
-	    if (!(node->filename[temp] = decr->header_filename[temp]))
-		break;
-	}
+    node = libxmp_malloc(sizeof(struct filename_node));
+    if (node == NULL) {
+	/* fprintf(stderr, "MAlloc(Filename_node)\n"); */
+	return NULL;
+    }
+
+    node->next = 0;
+    node->length = decr->unpack_size;
+    node->crc = decr->crc;
+    for (temp = 0; ; temp++) {
+	if (!(node->filename[temp] = decr->header_filename[temp]))
+	    break;
+    }
+
+    return node;
+}
+
+static void free_filename_list(struct LZXDecrData *decr)
+{
+    struct filename_node *node;
+    struct filename_node *temp_node;
+
+    temp_node = decr->filename_list;
+    while ((node = temp_node) != NULL) {
+	temp_node = node->next;
+	libxmp_free(node);
+    }
+    decr->filename_list = 0;	/* clear the list */
+}
+
+static int extract_archive(FILE * in_file, struct LZXDecrData *decr)
+{
+    struct filename_node *node;
+    int result = 1;		/* assume an error */
+
+    decr->filename_list = 0;	/* clear the list */
 
+    switch (read_entry_header(in_file, decr)) {
+    case 0:
+	return 0;		/* normal termination */
+    case 1:
+	break;
+    default:
+	return result;
+    }
+
+    /* allocate a filename node */
+    node = new_filename_node(decr);
+    if (node == NULL) {
+	return result;
+    }
+    decr->filename_list = node;
+
+    switch (decr->pack_mode) {
 #if 0
-	if (decr->pack_size == 0) {
-	    abort = 0;		/* continue */
-	    continue;
-	}
+    case 0:			/* store */
+	/*abort =*/ extract_store(in_file, decr);
+	break;
 #endif
+    case 2:			/* normal */
+	/*abort =*/ extract_normal(in_file, decr);
+	break;
+    default:		/* unknown */
+	break;
+    }
 
-	switch (decr->pack_mode) {
-#if 0
-	case 0:			/* store */
-	    /*abort =*/ extract_store(in_file, decr);
-	    abort = 1;		/* for xmp */
+    free_filename_list(decr);
+
+    return result;
+}
+
+/* Extract the file whose entry header is at the given offset. Files
+ * can be merged into a single packed stream, so the files before it in
+ * the same stream are unpacked and discarded.
+ */
+static int extract_member(FILE * in_file, struct LZXDecrData *decr,
+			  long offset)
+{
+    struct filename_node **filename_next;
+    struct filename_node *node;
+    long pos;
+    int result = 1;		/* assume an error */
+
+    decr->filename_list = 0;	/* clear the list */
+    filename_next = &decr->filename_list;
+
+    while (1) {
+	if ((pos = ftell(in_file)) < 0)
 	    break;
-#endif
-	case 2:			/* normal */
-	    /*abort =*/ extract_normal(in_file, decr);
-	    abort = 1;		/* for xmp */
+	if (read_entry_header(in_file, decr) <= 0)
 	    break;
-	default:		/* unknown */
+
+	node = new_filename_node(decr);
+	if (node == NULL)
 	    break;
-	}
+	*filename_next = node;	/* add this node to the list */
+	filename_next = &(node->next);
 
-#if 0
-	if (abort)
-	    break;		/* a read error occured */
-
-	/* CID 129002 (#1 of 1): Logically dead code (DEADCODE)
-	 * dead_error_begin: Execution cannot reach this statement: 
-	 */
-	temp_node = decr->filename_list;	/* free the list now */
-	while ((node = temp_node)) {
-	    temp_node = node->next;
-	    free(node);
+	if (pos == offset)
+	    decr->target = node;
+
+	if (decr->pack_size == 0)	/* merged with the next files */
+	    continue;
+
+	if (decr->target != NULL) {
+	    if (decr->pack_mode == 2) {
+		extract_normal(in_file, decr);
+		result = 0;
+	    }
+	    break;
 	}
-	decr->filename_list = 0;	/* clear the list */
+
+	free_filename_list(decr);
 	filename_next = &decr->filename_list;
 
 	if (fseek(in_file, decr->pack_size, SEEK_CUR)) {
 	    /* perror("FSeek(Data)"); */
 	    break;
 	}
-#endif
-
-    } while (!abort);
-
-    /* free the filename list in case an error occured */
-    temp_node = decr->filename_list;
-    while ((node = temp_node) != NULL) {
-	temp_node = node->next;
-	free(node);
     }
 
+    free_filename_list(decr);
+
     return result;
 }
 
+static int list_lzx(FILE *f, struct xmp_archive_entry *entries, int max)
+{
+	struct LZXDecrData *decr;
+	long offset;
+	int ret, num = 0;
+
+	decr = libxmp_calloc(1, sizeof(struct LZXDecrData));
+	if (decr == NULL)
+		return -1;
+
+	if (fseek(f, 10, SEEK_CUR) < 0)		/* skip header */
+		goto err;
+
+	libxmp_crc32_init_A();
+
+	while (1) {
+		if ((offset = ftell(f)) < 0)
+			goto err;
+		if ((ret = read_entry_header(f, decr)) < 0)
+			goto err;
+		if (ret == 0)
+			break;
+
+		if (num < max) {
+			snprintf(entries[num].name, XMP_ARCHIVE_NAME_SIZE,
+				 "%s", (char *)decr->header_filename);
+			entries[num].size = decr->unpack_size;
+			entries[num].offset = offset;
+		}
+		num++;
+
+		if (fseek(f, decr->pack_size, SEEK_CUR) < 0)
+			goto err;
+	}
+
+	libxmp_free(decr);
+
+	return num;
+
+    err:
+	libxmp_free(decr);
+	return -1;
+}
+
 static int test_lzx(unsigned char *b)
 {
 	return memcmp(b, "LZX", 3) == 0;
@@ -1103,7 +1204,7 @@ static int decrunch_lzx(FILE *f, FILE *fo)
 	if (fo == NULL)
 		goto err;
 
-	decr = calloc(1, sizeof(struct LZXDecrData));
+	decr = libxmp_calloc(1, sizeof(struct LZXDecrData));
 	if (decr == NULL)
 		goto err;
 
@@ -1114,17 +1215,45 @@ static int decrunch_lzx(FILE *f, FILE *fo)
 	decr->outfile = fo;
 	extract_archive(f, decr);
 
-	free(decr);
+	libxmp_free(decr);
 
 	return 0;
 
     err2:
-	free(decr);
+	libxmp_free(decr);
     err:
 	return -1;
 }
 
+static int decrunch_lzx_member(FILE *f, FILE *fo, long offset)
+{
+	struct LZXDecrData *decr;
+	int ret;
+
+	if (fo == NULL)
+		return -1;
+
+	decr = libxmp_calloc(1, sizeof(struct LZXDecrData));
+	if (decr == NULL)
+		return -1;
+
+	if (fseek(f, 10, SEEK_CUR) < 0) {	/* skip header */
+		libxmp_free(decr);
+		return -1;
+	}
+
+	libxmp_crc32_init_A();
+	decr->outfile = fo;
+	ret = extract_member(f, decr, offset);
+
+	libxmp_free(decr);
+
+	return ret ? -1 : 0;
+}
+
 struct depacker libxmp_depacker_lzx = {
 	test_lzx,
-	decrunch_lzx
+	decrunch_lzx,
+	list_lzx,
+	decrunch_lzx_member
 };
@@ -400,10 +400,10 @@ static int decrunch_sqsh(FILE * f, FILE * fo)
 	if (destlen < 0 || destlen > 0x100000)
 		goto err;
 
-	if ((src = malloc(srclen + 3)) == NULL)
+	if ((src = libxmp_malloc(srclen + 3)) == NULL)
 		goto err;
 
-	if ((dest = malloc(destlen + 100)) == NULL)
+	if ((dest = libxmp_malloc(destlen + 100)) == NULL)
 		goto err2;
 
 	if (fread(src, srclen - 8, 1, f) != 1)
@@ -415,15 +415,15 @@ static int decrunch_sqsh(FILE * f, FILE * fo)
 	if (fwrite(dest, destlen, 1, fo) != 1)
 		goto err3;
 
-	free(dest);
-	free(src);
+	libxmp_free(dest);
+	libxmp_free(src);
 
 	return 0;
 
     err3:
-	free(dest);
+	libxmp_free(dest);
     err2:
-	free(src);
+	libxmp_free(src);
     err:
 	return -1;
 }
@@ -27,7 +27,7 @@ static int decrunch_xz(FILE *in, FILE *out)
 	libxmp_crc32_init_A();
 
 	memset(&b, 0, sizeof(b));
-	if ((membuf = malloc(2 * BUFFER_SIZE)) == NULL)
+	if ((membuf = libxmp_malloc(2 * BUFFER_SIZE)) == NULL)
 		return -1;
 
 	b.in = membuf;
@@ -68,7 +68,7 @@ static int decrunch_xz(FILE *in, FILE *out)
 	}
 
 	xz_dec_end(state);
-	free(membuf);
+	libxmp_free(membuf);
 
 	return ret;
 }
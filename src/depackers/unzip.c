@@ -94,7 +94,7 @@ int t;
 #define BUFFER_SIZE 16738
 
 
-static int copy_file(FILE *in, FILE *out, int len, uint32 *_checksum, struct inflate_data *data)
+static int copy_file(FILE *in, FILE *out, int len, uint32 *_checksum)
 {
 unsigned char buffer[BUFFER_SIZE];
 unsigned int checksum;
@@ -153,17 +153,16 @@ struct zip_file_header header;
 int ret_code;
 uint32 checksum=0;
 long marker;
-struct inflate_data data;
 
   ret_code=0;
 
   if (read_zip_header(in,&header)==-1) return -1;
 
-  header.file_name=(char *)malloc(header.file_name_length+1);
+  header.file_name=(char *)libxmp_malloc(header.file_name_length+1);
   if (header.file_name == NULL)
     goto err;
 
-  header.extra_field=(unsigned char *)malloc(header.extra_field_length+1);
+  header.extra_field=(unsigned char *)libxmp_malloc(header.extra_field_length+1);
   if (header.extra_field == NULL)
     goto err2;
 
@@ -181,7 +180,7 @@ struct inflate_data data;
   {
     if (header.compression_method==0)
     {
-      if (copy_file(in,out,header.uncompressed_size,&checksum,&data) < 0)
+      if (copy_file(in,out,header.uncompressed_size,&checksum) < 0)
         goto err3;
     }
     else
@@ -199,8 +198,8 @@ struct inflate_data data;
     }
   }
 
-  free(header.file_name);
-  free(header.extra_field);
+  libxmp_free(header.file_name);
+  libxmp_free(header.extra_field);
 
   if (fseek(in,marker+header.compressed_size,SEEK_SET) < 0) {
     goto err;
@@ -216,9 +215,9 @@ struct inflate_data data;
   return ret_code;
 
  err3:
-  free(header.extra_field);
+  libxmp_free(header.extra_field);
  err2:
-  free(header.file_name);
+  libxmp_free(header.file_name);
  err:
   return -1;
 }
@@ -280,6 +279,56 @@ char name[1024];
   { return -1; }
 }
 
+/* For xmp:
+ * list the archive members from their local headers, skipping directories
+ */
+static int kunzip_list(FILE *in, struct xmp_archive_entry *entries, int max)
+{
+struct zip_file_header header;
+int num=0;
+int name_size;
+long curr;
+char name[1024];
+
+  while(1)
+  {
+    curr=ftell(in);
+    if (curr < 0) {
+      return -1;
+    }
+    if (read_zip_header(in,&header)==-1) break;
+
+    name_size = header.file_name_length;
+    if (name_size > 1023) {
+      name_size = 1023;
+    }
+
+    if (read_chars(in,name,name_size) < 0) {
+      return -1;
+    }
+
+    if (name_size > 0 && name[name_size-1] != '/')
+    {
+      if (num < max)
+      {
+        strncpy(entries[num].name,name,XMP_ARCHIVE_NAME_SIZE-1);
+        entries[num].name[XMP_ARCHIVE_NAME_SIZE-1]=0;
+        entries[num].size=header.uncompressed_size;
+        entries[num].offset=curr;
+      }
+      num++;
+    }
+
+    if (fseek(in,header.compressed_size+
+             header.file_name_length-name_size+
+             header.extra_field_length,SEEK_CUR) < 0) {
+      return -1;
+    }
+  }
+
+  return num;
+}
+
 static int test_zip(unsigned char *b)
 {
 	return b[0] == 'P' && b[1] == 'K' &&
@@ -304,7 +353,20 @@ static int decrunch_zip(FILE *in, FILE *out)
   return 0;
 }
 
+static int decrunch_zip_member(FILE *in, FILE *out, long offset)
+{
+  if (fseek(in, offset, SEEK_SET) < 0)
+    return -1;
+
+  if (kunzip_file_with_name(in,out) < 0)
+    return -1;
+
+  return 0;
+}
+
 struct depacker libxmp_depacker_zip = {
 	test_zip,
-	decrunch_zip
+	decrunch_zip,
+	kunzip_list,
+	decrunch_zip_member
 };
@@ -219,7 +219,7 @@ static int lzd(BLOCKFILE input_f, BLOCKFILE output_f, uint32 *crc_table)
 {
    struct lzd_data *data;
 
-   data = (struct lzd_data *)calloc(1, sizeof (struct lzd_data));
+   data = (struct lzd_data *)libxmp_calloc(1, sizeof (struct lzd_data));
    if (data == NULL)
       goto err;
 
@@ -240,7 +240,7 @@ static int lzd(BLOCKFILE input_f, BLOCKFILE output_f, uint32 *crc_table)
                   [______________||________________|]
                     output buffer    input buffer
    */
-   data->out_buf_adr = malloc(MEM_BLOCK_SIZE);
+   data->out_buf_adr = libxmp_malloc(MEM_BLOCK_SIZE);
    if (data->out_buf_adr == NULL)
       goto err1;
 
@@ -249,11 +249,11 @@ static int lzd(BLOCKFILE input_f, BLOCKFILE output_f, uint32 *crc_table)
    if (BLOCKREAD (data->in_f, data->in_buf_adr, INBUFSIZ) == -1)
       goto err2;
 
-   data->table = (struct tabentry *)malloc((MAXMAX+10) * sizeof(struct tabentry));
+   data->table = (struct tabentry *)libxmp_malloc((MAXMAX+10) * sizeof(struct tabentry));
    if (data->table == NULL)
       goto err2;
 
-   data->stack = (unsigned *)malloc(sizeof (unsigned) * STACKSIZE + 20);
+   data->stack = (unsigned *)libxmp_malloc(sizeof (unsigned) * STACKSIZE + 20);
    if (data->stack == NULL)
       goto err3;
 
@@ -269,10 +269,10 @@ static int lzd(BLOCKFILE input_f, BLOCKFILE output_f, uint32 *crc_table)
             addbfcrc(data->out_buf_adr, output_offset, data);
          }
    
-         free(data->stack);
-         free(data->table);
-         free(data->out_buf_adr);
-         free(data);
+         libxmp_free(data->stack);
+         libxmp_free(data->table);
+         libxmp_free(data->out_buf_adr);
+         libxmp_free(data);
          return 0;
       }
    
@@ -314,11 +314,11 @@ static int lzd(BLOCKFILE input_f, BLOCKFILE output_f, uint32 *crc_table)
    }
 
  err3:
-   free(data->table);
+   libxmp_free(data->table);
  err2:
-   free(data->out_buf_adr);
+   libxmp_free(data->out_buf_adr);
  err1:
-   free(data);
+   libxmp_free(data);
  err:
    return -1;
 
@@ -1101,7 +1101,7 @@ int decrunch_zoo(FILE *in, FILE *out)
 	struct local_data *data;
 	int res;
 
-	data = (struct local_data *)calloc(1, sizeof (struct local_data));
+	data = (struct local_data *)libxmp_calloc(1, sizeof (struct local_data));
 	if (data == NULL)
 		goto err;
 
@@ -1148,11 +1148,11 @@ int decrunch_zoo(FILE *in, FILE *out)
 			goto err1;
 	}
 
-	free(data);
+	libxmp_free(data);
 	return 0;
 
     err1:
-	free(data);
+	libxmp_free(data);
     err:
 	return -1;
 }
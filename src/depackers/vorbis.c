@@ -569,7 +569,7 @@ static void *setup_malloc(vorb *f, int sz)
       return p;
    }
 #endif
-   return sz ? calloc(sz, 1) : NULL;
+   return sz ? libxmp_calloc(sz, 1) : NULL;
 }
 
 static void setup_free(vorb *f, void *p)
@@ -577,7 +577,7 @@ static void setup_free(vorb *f, void *p)
 #ifndef STB_VORBIS_NO_ALLOC_BUFFER
    if (f->alloc.alloc_buffer) return; // do nothing; setup mem is not a stack
 #endif
-   free(p);
+   libxmp_free(p);
 }
 
 static void *setup_temp_malloc(vorb *f, int sz)
@@ -590,7 +590,7 @@ static void *setup_temp_malloc(vorb *f, int sz)
       return (char *) f->alloc.alloc_buffer + f->temp_offset;
    }
 #endif
-   return calloc(sz, 1);
+   return libxmp_calloc(sz, 1);
 }
 
 static void setup_temp_free(vorb *f, void *p, size_t sz)
@@ -601,11 +601,12 @@ static void setup_temp_free(vorb *f, void *p, size_t sz)
       return;
    }
 #endif
-   free(p);
+   libxmp_free(p);
 }
 
 #define CRC32_POLY    0x04c11db7   // from spec
 
+#ifndef STB_VORBIS_NO_PUSHDATA_API
 static uint32 crc_table[256];
 static void libxmp_crc32_init_A(void)
 {
@@ -617,6 +618,7 @@ static void libxmp_crc32_init_A(void)
       crc_table[i] = s;
    }
 }
+#endif
 
 #if 0
 static __forceinline uint32 libxmp_crc32_update(uint32 crc, uint8 byte)
@@ -2098,7 +2100,7 @@ void inverse_mdct_slow(float *buffer, int n)
 {
    int i,j;
    int n2 = n >> 1;
-   float *x = (float *) malloc(sizeof(*x) * n2);
+   float *x = (float *) libxmp_malloc(sizeof(*x) * n2);
    memcpy(x, buffer, sizeof(*x) * n2);
    for (i=0; i < n; ++i) {
       float acc = 0;
@@ -2113,7 +2115,7 @@ void inverse_mdct_slow(float *buffer, int n)
          acc += x[j] * (float) cos(M_PI / 2 / n * (2 * i + 1 + n/2.0)*(2*j+1));
       buffer[i] = acc;
    }
-   free(x);
+   libxmp_free(x);
 }
 #elif 0
 // same as above, but just barely able to run in real time on modern machines
@@ -2122,7 +2124,7 @@ void inverse_mdct_slow(float *buffer, int n, vorb *f, int blocktype)
    float mcos[16384];
    int i,j;
    int n2 = n >> 1, nmask = (n << 2) -1;
-   float *x = (float *) malloc(sizeof(*x) * n2);
+   float *x = (float *) libxmp_malloc(sizeof(*x) * n2);
    memcpy(x, buffer, sizeof(*x) * n2);
    for (i=0; i < 4*n; ++i)
       mcos[i] = (float) cos(M_PI / 2 * i / n);
@@ -2133,7 +2135,7 @@ void inverse_mdct_slow(float *buffer, int n, vorb *f, int blocktype)
          acc += x[j] * mcos[(2 * i + 1 + n2)*(2*j+1) & nmask];
       buffer[i] = acc;
    }
-   free(x);
+   libxmp_free(x);
 }
 #else
 // transform to use a slow dct-iv; this is STILL basically trivial,
@@ -3463,7 +3465,9 @@ static int start_decoder(vorb *f)
    }
    #endif
 
+   #ifndef STB_VORBIS_NO_PUSHDATA_API
    libxmp_crc32_init_A(); // always init it, to avoid multithread race conditions
+   #endif
 
    if (get8_packet(f) != VORBIS_packet_setup)       return error(f, VORBIS_invalid_setup);
    for (i=0; i < 6; ++i) header[i] = get8_packet(f);
@@ -3666,7 +3670,7 @@ static int start_decoder(vorb *f)
 
                   /* Sanity check */
                   if (div == 0) {
-                    free(mults);
+                    libxmp_free(mults);
                     return error(f, VORBIS_invalid_setup);
                   }
                }
@@ -5204,7 +5208,7 @@ int stb_vorbis_decode_filename(char *filename, int *channels, short **output)
    *channels = v->channels;
    offset = data_len = 0;
    total = limit;
-   data = (short *) malloc(total * sizeof(*data));
+   data = (short *) libxmp_malloc(total * sizeof(*data));
    if (data == NULL) goto error;
    for (;;) {
       int n = stb_vorbis_get_frame_short_interleaved(v, v->channels, data+offset, total-offset);
@@ -5215,7 +5219,7 @@ int stb_vorbis_decode_filename(char *filename, int *channels, short **output)
       if (offset + limit > total) {
 	 short *data2;
 	 total *= 2;
-	 data2 = (short *) realloc(data, total * sizeof(*data));
+	 data2 = (short *) libxmp_realloc(data, total * sizeof(*data));
 	 if (data2 == NULL) goto error;
 	 data = data2;
       }
@@ -5224,7 +5228,7 @@ int stb_vorbis_decode_filename(char *filename, int *channels, short **output)
    return data_len;
 
 error:
-   free(data);
+   libxmp_free(data);
    stb_vorbis_close(v);
    return -2;
 }
@@ -5245,7 +5249,7 @@ int stb_vorbis_decode_memory(uint8 *mem, int len, int *channels, short **output)
    offset = data_len = 0;
    total = limit;
    D_(D_INFO "total=%d\n", total);
-   data = (short *) malloc(total * sizeof(*data));
+   data = (short *) libxmp_malloc(total * sizeof(*data));
    if (data == NULL) goto error;
    for (;;) {
       int n = stb_vorbis_get_frame_short_interleaved(v, v->channels, data+offset, total-offset);
@@ -5257,7 +5261,7 @@ int stb_vorbis_decode_memory(uint8 *mem, int len, int *channels, short **output)
       if (offset + limit > total) {
 	 short *data2;
 	 total *= 2;
-	 data2 = (short *) realloc(data, total * sizeof(*data));
+	 data2 = (short *) libxmp_realloc(data, total * sizeof(*data));
 	 if (data2 == NULL) goto error;
 	 data = data2;
       }
@@ -5267,7 +5271,7 @@ int stb_vorbis_decode_memory(uint8 *mem, int len, int *channels, short **output)
    return data_len;
 
 error:
-   free(data);
+   libxmp_free(data);
    stb_vorbis_close(v);
    return -2;
 }
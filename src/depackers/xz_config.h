@@ -20,13 +20,14 @@
 
 #define XZ_DEC_ANY_CHECK 1
 
+#include "common.h"
 #include "xz.h"
 
 #define GFP_KERNEL (0)
-#define kmalloc(size, flags) malloc(size)
-#define kfree(ptr) free(ptr)
-#define vmalloc(size) malloc(size)
-#define vfree(ptr) free(ptr)
+#define kmalloc(size, flags) libxmp_malloc(size)
+#define kfree(ptr) libxmp_free(ptr)
+#define vmalloc(size) libxmp_malloc(size)
+#define vfree(ptr) libxmp_free(ptr)
 
 #define memeq(a, b, size) (memcmp(a, b, size) == 0)
 #define memzero(buf, size) memset(buf, 0, size)
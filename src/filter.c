@@ -28,6 +28,7 @@
 #include "xmp.h"
 #include "common.h"
 #include "mixer.h"
+#include "player.h"
 
 
 /* LUT for 2 * damping factor */
@@ -104,4 +105,77 @@ void libxmp_filter_setup(int srate, int cutoff, int res, int *a0, int *b0, int *
 	*b1 = (int)(fb1 * (1 << FILTER_SHIFT));
 }
 
+/*
+ * Set up the coefficient cache for the current sampling rate, so that
+ * filter envelopes don't need to call libxmp_filter_setup() every frame.
+ * Entries are computed the first time a cutoff/resonance pair is used.
+ * If the cache can't be allocated we compute coefficients on the fly.
+ */
+void libxmp_filter_init(struct context_data *ctx)
+{
+	struct player_data *p = &ctx->p;
+	struct module_data *m = &ctx->m;
+	struct filter_coef *fc;
+	int i;
+
+	p->filter_coef = NULL;
+
+	if (!HAS_QUIRK(QUIRK_FILTER)) {
+		return;
+	}
+
+	fc = libxmp_malloc(FILTER_CACHE_SIZE * sizeof(struct filter_coef));
+	if (fc == NULL) {
+		return;
+	}
+
+	for (i = 0; i < FILTER_CACHE_SIZE; i++) {
+		fc[i].key = -1;
+	}
+
+	p->filter_coef = fc;
+}
+
+void libxmp_filter_deinit(struct context_data *ctx)
+{
+	struct player_data *p = &ctx->p;
+
+	libxmp_free(p->filter_coef);
+	p->filter_coef = NULL;
+}
+
+/* Get filter coefficients from the cache, if available */
+void libxmp_filter_coef(struct context_data *ctx, int cutoff, int res,
+			int *a0, int *b0, int *b1)
+{
+	struct player_data *p = &ctx->p;
+	struct mixer_data *s = &ctx->s;
+	struct filter_coef *c;
+	int key;
+
+	CLAMP(cutoff, 0, 255);
+	CLAMP(res, 0, 255);
+
+	if (p->filter_coef == NULL || cutoff >= FILTER_NUM_CUTOFF) {
+		libxmp_filter_setup(s->freq, cutoff, res, a0, b0, b1);
+		return;
+	}
+
+	/* Envelopes sweep the cutoff with a fixed resonance, so consecutive
+	 * cutoff values never collide.
+	 */
+	key = (cutoff << 7) | (res >> 1);
+	c = &p->filter_coef[(cutoff + (res >> 1) * 37) & (FILTER_CACHE_SIZE - 1)];
+
+	if (c->key != key) {
+		libxmp_filter_setup(s->freq, cutoff, res,
+					&c->a0, &c->b0, &c->b1);
+		c->key = key;
+	}
+
+	*a0 = c->a0;
+	*b0 = c->b0;
+	*b1 = c->b1;
+}
+
 #endif
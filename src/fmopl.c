@@ -46,6 +46,7 @@
 #include <string.h>
 #include <stdarg.h>
 #include <math.h>
+#include "common.h"
 #include "fmopl.h"
 
 #ifndef PI
@@ -613,24 +614,24 @@ static int OPLOpenTable( OPL_STATE *ST )
 	double pom;
 
 	/* allocate dynamic tables */
-	if( (ST->TL_TABLE = malloc(TL_MAX*2*sizeof(INT32))) == NULL)
+	if( (ST->TL_TABLE = libxmp_malloc(TL_MAX*2*sizeof(INT32))) == NULL)
 		return 0;
-	if( (ST->SIN_TABLE = malloc(SIN_ENT*4 *sizeof(INT32 *))) == NULL)
+	if( (ST->SIN_TABLE = libxmp_malloc(SIN_ENT*4 *sizeof(INT32 *))) == NULL)
 	{
-		free(ST->TL_TABLE);
+		libxmp_free(ST->TL_TABLE);
 		return 0;
 	}
-	if( (ST->AMS_TABLE = malloc(AMS_ENT*2 *sizeof(INT32))) == NULL)
+	if( (ST->AMS_TABLE = libxmp_malloc(AMS_ENT*2 *sizeof(INT32))) == NULL)
 	{
-		free(ST->TL_TABLE);
-		free(ST->SIN_TABLE);
+		libxmp_free(ST->TL_TABLE);
+		libxmp_free(ST->SIN_TABLE);
 		return 0;
 	}
-	if( (ST->VIB_TABLE = malloc(VIB_ENT*2 *sizeof(INT32))) == NULL)
+	if( (ST->VIB_TABLE = libxmp_malloc(VIB_ENT*2 *sizeof(INT32))) == NULL)
 	{
-		free(ST->TL_TABLE);
-		free(ST->SIN_TABLE);
-		free(ST->AMS_TABLE);
+		libxmp_free(ST->TL_TABLE);
+		libxmp_free(ST->SIN_TABLE);
+		libxmp_free(ST->AMS_TABLE);
 		return 0;
 	}
 	/* make total level table */
@@ -700,10 +701,10 @@ static int OPLOpenTable( OPL_STATE *ST )
 
 static void OPLCloseTable( OPL_STATE *ST )
 {
-	free(ST->TL_TABLE);
-	free(ST->SIN_TABLE);
-	free(ST->AMS_TABLE);
-	free(ST->VIB_TABLE);
+	libxmp_free(ST->TL_TABLE);
+	libxmp_free(ST->SIN_TABLE);
+	libxmp_free(ST->AMS_TABLE);
+	libxmp_free(ST->VIB_TABLE);
 }
 
 #ifdef XMP_OPL_CSM
@@ -1231,7 +1232,7 @@ FM_OPL *OPLCreate(int type, int clock, int rate)
 	if(type&OPL_TYPE_ADPCM) state_size+= sizeof(YM_DELTAT);
 #endif
 	/* allocate memory block */
-	ptr = malloc(state_size);
+	ptr = libxmp_malloc(state_size);
 	if(ptr==NULL) return NULL;
 	/* clear */
 	memset(ptr,0,state_size);
@@ -1240,7 +1241,7 @@ FM_OPL *OPLCreate(int type, int clock, int rate)
 	OPL->state.cur_chip = NULL;
 
 	if( OPL_LockTable(&OPL->state) ==-1) {
-		free(OPL);
+		libxmp_free(OPL);
 		return NULL;
 	}
 
@@ -1290,7 +1291,7 @@ void OPLDestroy(FM_OPL *OPL)
 	}
 #endif
 	OPL_UnLockTable(&OPL->state);
-	free(OPL);
+	libxmp_free(OPL);
 }
 
 /* ----------  Option handlers ----------       */
@@ -358,7 +358,7 @@ HIO_HANDLE *hio_open(const char *path, const char *mode)
 {
 	HIO_HANDLE *h;
 
-	h = (HIO_HANDLE *)calloc(1, sizeof (HIO_HANDLE));
+	h = (HIO_HANDLE *)libxmp_calloc(1, sizeof (HIO_HANDLE));
 	if (h == NULL)
 		goto err;
 
@@ -376,7 +376,7 @@ HIO_HANDLE *hio_open(const char *path, const char *mode)
     err3:
 	fclose(h->handle.file);
     err2:
-	free(h);
+	libxmp_free(h);
     err:
 	return NULL;
 }
@@ -386,7 +386,7 @@ HIO_HANDLE *hio_open_mem(const void *ptr, long size)
 	HIO_HANDLE *h;
 
 	if (size <= 0) return NULL;
-	h = (HIO_HANDLE *)calloc(1, sizeof (HIO_HANDLE));
+	h = (HIO_HANDLE *)libxmp_calloc(1, sizeof (HIO_HANDLE));
 	if (h == NULL)
 		return NULL;
 
@@ -397,11 +397,39 @@ HIO_HANDLE *hio_open_mem(const void *ptr, long size)
 	return h;
 }
 
+/* Like hio_open_mem(), but takes ownership of a buffer allocated with
+ * malloc() and frees it when the handle is closed. The buffer may be
+ * empty.
+ */
+HIO_HANDLE *hio_open_mem2(void *ptr, long size)
+{
+	HIO_HANDLE *h;
+
+	h = (HIO_HANDLE *)libxmp_calloc(1, sizeof (HIO_HANDLE));
+	if (h == NULL)
+		goto err;
+
+	h->type = HIO_HANDLE_TYPE_MEMORY;
+	h->handle.mem = mopen(ptr, size);
+	if (h->handle.mem == NULL)
+		goto err2;
+	h->size = size;
+	h->buffer = ptr;
+
+	return h;
+
+    err2:
+	libxmp_free(h);
+    err:
+	free(ptr);
+	return NULL;
+}
+
 HIO_HANDLE *hio_open_file(FILE *f)
 {
 	HIO_HANDLE *h;
 
-	h = (HIO_HANDLE *)calloc(1, sizeof (HIO_HANDLE));
+	h = (HIO_HANDLE *)libxmp_calloc(1, sizeof (HIO_HANDLE));
 	if (h == NULL)
 		return NULL;
 
@@ -410,7 +438,7 @@ HIO_HANDLE *hio_open_file(FILE *f)
 	h->handle.file = f;
 	h->size = get_size(f);
 	if (h->size < 0) {
-		free(h);
+		libxmp_free(h);
 		return NULL;
 	}
 
@@ -436,7 +464,7 @@ HIO_HANDLE *hio_open_callbacks(void *priv, struct xmp_callbacks callbacks)
 	if (!f)
 		return NULL;
 
-	h = (HIO_HANDLE *)calloc(1, sizeof(HIO_HANDLE));
+	h = (HIO_HANDLE *)libxmp_calloc(1, sizeof(HIO_HANDLE));
 	if (h == NULL) {
 		cbclose(f);
 		return NULL;
@@ -447,7 +475,7 @@ HIO_HANDLE *hio_open_callbacks(void *priv, struct xmp_callbacks callbacks)
 	h->size = cbfilelength(f);
 	if (h->size < 0) {
 		cbclose(f);
-		free(h);
+		libxmp_free(h);
 		return NULL;
 	}
 	return h;
@@ -469,7 +497,8 @@ int hio_close(HIO_HANDLE *h)
 		break;
 	}
 
-	free(h);
+	free(h->buffer);
+	libxmp_free(h);
 	return ret;
 }
 
@@ -22,6 +22,7 @@ typedef struct {
 	} handle;
 	int error;
 	int noclose;
+	void *buffer;		/* freed on close */
 } HIO_HANDLE;
 
 int8	hio_read8s	(HIO_HANDLE *);
@@ -39,6 +40,7 @@ int	hio_eof		(HIO_HANDLE *);
 int	hio_error	(HIO_HANDLE *);
 HIO_HANDLE *hio_open	(const char *, const char *);
 HIO_HANDLE *hio_open_mem  (const void *, long);
+HIO_HANDLE *hio_open_mem2 (void *, long);/* allows free()ing the buffer by libxmp */
 HIO_HANDLE *hio_open_file (FILE *);
 HIO_HANDLE *hio_open_file2 (FILE *);/* allows fclose()ing the file by libxmp */
 HIO_HANDLE *hio_open_callbacks (void *, struct xmp_callbacks);
@@ -28,6 +28,7 @@
 #include "hio.h"
 #include "tempfile.h"
 #include "loaders/loader.h"
+#include "sample_store.h"
 
 #ifndef LIBXMP_NO_DEPACKERS
 #include "depackers/depacker.h"
@@ -73,13 +74,13 @@ static char *get_dirname(const char *name)
 
 	if ((div = strrchr(name, '/')) != NULL) {
 		len = div - name + 1;
-		dirname = malloc(len + 1);
+		dirname = libxmp_malloc(len + 1);
 		if (dirname != NULL) {
 			memcpy(dirname, name, len);
 			dirname[len] = 0;
 		}
 	} else {
-		dirname = strdup("");
+		dirname = libxmp_strdup("");
 	}
 
 	return dirname;
@@ -91,9 +92,9 @@ static char *get_basename(const char *name)
 	char *basename;
 
 	if ((div = strrchr(name, '/')) != NULL) {
-		basename = strdup(div + 1);
+		basename = libxmp_strdup(div + 1);
 	} else {
-		basename = strdup(name);
+		basename = libxmp_strdup(name);
 	}
 
 	return basename;
@@ -182,6 +183,30 @@ int xmp_test_module(const char *path, struct xmp_test_info *info)
 	return ret;
 }
 
+int xmp_list_archive(const char *path, struct xmp_archive_entry *entries,
+		     int max)
+{
+#ifndef LIBXMP_NO_DEPACKERS
+	FILE *f;
+	int ret;
+
+	if (max < 0 || (max > 0 && entries == NULL)) {
+		return -XMP_ERROR_INVALID;
+	}
+
+	if ((f = fopen(path, "rb")) == NULL) {
+		return -XMP_ERROR_SYSTEM;
+	}
+
+	ret = libxmp_list_archive(f, entries, max);
+	fclose(f);
+
+	return ret < 0 ? -XMP_ERROR_FORMAT : ret;
+#else
+	return -XMP_ERROR_FORMAT;
+#endif
+}
+
 int xmp_test_module_from_memory(const void *mem, long size, struct xmp_test_info *info)
 {
 	HIO_HANDLE *h;
@@ -332,6 +357,10 @@ static int load_module(xmp_context opaque, HIO_HANDLE *h)
 
 	libxmp_load_epilogue(ctx);
 
+	if (m->smpctl & XMP_SMPCTL_SHARE) {
+		libxmp_share_samples(ctx);
+	}
+
 	ret = libxmp_prepare_scan(ctx);
 	if (ret < 0) {
 		xmp_release_module(opaque);
@@ -353,7 +382,10 @@ static int load_module(xmp_context opaque, HIO_HANDLE *h)
 	return -XMP_ERROR_LOAD;
 }
 
-int xmp_load_module(xmp_context opaque, const char *path)
+/* Load a module file, or the archive member at the given offset if the
+ * offset is not negative
+ */
+static int load_from_path(xmp_context opaque, const char *path, long offset)
 {
 	struct context_data *ctx = (struct context_data *)opaque;
 #ifndef LIBXMP_CORE_PLAYER
@@ -384,10 +416,15 @@ int xmp_load_module(xmp_context opaque, const char *path)
 
 #ifndef LIBXMP_NO_DEPACKERS
 	D_(D_INFO "decrunch");
-	if (libxmp_decrunch(&h, path, &temp_name) < 0) {
+	if (libxmp_decrunch_member(&h, path, offset, &temp_name) < 0) {
 		ret = -XMP_ERROR_DEPACK;
 		goto err;
 	}
+#else
+	if (offset >= 0) {
+		hio_close(h);
+		return -XMP_ERROR_DEPACK;
+	}
 #endif
 
 #ifndef LIBXMP_CORE_PLAYER
@@ -441,7 +478,38 @@ int xmp_load_module(xmp_context opaque, const char *path)
 #endif
 }
 
-int xmp_load_module_from_memory(xmp_context opaque, const void *mem, long size)
+int xmp_load_module(xmp_context opaque, const char *path)
+{
+	struct context_data *ctx = (struct context_data *)opaque;
+	struct alloc_class *old;
+	int ret;
+
+	old = libxmp_enter_allocator(ctx, ALLOC_MODULE);
+	ret = load_from_path(opaque, path, -1);
+	libxmp_leave_allocator(old);
+
+	return ret;
+}
+
+int xmp_load_module_from_archive(xmp_context opaque, const char *path,
+				 long offset)
+{
+	struct context_data *ctx = (struct context_data *)opaque;
+	struct alloc_class *old;
+	int ret;
+
+	if (offset < 0) {
+		return -XMP_ERROR_INVALID;
+	}
+
+	old = libxmp_enter_allocator(ctx, ALLOC_MODULE);
+	ret = load_from_path(opaque, path, offset);
+	libxmp_leave_allocator(old);
+
+	return ret;
+}
+
+static int load_from_memory(xmp_context opaque, const void *mem, long size)
 {
 	struct context_data *ctx = (struct context_data *)opaque;
 	struct module_data *m = &ctx->m;
@@ -470,7 +538,20 @@ int xmp_load_module_from_memory(xmp_context opaque, const void *mem, long size)
 	return ret;
 }
 
-int xmp_load_module_from_file(xmp_context opaque, void *file, long size)
+int xmp_load_module_from_memory(xmp_context opaque, const void *mem, long size)
+{
+	struct context_data *ctx = (struct context_data *)opaque;
+	struct alloc_class *old;
+	int ret;
+
+	old = libxmp_enter_allocator(ctx, ALLOC_MODULE);
+	ret = load_from_memory(opaque, mem, size);
+	libxmp_leave_allocator(old);
+
+	return ret;
+}
+
+static int load_from_file(xmp_context opaque, void *file, long size)
 {
 	struct context_data *ctx = (struct context_data *)opaque;
 	struct module_data *m = &ctx->m;
@@ -495,7 +576,20 @@ int xmp_load_module_from_file(xmp_context opaque, void *file, long size)
 	return ret;
 }
 
-int xmp_load_module_from_callbacks(xmp_context opaque, void *priv,
+int xmp_load_module_from_file(xmp_context opaque, void *file, long size)
+{
+	struct context_data *ctx = (struct context_data *)opaque;
+	struct alloc_class *old;
+	int ret;
+
+	old = libxmp_enter_allocator(ctx, ALLOC_MODULE);
+	ret = load_from_file(opaque, file, size);
+	libxmp_leave_allocator(old);
+
+	return ret;
+}
+
+static int load_from_callbacks(xmp_context opaque, void *priv,
 				struct xmp_callbacks callbacks)
 {
 	struct context_data *ctx = (struct context_data *)opaque;
@@ -521,7 +615,21 @@ int xmp_load_module_from_callbacks(xmp_context opaque, void *priv,
 	return ret;
 }
 
-void xmp_release_module(xmp_context opaque)
+int xmp_load_module_from_callbacks(xmp_context opaque, void *priv,
+				struct xmp_callbacks callbacks)
+{
+	struct context_data *ctx = (struct context_data *)opaque;
+	struct alloc_class *old;
+	int ret;
+
+	old = libxmp_enter_allocator(ctx, ALLOC_MODULE);
+	ret = load_from_callbacks(opaque, priv, callbacks);
+	libxmp_leave_allocator(old);
+
+	return ret;
+}
+
+static void release_module(xmp_context opaque)
 {
 	struct context_data *ctx = (struct context_data *)opaque;
 	struct module_data *m = &ctx->m;
@@ -547,63 +655,79 @@ void xmp_release_module(xmp_context opaque)
 
 	if (mod->xxt != NULL) {
 		for (i = 0; i < mod->trk; i++) {
-			free(mod->xxt[i]);
+			libxmp_free(mod->xxt[i]);
 		}
-		free(mod->xxt);
+		libxmp_free(mod->xxt);
 		mod->xxt = NULL;
 	}
 
 	if (mod->xxp != NULL) {
 		for (i = 0; i < mod->pat; i++) {
-			free(mod->xxp[i]);
+			libxmp_free(mod->xxp[i]);
 		}
-		free(mod->xxp);
+		libxmp_free(mod->xxp);
 		mod->xxp = NULL;
 	}
 
 	if (mod->xxi != NULL) {
 		for (i = 0; i < mod->ins; i++) {
-			free(mod->xxi[i].sub);
-			free(mod->xxi[i].extra);
+			libxmp_free(mod->xxi[i].sub);
+			libxmp_free(mod->xxi[i].extra);
 		}
-		free(mod->xxi);
+		libxmp_free(mod->xxi);
 		mod->xxi = NULL;
 	}
 
 	if (mod->xxs != NULL) {
 		for (i = 0; i < mod->smp; i++) {
-			libxmp_free_sample(&mod->xxs[i]);
+			libxmp_release_sample(m, i);
 		}
-		free(mod->xxs);
+		libxmp_free(mod->xxs);
 		mod->xxs = NULL;
 	}
 
-	free(m->xtra);
+	libxmp_free(m->shared);
+	m->shared = NULL;
+
+	libxmp_free(m->xtra);
 	m->xtra = NULL;
 
+	libxmp_free(m->env_slopes);
+	m->env_slopes = NULL;
+
 #ifndef LIBXMP_CORE_DISABLE_IT
 	if (m->xsmp != NULL) {
 		for (i = 0; i < mod->smp; i++) {
 			libxmp_free_sample(&m->xsmp[i]);
 		}
-		free(m->xsmp);
+		libxmp_free(m->xsmp);
 		m->xsmp = NULL;
 	}
 #endif
 
 	libxmp_free_scan(ctx);
 
-	free(m->comment);
+	libxmp_free(m->comment);
 	m->comment = NULL;
 
 	D_("free dirname/basename");
-	free(m->dirname);
-	free(m->basename);
+	libxmp_free(m->dirname);
+	libxmp_free(m->basename);
 	m->basename = NULL;
 	m->dirname = NULL;
 }
 
-void xmp_scan_module(xmp_context opaque)
+void xmp_release_module(xmp_context opaque)
+{
+	struct context_data *ctx = (struct context_data *)opaque;
+	struct alloc_class *old;
+
+	old = libxmp_enter_allocator(ctx, ALLOC_MODULE);
+	release_module(opaque);
+	libxmp_leave_allocator(old);
+}
+
+static void scan_module(xmp_context opaque)
 {
 	struct context_data *ctx = (struct context_data *)opaque;
 
@@ -612,3 +736,13 @@ void xmp_scan_module(xmp_context opaque)
 
 	libxmp_scan_sequences(ctx);
 }
+
+void xmp_scan_module(xmp_context opaque)
+{
+	struct context_data *ctx = (struct context_data *)opaque;
+	struct alloc_class *old;
+
+	old = libxmp_enter_allocator(ctx, ALLOC_MODULE);
+	scan_module(opaque);
+	libxmp_leave_allocator(old);
+}
@@ -156,6 +156,33 @@ static void check_envelope(struct xmp_envelope *env)
 	}
 }
 
+static void build_slopes(struct xmp_envelope *env, struct envelope_slopes *es)
+{
+	int16 *data = env->data;
+	int i, dx, dy;
+
+	es->ok = 0;
+
+	if (~env->flg & XMP_ENVELOPE_ON) {
+		return;
+	}
+
+	for (i = 0; i < env->npt - 1; i++) {
+		dx = data[i * 2 + 2] - data[i * 2];
+		dy = data[i * 2 + 3] - data[i * 2 + 1];
+		if (dx < 0) {
+			return;
+		}
+		if (dy < 0) {
+			dy = -dy;
+		}
+		es->q[i] = dx > 0 ? dy / dx : 0;
+		es->r[i] = dx > 0 ? dy % dx : 0;
+	}
+
+	es->ok = 1;
+}
+
 void libxmp_load_prologue(struct context_data *ctx)
 {
 	struct module_data *m = &ctx->m;
@@ -191,6 +218,9 @@ void libxmp_load_prologue(struct context_data *ctx)
 #ifndef LIBXMP_CORE_DISABLE_IT
 	m->xsmp = NULL;
 #endif
+	m->shared = NULL;
+	m->env_slopes = NULL;
+	m->synth = NULL;
 
 	m->time_factor = DEFAULT_TIME_FACTOR;
 
@@ -256,6 +286,20 @@ void libxmp_load_epilogue(struct context_data *ctx)
 		check_envelope(&mod->xxi[i].pei);
 	}
 
+	/* Envelope slopes for the player, which falls back to searching
+	 * and dividing if we can't allocate them
+	 */
+	if (mod->ins > 0) {
+		m->env_slopes = libxmp_calloc(mod->ins, sizeof(struct instrument_slopes));
+	}
+	if (m->env_slopes != NULL) {
+		for (i = 0; i < mod->ins; i++) {
+			build_slopes(&mod->xxi[i].aei, &m->env_slopes[i].aei);
+			build_slopes(&mod->xxi[i].fei, &m->env_slopes[i].fei);
+			build_slopes(&mod->xxi[i].pei, &m->env_slopes[i].pei);
+		}
+	}
+
 	p->filter = 0;
 	p->mode = XMP_MODE_AUTO;
 	p->flags = p->player_flags;
@@ -283,7 +327,7 @@ int libxmp_prepare_scan(struct context_data *ctx)
 		return 0;
 	}
 
-	m->scan_cnt = calloc(sizeof (uint8 *), mod->len);
+	m->scan_cnt = libxmp_calloc(sizeof (uint8 *), mod->len);
 	if (m->scan_cnt == NULL)
 		return -XMP_ERROR_SYSTEM;
 
@@ -299,7 +343,7 @@ int libxmp_prepare_scan(struct context_data *ctx)
 		}
 
 		pat = pat_idx >= mod->pat ? NULL : mod->xxp[pat_idx];
-		m->scan_cnt[i] = calloc(1, pat && pat->rows ? pat->rows : 1);
+		m->scan_cnt[i] = libxmp_calloc(1, pat && pat->rows ? pat->rows : 1);
 		if (m->scan_cnt[i] == NULL)
 			return -XMP_ERROR_SYSTEM;
 	}
@@ -316,14 +360,22 @@ void libxmp_free_scan(struct context_data *ctx)
 
 	if (m->scan_cnt) {
 		for (i = 0; i < mod->len; i++)
-			free(m->scan_cnt[i]);
+			libxmp_free(m->scan_cnt[i]);
 
-		free(m->scan_cnt);
+		libxmp_free(m->scan_cnt);
 		m->scan_cnt = NULL;
 	}
 
-	free(p->scan);
+	libxmp_free(p->scan);
 	p->scan = NULL;
+
+	libxmp_free(p->sequence_control);
+	p->sequence_control = NULL;
+	libxmp_free(m->xxo_info);
+	m->xxo_info = NULL;
+	libxmp_free(m->seq_data);
+	m->seq_data = NULL;
+	m->num_sequences = 0;
 }
 
 /* Process player personality flags */
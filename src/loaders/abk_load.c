@@ -113,7 +113,7 @@ static void read_abk_playlist(HIO_HANDLE *f, uint32 playlist_offset, struct abk_
     /* move to the start of the songs data section. */
     hio_seek(f, playlist_offset, SEEK_SET);
 
-    playlist->pattern = (uint16 *) malloc(arraysize * sizeof(uint16));
+    playlist->pattern = (uint16 *) libxmp_malloc(arraysize * sizeof(uint16));
 
     playdata = hio_read16b(f);
 
@@ -125,7 +125,7 @@ static void read_abk_playlist(HIO_HANDLE *f, uint32 playlist_offset, struct abk_
         if (playlist->length >= arraysize)
         {
             arraysize *= 2;
-            playlist->pattern = (uint16 *) realloc(playlist->pattern , arraysize * sizeof(uint16));
+            playlist->pattern = (uint16 *) libxmp_realloc(playlist->pattern , arraysize * sizeof(uint16));
         }
 
         playlist->pattern[playlist->length++] = playdata;
@@ -381,7 +381,7 @@ static struct abk_instrument* read_abk_insts(HIO_HANDLE *f, uint32 inst_section_
     if (count < 1)
         return NULL;
 
-    inst = (struct abk_instrument*) malloc(count * sizeof(struct abk_instrument));
+    inst = (struct abk_instrument*) libxmp_malloc(count * sizeof(struct abk_instrument));
     memset(inst, 0, count * sizeof(struct abk_instrument));
 
     for (i = 0; i < count; i++)
@@ -402,7 +402,7 @@ static struct abk_instrument* read_abk_insts(HIO_HANDLE *f, uint32 inst_section_
         }
     
         if (hio_read(inst[i].sample_name, 1, 16, f) != 16) {
-            free(inst);
+            libxmp_free(inst);
             return NULL;
 	}
     }
@@ -525,7 +525,7 @@ static int abk_load(struct module_data *m, HIO_HANDLE *f, const int start)
     {
         if (libxmp_alloc_subinstrument(mod, i, 1) < 0)
         {
-            free(ci);
+            libxmp_free(ci);
             return -1;
         }
 
@@ -563,7 +563,7 @@ static int abk_load(struct module_data *m, HIO_HANDLE *f, const int start)
            mod->xxs[i].flg & XMP_SAMPLE_LOOP ? 'L' : ' ');
     }
 
-    free(ci);
+    libxmp_free(ci);
 
     if (libxmp_init_pattern(mod) < 0)
     {
@@ -587,7 +587,7 @@ static int abk_load(struct module_data *m, HIO_HANDLE *f, const int start)
     {
         if (libxmp_alloc_pattern_tracks(mod, i, 64) < 0)
         {
-            free(playlist.pattern);
+            libxmp_free(playlist.pattern);
             return -1;
         }
 
@@ -595,7 +595,7 @@ static int abk_load(struct module_data *m, HIO_HANDLE *f, const int start)
         {
             pattern = hio_read16b(f);
             if (read_abk_pattern(f,  mod->xxt[(i*mod->chn)+k]->event, AMOS_MAIN_HEADER + main_header.patterns_offset + pattern) < 0) {
-    		free(playlist.pattern);
+    		libxmp_free(playlist.pattern);
 		return -1;
 	    }
         }
@@ -605,7 +605,7 @@ static int abk_load(struct module_data *m, HIO_HANDLE *f, const int start)
 
     /* Sanity check */
     if (playlist.length > 256) {
-    	free(playlist.pattern);
+    	libxmp_free(playlist.pattern);
 	return -1;
     }
 	
@@ -618,7 +618,7 @@ static int abk_load(struct module_data *m, HIO_HANDLE *f, const int start)
     }
 
     /* free up some memory here */
-    free(playlist.pattern);
+    libxmp_free(playlist.pattern);
 
     D_(D_INFO "Stored patterns: %d", mod->pat);
     D_(D_INFO "Stored tracks: %d", mod->trk);
@@ -149,7 +149,7 @@ static int load_packed_patterns(struct module_data *m, HIO_HANDLE *f)
 	uint16 w;
 
 	D_(D_INFO "Stored patterns: %d", mod->pat);
-	mod->xxp = calloc(sizeof(struct xmp_pattern *), mod->pat + 1);
+	mod->xxp = libxmp_calloc(sizeof(struct xmp_pattern *), mod->pat + 1);
 	if (mod->xxp == NULL)
 		return -1;
 
@@ -182,7 +182,7 @@ static int load_packed_patterns(struct module_data *m, HIO_HANDLE *f)
 	D_(D_INFO "Tracks: %d", mod->trk);
 	D_(D_INFO "Stored tracks: %d", stored_tracks);
 
-	mod->xxt = calloc(sizeof(struct xmp_track *), mod->trk);
+	mod->xxt = libxmp_calloc(sizeof(struct xmp_track *), mod->trk);
 	if (mod->xxt == NULL)
 		return -1;
 
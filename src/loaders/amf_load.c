@@ -140,7 +140,7 @@ static int amf_load(struct module_data *m, HIO_HANDLE *f, const int start)
 
 	D_(D_INFO "Stored patterns: %d", mod->pat);
 
-	mod->xxp = calloc(sizeof(struct xmp_pattern *), mod->pat);
+	mod->xxp = libxmp_calloc(sizeof(struct xmp_pattern *), mod->pat);
 	if (mod->xxp == NULL)
 		return -1;
 
@@ -302,7 +302,7 @@ static int amf_load(struct module_data *m, HIO_HANDLE *f, const int start)
 	 * breaking modules that directly reference the empty track in the
 	 * order table (see "cosmos st.amf").
 	 */
-	trkmap = calloc(sizeof(int), mod->trk + 1);
+	trkmap = libxmp_calloc(sizeof(int), mod->trk + 1);
 	if (trkmap == NULL)
 		return -1;
 	newtrk = 0;
@@ -328,14 +328,14 @@ static int amf_load(struct module_data *m, HIO_HANDLE *f, const int start)
 	}
 
 	mod->trk = newtrk + 1;		/* + empty track */
-	free(trkmap);
+	libxmp_free(trkmap);
 
 	if (hio_error(f))
 		return -1;
 
 	D_(D_INFO "Stored tracks: %d", mod->trk - 1);
 
-	mod->xxt = calloc (sizeof (struct xmp_track *), mod->trk);
+	mod->xxt = libxmp_calloc (sizeof (struct xmp_track *), mod->trk);
 	if (mod->xxt == NULL)
 		return -1;
 
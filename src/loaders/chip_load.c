@@ -60,7 +60,7 @@ static int chip_load(struct module_data *m, HIO_HANDLE *f, const int start)
 
 	LOAD_INIT();
 
-	if ((tidx = calloc(1, 1024)) == NULL) {
+	if ((tidx = libxmp_calloc(1, 1024)) == NULL) {
 		goto err;
 	}
 
@@ -191,12 +191,12 @@ static int chip_load(struct module_data *m, HIO_HANDLE *f, const int start)
 			goto err2;
 	}
 
-	free(tidx);
+	libxmp_free(tidx);
 
 	return 0;
 
     err2:
-	free(tidx);
+	libxmp_free(tidx);
     err:
 	return -1;
 }
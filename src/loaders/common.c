@@ -51,7 +51,7 @@ int libxmp_init_instrument(struct module_data *m)
 	struct xmp_module *mod = &m->mod;
 
 	if (mod->ins > 0) {
-		mod->xxi = calloc(sizeof (struct xmp_instrument), mod->ins);
+		mod->xxi = libxmp_calloc(sizeof (struct xmp_instrument), mod->ins);
 		if (mod->xxi == NULL)
 			return -1;
 	}
@@ -65,10 +65,10 @@ int libxmp_init_instrument(struct module_data *m)
 			return -1;
 		}
 
-		mod->xxs = calloc(sizeof (struct xmp_sample), mod->smp);
+		mod->xxs = libxmp_calloc(sizeof (struct xmp_sample), mod->smp);
 		if (mod->xxs == NULL)
 			return -1;
-		m->xtra = calloc(sizeof (struct extra_sample_data), mod->smp);
+		m->xtra = libxmp_calloc(sizeof (struct extra_sample_data), mod->smp);
 		if (m->xtra == NULL)
 			return -1;
 
@@ -96,19 +96,19 @@ int libxmp_realloc_samples(struct module_data *m, int new_size)
 	if (new_size == 0) {
 		/* Don't rely on implementation-defined realloc(x,0) behavior. */
 		mod->smp = 0;
-		free(mod->xxs);
+		libxmp_free(mod->xxs);
 		mod->xxs = NULL;
-		free(m->xtra);
+		libxmp_free(m->xtra);
 		m->xtra = NULL;
 		return 0;
 	}
 
-	xxs = realloc(mod->xxs, sizeof(struct xmp_sample) * new_size);
+	xxs = libxmp_realloc(mod->xxs, sizeof(struct xmp_sample) * new_size);
 	if (xxs == NULL)
 		return -1;
 	mod->xxs = xxs;
 
-	xtra = realloc(m->xtra, sizeof(struct extra_sample_data) * new_size);
+	xtra = libxmp_realloc(m->xtra, sizeof(struct extra_sample_data) * new_size);
 	if (xtra == NULL)
 		return -1;
 	m->xtra = xtra;
@@ -133,7 +133,7 @@ int libxmp_alloc_subinstrument(struct xmp_module *mod, int i, int num)
 	if (num == 0)
 		return 0;
 
-	mod->xxi[i].sub = calloc(sizeof (struct xmp_subinstrument), num);
+	mod->xxi[i].sub = libxmp_calloc(sizeof (struct xmp_subinstrument), num);
 	if (mod->xxi[i].sub == NULL)
 		return -1;
 
@@ -142,11 +142,11 @@ int libxmp_alloc_subinstrument(struct xmp_module *mod, int i, int num)
 
 int libxmp_init_pattern(struct xmp_module *mod)
 {
-	mod->xxt = calloc(sizeof (struct xmp_track *), mod->trk);
+	mod->xxt = libxmp_calloc(sizeof (struct xmp_track *), mod->trk);
 	if (mod->xxt == NULL)
 		return -1;
 
-	mod->xxp = calloc(sizeof (struct xmp_pattern *), mod->pat);
+	mod->xxp = libxmp_calloc(sizeof (struct xmp_pattern *), mod->pat);
 	if (mod->xxp == NULL)
 		return -1;
 
@@ -159,7 +159,7 @@ int libxmp_alloc_pattern(struct xmp_module *mod, int num)
 	if (num < 0 || num >= mod->pat || mod->xxp[num] != NULL)
 		return -1;
 
-	mod->xxp[num] = calloc(1, sizeof (struct xmp_pattern) +
+	mod->xxp[num] = libxmp_calloc(1, sizeof (struct xmp_pattern) +
         				sizeof (int) * (mod->chn - 1));
 	if (mod->xxp[num] == NULL)
 		return -1;
@@ -173,7 +173,7 @@ int libxmp_alloc_track(struct xmp_module *mod, int num, int rows)
 	if (num < 0 || num >= mod->trk || mod->xxt[num] != NULL || rows <= 0)
 		return -1;
 
-	mod->xxt[num] = calloc(sizeof (struct xmp_track) +
+	mod->xxt[num] = libxmp_calloc(sizeof (struct xmp_track) +
 			       sizeof (struct xmp_event) * (rows - 1), 1);
 	if (mod->xxt[num] == NULL)
 		return -1;
@@ -345,9 +345,9 @@ static int dynamic_buffer_alloc(struct dynamic_buffer* buf, uint32 size)
 	if (buf->size >= size)
 	  return 0;
 	if (!buf->data)
-	  data = malloc(size);
+	  data = libxmp_malloc(size);
 	else
-	  data = realloc(buf->data, size);
+	  data = libxmp_realloc(buf->data, size);
 	if (data) {
 	  buf->data = data;
 	  buf->size = size;
@@ -359,7 +359,7 @@ static int dynamic_buffer_alloc(struct dynamic_buffer* buf, uint32 size)
 
 static void dynamic_buffer_free(struct dynamic_buffer* buf)
 {
-	free(buf->data);
+	libxmp_free(buf->data);
 }
 
 static int get_smpd(struct module_data *m, int size, HIO_HANDLE *f, void *parm)
@@ -215,11 +215,11 @@ static int hvl_load(struct module_data *m, HIO_HANDLE *f, const int start)
 
 	hio_seek (f, subsongs*2, SEEK_CUR);
 
-	uint8 *seqbuf = malloc(mod->len * mod->chn * 2);
+	uint8 *seqbuf = libxmp_malloc(mod->len * mod->chn * 2);
 	uint8 *seqptr = seqbuf;
 	hio_read (seqbuf, 1, mod->len * mod->chn * 2, f);
 
-	uint8 **transbuf = malloc (mod->len * mod->chn * sizeof(uint8 *));
+	uint8 **transbuf = libxmp_malloc (mod->len * mod->chn * sizeof(uint8 *));
 	int transposed = 0;
 
 	reportv(ctx, 0, "Stored patterns: %d ", mod->len);
@@ -252,13 +252,13 @@ static int hvl_load(struct module_data *m, HIO_HANDLE *f, const int start)
 
 	if (transposed) {
 		mod->trk += transposed;
-		mod->xxt = realloc(mod->xxt, mod->trk * sizeof (struct xmp_track *));
+		mod->xxt = libxmp_realloc(mod->xxt, mod->trk * sizeof (struct xmp_track *));
 	}
 	
 	reportv(ctx, 0, "Stored tracks  : %d ", mod->trk);
 
 	for (i = 0; i < mod->trk; i++) {
-		mod->xxt[i] = calloc(sizeof(struct xmp_track) +
+		mod->xxt[i] = libxmp_calloc(sizeof(struct xmp_track) +
 				   sizeof(struct xmp_event) * pattlen - 1, 1);
                 mod->xxt[i]->rows = pattlen;
 
@@ -305,8 +305,8 @@ static int hvl_load(struct module_data *m, HIO_HANDLE *f, const int start)
 	}
 	reportv(ctx, 0, "\n");
 
-	free(seqbuf);
-	free(transbuf);
+	libxmp_free(seqbuf);
+	libxmp_free(transbuf);
 
 	/*
 	 * Instruments
@@ -317,7 +317,7 @@ static int hvl_load(struct module_data *m, HIO_HANDLE *f, const int start)
 		int vol, fspd, wavelen, flow, vibdel, hclen, hc;
 		int vibdep, vibspd, sqmin, sqmax, sqspd, fmax, plen, pspd;
 		int Alen, Avol, Dlen, Dvol, Slen, Rlen, Rvol;
-                mod->xxi[i].sub = calloc(sizeof (struct xmp_subinstrument), 1);
+                mod->xxi[i].sub = libxmp_calloc(sizeof (struct xmp_subinstrument), 1);
 
 		hio_read(buf, 22, 1, f);
 
@@ -359,7 +359,7 @@ static int hvl_load(struct module_data *m, HIO_HANDLE *f, const int start)
 
 		mod->xxi[i].fei.flg = XMP_ENVELOPE_ON; /* | XMP_ENVELOPE_LOOP;*/
 		mod->xxi[i].fei.npt = plen*2;
-		mod->xxfe[i] = calloc (4, mod->xxi[i].fei.npt);
+		mod->xxfe[i] = libxmp_calloc (4, mod->xxi[i].fei.npt);
 
 		int note=0;
 		int jump = -1;
@@ -439,7 +439,7 @@ static int hvl_load(struct module_data *m, HIO_HANDLE *f, const int start)
 			i, vol, Alen, Avol, Dlen, Dvol, Slen, Rlen, Rvol, wave);
 		mod->xxi[i].aei.flg = XMP_ENVELOPE_ON;
 		mod->xxi[i].aei.npt = 5;
-		mod->xxae[i] = calloc (4, mod->xxi[i].aei.npt);
+		mod->xxae[i] = libxmp_calloc (4, mod->xxi[i].aei.npt);
 		mod->xxae[i][0] = 0;
 		mod->xxae[i][1] = vol;
 		mod->xxae[i][2] = Alen; /* these are *not* multiplied by pspd */
@@ -502,7 +502,7 @@ static int hvl_load(struct module_data *m, HIO_HANDLE *f, const int start)
 		len = hio_tell(f) - title_offset;
 		hio_seek (f, title_offset, SEEK_SET);
 
-		nameptr = namebuf = malloc (len+1);
+		nameptr = namebuf = libxmp_malloc (len+1);
 		hio_read (namebuf, 1, len, f);
 		namebuf[len]=0;
 
@@ -517,7 +517,7 @@ static int hvl_load(struct module_data *m, HIO_HANDLE *f, const int start)
 			printf ("%02x: %s\n", i, nameptr);
 		}
 
-		free (namebuf);
+		libxmp_free (namebuf);
 	}
 
 	for (i = 0; i < mod->chn; i++)
@@ -128,7 +128,7 @@ iff_handle libxmp_iff_new()
 {
 	struct iff_data *data;
 
-	data = malloc(sizeof(struct iff_data));
+	data = libxmp_malloc(sizeof(struct iff_data));
 	if (data == NULL) {
 		return NULL;
 	}
@@ -164,7 +164,7 @@ int libxmp_iff_register(iff_handle opaque, const char *id,
 	struct iff_info *f;
 	int i = 0;
 
-	f = malloc(sizeof(struct iff_info));
+	f = libxmp_malloc(sizeof(struct iff_info));
 	if (f == NULL)
 		return -1;
 
@@ -192,10 +192,10 @@ void libxmp_iff_release(iff_handle opaque)
 		i = list_entry(tmp, struct iff_info, list);
 		list_del(&i->list);
 		tmp = tmp->next;
-		free(i);
+		libxmp_free(i);
 	}
 
-	free(data);
+	libxmp_free(data);
 }
 
 /* Functions to tune IFF mutations */
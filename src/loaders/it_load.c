@@ -486,7 +486,7 @@ static int load_old_it_instrument(struct xmp_instrument *xxi, HIO_HANDLE *f)
 	xxi->vol = 0x40;
 
 	if (k) {
-		xxi->sub = calloc(sizeof(struct xmp_subinstrument), k);
+		xxi->sub = libxmp_calloc(sizeof(struct xmp_subinstrument), k);
 		if (xxi->sub == NULL) {
 			return -1;
 		}
@@ -637,7 +637,7 @@ static int load_new_it_instrument(struct xmp_instrument *xxi, HIO_HANDLE *f)
 	xxi->vol = i2h.gbv >> 1;
 
 	if (k) {
-		xxi->sub = calloc(sizeof(struct xmp_subinstrument), k);
+		xxi->sub = libxmp_calloc(sizeof(struct xmp_subinstrument), k);
 		if (xxi->sub == NULL)
 			return -1;
 
@@ -692,7 +692,7 @@ static int load_it_sample(struct module_data *m, int i, int start,
 	uint8 buf[80];
 
 	if (sample_mode) {
-		mod->xxi[i].sub = calloc(sizeof(struct xmp_subinstrument), 1);
+		mod->xxi[i].sub = libxmp_calloc(sizeof(struct xmp_subinstrument), 1);
 		if (mod->xxi[i].sub == NULL) {
 			return -1;
 		}
@@ -858,7 +858,7 @@ static int load_it_sample(struct module_data *m, int i, int start,
 					force_sample_length(xsmp, left << 3);
 			}
 
-			buf = calloc(1, xxs->len * 2);
+			buf = libxmp_calloc(1, xxs->len * 2);
 			if (buf == NULL)
 				return -1;
 
@@ -880,13 +880,13 @@ static int load_it_sample(struct module_data *m, int i, int start,
 			if (ish.flags & IT_SMP_SLOOP) {
 				long pos = hio_tell(f);
 				if (pos < 0) {
-					free(buf);
+					libxmp_free(buf);
 					return -1;
 				}
 				ret = libxmp_load_sample(m, NULL, SAMPLE_FLAG_NOLOAD |
 							cvt, &m->xsmp[i], buf);
 				if (ret < 0) {
-					free(buf);
+					libxmp_free(buf);
 					return -1;
 				}
 				hio_seek(f, pos, SEEK_SET);
@@ -895,11 +895,11 @@ static int load_it_sample(struct module_data *m, int i, int start,
 			ret = libxmp_load_sample(m, NULL, SAMPLE_FLAG_NOLOAD | cvt,
 					  &mod->xxs[i], buf);
 			if (ret < 0) {
-				free(buf);
+				libxmp_free(buf);
 				return -1;
 			}
 
-			free(buf);
+			libxmp_free(buf);
 		} else {
 			if (ish.flags & IT_SMP_SLOOP) {
 				long pos = hio_tell(f);
@@ -1120,18 +1120,18 @@ static int it_load(struct module_data *m, HIO_HANDLE *f, const int start)
 	}
 
 	if (mod->ins) {
-		pp_ins = calloc(4, mod->ins);
+		pp_ins = libxmp_calloc(4, mod->ins);
 		if (pp_ins == NULL)
 			goto err;
 	} else {
 		pp_ins = NULL;
 	}
 
-	pp_smp = calloc(4, mod->smp);
+	pp_smp = libxmp_calloc(4, mod->smp);
 	if (pp_smp == NULL)
 		goto err2;
 
-	pp_pat = calloc(4, mod->pat);
+	pp_pat = libxmp_calloc(4, mod->pat);
 	if (pp_pat == NULL)
 		goto err3;
 
@@ -1201,7 +1201,7 @@ static int it_load(struct module_data *m, HIO_HANDLE *f, const int start)
 
 	/* Alloc extra samples for sustain loop */
 	if (mod->smp > 0) {
-		m->xsmp = calloc(sizeof (struct xmp_sample), mod->smp);
+		m->xsmp = libxmp_calloc(sizeof (struct xmp_sample), mod->smp);
 		if (m->xsmp == NULL) {
 			goto err4;
 		}
@@ -1368,14 +1368,14 @@ static int it_load(struct module_data *m, HIO_HANDLE *f, const int start)
 		}
 	}
 
-	free(pp_pat);
-	free(pp_smp);
-	free(pp_ins);
+	libxmp_free(pp_pat);
+	libxmp_free(pp_smp);
+	libxmp_free(pp_ins);
 
 	/* Song message */
 
 	if (ifh.special & IT_HAS_MSG) {
-		if ((m->comment = malloc(ifh.msglen)) != NULL) {
+		if ((m->comment = libxmp_malloc(ifh.msglen)) != NULL) {
 			hio_seek(f, start + ifh.msgofs, SEEK_SET);
 
 			D_(D_INFO "Message length : %d", ifh.msglen);
@@ -1425,11 +1425,11 @@ static int it_load(struct module_data *m, HIO_HANDLE *f, const int start)
 	return 0;
 
 err4:
-	free(pp_pat);
+	libxmp_free(pp_pat);
 err3:
-	free(pp_smp);
+	libxmp_free(pp_smp);
 err2:
-	free(pp_ins);
+	libxmp_free(pp_ins);
 err:
 	return -1;
 }
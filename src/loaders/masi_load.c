@@ -760,11 +760,11 @@ static int masi_load(struct module_data *m, HIO_HANDLE *f, const int start)
 	libxmp_iff_release(handle);
 
 	mod->trk = mod->pat * mod->chn;
-	data.pnam = malloc(mod->pat * 8);	/* pattern names */
+	data.pnam = libxmp_malloc(mod->pat * 8);	/* pattern names */
 	if (data.pnam == NULL)
 		goto err;
 
-	data.pord = malloc(XMP_MAX_MOD_LENGTH * 8);	/* pattern orders */
+	data.pord = libxmp_malloc(XMP_MAX_MOD_LENGTH * 8);	/* pattern orders */
 	if (data.pord == NULL)
 		goto err2;
 
@@ -822,15 +822,15 @@ static int masi_load(struct module_data *m, HIO_HANDLE *f, const int start)
 			break;
 	}
 
-	free(data.pord);
-	free(data.pnam);
+	libxmp_free(data.pord);
+	libxmp_free(data.pnam);
 
 	return 0;
 
     err3:
-	free(data.pord);
+	libxmp_free(data.pord);
     err2:
-	free(data.pnam);
+	libxmp_free(data.pnam);
     err:
 	return -1;
 }
@@ -432,7 +432,7 @@ static int get_chunk_pa(struct module_data *m, int size, HIO_HANDLE *f, void *pa
 
     mod->pat = hio_read8(f);
 
-    if ((mod->xxp = calloc(sizeof (struct xmp_pattern *), mod->pat)) == NULL)
+    if ((mod->xxp = libxmp_calloc(sizeof (struct xmp_pattern *), mod->pat)) == NULL)
         return -1;
 
     D_(D_INFO "Stored patterns: %d", mod->pat);
@@ -471,7 +471,7 @@ static int get_chunk_p0(struct module_data *m, int size, HIO_HANDLE *f, void *pa
 
     mod->pat = hio_read8(f);
 
-    if ((mod->xxp = calloc(sizeof (struct xmp_pattern *), mod->pat)) == NULL)
+    if ((mod->xxp = libxmp_calloc(sizeof (struct xmp_pattern *), mod->pat)) == NULL)
         return -1;
 
     D_(D_INFO "Stored patterns: %d", mod->pat);
@@ -519,12 +519,12 @@ static int get_chunk_tr(struct module_data *m, int size, HIO_HANDLE *f, void *pa
 	return -1;
     }
 
-    if ((mod->xxt = calloc(sizeof (struct xmp_track *), mod->trk)) == NULL)
+    if ((mod->xxt = libxmp_calloc(sizeof (struct xmp_track *), mod->trk)) == NULL)
 	return -1;
 
     D_(D_INFO "Stored tracks: %d", mod->trk);
 
-    track = calloc(1, sizeof (struct xmp_track) +
+    track = libxmp_calloc(1, sizeof (struct xmp_track) +
 			sizeof (struct xmp_event) * 255);
     if (track == NULL)
 	goto err;
@@ -620,12 +620,12 @@ static int get_chunk_tr(struct module_data *m, int size, HIO_HANDLE *f, void *pa
 	}
     }
 
-    free(track);
+    libxmp_free(track);
 
     return 0;
 
   err2:
-    free(track);
+    libxmp_free(track);
   err:
     return -1;
 }
@@ -647,7 +647,7 @@ static int get_chunk_ii(struct module_data *m, int size, HIO_HANDLE *f, void *pa
     mod->ins = hio_read8(f);
     D_(D_INFO "Instruments: %d", mod->ins);
 
-    if ((mod->xxi = calloc(sizeof (struct xmp_instrument), mod->ins)) == NULL)
+    if ((mod->xxi = libxmp_calloc(sizeof (struct xmp_instrument), mod->ins)) == NULL)
 	return -1;
 
     for (i = 0; i < mod->ins; i++) {
@@ -736,12 +736,12 @@ static int get_chunk_is(struct module_data *m, int size, HIO_HANDLE *f, void *pa
     data->has_is = 1;
 
     mod->smp = hio_read8(f);
-    if ((mod->xxs = calloc(sizeof (struct xmp_sample), mod->smp)) == NULL)
+    if ((mod->xxs = libxmp_calloc(sizeof (struct xmp_sample), mod->smp)) == NULL)
 	return -1;
-    if ((m->xtra = calloc(sizeof (struct extra_sample_data), mod->smp)) == NULL)
+    if ((m->xtra = libxmp_calloc(sizeof (struct extra_sample_data), mod->smp)) == NULL)
         return -1;
 
-    data->packinfo = calloc(sizeof (int), mod->smp);
+    data->packinfo = libxmp_calloc(sizeof (int), mod->smp);
     if (data->packinfo == NULL)
 	return -1;
 
@@ -817,7 +817,7 @@ static int get_chunk_i0(struct module_data *m, int size, HIO_HANDLE *f, void *pa
     if (libxmp_init_instrument(m) < 0)
 	return -1;
 
-    if ((data->packinfo = calloc(sizeof (int), mod->smp)) == NULL)
+    if ((data->packinfo = libxmp_calloc(sizeof (int), mod->smp)) == NULL)
 	return -1;
 
     for (i = 0; i < mod->ins; i++) {
@@ -929,7 +929,7 @@ static int get_chunk_sa(struct module_data *m, int size, HIO_HANDLE *f, void *pa
 	}
 
 	if (len > smpbuf_alloc) {
-	    uint8 *tmp = realloc(smpbuf, len);
+	    uint8 *tmp = libxmp_realloc(smpbuf, len);
 	    if (!tmp)
 		goto err2;
 
@@ -950,7 +950,7 @@ static int get_chunk_sa(struct module_data *m, int size, HIO_HANDLE *f, void *pa
                 goto err2;
             if (len <= 0 || len > 0x80000)  /* Max compressed sample size */
                 goto err2;
-	    if ((buf = malloc(len + 4)) == NULL)
+	    if ((buf = libxmp_malloc(len + 4)) == NULL)
 		goto err2;
 	    if (hio_read(buf, 1, len, f) != len)
                 goto err3;
@@ -958,7 +958,7 @@ static int get_chunk_sa(struct module_data *m, int size, HIO_HANDLE *f, void *pa
 	    buf[len] = buf[len + 1] = buf[len + 2] = buf[len + 3] = 0;
             if (unpack_sample8(smpbuf, buf, len, xxs->len) < 0)
                 goto err3;
-	    free(buf);
+	    libxmp_free(buf);
 	    left -= len + 4;
 	    break;
 	case 2:
@@ -968,7 +968,7 @@ static int get_chunk_sa(struct module_data *m, int size, HIO_HANDLE *f, void *pa
                 goto err2;
             if (len <= 0 || len > MAX_SAMPLE_SIZE)
                 goto err2;
-	    if ((buf = malloc(len + 4)) == NULL)
+	    if ((buf = libxmp_malloc(len + 4)) == NULL)
 		goto err2;
 	    if (hio_read(buf, 1, len, f) != len)
                 goto err3;
@@ -976,7 +976,7 @@ static int get_chunk_sa(struct module_data *m, int size, HIO_HANDLE *f, void *pa
 	    buf[len] = buf[len + 1] = buf[len + 2] = buf[len + 3] = 0;
             if (unpack_sample16(smpbuf, buf, len, xxs->len) < 0)
                 goto err3;
-	    free(buf);
+	    libxmp_free(buf);
 	    left -= len + 4;
 	    break;
 	}
@@ -985,12 +985,12 @@ static int get_chunk_sa(struct module_data *m, int size, HIO_HANDLE *f, void *pa
 	    goto err2;
     }
 
-    free(smpbuf);
+    libxmp_free(smpbuf);
     return 0;
   err3:
-    free(buf);
+    libxmp_free(buf);
   err2:
-    free(smpbuf);
+    libxmp_free(smpbuf);
     return -1;
 }
 
@@ -1009,7 +1009,7 @@ static int get_chunk_ve(struct module_data *m, int size, HIO_HANDLE *f, void *pa
 
     D_(D_INFO "Vol envelopes: %d", data->v_envnum);
 
-    data->v_env = calloc(data->v_envnum, sizeof (struct mdl_envelope));
+    data->v_env = libxmp_calloc(data->v_envnum, sizeof (struct mdl_envelope));
     if (data->v_env == NULL) {
 	return -1;
     }
@@ -1039,7 +1039,7 @@ static int get_chunk_pe(struct module_data *m, int size, HIO_HANDLE *f, void *pa
 
     D_(D_INFO "Pan envelopes: %d", data->p_envnum);
 
-    data->p_env = calloc(data->p_envnum, sizeof (struct mdl_envelope));
+    data->p_env = libxmp_calloc(data->p_envnum, sizeof (struct mdl_envelope));
     if (data->p_env == NULL) {
 	return -1;
     }
@@ -1069,7 +1069,7 @@ static int get_chunk_fe(struct module_data *m, int size, HIO_HANDLE *f, void *pa
 
     D_(D_INFO "Pitch envelopes: %d", data->f_envnum);
 
-    data->f_env = calloc(data->f_envnum, sizeof (struct mdl_envelope));
+    data->f_env = libxmp_calloc(data->f_envnum, sizeof (struct mdl_envelope));
     if (data->f_env == NULL) {
 	return -1;
     }
@@ -1136,11 +1136,11 @@ static int mdl_load(struct module_data *m, HIO_HANDLE *f, const int start)
     m->c4rate = C4_NTSC_RATE;
 
     data.v_envnum = data.p_envnum = data.f_envnum = 0;
-    data.s_index = calloc(256, sizeof (int));
-    data.i_index = calloc(256, sizeof (int));
-    data.v_index = malloc(256 * sizeof (int));
-    data.p_index = malloc(256 * sizeof (int));
-    data.f_index = malloc(256 * sizeof (int));
+    data.s_index = libxmp_calloc(256, sizeof (int));
+    data.i_index = libxmp_calloc(256, sizeof (int));
+    data.v_index = libxmp_malloc(256 * sizeof (int));
+    data.p_index = libxmp_malloc(256 * sizeof (int));
+    data.f_index = libxmp_malloc(256 * sizeof (int));
     if (!data.s_index || !data.i_index || !data.v_index || !data.p_index || !data.f_index) {
 	goto err;
     }
@@ -1191,17 +1191,17 @@ static int mdl_load(struct module_data *m, HIO_HANDLE *f, const int start)
     }
 
   err:
-    free(data.f_index);
-    free(data.p_index);
-    free(data.v_index);
-    free(data.i_index);
-    free(data.s_index);
+    libxmp_free(data.f_index);
+    libxmp_free(data.p_index);
+    libxmp_free(data.v_index);
+    libxmp_free(data.i_index);
+    libxmp_free(data.s_index);
 
-    free(data.v_env);
-    free(data.p_env);
-    free(data.f_env);
+    libxmp_free(data.v_env);
+    libxmp_free(data.p_env);
+    libxmp_free(data.f_env);
 
-    free(data.packinfo);
+    libxmp_free(data.packinfo);
 
     m->quirk |= QUIRKS_FT2 | QUIRK_KEYOFF;
     m->read_event_type = READ_EVENT_FT2;
@@ -106,7 +106,7 @@ static int unpack_block(struct module_data *m, uint16 bnum, uint8 *from, uint16
 	int i, j, trkn = mod->chn;
 
 	/*from += 16;*/
-	patbuf = to = calloc(3, 4 * 64);
+	patbuf = to = libxmp_calloc(3, 4 * 64);
 	if (to == NULL) {
 		goto err;
 	}
@@ -228,12 +228,12 @@ static int unpack_block(struct module_data *m, uint16 bnum, uint8 *from, uint16
 		}
 	}
 
-	free(patbuf);
+	libxmp_free(patbuf);
 
 	return 0;
 
      err2:
-	free(patbuf);
+	libxmp_free(patbuf);
      err:
 	return -1;
 }
@@ -360,7 +360,7 @@ static int med3_load(struct module_data *m, HIO_HANDLE *f, const int start)
 
 		b = hio_read8(f);
 		convsz = hio_read16b(f);
-		conv = calloc(1, convsz + 16);
+		conv = libxmp_calloc(1, convsz + 16);
 		if (conv == NULL)
 			return -1;
 
@@ -393,16 +393,16 @@ static int med3_load(struct module_data *m, HIO_HANDLE *f, const int start)
 			*(conv + 3) = hio_read32b(f);
 
 		if (hio_read(conv + 4, 1, convsz, f) != convsz) {
-			free(conv);
+			libxmp_free(conv);
 			return -1;
 		}
 
                 if (unpack_block(m, i, (uint8 *)conv, convsz) < 0) {
-			free(conv);
+			libxmp_free(conv);
 			return -1;
 		}
 
-		free(conv);
+		libxmp_free(conv);
 	}
 
 	/* Load samples */
@@ -270,7 +270,7 @@ static int mmd1_load(struct module_data *m, HIO_HANDLE *f, const int start)
 		/* Read annotation */
 		if (annotxt_offset != 0 && expdata.annolen != 0) {
 			D_(D_INFO "annotxt_offset = 0x%08x", annotxt_offset);
-			m->comment = malloc(expdata.annolen + 1);
+			m->comment = libxmp_malloc(expdata.annolen + 1);
 			if (m->comment != NULL) {
 				hio_seek(f, start + annotxt_offset, SEEK_SET);
 				hio_read(m->comment, 1, expdata.annolen, f);
@@ -385,12 +385,12 @@ int mmd_alloc_tables(struct module_data *m, int i, struct SynthInstr *synth)
 {
 	struct med_module_extras *me = (struct med_module_extras *)m->extra;
 
-	me->vol_table[i] = calloc(1, synth->voltbllen);
+	me->vol_table[i] = libxmp_calloc(1, synth->voltbllen);
 	if (me->vol_table[i] == NULL)
 		goto err;
 	memcpy(me->vol_table[i], synth->voltbl, synth->voltbllen);
 
-	me->wav_table[i] = calloc(1, synth->wftbllen);
+	me->wav_table[i] = libxmp_calloc(1, synth->wftbllen);
 	if (me->wav_table[i] == NULL)
 		goto err1;
 	memcpy(me->wav_table[i], synth->wftbl, synth->wftbllen);
@@ -398,7 +398,7 @@ int mmd_alloc_tables(struct module_data *m, int i, struct SynthInstr *synth)
 	return 0;
 
     err1:
-	free(me->vol_table[i]);
+	libxmp_free(me->vol_table[i]);
     err:
 	return -1;
 }
@@ -770,7 +770,7 @@ void mmd_info_text(HIO_HANDLE *f, struct module_data *m, int offset)
 		len = hio_read32b(f);
 		D_(D_INFO "mmdinfo length=%d", len);
 		if (len > 0 && len < hio_size(f)) {
-			m->comment = malloc(len + 1);
+			m->comment = libxmp_malloc(len + 1);
 			if (m->comment == NULL)
 				return;
 			hio_read(m->comment, 1, len, f);
@@ -64,14 +64,14 @@ static int polly_test(HIO_HANDLE *f, char *t, const int start)
 	if (hio_read8(f) != 0xae)
 		return -1;
 
-	if ((buf = malloc(0x10000)) == NULL)
+	if ((buf = libxmp_malloc(0x10000)) == NULL)
 		return -1;
 
 	decode_rle(buf, f, 0x10000);
 
 	for (i = 0; i < 128; i++) {
 		if (buf[ORD_OFS + i] != 0 && buf[ORD_OFS] < 0xe0) {
-			free(buf);
+			libxmp_free(buf);
 			return -1;
 		}
 	}
@@ -88,7 +88,7 @@ static int polly_test(HIO_HANDLE *f, char *t, const int start)
 		}
 	}
 
-	free(buf);
+	libxmp_free(buf);
 
 	return 0;
 }
@@ -107,7 +107,7 @@ static int polly_load(struct module_data *m, HIO_HANDLE *f, const int start)
 	 * File is RLE-encoded, escape is 0xAE (Aleksi Eeben's initials).
 	 * Actual 0xAE is encoded as 0xAE 0x01
 	 */
-	if ((buf = calloc(1, 0x10000)) == NULL)
+	if ((buf = libxmp_calloc(1, 0x10000)) == NULL)
 		return -1;
 
 	decode_rle(buf, f, 0x10000);
@@ -141,7 +141,7 @@ static int polly_load(struct module_data *m, HIO_HANDLE *f, const int start)
 	mod->trk = mod->pat * mod->chn;
 
 	if (libxmp_init_pattern(mod) < 0) {
-		free(buf);
+		libxmp_free(buf);
 		return -1;
 	}
 
@@ -149,7 +149,7 @@ static int polly_load(struct module_data *m, HIO_HANDLE *f, const int start)
 
 	for (i = 0; i < mod->pat; i++) {
 		if (libxmp_alloc_pattern_tracks(mod, i, 64) < 0) {
-			free(buf);
+			libxmp_free(buf);
 			return -1;
 		}
 
@@ -172,13 +172,13 @@ static int polly_load(struct module_data *m, HIO_HANDLE *f, const int start)
 
 	mod->ins = mod->smp = 15;
 	if (libxmp_init_instrument(m) < 0) {
-		free(buf);
+		libxmp_free(buf);
 		return -1;
 	}
 
 	for (i = 0; i < 15; i++) {
 		if (libxmp_alloc_subinstrument(mod, i, 1) < 0) {
-			free(buf);
+			libxmp_free(buf);
 			return -1;
 		}
 		mod->xxs[i].len = buf[ORD_OFS + 129 + i] < 0x10 ? 0 :
@@ -215,12 +215,12 @@ static int polly_load(struct module_data *m, HIO_HANDLE *f, const int start)
 					256 * (buf[ORD_OFS + 129 + i] - 0x10));
 
 		if (ret < 0) {
-			free(buf);
+			libxmp_free(buf);
 			return -1;
 		}
 	}
 
-	free(buf);
+	libxmp_free(buf);
 
 	/* make it mono */
 	for (i = 0; i < mod->chn; i++)
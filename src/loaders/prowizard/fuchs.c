@@ -98,9 +98,9 @@ static int depack_fuchs(HIO_HANDLE *in, FILE *out)
 		return -1;
 
 	/* read pattern data */
-	tmp = (uint8 *)malloc(pat_size);
+	tmp = (uint8 *)libxmp_malloc(pat_size);
 	if (hio_read(tmp, 1, pat_size, in) != pat_size) {
-		free(tmp);
+		libxmp_free(tmp);
 		return -1;
 	}
 
@@ -115,7 +115,7 @@ static int depack_fuchs(HIO_HANDLE *in, FILE *out)
 
 	/* write pattern data */
 	fwrite(tmp, pat_size, 1, out);
-	free(tmp);
+	libxmp_free(tmp);
 
 	/* read/write sample data */
 	hio_read32b(in);			/* bypass "INST" Id */
@@ -164,7 +164,7 @@ static int depack_p4x(HIO_HANDLE *in, FILE *out)
 
 	hio_seek(in, trkdat_ofs + 4, SEEK_SET);
 
-	if ((tdata = calloc(512, 256)) == NULL) {
+	if ((tdata = libxmp_calloc(512, 256)) == NULL) {
 		return -1;
 	}
 
@@ -264,10 +264,10 @@ static int depack_p4x(HIO_HANDLE *in, FILE *out)
 		pw_move_data(out, in, SampleSize[i]);
 	}
 
-	free(tdata);
+	libxmp_free(tdata);
 	return 0;
     err:
-	free(tdata);
+	libxmp_free(tdata);
 	return -1;
 }
 
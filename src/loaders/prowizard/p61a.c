@@ -529,7 +529,7 @@ static int depack_p61a(HIO_HANDLE *in, FILE *out)
     /*printf ( "writing sample data ... " ); */
     for (i = 0; i < nins; i++) {
 	hio_seek(in, sdata_addr + saddr[i], 0);
-	smp_buffer = malloc(smp_size[i]);
+	smp_buffer = libxmp_malloc(smp_size[i]);
 	memset(smp_buffer, 0, smp_size[i]);
 	hio_read(smp_buffer, smp_size[i], 1, in);
 	if (use_delta == 1) {
@@ -543,7 +543,7 @@ static int depack_p61a(HIO_HANDLE *in, FILE *out)
 	    }
 	}
 	fwrite(smp_buffer, smp_size[i], 1, out);
-	free(smp_buffer);
+	libxmp_free(smp_buffer);
     }
 
     /* if (use_delta == 1)
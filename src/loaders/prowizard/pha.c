@@ -199,14 +199,14 @@ restart:
 	 * clear it after reading.
 	 */
 	psize = npat * 1024;
-	if ((pdata = (uint8 *)malloc(psize)) == NULL)
+	if ((pdata = (uint8 *)libxmp_malloc(psize)) == NULL)
 		return -1;
 
 	psize = hio_read(pdata, 1, psize, in);
 	hio_error(in);
 
 	size = npat * 1024;
-	if ((pat = (uint8 *)calloc(1, size)) == NULL)
+	if ((pat = (uint8 *)libxmp_calloc(1, size)) == NULL)
 		goto err;
 
 	j = 0;
@@ -264,8 +264,8 @@ restart:
 		j += 4;
 	}
 	fwrite(pat, npat * 1024, 1, out);
-	free(pdata);
-	free(pat);
+	libxmp_free(pdata);
+	libxmp_free(pat);
 
 	/* Sample data */
 	hio_seek(in, smp_addr, SEEK_SET);
@@ -274,8 +274,8 @@ restart:
 	return 0;
 
     err:
-	free(pdata);
-	free(pat);
+	libxmp_free(pdata);
+	libxmp_free(pat);
 	return -1;
 }
 
@@ -73,15 +73,15 @@ void Depack_PM (FILE * in, FILE * out)
 	/*printf ( "Number of pattern : %d\n" , Max ); */
 	/* pattern data */
 	fseek (in, 1084, SEEK_SET);
-	tmp = (uint8 *) malloc (Max * 1024);
+	tmp = (uint8 *) libxmp_malloc (Max * 1024);
 	memset(tmp, 0, Max * 1024);
 	fread (tmp, Max * 1024, 1, in);
 	fwrite (tmp, Max * 1024, 1, out);
-	free (tmp);
+	libxmp_free (tmp);
 
 	/* sample data */
-	tmp = (signed char *) malloc (ssize);
-	ins_Data = (signed char *) malloc (ssize);
+	tmp = (signed char *) libxmp_malloc (ssize);
+	ins_Data = (signed char *) libxmp_malloc (ssize);
 	memset(tmp, 0, ssize);
 	memset(ins_Data, 0, ssize);
 	fread (tmp, ssize, 1, in);
@@ -90,8 +90,8 @@ void Depack_PM (FILE * in, FILE * out)
 		ins_Data[i] = ins_Data[i - 1] + tmp[i];
 	}
 	fwrite (ins_Data, ssize, 1, out);
-	free (tmp);
-	free (ins_Data);
+	libxmp_free (tmp);
+	libxmp_free (ins_Data);
 
 
 	/* crap */
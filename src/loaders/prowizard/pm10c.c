@@ -159,7 +159,7 @@ restart:
 	/* read "reference Table" */
 	refmax++;		/* coz 1st value is 0 ! */
 	refsize = refmax * 4;	/* coz each block is 4 bytes long */
-	if ((reftab = (uint8 *)malloc(refsize)) == NULL) {
+	if ((reftab = (uint8 *)libxmp_malloc(refsize)) == NULL) {
 		return -1;
 	}
 
@@ -228,7 +228,7 @@ restart:
 		fwrite(pat[j], 1024, 1, out);
 	}
 
-	free(reftab);
+	libxmp_free(reftab);
 
 	hio_seek(in, 4452, SEEK_SET);
 	smp_ofs = hio_read32b(in);
@@ -239,7 +239,7 @@ restart:
 	return 0;
 
     err:
-	free(reftab);
+	libxmp_free(reftab);
 	return -1;
 }
 
@@ -108,7 +108,7 @@ static int depack_p18a(HIO_HANDLE *in, FILE *out)
 	/* read "reference table" */
 	refmax += 1;			/* 1st value is 0 ! */
 	refsize = refmax * 4;		/* each block is 4 bytes long */
-	if ((reftab = (uint8 *)malloc(refsize)) == NULL) {
+	if ((reftab = (uint8 *)libxmp_malloc(refsize)) == NULL) {
 		return -1;
 	}
 
@@ -179,7 +179,7 @@ static int depack_p18a(HIO_HANDLE *in, FILE *out)
 
 	/* printf ( "Highest value in pattern data : %d\n" , refmax ); */
 
-	free(reftab);
+	libxmp_free(reftab);
 
 	hio_seek(in, 4456, SEEK_SET);
 	smp_ofs = hio_read32b(in);
@@ -191,7 +191,7 @@ static int depack_p18a(HIO_HANDLE *in, FILE *out)
 	return 0;
 
     err:
-	free(reftab);
+	libxmp_free(reftab);
 	return -1;
 }
 
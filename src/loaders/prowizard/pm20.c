@@ -228,7 +228,7 @@ void Depack_PM20 (FILE * in, FILE * out)
 	/*printf ( "address of 'reference table' : %ld\n" , ftell (in ) ); */
 	refmax += 1;		/* coz 1st value is 0 ! */
 	i = refmax * 4;	/* coz each block is 4 bytes long */
-	reftab = (uint8 *) malloc (i);
+	reftab = (uint8 *) libxmp_malloc (i);
 	fread (reftab, i, 1, in);
 
 	/* go back to pattern data starting address */
@@ -344,7 +344,7 @@ void Depack_PM20 (FILE * in, FILE * out)
 		fwrite (Pattern[j], 1024, 1, out);
 	}
 
-	free (reftab);
+	libxmp_free (reftab);
 
 	/* get address of sample data .. and go there */
 	fseek (in, ADDRESS_SAMPLE_DATA, 0);	/* SEEK_SET */
@@ -359,10 +359,10 @@ void Depack_PM20 (FILE * in, FILE * out)
 	/* read and save sample data */
 	/*printf ( "out: where before saving sample data : %ld\n" , ftell ( out ) ); */
 	/*printf ( "Total sample size : %ld\n" , ssize ); */
-	sdata = (uint8 *) malloc (ssize);
+	sdata = (uint8 *) libxmp_malloc (ssize);
 	fread (sdata, ssize, 1, in);
 	fwrite (sdata, ssize, 1, out);
-	free (sdata);
+	libxmp_free (sdata);
 
 
 	Crap ("PM20:Promizer 2.0", BAD, BAD, out);
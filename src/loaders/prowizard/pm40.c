@@ -221,7 +221,7 @@ void Depack_PM40 (FILE * in, FILE * out)
 /*  printf ( "address of 'reference table' : %ld\n" , ftell (in ) );*/
 	refmax += 1;		/* coz 1st value is 0 and will be empty in this table */
 	i = refmax * 4;	/* coz each block is 4 bytes long */
-	reftab = (uint8 *) malloc (i);
+	reftab = (uint8 *) libxmp_malloc (i);
 	memset(reftab, 0, i);
 	fread (&reftab[4], i, 1, in);
 
@@ -333,7 +333,7 @@ void Depack_PM40 (FILE * in, FILE * out)
 		fwrite (Pattern[j], 1024, 1, out);
 		/*printf ( "." ); */
 	}
-	free (reftab);
+	libxmp_free (reftab);
 	/*printf ( " ok\n" ); */
 
 
@@ -351,10 +351,10 @@ void Depack_PM40 (FILE * in, FILE * out)
 	/* read and save sample data */
 /*  printf ( "out: where before saving sample data : %ld\n" , ftell ( out ) );*/
 /*  printf ( "Whole sample size : %ld\n" , ssize );*/
-	sdata = (uint8 *) malloc (ssize);
+	sdata = (uint8 *) libxmp_malloc (ssize);
 	fread (sdata, ssize, 1, in);
 	fwrite (sdata, ssize, 1, out);
-	free (sdata);
+	libxmp_free (sdata);
 	/*printf ( " ok\n" ); */
 
 	Crap ("PM40:Promizer 4.0", BAD, BAD, out);
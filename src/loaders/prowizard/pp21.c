@@ -91,9 +91,9 @@ static int depack_pp21_pp30(HIO_HANDLE *in, FILE *out, int is_30)
 	}
 
 	/* read "reference Table" */
-	tab = (uint8 *)malloc(tabsize);
+	tab = (uint8 *)libxmp_malloc(tabsize);
 	if (hio_read(tab, tabsize, 1, in) != 1) {
-		free(tab);
+		libxmp_free(tab);
 		return -1;
 	}
 
@@ -109,7 +109,7 @@ static int depack_pp21_pp30(HIO_HANDLE *in, FILE *out, int is_30)
 		fwrite (buf, 1024, 1, out);
 	}
 
-	free (tab);
+	libxmp_free (tab);
 
 	/* Now, it's sample data ... though, VERY quickly handled :) */
 	pw_move_data(out, in, ssize);
@@ -121,7 +121,7 @@ void Depack_PP30 (FILE * in, FILE * out)
 
 
 	/* read "reference Table" */
-	reftab = (uint8 *) malloc (RTS);
+	reftab = (uint8 *) libxmp_malloc (RTS);
 	fread (reftab, RTS, 1, in);
 
 	/* NOW, the real shit takes place :) */
@@ -186,17 +186,17 @@ void Depack_PP30 (FILE * in, FILE * out)
 		fwrite (Pattern, 1024, 1, out);
 	}
 
-	free (reftab);
+	libxmp_free (reftab);
 
 
 	/* Now, it's sample data ... though, VERY quickly handled :) */
 	/* thx GCC ! (GNU C COMPILER). */
 
 	/*printf ( "Total sample size : %ld\n" , ssize ); */
-	reftab = (uint8 *) malloc (ssize);
+	reftab = (uint8 *) libxmp_malloc (ssize);
 	fread (reftab, ssize, 1, in);
 	fwrite (reftab, ssize, 1, out);
-	free (reftab);
+	libxmp_free (reftab);
 
 
 	Crap ("PP30:ProPacker v3.0", BAD, BAD, out);
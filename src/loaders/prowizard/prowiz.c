@@ -130,7 +130,7 @@ const struct pw_format *pw_check(HIO_HANDLE *f, struct xmp_test_info *info)
 	unsigned char *b;
 	int s = BUF_SIZE;
 
-	b = calloc(1, BUF_SIZE);
+	b = libxmp_calloc(1, BUF_SIZE);
 	if (b == NULL)
 		return NULL;
 
@@ -141,9 +141,9 @@ const struct pw_format *pw_check(HIO_HANDLE *f, struct xmp_test_info *info)
 		res = pw_formats[i]->test(b, title, s);
 		if (res > 0) {
 			/* Extra data was requested. */
-			unsigned char *buf = realloc(b, s + res);
+			unsigned char *buf = libxmp_realloc(b, s + res);
 			if (buf == NULL) {
-				free(b);
+				libxmp_free(b);
 				return NULL;
 			}
 			b = buf;
@@ -163,11 +163,11 @@ const struct pw_format *pw_check(HIO_HANDLE *f, struct xmp_test_info *info)
 				strncpy(info->type, pw_formats[i]->name,
 							XMP_NAME_SIZE - 1);
 			}
-			free(b);
+			libxmp_free(b);
 			return pw_formats[i];
 		}
 	}
-	free(b);
+	libxmp_free(b);
 	return NULL;
 }
 
@@ -54,13 +54,13 @@ static int depack_emod (HIO_HANDLE *in, FILE *out)
 	fread (&nins, 1, 1, in);
 
 	/* write empty 930 sample header */
-	tmp = (uint8 *) malloc (930);
+	tmp = (uint8 *) libxmp_malloc (930);
 	memset(tmp, 0, 930);
 	/* puts some $01 for replen */
 	for (i = 0; i < 31; i++)
 		tmp[i * 30 + 29] = 0x01;
 	fwrite (tmp, 930, 1, out);
-	free (tmp);
+	libxmp_free (tmp);
 
 	/* read and write sample descriptions */
 /*printf ( "sample number:" );*/
@@ -261,10 +261,10 @@ static int depack_emod (HIO_HANDLE *in, FILE *out)
 			continue;
 		}
 		fseek (in, iaddr[i], 0);
-		tmp = (uint8 *) malloc (isize[i]);
+		tmp = (uint8 *) libxmp_malloc (isize[i]);
 		fread (tmp, isize[i], 1, in);
 		fwrite (tmp, isize[i], 1, out);
-		free (tmp);
+		libxmp_free (tmp);
 	}
 
 	return 0;
@@ -25,10 +25,10 @@ void Depack_SoundFX13 (FILE * in, FILE * out)
 	// out = fdopen (fd_out, "w+b");
 
 	/* title */
-	tmp = (uint8 *) malloc (20);
+	tmp = (uint8 *) libxmp_malloc (20);
 	memset(tmp, 0, 20);
 	fwrite (tmp, 20, 1, out);
-	free (tmp);
+	libxmp_free (tmp);
 
 	/* read and write whole header */
 	for (i = 0; i < 15; i++) {
@@ -74,12 +74,12 @@ void Depack_SoundFX13 (FILE * in, FILE * out)
 		fwrite (&c1, 1, 1, out);
 		fwrite (&c2, 1, 1, out);
 	}
-	tmp = (uint8 *) malloc (30);
+	tmp = (uint8 *) libxmp_malloc (30);
 	memset(tmp, 0, 30);
 	tmp[29] = 0x01;
 	for (i = 0; i < 16; i++)
 		fwrite (tmp, 30, 1, out);
-	free (tmp);
+	libxmp_free (tmp);
 
 	/* pattern list size */
 	fread (&PatPos, 1, 1, in);
@@ -116,7 +116,7 @@ void Depack_SoundFX13 (FILE * in, FILE * out)
 
 	/* pattern data */
 	fseek (in, 0x294, 0);
-	tmp = (uint8 *) malloc (1024);
+	tmp = (uint8 *) libxmp_malloc (1024);
 	for (i = 0; i <= Max; i++) {
 		memset(tmp, 0, 1024);
 		fread (tmp, 1024, 1, in);
@@ -173,16 +173,16 @@ void Depack_SoundFX13 (FILE * in, FILE * out)
 		fwrite (tmp, 1024, 1, out);
 		fflush (stdout);
 	}
-	free (tmp);
+	libxmp_free (tmp);
 	fflush (stdout);
 
 
 	/* sample data */
-	tmp = (uint8 *) malloc (ssize);
+	tmp = (uint8 *) libxmp_malloc (ssize);
 	memset(tmp, 0, ssize);
 	fread (tmp, ssize, 1, in);
 	fwrite (tmp, ssize, 1, out);
-	free (tmp);
+	libxmp_free (tmp);
 	fflush (stdout);
 
 
@@ -204,7 +204,7 @@ static int theplayer_depack(HIO_HANDLE *in, FILE *out, int version)
     int val;
     uint8 buf[1024];
 
-    if ((tdata = calloc(512, 256)) == NULL) {
+    if ((tdata = libxmp_calloc(512, 256)) == NULL) {
 	return -1;
     }
 
@@ -223,7 +223,7 @@ static int theplayer_depack(HIO_HANDLE *in, FILE *out, int version)
 
     /* Sanity check */
     if (npat > 128) {
-	free(tdata);
+	libxmp_free(tdata);
         return -1;
     }
 
@@ -238,7 +238,7 @@ static int theplayer_depack(HIO_HANDLE *in, FILE *out, int version)
 	/* Some samples are packed -- depacking not implemented */
 	/* pack = 1; */
 
-	free(tdata);
+	libxmp_free(tdata);
 	return -1;
     }
 
@@ -246,7 +246,7 @@ static int theplayer_depack(HIO_HANDLE *in, FILE *out, int version)
 
     /* Sanity check */
     if (nins > 31) {
-	free(tdata);
+	libxmp_free(tdata);
         return -1;
     }
 
@@ -321,7 +321,7 @@ static int theplayer_depack(HIO_HANDLE *in, FILE *out, int version)
 
     /* patterns */
     if (decode_pattern(in, npat, tdata, taddr) < 0) {
-        free(tdata);
+        libxmp_free(tdata);
         return -1;
     }
 
@@ -335,12 +335,12 @@ static int theplayer_depack(HIO_HANDLE *in, FILE *out, int version)
 	fwrite(buf, 1024, 1, out);
     }
 
-    free(tdata);
+    libxmp_free(tdata);
 
     /* read and write sample data */
     for (i = 0; i < nins; i++) {
 	hio_seek(in, sdata_addr + saddr[i], SEEK_SET);
-	smp_buffer = malloc(smp_size[i]);
+	smp_buffer = libxmp_malloc(smp_size[i]);
 	memset(smp_buffer, 0, smp_size[i]);
 	hio_read(smp_buffer, smp_size[i], 1, in);
 	if (delta == 1) {
@@ -351,7 +351,7 @@ static int theplayer_depack(HIO_HANDLE *in, FILE *out, int version)
 	    }
 	}
 	fwrite(smp_buffer, smp_size[i], 1, out);
-	free(smp_buffer);
+	libxmp_free(smp_buffer);
     }
 
     /* if (delta == 1)
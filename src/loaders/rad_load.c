@@ -113,7 +113,7 @@ static int rad_load(struct module_data *m, HIO_HANDLE *f, const int start)
 		goto err;
 	}
 
-	if ((buf = calloc(mod->ins, 11)) == NULL) {
+	if ((buf = libxmp_calloc(mod->ins, 11)) == NULL) {
 		goto err;
 	}
 
@@ -144,7 +144,7 @@ static int rad_load(struct module_data *m, HIO_HANDLE *f, const int start)
 		mod->xxi[i].nsm = 1;
 	}
 
-	free(buf);
+	libxmp_free(buf);
 
 	/* Read orders */
 	mod->len = hio_read8(f);
@@ -265,7 +265,7 @@ static int rad_load(struct module_data *m, HIO_HANDLE *f, const int start)
 	return 0;
 
     err2:
-	free(buf);
+	libxmp_free(buf);
     err:
 	return -1;
 }
@@ -61,6 +61,9 @@
 #include "loader.h"
 #include "s3m.h"
 #include "period.h"
+#ifndef LIBXMP_CORE_PLAYER
+#include "synth.h"
+#endif
 
 #define MAGIC_SCRM	MAGIC4('S','C','R','M')
 #define MAGIC_SCRI	MAGIC4('S','C','R','I')
@@ -262,12 +265,12 @@ static int s3m_load(struct module_data *m, HIO_HANDLE * f, const int start)
 
 	libxmp_copy_adjust(mod->name, sfh.name, 28);
 
-	pp_ins = calloc(2, sfh.insnum);
+	pp_ins = libxmp_calloc(2, sfh.insnum);
 	if (pp_ins == NULL) {
 		goto err;
 	}
 
-	pp_pat = calloc(2, sfh.patnum);
+	pp_pat = libxmp_calloc(2, sfh.patnum);
 	if (pp_pat == NULL) {
 		goto err2;
 	}
@@ -488,7 +491,7 @@ static int s3m_load(struct module_data *m, HIO_HANDLE * f, const int start)
 		struct xmp_subinstrument *sub;
 		int load_sample_flags;
 
-		xxi->sub = calloc(sizeof(struct xmp_subinstrument), 1);
+		xxi->sub = libxmp_calloc(sizeof(struct xmp_subinstrument), 1);
 		if (xxi->sub == NULL) {
 			goto err3;
 		}
@@ -526,13 +529,14 @@ static int s3m_load(struct module_data *m, HIO_HANDLE * f, const int start)
 			xxi->nsm = 1;
 			sub->vol = sah.vol;
 			libxmp_c2spd_to_note(sah.c2spd, &sub->xpo, &sub->fin);
-			sub->xpo += 12;
 			ret =
 			    libxmp_load_sample(m, f, SAMPLE_FLAG_ADLIB, xxs,
 					(char *)sah.reg);
 			if (ret < 0)
 				goto err3;
 
+			m->synth = &synth_adlib;
+
 			D_(D_INFO "[%2X] %-28.28s", i, xxi->name);
 
 			continue;
@@ -608,8 +612,8 @@ static int s3m_load(struct module_data *m, HIO_HANDLE * f, const int start)
 		}
 	}
 
-	free(pp_pat);
-	free(pp_ins);
+	libxmp_free(pp_pat);
+	libxmp_free(pp_ins);
 
 	m->quirk |= QUIRKS_ST3 | QUIRK_ARPMEM;
 	m->read_event_type = READ_EVENT_ST3;
@@ -617,9 +621,9 @@ static int s3m_load(struct module_data *m, HIO_HANDLE * f, const int start)
 	return 0;
 
 err3:
-	free(pp_pat);
+	libxmp_free(pp_pat);
 err2:
-	free(pp_ins);
+	libxmp_free(pp_ins);
 err:
 	return -1;
 }
@@ -22,6 +22,9 @@
 
 #include "common.h"
 #include "loader.h"
+#ifndef LIBXMP_CORE_PLAYER
+#include "synth.h"
+#endif
 
 #ifndef LIBXMP_CORE_PLAYER
 
@@ -55,15 +58,6 @@ static const int8 vdic_table[128] = {
 	/* 120 */	 95,  98, 103, 109, 114, 120, 126, 127
 };
 
-
-/* Convert 7 bit samples to 8 bit */
-static void convert_7bit_to_8bit(uint8 *p, int l)
-{
-	for (; l--; p++) {
-		*p <<= 1;
-	}
-}
-
 /* Convert Archimedes VIDC samples to linear */
 static void convert_vidc_to_linear(uint8 *p, int l)
 {
@@ -98,50 +92,52 @@ static void adpcm4_decoder(uint8 *inp, uint8 *outp, char *tab, int len)
 
 #endif
 
-/* Convert differential to absolute sample data */
-static void convert_delta(uint8 *p, int l, int r)
+/* Sample conversions done in a single pass over the data, in this order */
+#define CONVERT_7BIT	0x01	/* 7 bit to 8 bit (8-bit samples only) */
+#define CONVERT_ENDIAN	0x02	/* Swap bytes (16-bit samples only) */
+#define CONVERT_DELTA	0x04	/* Differential to absolute */
+#define CONVERT_SIGNAL	0x08	/* Unsigned to signed */
+
+/* Convert 8 bit sample data. The loops are branchless so that the
+ * compiler can vectorize them, except for delta decoding which is a
+ * serial prefix sum.
+ */
+static void convert_8bit(uint8 *p, int l, int ops)
 {
-	uint16 *w = (uint16 *)p;
-	uint16 abs = 0;
+	const int shift = ops & CONVERT_7BIT ? 1 : 0;
+	const uint8 sign = ops & CONVERT_SIGNAL ? 0x80 : 0;
+	uint8 abs = 0;
+	int i;
 
-	if (r) {
-		for (; l--;) {
-			abs = *w + abs;
-			*w++ = abs;
+	if (ops & CONVERT_DELTA) {
+		for (i = 0; i < l; i++) {
+			abs += (uint8)(p[i] << shift);
+			p[i] = abs + sign;
 		}
 	} else {
-		for (; l--;) {
-			abs = *p + abs;
-			*p++ = (uint8) abs;
+		for (i = 0; i < l; i++) {
+			p[i] = (uint8)(p[i] << shift) + sign;
 		}
 	}
 }
 
-/* Convert signed to unsigned sample data */
-static void convert_signal(uint8 *p, int l, int r)
-{
-	uint16 *w = (uint16 *)p;
-
-	if (r) {
-		for (; l--; w++)
-			*w += 0x8000;
-	} else {
-		for (; l--; p++)
-			*p += (char)0x80;	/* cast needed by MSVC++ */
-	}
-}
-
-/* Convert little-endian 16 bit samples to big-endian */
-static void convert_endian(uint8 *p, int l)
+/* Convert 16 bit sample data. A zero shift leaves the bytes in place. */
+static void convert_16bit(uint16 *w, int l, int ops)
 {
-	uint8 b;
+	const int shift = ops & CONVERT_ENDIAN ? 8 : 0;
+	const uint16 sign = ops & CONVERT_SIGNAL ? 0x8000 : 0;
+	uint16 abs = 0;
 	int i;
 
-	for (i = 0; i < l; i++) {
-		b = p[0];
-		p[0] = p[1];
-		p[1] = b;
-		p += 2;
+	if (ops & CONVERT_DELTA) {
+		for (i = 0; i < l; i++) {
+			abs += (uint16)((w[i] << shift) | (w[i] >> shift));
+			w[i] = abs + sign;
+		}
+	} else {
+		for (i = 0; i < l; i++) {
+			w[i] = (uint16)((w[i] << shift) | (w[i] >> shift)) + sign;
+		}
 	}
 }
 
@@ -163,45 +159,24 @@ static void convert_stereo_to_mono(uint8 *p, int l, int r)
 }
 #endif
 
-static void unroll_loop(struct xmp_sample *xxs)
-{
-	int8 *s8;
-	int16 *s16;
-	int start, loop_size;
-	int i;
-
-	s16 = (int16 *)xxs->data;
-	s8 = (int8 *)xxs->data;
-
-	if (xxs->len > xxs->lpe) {
-		start = xxs->lpe;
-	} else {
-		start = xxs->len;
-	}
-
-	loop_size = xxs->lpe - xxs->lps;
-
-	if (xxs->flg & XMP_SAMPLE_16BIT) {
-		s16 += start;
-		for (i = 0; i < loop_size; i++) {
-			*(s16 + i) = *(s16 - i - 1);
-		}
-	} else {
-		s8 += start;
-		for (i = 0; i < loop_size; i++) {
-			*(s8 + i) = *(s8 - i - 1);
-		}
-	}
-}
-
-
 int libxmp_load_sample(struct module_data *m, HIO_HANDLE *f, int flags, struct xmp_sample *xxs, const void *buffer)
 {
-	int bytelen, extralen, unroll_extralen, i;
+	int bytelen, extralen, convert, i;
 
 #ifndef LIBXMP_CORE_PLAYER
-	/* Adlib FM patches */
+	/* Adlib FM patches: keep the register values as sample data, to
+	 * be used by the synth driver
+	 */
 	if (flags & SAMPLE_FLAG_ADLIB) {
+		xxs->data = libxmp_calloc(1, ADLIB_PATCH_SIZE + 4);
+		if (xxs->data == NULL) {
+			return -1;
+		}
+		xxs->data += 4;
+		memcpy(xxs->data, buffer, ADLIB_PATCH_SIZE);
+		xxs->len = ADLIB_PATCH_SIZE;
+		xxs->lps = xxs->lpe = 0;
+		xxs->flg = XMP_SAMPLE_SYNTH;
 		return 0;
 	}
 #endif
@@ -264,7 +239,6 @@ int libxmp_load_sample(struct module_data *m, HIO_HANDLE *f, int flags, struct x
 	 */
 	bytelen = xxs->len;
 	extralen = 4;
-	unroll_extralen = 0;
 
 	/* Disable birectional loop flag if sample is not looped
 	 */
@@ -272,25 +246,14 @@ int libxmp_load_sample(struct module_data *m, HIO_HANDLE *f, int flags, struct x
 		if (~xxs->flg & XMP_SAMPLE_LOOP)
 			xxs->flg &= ~XMP_SAMPLE_LOOP_BIDIR;
 	}
-	/* Unroll bidirectional loops
-	 */
-	if (xxs->flg & XMP_SAMPLE_LOOP_BIDIR) {
-		unroll_extralen = (xxs->lpe - xxs->lps) -
-				(xxs->len - xxs->lpe);
-
-		if (unroll_extralen < 0) {
-			unroll_extralen = 0;
-		}
-	}
 
 	if (xxs->flg & XMP_SAMPLE_16BIT) {
 		bytelen *= 2;
 		extralen *= 2;
-		unroll_extralen *= 2;
 	}
 
 	/* add guard bytes before the buffer for higher order interpolation */
-	xxs->data = malloc(bytelen + extralen + unroll_extralen + 4);
+	xxs->data = libxmp_malloc(bytelen + extralen + 4);
 	if (xxs->data == NULL) {
 		goto err;
 	}
@@ -324,38 +287,47 @@ int libxmp_load_sample(struct module_data *m, HIO_HANDLE *f, int flags, struct x
 		}
 	}
 
-#ifndef LIBXMP_CORE_PLAYER
-	if (flags & SAMPLE_FLAG_7BIT) {
-		convert_7bit_to_8bit(xxs->data, xxs->len);
-	}
-#endif
-
-	/* Fix endianism if needed */
+	/* Convert sample data to signed, native endian absolute values */
+	convert = 0;
 	if (xxs->flg & XMP_SAMPLE_16BIT) {
 #ifdef WORDS_BIGENDIAN
 		if (~flags & SAMPLE_FLAG_BIGEND)
-			convert_endian(xxs->data, xxs->len);
+			convert |= CONVERT_ENDIAN;
 #else
 		if (flags & SAMPLE_FLAG_BIGEND)
-			convert_endian(xxs->data, xxs->len);
+			convert |= CONVERT_ENDIAN;
 #endif
 	}
+#ifndef LIBXMP_CORE_PLAYER
+	else if (flags & SAMPLE_FLAG_7BIT) {
+		convert |= CONVERT_7BIT;
+	}
+#endif
 
-	/* Convert delta samples */
 	if (flags & SAMPLE_FLAG_DIFF) {
-		convert_delta(xxs->data, xxs->len, xxs->flg & XMP_SAMPLE_16BIT);
+		convert |= CONVERT_DELTA;
 	} else if (flags & SAMPLE_FLAG_8BDIFF) {
-		int len = xxs->len;
 		if (xxs->flg & XMP_SAMPLE_16BIT) {
-			len *= 2;
+			/* Byte deltas must be decoded on their own */
+			convert_16bit((uint16 *)xxs->data, xxs->len,
+					convert & CONVERT_ENDIAN);
+			convert_8bit(xxs->data, xxs->len * 2, CONVERT_DELTA);
+			convert &= ~CONVERT_ENDIAN;
+		} else {
+			convert |= CONVERT_DELTA;
 		}
-		convert_delta(xxs->data, len, 0);
 	}
 
-	/* Convert samples to signed */
 	if (flags & SAMPLE_FLAG_UNS) {
-		convert_signal(xxs->data, xxs->len,
-				xxs->flg & XMP_SAMPLE_16BIT);
+		convert |= CONVERT_SIGNAL;
+	}
+
+	if (convert != 0) {
+		if (xxs->flg & XMP_SAMPLE_16BIT) {
+			convert_16bit((uint16 *)xxs->data, xxs->len, convert);
+		} else {
+			convert_8bit(xxs->data, xxs->len, convert);
+		}
 	}
 
 #if 0
@@ -379,12 +351,6 @@ int libxmp_load_sample(struct module_data *m, HIO_HANDLE *f, int flags, struct x
 		xxs->flg |= XMP_SAMPLE_LOOP_FULL;
 	}
 
-	/* Unroll bidirectional loops */
-	if (xxs->flg & XMP_SAMPLE_LOOP_BIDIR) {
-		unroll_loop(xxs);
-		bytelen += unroll_extralen;
-	}
-
 	/* Add extra samples at end */
 	if (xxs->flg & XMP_SAMPLE_16BIT) {
 		for (i = 0; i < 8; i++) {
@@ -405,13 +371,26 @@ int libxmp_load_sample(struct module_data *m, HIO_HANDLE *f, int flags, struct x
 	}
 
 	/* Fix sample at loop */
-	if (xxs->flg & XMP_SAMPLE_LOOP) {
+	if (xxs->flg & XMP_SAMPLE_LOOP_BIDIR) {
+		/* Bidirectional loops are played backwards by the mixer,
+		 * interpolation past the loop end reads the mirrored data.
+		 */
 		int lpe = xxs->lpe;
 		int lps = xxs->lps;
 
-		if (xxs->flg & XMP_SAMPLE_LOOP_BIDIR) {
-			lpe += lpe - lps;
+		if (xxs->flg & XMP_SAMPLE_16BIT) {
+			int16 *s16 = (int16 *)xxs->data;
+			for (i = 0; i < 4; i++) {
+				s16[lpe + i] = s16[MAX(lpe - 1 - i, lps)];
+			}
+		} else {
+			for (i = 0; i < 4; i++) {
+				xxs->data[lpe + i] = xxs->data[MAX(lpe - 1 - i, lps)];
+			}
 		}
+	} else if (xxs->flg & XMP_SAMPLE_LOOP) {
+		int lpe = xxs->lpe;
+		int lps = xxs->lps;
 
 		if (xxs->flg & XMP_SAMPLE_16BIT) {
 			lpe <<= 1;
@@ -439,7 +418,7 @@ int libxmp_load_sample(struct module_data *m, HIO_HANDLE *f, int flags, struct x
 void libxmp_free_sample(struct xmp_sample *s)
 {
     if (s->data) {
-	free(s->data - 4);
+	libxmp_free(s->data - 4);
 	s->data = NULL;		/* prevent double free in PCM load error */
     }
 }
@@ -151,7 +151,7 @@ static int stc_load(struct module_data *m, HIO_HANDLE * f, const int start)
 		return -1;
 
 	hio_seek(f, pat_ptr, SEEK_SET);
-	decoded = calloc(mod->pat, sizeof(int));
+	decoded = libxmp_calloc(mod->pat, sizeof(int));
 	D_(D_INFO "Stored patterns: %d ", mod->pat);
 
 	for (i = 0; i < MAX_PAT; i++) {
@@ -234,7 +234,7 @@ static int stc_load(struct module_data *m, HIO_HANDLE * f, const int start)
 		decoded[dest] = 1;
 	}
 
-	free(decoded);
+	libxmp_free(decoded);
 
 	/* Read instruments */
 
@@ -331,7 +331,7 @@ static int stc_load(struct module_data *m, HIO_HANDLE * f, const int start)
 	/* Read ornaments */
 
 	hio_seek(f, orn_ptr, SEEK_SET);
-	m->extra = calloc(1, sizeof (struct spectrum_extra));
+	m->extra = libxmp_calloc(1, sizeof (struct spectrum_extra));
 	se = m->extra;
 
 	D_(D_INFO "Ornaments: %d", orn);
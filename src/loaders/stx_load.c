@@ -206,11 +206,11 @@ static int stx_load(struct module_data *m, HIO_HANDLE *f, const int start)
 
 	MODULE_INFO();
 
-	pp_pat = calloc(2, mod->pat);
+	pp_pat = libxmp_calloc(2, mod->pat);
 	if (pp_pat == NULL)
 		goto err;
 
-	pp_ins = calloc(2, mod->ins);
+	pp_ins = libxmp_calloc(2, mod->ins);
 	if (pp_ins == NULL)
 		goto err2;
 
@@ -362,8 +362,8 @@ static int stx_load(struct module_data *m, HIO_HANDLE *f, const int start)
 		}
 	}
 
-	free(pp_ins);
-	free(pp_pat);
+	libxmp_free(pp_ins);
+	libxmp_free(pp_pat);
 
 	/* Read samples */
 	D_(D_INFO "Stored samples: %d", mod->smp);
@@ -379,9 +379,9 @@ static int stx_load(struct module_data *m, HIO_HANDLE *f, const int start)
 	return 0;
 
 err3:
-	free(pp_ins);
+	libxmp_free(pp_ins);
 err2:
-	free(pp_pat);
+	libxmp_free(pp_pat);
 err:
 	return -1;
 }
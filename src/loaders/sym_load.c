@@ -43,10 +43,6 @@ static int sym_test(HIO_HANDLE *f, char *t, const int start)
 	uint32 a, b;
 	int i, ver;
 
-	/* Load from memory not supported until we handle sample depacking */
-	if (HIO_HANDLE_TYPE(f) != HIO_HANDLE_TYPE_FILE)
-		return -1;
-
 	a = hio_read32b(f);
 	b = hio_read32b(f);
 
@@ -323,26 +319,26 @@ static int sym_load(struct module_data *m, HIO_HANDLE *f, const int start)
 	D_(D_INFO "Packed sequence: %s", a ? "yes" : "no");
 
 	size = mod->len * mod->chn * 2;
-	if ((buf = malloc(size)) == NULL)
+	if ((buf = libxmp_malloc(size)) == NULL)
 		return -1;
 
 	if (a) {
-		unsigned char *x = libxmp_read_lzw_dynamic(f->handle.file, buf,
+		unsigned char *x = libxmp_read_lzw_dynamic(f, buf,
 					13, 0, size, size, XMP_LZW_QUIRK_DSYM);
 		if (x == NULL) {
-			free(buf);
+			libxmp_free(buf);
 			return -1;
 		}
 	} else {
 		if (hio_read(buf, 1, size, f) != size) {
-			free(buf);
+			libxmp_free(buf);
 			return -1;
 		}
 	}
 
 	for (i = 0; i < mod->len; i++) {	/* len == pat */
 		if (libxmp_alloc_pattern(mod, i) < 0) {
-			free(buf);
+			libxmp_free(buf);
 			return -1;
 		}
 		mod->xxp[i]->rows = 64;
@@ -356,7 +352,7 @@ static int sym_load(struct module_data *m, HIO_HANDLE *f, const int start)
 				t = mod->trk - 1;
 			} else if (t >= mod->trk - 1) {
 				/* Sanity check */
-				free(buf);
+				libxmp_free(buf);
 				return -1;
 			}
 
@@ -364,7 +360,7 @@ static int sym_load(struct module_data *m, HIO_HANDLE *f, const int start)
 		}
 		mod->xxo[i] = i;
 	}
-	free(buf);
+	libxmp_free(buf);
 
 	/* Read and convert patterns */
 
@@ -377,26 +373,26 @@ static int sym_load(struct module_data *m, HIO_HANDLE *f, const int start)
 	D_(D_INFO "Stored tracks: %d", mod->trk - 1);
 
 	size = 64 * (mod->trk - 1) * 4;
-	if ((buf = malloc(size)) == NULL)
+	if ((buf = libxmp_malloc(size)) == NULL)
 		return -1;
 
 	if (a) {
-		unsigned char *x = libxmp_read_lzw_dynamic(f->handle.file, buf,
+		unsigned char *x = libxmp_read_lzw_dynamic(f, buf,
 					13, 0, size, size, XMP_LZW_QUIRK_DSYM);
 		if (x == NULL) {
-			free(buf);
+			libxmp_free(buf);
 			return -1;
 		}
 	} else {
 		if (hio_read(buf, 1, size, f) != size) {
-			free(buf);
+			libxmp_free(buf);
 			return -1;
 		}
 	}
 
 	for (i = 0; i < mod->trk - 1; i++) {
 		if (libxmp_alloc_track(mod, i, 64) < 0) {
-			free(buf);
+			libxmp_free(buf);
 			return -1;
 		}
 
@@ -421,7 +417,7 @@ static int sym_load(struct module_data *m, HIO_HANDLE *f, const int start)
 		}
 	}
 
-	free(buf);
+	libxmp_free(buf);
 
 	/* Extra track */
 	if (libxmp_alloc_track(mod, i, 64) < 0)
@@ -471,14 +467,14 @@ static int sym_load(struct module_data *m, HIO_HANDLE *f, const int start)
 		}
 
 		if (a == 1) {
-			uint8 *b = malloc(mod->xxs[i].len);
-			libxmp_read_lzw_dynamic(f->handle.file, b, 13, 0,
+			uint8 *b = libxmp_malloc(mod->xxs[i].len);
+			libxmp_read_lzw_dynamic(f, b, 13, 0,
 					mod->xxs[i].len, mod->xxs[i].len,
 					XMP_LZW_QUIRK_DSYM);
 			ret = libxmp_load_sample(m, NULL,
 					SAMPLE_FLAG_NOLOAD | SAMPLE_FLAG_DIFF,
 					&mod->xxs[i], (char*)b);
-			free(b);
+			libxmp_free(b);
 		/*} else if (a == 4) {
 			ret = libxmp_load_sample(m, f, SAMPLE_FLAG_VIDC,
 					&mod->xxs[i], NULL);*/
@@ -98,4 +98,19 @@ struct xm_event {
 	uint8 fx_parm;		/* Effect parameter */
 };
 
+struct xm_ogg_sample {
+	uint8 *data;		/* Ogg stream */
+	int len;		/* Ogg stream length */
+	int sid;		/* Sample number */
+	int is16;		/* Decode to 16-bit */
+	void *pcm;		/* Decoded sample data */
+	int num;		/* Decoded sample length */
+};
+
+struct xm_ogg_list {
+	struct xm_ogg_sample *smp;
+	int num;
+	int max;
+};
+
 #endif
@@ -36,6 +36,14 @@
 #include "loader.h"
 #include "xm.h"
 
+#if !defined(LIBXMP_CORE_PLAYER) && !defined(LIBXMP_NO_DEPACKERS)
+#define XM_OGG_SAMPLES
+#include "../depackers/vorbis.h"
+#include "../worker.h"
+
+#define MAGIC_OGGS	0x4f676753
+#endif
+
 static int xm_test(HIO_HANDLE *, char *, const int);
 static int xm_load(struct module_data *, HIO_HANDLE *, const int);
 
@@ -100,7 +108,7 @@ static int load_xm_pattern(struct module_data *m, int num, int version, HIO_HAND
 
 	size = xph.datasize;
 
-	pat = patbuf = calloc(1, size);
+	pat = patbuf = libxmp_calloc(1, size);
 	if (patbuf == NULL) {
 		goto err;
 	}
@@ -286,16 +294,159 @@ static int load_xm_pattern(struct module_data *m, int num, int version, HIO_HAND
 		}
 		event->vol = 0;
 	}
-	free(patbuf);
+	libxmp_free(patbuf);
 
 	return 0;
 
 err2:
-	free(patbuf);
+	libxmp_free(patbuf);
 err:
 	return -1;
 }
 
+#ifdef XM_OGG_SAMPLES
+
+/* OggMod (OXM) files store samples as Ogg Vorbis streams. Compressed
+ * samples are collected while loading the instruments and decoded
+ * together at the end, so independent samples can be decoded in
+ * parallel.
+ */
+
+static int is_ogg_sample(HIO_HANDLE *f, int len)
+{
+	uint8 buf[8];
+	long pos;
+	int ret;
+
+	if (len < 8) {
+		return 0;
+	}
+
+	pos = hio_tell(f);
+	if (pos < 0) {
+		return 0;
+	}
+
+	ret = hio_read(buf, 1, 8, f) == 8 && readmem32b(buf + 4) == MAGIC_OGGS;
+
+	if (hio_seek(f, pos, SEEK_SET) < 0) {
+		return 0;
+	}
+
+	return ret;
+}
+
+static int add_ogg_sample(struct xm_ogg_list *ogg, HIO_HANDLE *f, int len,
+			  int sid, int is16)
+{
+	struct xm_ogg_sample *smp;
+	uint8 *data;
+
+	if (ogg->num >= ogg->max) {
+		int max = ogg->max > 0 ? ogg->max * 2 : 16;
+
+		smp = (struct xm_ogg_sample *)libxmp_realloc(ogg->smp, max * sizeof(struct xm_ogg_sample));
+		if (smp == NULL) {
+			return -1;
+		}
+		ogg->smp = smp;
+		ogg->max = max;
+	}
+
+	if ((data = (uint8 *)libxmp_calloc(1, len)) == NULL) {
+		return -1;
+	}
+
+	/* The Ogg stream starts after the first four bytes */
+	if (hio_seek(f, 4, SEEK_CUR) < 0 || hio_read(data, 1, len - 4, f) != len - 4) {
+		libxmp_free(data);
+		return -1;
+	}
+
+	smp = &ogg->smp[ogg->num++];
+	smp->data = data;
+	smp->len = len;
+	smp->sid = sid;
+	smp->is16 = is16;
+	smp->pcm = NULL;
+	smp->num = 0;
+
+	return 0;
+}
+
+/* Worker job, must only touch its own sample */
+static void decode_ogg_sample(void *data, int n)
+{
+	struct xm_ogg_sample *smp = (struct xm_ogg_sample *)data + n;
+	int16 *pcm16 = NULL;
+	int ch, i, num;
+
+	num = stb_vorbis_decode_memory(smp->data, smp->len, &ch, &pcm16);
+	libxmp_free(smp->data);
+	smp->data = NULL;
+
+	if (num <= 0) {
+		libxmp_free(pcm16);
+		return;
+	}
+
+	if (!smp->is16) {
+		int8 *pcm8 = (int8 *)pcm16;
+		for (i = 0; i < num; i++) {
+			pcm8[i] = pcm16[i] >> 8;
+		}
+	}
+
+	smp->pcm = pcm16;
+	smp->num = num;
+}
+
+static int load_ogg_samples(struct module_data *m, struct xm_ogg_list *ogg)
+{
+	struct xmp_module *mod = &m->mod;
+	int i, flags;
+
+	D_(D_INFO "Ogg samples: %d", ogg->num);
+
+	libxmp_run_jobs(decode_ogg_sample, ogg->smp, ogg->num);
+
+	/* Decoded data is in host byte order */
+	flags = SAMPLE_FLAG_NOLOAD;
+#ifdef WORDS_BIGENDIAN
+	flags |= SAMPLE_FLAG_BIGEND;
+#endif
+
+	for (i = 0; i < ogg->num; i++) {
+		struct xm_ogg_sample *smp = &ogg->smp[i];
+		struct xmp_sample *xxs = &mod->xxs[smp->sid];
+
+		if (smp->pcm == NULL) {
+			D_(D_CRIT "can't decode Ogg sample %d", smp->sid);
+			return -1;
+		}
+
+		xxs->len = smp->num;
+		if (libxmp_load_sample(m, NULL, flags, xxs, smp->pcm) < 0) {
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+static void release_ogg_samples(struct xm_ogg_list *ogg)
+{
+	int i;
+
+	for (i = 0; i < ogg->num; i++) {
+		libxmp_free(ogg->smp[i].data);
+		libxmp_free(ogg->smp[i].pcm);
+	}
+	libxmp_free(ogg->smp);
+}
+
+#endif
+
 static int load_patterns(struct module_data *m, int version, HIO_HANDLE *f)
 {
 	struct xmp_module *mod = &m->mod;
@@ -348,7 +499,8 @@ err:
  * for more details. */
 #define XM_MAX_SAMPLES_PER_INST 32
 
-static int load_instruments(struct module_data *m, int version, HIO_HANDLE *f)
+static int load_instruments(struct module_data *m, int version, HIO_HANDLE *f,
+			    struct xm_ogg_list *ogg)
 {
 	struct xmp_module *mod = &m->mod;
 	struct xm_instrument_header xih;
@@ -606,6 +758,18 @@ static int load_instruments(struct module_data *m, int version, HIO_HANDLE *f)
 
 			if (version > 0x0103) {
 			        D_(D_INFO "  read sample: index:%d sample id:%d", j, sub->sid);
+#ifdef XM_OGG_SAMPLES
+				if (~m->smpctl & XMP_SMPCTL_SKIP &&
+				    is_ogg_sample(f, xsh[j].length)) {
+					D_(D_INFO "  sample is ogg");
+					if (add_ogg_sample(ogg, f, xsh[j].length, sub->sid,
+						xsh[j].type & XM_SAMPLE_16BIT) < 0) {
+						return -1;
+					}
+					total_sample_size += xsh[j].length;
+					continue;
+				}
+#endif
 				if (libxmp_load_sample(m, f, flags, &mod->xxs[sub->sid], NULL) < 0) {
 					return -1;
 				}
@@ -639,12 +803,15 @@ static int xm_load(struct module_data *m, HIO_HANDLE * f, const int start)
 	struct xmp_module *mod = &m->mod;
 	int i, j;
 	struct xm_file_header xfh;
+	struct xm_ogg_list ogg;
 	char tracker_name[21];
 	int len;
 	uint8 buf[80];
 
 	LOAD_INIT();
 
+	memset(&ogg, 0, sizeof(struct xm_ogg_list));
+
 	if (hio_read(buf, 80, 1, f) != 1) {
 		D_(D_CRIT "error reading header");
 		return -1;
@@ -760,21 +927,30 @@ static int xm_load(struct module_data *m, HIO_HANDLE * f, const int start)
 
 	/* XM 1.02/1.03 has a different patterns and instruments order */
 	if (xfh.version <= 0x0103) {
-		if (load_instruments(m, xfh.version, f) < 0) {
-			return -1;
+		if (load_instruments(m, xfh.version, f, &ogg) < 0) {
+			goto err;
 		}
 		if (load_patterns(m, xfh.version, f) < 0) {
-			return -1;
+			goto err;
 		}
 	} else {
 		if (load_patterns(m, xfh.version, f) < 0) {
-			return -1;
+			goto err;
 		}
-		if (load_instruments(m, xfh.version, f) < 0) {
-			return -1;
+		if (load_instruments(m, xfh.version, f, &ogg) < 0) {
+			goto err;
 		}
 	}
 
+#ifdef XM_OGG_SAMPLES
+	if (ogg.num > 0) {
+		if (load_ogg_samples(m, &ogg) < 0) {
+			goto err;
+		}
+		release_ogg_samples(&ogg);
+	}
+#endif
+
 	D_(D_INFO "Stored samples: %d", mod->smp);
 
 	/* XM 1.02 stores all samples after the patterns */
@@ -797,4 +973,10 @@ static int xm_load(struct module_data *m, HIO_HANDLE * f, const int start)
 	m->read_event_type = READ_EVENT_FT2;
 
 	return 0;
+
+err:
+#ifdef XM_OGG_SAMPLES
+	release_ogg_samples(&ogg);
+#endif
+	return -1;
 }
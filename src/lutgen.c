@@ -4,6 +4,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <stdint.h>
+#include <string.h>
 #include <math.h>
 
 /* Lifted from Schism Tracker, array interleaving changed */
@@ -286,8 +287,72 @@ for(int j = 0; j < 4; j++) { \
 }
 
 
+/* pitch table doc,
+ *
+ *  pitch_table[i] = 2^(-i / (12 * PITCH_STEPS)) for one octave. The player
+ *  scales it by the octave with ldexp() and corrects for the fractional
+ *  step with a short power series, which keeps results within a few ulps
+ *  of the pow() based formula.
+ *
+ *  log2_table[i] = log2(1 + i / LOG2_LUTLEN) for mantissas in [1, 2), used
+ *  with a power series for log2(1 + e) to convert period ratios back to
+ *  pitchbend values.
+ */
+
+// steps per semitone in the pitch table (same as finetune resolution)
+#define PITCH_STEPS         128
+#define PITCH_LUTLEN        (12 * PITCH_STEPS)
+
+// log2(number) of mantissa steps in the log2 table
+#define LOG2_FRACBITS       10
+#define LOG2_LUTLEN         (1L << LOG2_FRACBITS)
+
+
+double pitch_table[PITCH_LUTLEN];
+double log2_table[LOG2_LUTLEN];
+
+void pitch_init(void)
+{
+    int i;
+
+    for (i = 0; i < PITCH_LUTLEN; i++) {
+        pitch_table[i] = pow(2.0, -(double) i / PITCH_LUTLEN);
+    }
+
+    for (i = 0; i < LOG2_LUTLEN; i++) {
+        log2_table[i] = log(1.0 + (double) i / LOG2_LUTLEN) / log(2.0);
+    }
+}
+
+
+#define LOOPD(x, y) \
+    printf("static const double %s[%lu] = {\n\t", #x, y); \
+    \
+    for (int i = 0; i < y; i++) { \
+        if (i && !(i % 4)) { \
+            printf("\n\t"); \
+        } \
+        printf(" %.17g,", x[i]); \
+    } \
+    \
+    printf("\n};\n\n");
+
+
 int main(int argc, char **argv)
 {
+    if (argc > 1 && !strcmp(argv[1], "pitch")) {
+        pitch_init();
+
+        printf("#define PITCH_STEPS\t%d\n", PITCH_STEPS);
+        printf("#define PITCH_LUTLEN\t%d\n", PITCH_LUTLEN);
+        printf("#define LOG2_FRACBITS\t%d\n\n", LOG2_FRACBITS);
+
+        LOOPD(pitch_table, (unsigned long)PITCH_LUTLEN);
+        LOOPD(log2_table, (unsigned long)LOG2_LUTLEN);
+
+        return 0;
+    }
+
     cubic_spline_init();
     windowed_fir_init();
 
@@ -93,7 +93,7 @@ MFILE *mopen(const void *ptr, long size)
 {
 	MFILE *m;
 
-	m = (MFILE *)malloc(sizeof (MFILE));
+	m = (MFILE *)libxmp_malloc(sizeof (MFILE));
 	if (m == NULL)
 		return NULL;
 
@@ -106,7 +106,7 @@ MFILE *mopen(const void *ptr, long size)
 
 int mclose(MFILE *m)
 {
-	free(m);
+	libxmp_free(m);
 	return 0;
 }
 
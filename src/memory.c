@@ -0,0 +1,44 @@
+/* Extended Module Player
+ * Copyright (C) 1996-2021 Claudio Matsuoka and Hipolito Carraro Jr
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/* Memory footprint of a context. Every block allocated by libxmp is
+ * charged to the context and class that requested it (see alloc.c), so
+ * the sizes include block headers but not samples held in the shared
+ * sample store.
+ */
+
+#include "common.h"
+
+int xmp_get_memory_info(xmp_context opaque, struct xmp_memory_info *info)
+{
+	struct context_data *ctx = (struct context_data *)opaque;
+
+	info->context = sizeof(struct context_data) +
+					ctx->mem[ALLOC_CONTEXT].used;
+	info->module = ctx->mem[ALLOC_MODULE].used;
+	info->player = ctx->mem[ALLOC_PLAYER].used;
+	info->smix = ctx->mem[ALLOC_SMIX].used;
+	info->total = info->context + info->module + info->player +
+				info->smix;
+
+	return 0;
+}
@@ -20,6 +20,7 @@
  * THE SOFTWARE.
  */
 
+#include <math.h>
 #include "common.h"
 #include "virtual.h"
 #include "mixer.h"
@@ -149,8 +150,8 @@
 #define VAR_NORM(x) \
     register int smp_in; \
     x *sptr = vi->sptr; \
-    unsigned int pos = vi->pos; \
-    int frac = (1 << SMIX_SHIFT) * (vi->pos - (int)vi->pos)
+    int pos = floor(vi->pos); \
+    int frac = (1 << SMIX_SHIFT) * (vi->pos - pos)
 
 #define VAR_LINEAR_MONO(x) \
     VAR_NORM(x); \
@@ -15,22 +15,36 @@ void libxmp_paula_init(struct context_data *ctx, struct paula_state *paula)
 	struct mixer_data *s = &ctx->s;
 
 	paula->global_output_level = 0;
-	paula->active_bleps = 0;
-	paula->fdiv = (double)PAULA_HZ / s->freq;
-	paula->remainder = paula->fdiv;
+	paula->clock = 0;
+	paula->first = paula->last = 0;
+	paula->freq = s->freq;
+	paula->remainder = PAULA_HZ;
+}
+
+/* drop bleps older than the BLEP table */
+static inline void expire_bleps(struct paula_state *paula)
+{
+	while (paula->first < paula->last &&
+	       paula->clock - paula->blep_clock[paula->first] >= BLEP_SIZE) {
+		paula->first++;
+	}
 }
 
 /* return output simulated as series of bleps */
 static int16 output_sample(struct paula_state *paula, int tabnum)
 {
-	int i;
+	const int *table = winsinc_integral[tabnum];
+	const int32 *level = paula->blep_level;
+	const uint32 *start = paula->blep_clock;
+	uint32 clock = paula->clock;
+	unsigned int i;
 	int32 output;
 
+	expire_bleps(paula);
+
 	output = paula->global_output_level << BLEP_SCALE;
-	for (i = 0; i < paula->active_bleps; i++) {
-		int age = paula->blepstate[i].age;
-		int level = paula->blepstate[i].level;
-		output -= winsinc_integral[tabnum][age] * level;
+	for (i = paula->first; i < paula->last; i++) {
+		output -= table[clock - start[i]] * level[i];
 	}
 	output >>= BLEP_SCALE;
 
@@ -46,38 +60,36 @@ static void input_sample(struct paula_state *paula, int16 sample)
 {
 	if (sample != paula->global_output_level) {
 		/* Start a new blep: level is the difference, age (or phase) is 0 clocks. */
-		if (paula->active_bleps > MAX_BLEPS - 1) {
+		expire_bleps(paula);
+
+		if (paula->last - paula->first > MAX_BLEPS - 1) {
 			fprintf(stderr, "warning: active blep list truncated!\n");
-			paula->active_bleps = MAX_BLEPS - 1;
+			paula->first = paula->last - (MAX_BLEPS - 1);
 		}
 
 		/* Make room for new blep */
-		memmove(&paula->blepstate[1], &paula->blepstate[0],
-			sizeof(struct blep_state) * paula->active_bleps);
+		if (paula->last >= BLEP_BUFFER_SIZE) {
+			unsigned int num = paula->last - paula->first;
+
+			memmove(paula->blep_level, paula->blep_level + paula->first,
+				sizeof(int32) * num);
+			memmove(paula->blep_clock, paula->blep_clock + paula->first,
+				sizeof(uint32) * num);
+			paula->first = 0;
+			paula->last = num;
+		}
 
 		/* Update state to account for the new blep */
-		paula->active_bleps++;
-		paula->blepstate[0].age = 0;
-		paula->blepstate[0].level = sample - paula->global_output_level;
+		paula->blep_level[paula->last] = sample - paula->global_output_level;
+		paula->blep_clock[paula->last] = paula->clock;
+		paula->last++;
 		paula->global_output_level = sample;
 	}
 }
 
-static void do_clock(struct paula_state *paula, int cycles)
+static inline void do_clock(struct paula_state *paula, int cycles)
 {
-	int i;
-
-	if (cycles <= 0) {
-		return;
-	}
-
-	for (i = 0; i < paula->active_bleps; i++) {
-		paula->blepstate[i].age += cycles;
-		if (paula->blepstate[i].age >= BLEP_SIZE) {
-			paula->active_bleps = i;
-			break;
-		}
-	}
+	paula->clock += cycles;
 }
 
 #define LOOP for (; count; count--)
@@ -89,25 +101,27 @@ static void do_clock(struct paula_state *paula, int cycles)
 } while (0)
 
 #define PAULA_SIMULATION(x) do { \
-	int num_in = vi->paula->remainder / MINIMUM_INTERVAL; \
+	int interval = MINIMUM_INTERVAL * paula->freq; \
+	int num_in = paula->remainder / interval; \
 	int ministep = step / num_in; \
-	int i; \
+	int cycles, i; \
 	\
 	/* input is always sampled at a higher rate than output */ \
 	for (i = 0; i < num_in - 1; i++) { \
-		input_sample(vi->paula, sptr[pos]); \
-		do_clock(vi->paula, MINIMUM_INTERVAL); \
+		input_sample(paula, sptr[pos]); \
+		do_clock(paula, MINIMUM_INTERVAL); \
 		UPDATE_POS(ministep); \
 	} \
-	input_sample(vi->paula, sptr[pos]); \
-	vi->paula->remainder -= num_in * MINIMUM_INTERVAL; \
+	input_sample(paula, sptr[pos]); \
+	paula->remainder -= num_in * interval; \
 	\
-	do_clock(vi->paula, (int)vi->paula->remainder); \
-	smp_in = output_sample(vi->paula, (x)); \
-	do_clock(vi->paula, MINIMUM_INTERVAL - (int)vi->paula->remainder); \
+	cycles = paula->remainder / paula->freq; \
+	do_clock(paula, cycles); \
+	smp_in = output_sample(paula, (x)); \
+	do_clock(paula, MINIMUM_INTERVAL - cycles); \
 	UPDATE_POS(step - (num_in - 1) * ministep); \
 	\
-	vi->paula->remainder += vi->paula->fdiv; \
+	paula->remainder += PAULA_HZ; \
 } while (0)
 
 #define MIX_MONO() do { \
@@ -127,6 +141,7 @@ static void do_clock(struct paula_state *paula, int cycles)
 
 #define VAR_PAULA(x) \
     VAR_NORM(x); \
+    struct paula_state *paula = vi->paula; \
     vl <<= 8; \
     vr <<= 8
 
@@ -26,6 +26,10 @@
 #include "mixer.h"
 #include "period.h"
 #include "player.h"	/* for set_sample_end() */
+#include "profile.h"
+#ifndef LIBXMP_CORE_PLAYER
+#include "synth.h"
+#endif
 
 #ifdef LIBXMP_PAULA_SIMULATOR
 #include "paula.h"
@@ -36,7 +40,7 @@
 #define FLAG_STEREO	0x02
 #define FLAG_FILTER	0x04
 #define FLAG_ACTIVE	0x10
-/* #define FLAG_SYNTH	0x20 */
+#define FLAG_SYNTH	0x20
 #define FIDX_FLAGMASK	(FLAG_16_BITS | FLAG_STEREO | FLAG_FILTER)
 
 #define DOWNMIX_SHIFT	 12
@@ -196,6 +200,26 @@ static void downmix_int_16bit(int16 *dest, int32 *src, int num, int amp, int off
 	}
 }
 
+/* Get the tick buffer a voice is mixed into */
+static int32 *voice_buffer(struct context_data *ctx, struct mixer_voice *vi)
+{
+	struct mixer_data *s = &ctx->s;
+	int stem;
+
+	if (s->undo) {
+		return s->undo32;
+	}
+
+	if (s->num_stems > 0 && vi->root >= 0 && vi->root < ctx->m.mod.chn) {
+		stem = s->stem_map[vi->root];
+		if (stem >= 0) {
+			return s->stem32 + stem * s->framesize;
+		}
+	}
+
+	return s->buf32;
+}
+
 static void anticlick(struct mixer_voice *vi)
 {
 	vi->flags |= ANTICLICK;
@@ -220,8 +244,10 @@ static void do_anticlick(struct context_data *ctx, int voc, int32 *buf, int coun
 		return;
 	}
 
+	PROFILE_COUNT(ctx, anticlick, 1);
+
 	if (buf == NULL) {
-		buf = s->buf32;
+		buf = voice_buffer(ctx, vi);
 		count = discharge;
 	} else if (count > discharge) {
 		count = discharge;
@@ -254,8 +280,14 @@ static void set_sample_end(struct context_data *ctx, int voc, int end)
 
 	xc = &p->xc_data[vi->chn];
 
+	/* Replaying a restarted voice, the note already ended */
+	if (ctx->s.undo) {
+		return;
+	}
+
 	if (end) {
 		SET_NOTE(NOTE_SAMPLE_END);
+		libxmp_smix_voice_end(ctx, vi->chn);
 		if (HAS_QUIRK(QUIRK_RSTCHN)) {
 			libxmp_virt_resetvoice(ctx, voc, 0);
 		}
@@ -264,9 +296,34 @@ static void set_sample_end(struct context_data *ctx, int voc, int end)
 	}
 }
 
-static void adjust_voice_end(struct mixer_voice *vi, struct xmp_sample *xxs)
+/* Set the sample position where the current run ends. Bidirectional
+ * loops are played backwards from the loop end down to the loop start.
+ */
+static void adjust_voice_end(struct context_data *ctx, struct mixer_voice *vi, struct xmp_sample *xxs)
 {
-	if (xxs->flg & XMP_SAMPLE_LOOP) {
+	struct player_data *p = &ctx->p;
+#ifndef LIBXMP_CORE_DISABLE_IT
+	struct module_data *m = &ctx->m;
+#endif
+
+	if (vi->flags & VOICE_REVERSE) {
+		int lps = xxs->lps;
+
+		if (p->flags & XMP_FLAGS_FIXLOOP) {
+			lps >>= 1;
+		}
+
+		vi->end = lps - 1;
+
+#ifndef LIBXMP_CORE_DISABLE_IT
+		/* OpenMPT Bidi-Loops.it: "In Impulse Tracker’s software mixer,
+		 * ping-pong loops are shortened by one sample.
+		 */
+		if (IS_PLAYER_MODE_IT()) {
+			vi->end++;
+		}
+#endif
+	} else if (xxs->flg & XMP_SAMPLE_LOOP) {
 		if ((xxs->flg & XMP_SAMPLE_LOOP_FULL) && (~vi->flags & SAMPLE_LOOP)) {
 			vi->end = xxs->len;
 		} else {
@@ -284,25 +341,31 @@ static void loop_reposition(struct context_data *ctx, struct mixer_voice *vi, st
 #endif
 	int loop_size = xxs->lpe - xxs->lps;
 
-	/* Reposition for next loop */
-	vi->pos -= loop_size;		/* forward loop */
-	vi->end = xxs->lpe;
 	vi->flags |= SAMPLE_LOOP;
 
-	if (xxs->flg & XMP_SAMPLE_LOOP_BIDIR) {
-		vi->end += loop_size;	/* unrolled loop */
-		vi->pos -= loop_size;	/* forward loop */
+	if (~xxs->flg & XMP_SAMPLE_LOOP_BIDIR) {
+		/* Reposition for next loop */
+		vi->pos -= loop_size;
+		vi->end = xxs->lpe;
+		return;
+	}
+
+	/* Bounce at the loop boundary and reverse direction */
+	if (vi->flags & VOICE_REVERSE) {
+		vi->pos = 2 * xxs->lps - 1 - vi->pos;
+		vi->flags &= ~VOICE_REVERSE;
 
 #ifndef LIBXMP_CORE_DISABLE_IT
-		/* OpenMPT Bidi-Loops.it: "In Impulse Tracker’s software mixer,
-		 * ping-pong loops are shortened by one sample. 
-		 */
-		if (IS_PLAYER_MODE_IT()) {
-			vi->end--;
+		if (IS_PLAYER_MODE_IT()) {	/* see adjust_voice_end() */
 			vi->pos++;
 		}
 #endif
+	} else {
+		vi->pos = 2 * xxs->lpe - 1 - vi->pos;
+		vi->flags |= VOICE_REVERSE;
 	}
+
+	adjust_voice_end(ctx, vi, xxs);
 }
 
 
@@ -312,37 +375,38 @@ void libxmp_mixer_prepare(struct context_data *ctx)
 	struct player_data *p = &ctx->p;
 	struct module_data *m = &ctx->m;
 	struct mixer_data *s = &ctx->s;
-	int bytelen;
+	int bytelen, i;
 
 	s->ticksize = s->freq * m->time_factor * m->rrate / p->bpm / 1000;
 
+	/* Never overrun the tick buffers */
+	if (~s->format & XMP_FORMAT_MONO) {
+		if (s->ticksize > s->framesize / 2) {
+			s->ticksize = s->framesize / 2;
+		}
+	} else if (s->ticksize > s->framesize) {
+		s->ticksize = s->framesize;
+	}
+
 	bytelen = s->ticksize * sizeof(int);
 	if (~s->format & XMP_FORMAT_MONO) {
 		bytelen *= 2;
 	}
 	memset(s->buf32, 0, bytelen);
+
+	for (i = 0; i < s->num_stems; i++) {
+		memset(s->stem32 + i * s->framesize, 0, bytelen);
+	}
 }
-/* Fill the output buffer calling one of the handlers. The buffer contains
- * sound for one tick (a PAL frame or 1/50s for standard vblank-timed mods)
- */
-void libxmp_mixer_softmixer(struct context_data *ctx)
+static MIX_FP *get_mixerset(struct context_data *ctx, int interp)
 {
+#ifdef LIBXMP_PAULA_SIMULATOR
 	struct player_data *p = &ctx->p;
-	struct mixer_data *s = &ctx->s;
 	struct module_data *m = &ctx->m;
-	struct xmp_module *mod = &m->mod;
-	struct xmp_sample *xxs;
-	struct mixer_voice *vi;
-	double step;
-	int samples, size;
-	int vol_l, vol_r, voc, usmp;
-	int prev_l, prev_r = 0;
-	int lps, lpe;
-	int32 *buf_pos;
-	MIX_FP  mix_fn;
+#endif
 	MIX_FP *mixerset;
 
-	switch (s->interp) {
+	switch (interp) {
 	case XMP_INTERP_NEAREST:
 		mixerset = nearest_mixers;
 		break;
@@ -368,224 +432,631 @@ void libxmp_mixer_softmixer(struct context_data *ctx)
 	}
 #endif
 
-	libxmp_mixer_prepare(ctx);
+	return mixerset;
+}
 
-	for (voc = 0; voc < p->virt.maxvoc; voc++) {
-		int c5spd, rampsize, delta_l, delta_r;
+/* Under the CPU budget, each quality reduction level steps background
+ * voices down one interpolation type before the channel voices.
+ */
+static MIX_FP *voice_mixerset(struct context_data *ctx, struct mixer_voice *vi,
+			      MIX_FP *mixerset)
+{
+	struct player_data *p = &ctx->p;
+	struct mixer_data *s = &ctx->s;
+	int interp;
 
-		vi = &p->virt.voice_array[voc];
+	if (s->quality == 0) {
+		return mixerset;
+	}
 
-		if (vi->flags & ANTICLICK) {
-			if (s->interp > XMP_INTERP_NEAREST) {
-				do_anticlick(ctx, voc, NULL, 0);
-			}
-			vi->flags &= ~ANTICLICK;
-		}
+	interp = s->interp - (s->quality + (vi->chn >= p->virt.num_tracks)) / 2;
+	if (interp < XMP_INTERP_NEAREST) {
+		interp = XMP_INTERP_NEAREST;
+	}
 
-		if (vi->chn < 0) {
-			continue;
-		}
+	return get_mixerset(ctx, interp);
+}
 
-		if (vi->period < 1) {
-			libxmp_virt_resetvoice(ctx, voc, 1);
-			continue;
-		}
+/* Mix a voice into the tick buffer, starting at the given sample offset */
+static void mix_voice(struct context_data *ctx, int voc, MIX_FP *mixerset, int offset)
+{
+	struct player_data *p = &ctx->p;
+	struct mixer_data *s = &ctx->s;
+	struct module_data *m = &ctx->m;
+	struct xmp_module *mod = &m->mod;
+	struct mixer_voice *vi = &p->virt.voice_array[voc];
+	struct xmp_sample *xxs;
+	double step;
+	int samples, size;
+	int vol_l, vol_r, usmp;
+	int prev_l, prev_r = 0;
+	int c5spd, rampsize, delta_l, delta_r;
+	int32 *buf_pos;
+	MIX_FP  mix_fn;
 
-		vi->pos0 = vi->pos;
+	if (vi->chn < 0) {
+		return;
+	}
 
-		buf_pos = s->buf32;
-		if (vi->pan == PAN_SURROUND) {
-			vol_r = vi->vol * 0x80;
-			vol_l = -vi->vol * 0x80;
-		} else {
-			vol_r = vi->vol * (0x80 - vi->pan);
-			vol_l = vi->vol * (0x80 + vi->pan);
+	if (vi->period < 1) {
+		if (s->undo) {
+			return;
 		}
+		libxmp_virt_resetvoice(ctx, voc, 1);
+		PROFILE_COUNT(ctx, voices_skipped, 1);
+		return;
+	}
 
-		if (vi->smp < mod->smp) {
-			xxs = &mod->xxs[vi->smp];
-			c5spd = m->xtra[vi->smp].c5spd;
-		} else {
-			xxs = &ctx->smix.xxs[vi->smp - mod->smp];
-			c5spd = m->c4rate;
-		}
+	vi->pos0 = vi->pos;
 
-		step = C4_PERIOD * c5spd / s->freq / vi->period;
+	buf_pos = voice_buffer(ctx, vi);
+	if (~s->format & XMP_FORMAT_MONO) {
+		buf_pos += offset * 2;
+	} else {
+		buf_pos += offset;
+	}
+	if (vi->pan == PAN_SURROUND) {
+		vol_r = vi->vol * 0x80;
+		vol_l = -vi->vol * 0x80;
+	} else {
+		vol_r = vi->vol * (0x80 - vi->pan);
+		vol_l = vi->vol * (0x80 + vi->pan);
+	}
 
-		if (step < 0.001) {	/* otherwise m5v-nwlf.it crashes */
-			continue;
-		}
+	if (vi->smp < mod->smp) {
+		xxs = &mod->xxs[vi->smp];
+		c5spd = m->xtra[vi->smp].c5spd;
+	} else {
+		xxs = &ctx->smix.xxs[vi->smp - mod->smp];
+		c5spd = ctx->smix.xtra[vi->smp - mod->smp].rate;
+	}
+
+	step = C4_PERIOD * c5spd / s->freq / vi->period;
+
+	if (step < 0.001) {	/* otherwise m5v-nwlf.it crashes */
+		PROFILE_COUNT(ctx, voices_skipped, 1);
+		return;
+	}
 
 #ifndef LIBXMP_CORE_DISABLE_IT
-		if (xxs->flg & XMP_SAMPLE_SLOOP && vi->smp < mod->smp) {
-			if (~vi->flags & VOICE_RELEASE) {
-				if (vi->pos < m->xsmp[vi->smp].lpe) {
-					xxs = &m->xsmp[vi->smp];
-				}
+	if (xxs->flg & XMP_SAMPLE_SLOOP && vi->smp < mod->smp) {
+		if (~vi->flags & VOICE_RELEASE) {
+			if (vi->pos < m->xsmp[vi->smp].lpe) {
+				xxs = &m->xsmp[vi->smp];
 			}
 		}
-
-		adjust_voice_end(vi, xxs);
+	}
 #endif
 
-		lps = xxs->lps;
-		lpe = xxs->lpe;
+	if (~xxs->flg & XMP_SAMPLE_LOOP_BIDIR) {
+		vi->flags &= ~VOICE_REVERSE;
+	}
 
-		if (p->flags & XMP_FLAGS_FIXLOOP) {
-			lps >>= 1;
-		}
+	adjust_voice_end(ctx, vi, xxs);
 
-		if (xxs->flg & XMP_SAMPLE_LOOP_BIDIR) {
-			vi->end += lpe - lps;
+	rampsize = s->ticksize >> ANTICLICK_SHIFT;
+	delta_l = (vol_l - vi->old_vl) / rampsize;
+	delta_r = (vol_r - vi->old_vr) / rampsize;
 
-#ifndef LIBXMP_CORE_DISABLE_IT
-			if (IS_PLAYER_MODE_IT()) {
-				vi->end--;
-			}
-#endif
-		}
+	if (vi->vol) {
+		PROFILE_COUNT(ctx, voices_mixed, 1);
+	} else {
+		PROFILE_COUNT(ctx, voices_skipped, 1);
+	}
 
-		rampsize = s->ticksize >> ANTICLICK_SHIFT;
-		delta_l = (vol_l - vi->old_vl) / rampsize;
-		delta_r = (vol_r - vi->old_vr) / rampsize;
+	usmp = 0;
+	for (size = s->ticksize - offset; size > 0; ) {
+		int reverse = vi->flags & VOICE_REVERSE;
+		int split_noloop = 0;
 
-		usmp = 0;
-		for (size = s->ticksize; size > 0; ) {
-			int split_noloop = 0;
+		if (p->xc_data[vi->chn].split) {
+			split_noloop = 1;
+		}
 
-			if (p->xc_data[vi->chn].split) {
-				split_noloop = 1;
+		/* How many samples we can write before the loop break
+		 * or sample end... */
+		if (reverse ? vi->pos <= vi->end : vi->pos >= vi->end) {
+			samples = 0;
+			usmp = 1;
+		} else {
+			double dist = reverse ? vi->pos - vi->end :
+					(double)vi->end - vi->pos;
+			int s = ceil(dist / step);
+			/* ...inside the tick boundaries */
+			if (s > size) {
+				s = size;
 			}
 
-			/* How many samples we can write before the loop break
-			 * or sample end... */
-			if (vi->pos >= vi->end) {
-				samples = 0;
-				usmp = 1;
-			} else {
-				int s = ceil(((double)vi->end - vi->pos) / step);
-				/* ...inside the tick boundaries */
-				if (s > size) {
-					s = size;
-				}
-
-				samples = s;
-				if (samples > 0) {
-					usmp = 0;
-				}
+			samples = s;
+			if (samples > 0) {
+				usmp = 0;
 			}
+		}
 
-			if (vi->vol) {
-				int mix_size = samples;
-				int mixer_id = vi->fidx & FIDX_FLAGMASK;
+		if (vi->vol) {
+			int mix_size = samples;
+			int mixer_id = vi->fidx & FIDX_FLAGMASK;
 
-				if (~s->format & XMP_FORMAT_MONO) {
-					mix_size *= 2;
-				}
+			if (~s->format & XMP_FORMAT_MONO) {
+				mix_size *= 2;
+			}
 
-				/* For Hipolito's anticlick routine */
-				if (samples > 0) {
-					if (~s->format & XMP_FORMAT_MONO) {
-						prev_r = buf_pos[mix_size - 2];
-					}
-					prev_l = buf_pos[mix_size - 1];
-				} else {
-					prev_r = prev_l = 0;
+			/* For Hipolito's anticlick routine */
+			if (samples > 0) {
+				if (~s->format & XMP_FORMAT_MONO) {
+					prev_r = buf_pos[mix_size - 2];
 				}
+				prev_l = buf_pos[mix_size - 1];
+			} else {
+				prev_r = prev_l = 0;
+			}
 
 #ifndef LIBXMP_CORE_DISABLE_IT
-				/* See OpenMPT env-flt-max.it */
-				if (vi->filter.cutoff >= 0xfe &&
+			/* See OpenMPT env-flt-max.it */
+			if (vi->filter.cutoff >= 0xfe &&
                                     vi->filter.resonance == 0) {
-					mixer_id &= ~FLAG_FILTER;
-				}
+				mixer_id &= ~FLAG_FILTER;
+			}
 #endif
 
-				mix_fn = mixerset[mixer_id];
+			mix_fn = mixerset[mixer_id];
 
-				/* Call the output handler */
-				if (samples > 0 && vi->sptr != NULL) {
-					int rsize = 0;
+			/* Nothing to interpolate at the output rate */
+			if (step == 1.0 && vi->pos == floor(vi->pos) &&
+			    (~mixer_id & FLAG_FILTER) &&
+			    (mixerset == linear_mixers ||
+			     mixerset == spline_mixers)) {
+				mix_fn = nearest_mixers[mixer_id];
+			}
 
-					if (rampsize > samples) {
-						rampsize -= samples;
-					} else {
-						rsize = samples - rampsize;
-						rampsize = 0;
-					}
+			/* Call the output handler */
+			if (samples > 0 && vi->sptr != NULL) {
+				int mix_step = step * (1 << SMIX_SHIFT);
+				int rsize = 0;
 
-					if (delta_l == 0 && delta_r == 0) {
-						/* no need to ramp */
-						rsize = samples;
-					}
+				if (reverse) {
+					mix_step = -mix_step;
+				}
 
-					if (mix_fn != NULL) {
-						mix_fn(vi, buf_pos, samples,
-							vol_l >> 8, vol_r >> 8, step * (1 << SMIX_SHIFT), rsize, delta_l, delta_r);
-					}
+				if (rampsize > samples) {
+					rampsize -= samples;
+				} else {
+					rsize = samples - rampsize;
+					rampsize = 0;
+				}
+
+				if (delta_l == 0 && delta_r == 0) {
+					/* no need to ramp */
+					rsize = samples;
+				}
 
-					buf_pos += mix_size;
-					vi->old_vl += samples * delta_l;
-					vi->old_vr += samples * delta_r;
+				if (mix_fn != NULL) {
+					mix_fn(vi, buf_pos, samples,
+						vol_l >> 8, vol_r >> 8, mix_step, rsize, delta_l, delta_r);
+					PROFILE_COUNT(ctx, samples, samples);
+				}
 
+				buf_pos += mix_size;
+				vi->old_vl += samples * delta_l;
+				vi->old_vr += samples * delta_r;
 
-					/* For Hipolito's anticlick routine */
-					if (~s->format & XMP_FORMAT_MONO) {
-						vi->sright = buf_pos[-2] - prev_r;
-					}
-					vi->sleft = buf_pos[-1] - prev_l;
+
+				/* For Hipolito's anticlick routine */
+				if (~s->format & XMP_FORMAT_MONO) {
+					vi->sright = buf_pos[-2] - prev_r;
 				}
+				vi->sleft = buf_pos[-1] - prev_l;
 			}
+		}
 
+		if (reverse) {
+			vi->pos -= step * samples;
+		} else {
 			vi->pos += step * samples;
+		}
 
-			/* No more samples in this tick */
-			size -= samples + usmp;
-			if (size <= 0) {
-				if (xxs->flg & XMP_SAMPLE_LOOP) {
-					if (vi->pos + step > vi->end) {
-						vi->pos += step;
+		/* No more samples in this tick */
+		size -= samples + usmp;
+		if (size <= 0) {
+			if (xxs->flg & XMP_SAMPLE_LOOP) {
+				if (reverse) {
+					if (vi->pos - step < vi->end) {
+						vi->pos -= step;
+						loop_reposition(ctx, vi, xxs);
+					}
+				} else if (xxs->flg & XMP_SAMPLE_LOOP_BIDIR) {
+					/* Turn around at the loop end */
+					if (vi->pos >= vi->end) {
 						loop_reposition(ctx, vi, xxs);
 					}
+				} else if (vi->pos + step > vi->end) {
+					vi->pos += step;
+					loop_reposition(ctx, vi, xxs);
 				}
-				continue;
-			}
-
-			/* First sample loop run */
-			if ((~xxs->flg & XMP_SAMPLE_LOOP) || split_noloop) {
-				do_anticlick(ctx, voc, buf_pos, size);
-				set_sample_end(ctx, voc, 1);
-				size = 0;
-				continue;
 			}
+			continue;
+		}
 
-			loop_reposition(ctx, vi, xxs);
+		/* First sample loop run */
+		if ((~xxs->flg & XMP_SAMPLE_LOOP) || split_noloop) {
+			do_anticlick(ctx, voc, buf_pos, size);
+			set_sample_end(ctx, voc, 1);
+			size = 0;
+			continue;
 		}
 
-		vi->old_vl = vol_l;
-		vi->old_vr = vol_r;
+		loop_reposition(ctx, vi, xxs);
 	}
 
-	/* Render final frame */
+	vi->old_vl = vol_l;
+	vi->old_vr = vol_r;
+}
+
+/* Convert a tick buffer to the output format from the given offset */
+static void downmix_buffer(struct context_data *ctx, char *dest, int32 *src, int offset)
+{
+	struct mixer_data *s = &ctx->s;
+	int size;
 
 	size = s->ticksize;
 	if (~s->format & XMP_FORMAT_MONO) {
 		size *= 2;
+		offset *= 2;
+	}
+
+	if (size > s->framesize) {
+		size = s->framesize;
 	}
 
-	if (size > XMP_MAX_FRAMESIZE) {
-		size = XMP_MAX_FRAMESIZE;
+	if (offset >= size) {
+		return;
 	}
 
 	if (s->format & XMP_FORMAT_8BIT) {
-		downmix_int_8bit(s->buffer, s->buf32, size, s->amplify,
+		downmix_int_8bit(dest + offset, src + offset,
+				size - offset, s->amplify,
 				s->format & XMP_FORMAT_UNSIGNED ? 0x80 : 0);
 	} else {
-		downmix_int_16bit((int16 *)s->buffer, s->buf32, size,s->amplify,
+		downmix_int_16bit((int16 *)dest + offset, src + offset,
+				size - offset, s->amplify,
 				s->format & XMP_FORMAT_UNSIGNED ? 0x8000 : 0);
 	}
+}
+
+/* Render the output buffer and the stem buffers from the given offset */
+static void downmix(struct context_data *ctx, int offset)
+{
+	struct mixer_data *s = &ctx->s;
+	int32 *src;
+	int i, j, start, size;
+
+	if (s->num_stems == 0) {
+		downmix_buffer(ctx, s->buffer, s->buf32, offset);
+		return;
+	}
+
+	for (i = 0; i < s->num_stems; i++) {
+		downmix_buffer(ctx, s->stem_buffer + i * s->framesize * 2,
+				s->stem32 + i * s->framesize, offset);
+	}
+
+	if (s->stem_flags & XMP_STEMS_NOMIX) {
+		return;
+	}
+
+	/* Voices not assigned to a stem are already in buf32 */
+	size = s->ticksize;
+	start = offset;
+	if (~s->format & XMP_FORMAT_MONO) {
+		size *= 2;
+		start *= 2;
+	}
+	if (size > s->framesize) {
+		size = s->framesize;
+	}
+
+	memcpy(s->mix32 + start, s->buf32 + start,
+				(size - start) * sizeof(int32));
+	for (i = 0; i < s->num_stems; i++) {
+		src = s->stem32 + i * s->framesize;
+		for (j = start; j < size; j++) {
+			s->mix32[j] += src[j];
+		}
+	}
+
+	downmix_buffer(ctx, s->buffer, s->mix32, offset);
+}
+
+#ifndef LIBXMP_CORE_PLAYER
+
+/* Pass the state of each synth voice to the synth driver and render
+ * them all into the tick buffer in one block.
+ */
+static void mix_synth(struct context_data *ctx)
+{
+	struct player_data *p = &ctx->p;
+	struct mixer_data *s = &ctx->s;
+	struct module_data *m = &ctx->m;
+	const struct synth_info *synth = m->synth;
+	int voc;
+
+	for (voc = 0; voc < p->virt.maxvoc; voc++) {
+		struct mixer_voice *vi = &p->virt.voice_array[voc];
+		double rate;
+
+		if (~vi->fidx & FLAG_SYNTH || vi->chn < 0 || vi->period < 1) {
+			continue;
+		}
+
+		rate = C4_PERIOD * m->xtra[vi->smp].c5spd / vi->period;
+		synth->setvoice(ctx, voc, rate, vi->vol,
+					vi->flags & VOICE_RELEASE);
+	}
+
+	synth->mixer(ctx, s->buf32, s->ticksize, ~s->format & XMP_FORMAT_MONO);
+}
+
+#endif
+
+#define MAX_QUALITY_LEVEL	(XMP_INTERP_SPLINE * 2)
+#define QUALITY_HOLD_TICKS	8
+
+/* Compare the mixer cost of the last tick with the CPU budget. Under
+ * pressure, cull the quietest background voice, or if there are none,
+ * reduce the interpolation quality. Quality is restored when the load
+ * drops well below the budget.
+ */
+static void adapt_quality(struct context_data *ctx, double time)
+{
+	struct mixer_data *s = &ctx->s;
+	double load;
+
+	/* Mixer time in microseconds per second of output */
+	load = time / 1000 * s->freq / s->ticksize;
+	s->cpu_load += (load - s->cpu_load) / 4;
+
+	if (s->quality_hold > 0) {
+		s->quality_hold--;
+	}
+
+	if (s->cpu_load > s->cpu_budget) {
+		if (libxmp_virt_cull(ctx) >= 0) {
+			s->culled++;
+		} else if (s->quality_hold == 0 &&
+			   s->quality < MAX_QUALITY_LEVEL) {
+			s->quality++;
+			s->quality_hold = QUALITY_HOLD_TICKS;
+		}
+	} else if (s->cpu_load < s->cpu_budget * 0.75) {
+		if (s->quality_hold == 0 && s->quality > 0) {
+			s->quality--;
+			s->quality_hold = QUALITY_HOLD_TICKS;
+		}
+	}
+}
+
+#ifdef LIBXMP_PAULA_SIMULATOR
+static int uses_paula(struct context_data *ctx, struct mixer_voice *vi)
+{
+	return ctx->s.tick_paula != NULL && vi->paula != NULL &&
+				(ctx->p.flags & XMP_FLAGS_A500);
+}
+#endif
+
+/* Keep the state of a voice before it is mixed into the tick, so that
+ * its output can be taken out if the voice is restarted later in the
+ * same tick.
+ */
+static void save_tick_voice(struct context_data *ctx, int voc, int offset)
+{
+	struct player_data *p = &ctx->p;
+	struct mixer_data *s = &ctx->s;
+	struct mixer_voice *vi = &p->virt.voice_array[voc];
+
+	if (s->tick_voice == NULL) {
+		return;
+	}
+
+	memcpy(&s->tick_voice[voc], vi, sizeof(struct mixer_voice));
+	s->tick_offset[voc] = offset;
+
+#ifdef LIBXMP_PAULA_SIMULATOR
+	if (uses_paula(ctx, vi)) {
+		memcpy(&s->tick_paula[voc], vi->paula, sizeof(struct paula_state));
+	}
+#endif
+}
+
+/* Take out what the previous sound of a restarted voice played from the
+ * given offset to the end of the tick. The sound is mixed again from its
+ * saved state into a separate buffer and subtracted, then discharged
+ * from its last sample before the offset. Returns 0 if the previous
+ * sound is unknown.
+ */
+static int remove_voice_tail(struct context_data *ctx, int voc,
+			     MIX_FP *mixerset, int offset)
+{
+	struct player_data *p = &ctx->p;
+	struct mixer_data *s = &ctx->s;
+	struct mixer_voice *vi = &p->virt.voice_array[voc];
+	struct mixer_voice cur;
+	int32 *buf;
+	int i, ch, size, start;
+
+	if (s->tick_voice == NULL || s->tick_voice[voc].chn < 0 ||
+	    s->tick_voice[voc].fidx & FLAG_SYNTH) {
+		return 0;
+	}
+
+	ch = (s->format & XMP_FORMAT_MONO) ? 1 : 2;
+	size = s->ticksize * ch;
+	if (size > s->framesize) {
+		size = s->framesize;
+	}
+	start = s->tick_offset[voc];
+
+	memcpy(&cur, vi, sizeof(struct mixer_voice));
+	memcpy(vi, &s->tick_voice[voc], sizeof(struct mixer_voice));
+#ifdef LIBXMP_PAULA_SIMULATOR
+	if (uses_paula(ctx, vi)) {
+		/* The last slot keeps the state of the new sound */
+		struct paula_state *tmp = &s->tick_paula[p->virt.maxvoc];
+		memcpy(tmp, vi->paula, sizeof(struct paula_state));
+		memcpy(vi->paula, &s->tick_paula[voc], sizeof(struct paula_state));
+	}
+#endif
+
+	buf = voice_buffer(ctx, vi);
+
+	memset(s->undo32, 0, size * sizeof(int32));
+	s->undo = 1;
+	mix_voice(ctx, voc, voice_mixerset(ctx, vi, mixerset), start);
+	s->undo = 0;
+
+	for (i = offset * ch; i < size; i++) {
+		buf[i] -= s->undo32[i];
+	}
+
+	if (offset > start && s->interp > XMP_INTERP_NEAREST) {
+		if (ch == 2) {
+			vi->sright = s->undo32[offset * 2 - 2];
+		}
+		vi->sleft = s->undo32[offset * ch - 1];
+		do_anticlick(ctx, voc, buf + offset * ch, s->ticksize - offset);
+	}
+
+#ifdef LIBXMP_PAULA_SIMULATOR
+	if (uses_paula(ctx, vi)) {
+		memcpy(vi->paula, &s->tick_paula[p->virt.maxvoc],
+					sizeof(struct paula_state));
+	}
+#endif
+	memcpy(vi, &cur, sizeof(struct mixer_voice));
+
+	return 1;
+}
+
+/* Fill the output buffer calling one of the handlers. The buffer contains
+ * sound for one tick (a PAL frame or 1/50s for standard vblank-timed mods)
+ */
+void libxmp_mixer_softmixer(struct context_data *ctx)
+{
+	struct player_data *p = &ctx->p;
+	struct mixer_data *s = &ctx->s;
+	MIX_FP *mixerset;
+	double start = 0;
+	int voc;
+
+	if (s->cpu_budget > 0) {
+		start = libxmp_profile_time();
+	}
+
+	mixerset = get_mixerset(ctx, s->interp);
+
+	PROFILE_START(ctx, mix_time);
+
+	libxmp_mixer_prepare(ctx);
+
+	for (voc = 0; voc < p->virt.maxvoc; voc++) {
+		struct mixer_voice *vi = &p->virt.voice_array[voc];
+
+		if (vi->fidx & FLAG_SYNTH) {
+			vi->flags &= ~(ANTICLICK | VOICE_START);
+			save_tick_voice(ctx, voc, 0);
+			continue;
+		}
+
+		if (vi->flags & ANTICLICK) {
+			if (s->interp > XMP_INTERP_NEAREST) {
+				do_anticlick(ctx, voc, NULL, 0);
+			}
+			vi->flags &= ~ANTICLICK;
+		}
+
+		vi->flags &= ~VOICE_START;
+		save_tick_voice(ctx, voc, 0);
+		mix_voice(ctx, voc, voice_mixerset(ctx, vi, mixerset), 0);
+	}
+
+#ifndef LIBXMP_CORE_PLAYER
+	if (s->synth_chip != NULL) {
+		mix_synth(ctx);
+	}
+#endif
+
+	PROFILE_STOP(ctx, mix_time);
+
+	/* Render final frame */
+
+	PROFILE_START(ctx, downmix_time);
+	downmix(ctx, 0);
+	PROFILE_STOP(ctx, downmix_time);
 
 	s->dtright = s->dtleft = 0;
+
+	if (s->cpu_budget > 0) {
+		adapt_quality(ctx, libxmp_profile_time() - start);
+	}
+}
+
+/* Mix voices started after the current tick was rendered into the rest
+ * of the tick, from the given sample offset.
+ */
+void libxmp_mixer_split_tick(struct context_data *ctx, int offset)
+{
+	struct player_data *p = &ctx->p;
+	struct mixer_data *s = &ctx->s;
+	MIX_FP *mixerset;
+	int voc, mixed = 0;
+
+	if (offset < 0 || offset >= s->ticksize) {
+		return;
+	}
+
+	mixerset = get_mixerset(ctx, s->interp);
+
+	PROFILE_START(ctx, mix_time);
+
+	for (voc = 0; voc < p->virt.maxvoc; voc++) {
+		struct mixer_voice *vi = &p->virt.voice_array[voc];
+		int sleft, sright;
+
+		/* Synth voices start on the next tick */
+		if (~vi->flags & VOICE_START || vi->fidx & FLAG_SYNTH) {
+			continue;
+		}
+		vi->flags &= ~VOICE_START;
+
+		/* The previous sound was already mixed up to the end of the
+		 * tick. Take it out from the offset if we can, otherwise keep
+		 * its last output for the anticlick discharge.
+		 */
+		if (remove_voice_tail(ctx, voc, mixerset, offset)) {
+			save_tick_voice(ctx, voc, offset);
+			mix_voice(ctx, voc, voice_mixerset(ctx, vi, mixerset), offset);
+			vi->flags &= ~ANTICLICK;
+		} else {
+			sleft = vi->sleft;
+			sright = vi->sright;
+
+			save_tick_voice(ctx, voc, offset);
+			mix_voice(ctx, voc, voice_mixerset(ctx, vi, mixerset), offset);
+
+			if (vi->flags & ANTICLICK) {
+				vi->sleft = sleft;
+				vi->sright = sright;
+			}
+		}
+		mixed = 1;
+	}
+
+	PROFILE_STOP(ctx, mix_time);
+
+	if (mixed) {
+		PROFILE_START(ctx, downmix_time);
+		downmix(ctx, offset);
+		PROFILE_STOP(ctx, downmix_time);
+	}
 }
 
 void libxmp_mixer_voicepos(struct context_data *ctx, int voc, double pos, int ac)
@@ -594,7 +1065,6 @@ void libxmp_mixer_voicepos(struct context_data *ctx, int voc, double pos, int ac
 	struct module_data *m = &ctx->m;
 	struct mixer_voice *vi = &p->virt.voice_array[voc];
 	struct xmp_sample *xxs;
-	int lps;
 
 	if (vi->smp < m->mod.smp) {
  		xxs = &m->mod.xxs[vi->smp];
@@ -607,8 +1077,9 @@ void libxmp_mixer_voicepos(struct context_data *ctx, int voc, double pos, int ac
 	}
 
 	vi->pos = pos;
+	vi->flags &= ~VOICE_REVERSE;
 
-	adjust_voice_end(vi, xxs);
+	adjust_voice_end(ctx, vi, xxs);
 
 	if (vi->pos >= vi->end) {
 		if (xxs->flg & XMP_SAMPLE_LOOP) {
@@ -618,21 +1089,6 @@ void libxmp_mixer_voicepos(struct context_data *ctx, int voc, double pos, int ac
 		}
 	}
 
-	lps = xxs->lps;
-	if (p->flags & XMP_FLAGS_FIXLOOP) {
-		lps >>= 1;
-	}
-
-	if (xxs->flg & XMP_SAMPLE_LOOP_BIDIR) {
-		vi->end += (xxs->lpe - lps);
-
-#ifndef LIBXMP_CORE_DISABLE_IT
-		if (IS_PLAYER_MODE_IT()) {
-			vi->end--;
-		}
-#endif
-	}
-
 	if (ac) {
 		anticlick(vi);
 	}
@@ -650,19 +1106,13 @@ double libxmp_mixer_getvoicepos(struct context_data *ctx, int voc)
 		return 0;
 	}
 
-	if (xxs->flg & XMP_SAMPLE_LOOP_BIDIR) {
-		if (vi->pos >= xxs->lpe) {
-			return xxs->lpe - (vi->pos - xxs->lpe) - 1;
-		}
-	}
-
 	return vi->pos;
 }
 
 void libxmp_mixer_setpatch(struct context_data *ctx, int voc, int smp, int ac)
 {
 	struct player_data *p = &ctx->p;
-#ifndef LIBXMP_CORE_DISABLE_IT
+#if !defined(LIBXMP_CORE_DISABLE_IT) || !defined(LIBXMP_CORE_PLAYER)
 	struct module_data *m = &ctx->m;
 #endif
 	struct mixer_data *s = &ctx->s;
@@ -675,9 +1125,20 @@ void libxmp_mixer_setpatch(struct context_data *ctx, int voc, int smp, int ac)
 	vi->vol = 0;
 	vi->pan = 0;
 	vi->flags &= ~SAMPLE_LOOP;
+	vi->flags |= VOICE_START;
 
 	vi->fidx = 0;
 
+#ifndef LIBXMP_CORE_PLAYER
+	if (xxs->flg & XMP_SAMPLE_SYNTH) {
+		if (smp < m->mod.smp && ctx->s.synth_chip != NULL) {
+			vi->fidx = FLAG_SYNTH;
+			m->synth->setpatch(ctx, voc, (uint8 *)xxs->data);
+		}
+		return;
+	}
+#endif
+
 	if (~s->format & XMP_FORMAT_MONO) {
 		vi->fidx |= FLAG_STEREO;
 	}
@@ -797,15 +1258,42 @@ int libxmp_mixer_numvoices(struct context_data *ctx, int num)
 	}
 }
 
+/* Longest tick in samples at the given rate and time factor, with the
+ * player at the lowest tempo it allows */
+int libxmp_mixer_max_ticksize(struct context_data *ctx, int rate, double time_factor)
+{
+	struct module_data *m = &ctx->m;
+	int min_bpm;
+
+	/* See FX_S3M_BPM */
+	min_bpm = (int)(0.5 + time_factor * XMP_MIN_BPM / 10);
+	if (min_bpm > XMP_MIN_BPM) {
+		min_bpm = XMP_MIN_BPM;
+	} else if (min_bpm < 1) {
+		min_bpm = 1;
+	}
+
+	return (int)ceil((double)rate * time_factor * m->rrate / min_bpm / 1000);
+}
+
 int libxmp_mixer_on(struct context_data *ctx, int rate, int format, int c4rate)
 {
 	struct mixer_data *s = &ctx->s;
+	int size;
+
+	/* Size the tick buffers for the longest stereo tick at this rate,
+	 * including ticks made longer by the current time factor */
+	s->framesize = 5 * rate * 2 / XMP_MIN_BPM;
+	size = libxmp_mixer_max_ticksize(ctx, rate, ctx->m.time_factor) * 2;
+	if (s->framesize < size) {
+		s->framesize = size;
+	}
 
-	s->buffer = (char *) calloc(2, XMP_MAX_FRAMESIZE);
+	s->buffer = (char *) libxmp_calloc(2, s->framesize);
 	if (s->buffer == NULL)
 		goto err;
 
-	s->buf32 = (int32 *) calloc(sizeof(int32), XMP_MAX_FRAMESIZE);
+	s->buf32 = (int32 *) libxmp_calloc(sizeof(int32), s->framesize);
 	if (s->buf32 == NULL)
 		goto err1;
 
@@ -818,22 +1306,197 @@ int libxmp_mixer_on(struct context_data *ctx, int rate, int format, int c4rate)
 	s->dsp = XMP_DSP_LOWPASS;	/* enable filters by default */
 	/* s->numvoc = SMIX_NUMVOC; */
 	s->dtright = s->dtleft = 0;
+	s->cpu_budget = 0;		/* no CPU budget by default */
+	s->cpu_load = 0;
+	s->quality = 0;
+	s->quality_hold = 0;
+	s->culled = 0;
+	s->tick_voice = NULL;
+	s->tick_offset = NULL;
+	s->tick_paula = NULL;
+	s->undo32 = NULL;
+	s->undo = 0;
+
+#ifndef LIBXMP_CORE_PLAYER
+	s->synth_chip = NULL;
+	if (ctx->m.synth != NULL && ctx->m.synth->init(ctx, rate) < 0) {
+		goto err2;
+	}
+#endif
 
 	return 0;
 
+#ifndef LIBXMP_CORE_PLAYER
+    err2:
+	libxmp_free(s->buf32);
+	s->buf32 = NULL;
+#endif
     err1:
-	free(s->buffer);
+	libxmp_free(s->buffer);
 	s->buffer = NULL;
     err:
 	return -1;
 }
 
+/* Mix module channels into separate stem buffers. Each entry in the
+ * map assigns a module channel to a stem, or to the main output only
+ * if negative. Without a map, channel n goes to stem n.
+ */
+int libxmp_mixer_start_stems(struct context_data *ctx, int num, const int *map, int flags)
+{
+	struct mixer_data *s = &ctx->s;
+	struct xmp_module *mod = &ctx->m.mod;
+	int i;
+
+	libxmp_mixer_end_stems(ctx);
+
+	if (num <= 0) {
+		return 0;
+	}
+
+	s->stem_map = libxmp_malloc(mod->chn * sizeof(int));
+	if (s->stem_map == NULL) {
+		goto err;
+	}
+	s->stem32 = libxmp_calloc(num * s->framesize, sizeof(int32));
+	if (s->stem32 == NULL) {
+		goto err1;
+	}
+	s->mix32 = libxmp_calloc(s->framesize, sizeof(int32));
+	if (s->mix32 == NULL) {
+		goto err2;
+	}
+	s->stem_buffer = libxmp_calloc(num, 2 * s->framesize);
+	if (s->stem_buffer == NULL) {
+		goto err3;
+	}
+
+	for (i = 0; i < mod->chn; i++) {
+		if (map != NULL) {
+			s->stem_map[i] = map[i] < num ? map[i] : -1;
+		} else {
+			s->stem_map[i] = i < num ? i : -1;
+		}
+	}
+
+	s->num_stems = num;
+	s->stem_flags = flags;
+
+	return 0;
+
+    err3:
+	libxmp_free(s->mix32);
+	s->mix32 = NULL;
+    err2:
+	libxmp_free(s->stem32);
+	s->stem32 = NULL;
+    err1:
+	libxmp_free(s->stem_map);
+	s->stem_map = NULL;
+    err:
+	return -1;
+}
+
+void libxmp_mixer_end_stems(struct context_data *ctx)
+{
+	struct mixer_data *s = &ctx->s;
+
+	libxmp_free(s->stem_map);
+	libxmp_free(s->stem32);
+	libxmp_free(s->mix32);
+	libxmp_free(s->stem_buffer);
+	s->stem_map = NULL;
+	s->stem32 = NULL;
+	s->mix32 = NULL;
+	s->stem_buffer = NULL;
+	s->num_stems = 0;
+}
+
+/* Keep the voice state at the start of each tick, so that voices
+ * restarted in the middle of a tick by libxmp_mixer_split_tick() can
+ * replace the sound already mixed. Called by xmp_start_player() once the
+ * voices are allocated.
+ */
+int libxmp_mixer_start_split(struct context_data *ctx)
+{
+	struct player_data *p = &ctx->p;
+	struct mixer_data *s = &ctx->s;
+	int i;
+
+	s->tick_voice = libxmp_malloc(p->virt.maxvoc * sizeof(struct mixer_voice));
+	if (s->tick_voice == NULL) {
+		goto err;
+	}
+	s->tick_offset = libxmp_malloc(p->virt.maxvoc * sizeof(int));
+	if (s->tick_offset == NULL) {
+		goto err1;
+	}
+	s->undo32 = libxmp_malloc(s->framesize * sizeof(int32));
+	if (s->undo32 == NULL) {
+		goto err2;
+	}
+
+#ifdef LIBXMP_PAULA_SIMULATOR
+	if (p->virt.maxvoc > 0 && p->virt.voice_array[0].paula != NULL) {
+		s->tick_paula = libxmp_malloc((p->virt.maxvoc + 1) *
+					sizeof(struct paula_state));
+		if (s->tick_paula == NULL) {
+			goto err3;
+		}
+	}
+#endif
+
+	/* Nothing was mixed in this tick yet */
+	for (i = 0; i < p->virt.maxvoc; i++) {
+		s->tick_voice[i].chn = -1;
+	}
+
+	return 0;
+
+#ifdef LIBXMP_PAULA_SIMULATOR
+    err3:
+	libxmp_free(s->undo32);
+	s->undo32 = NULL;
+#endif
+    err2:
+	libxmp_free(s->tick_offset);
+	s->tick_offset = NULL;
+    err1:
+	libxmp_free(s->tick_voice);
+	s->tick_voice = NULL;
+    err:
+	return -1;
+}
+
+static void end_split(struct context_data *ctx)
+{
+	struct mixer_data *s = &ctx->s;
+
+	libxmp_free(s->tick_voice);
+	libxmp_free(s->tick_offset);
+	libxmp_free(s->tick_paula);
+	libxmp_free(s->undo32);
+	s->tick_voice = NULL;
+	s->tick_offset = NULL;
+	s->tick_paula = NULL;
+	s->undo32 = NULL;
+}
+
 void libxmp_mixer_off(struct context_data *ctx)
 {
 	struct mixer_data *s = &ctx->s;
 
-	free(s->buffer);
-	free(s->buf32);
+	libxmp_mixer_end_stems(ctx);
+	end_split(ctx);
+
+#ifndef LIBXMP_CORE_PLAYER
+	if (ctx->m.synth != NULL) {
+		ctx->m.synth->deinit(ctx);
+	}
+#endif
+
+	libxmp_free(s->buffer);
+	libxmp_free(s->buf32);
 	s->buf32 = NULL;
 	s->buffer = NULL;
 }
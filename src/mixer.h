@@ -39,6 +39,8 @@ struct mixer_voice {
 #define VOICE_RELEASE	(1 << 0)
 #define ANTICLICK	(1 << 1)	
 #define SAMPLE_LOOP	(1 << 2)
+#define VOICE_REVERSE	(1 << 3)	/* playing backwards in bidi loop */
+#define VOICE_START	(1 << 4)	/* sample started in current tick */
 	int flags;		/* flags */
 	void *sptr;		/* sample pointer */
 #ifdef LIBXMP_PAULA_SIMULATOR
@@ -61,12 +63,17 @@ struct mixer_voice {
 };
 
 int	libxmp_mixer_on		(struct context_data *, int, int, int);
+int	libxmp_mixer_max_ticksize(struct context_data *, int, double);
 void	libxmp_mixer_off	(struct context_data *);
 void    libxmp_mixer_setvol	(struct context_data *, int, int);
 void    libxmp_mixer_seteffect	(struct context_data *, int, int, int);
 void    libxmp_mixer_setpan	(struct context_data *, int, int);
 int	libxmp_mixer_numvoices	(struct context_data *, int);
 void	libxmp_mixer_softmixer	(struct context_data *);
+void	libxmp_mixer_split_tick	(struct context_data *, int);
+int	libxmp_mixer_start_split(struct context_data *);
+int	libxmp_mixer_start_stems(struct context_data *, int, const int *, int);
+void	libxmp_mixer_end_stems	(struct context_data *);
 void	libxmp_mixer_reset	(struct context_data *);
 void	libxmp_mixer_setpatch	(struct context_data *, int, int, int);
 void	libxmp_mixer_voicepos	(struct context_data *, int, double, int);
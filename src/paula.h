@@ -8,27 +8,32 @@
 #define BLEP_SIZE 2048
 #define MAX_BLEPS (BLEP_SIZE / MINIMUM_INTERVAL)
 
-/* the structure that holds data of bleps */
-struct blep_state {
-	int16 level;
-	int16 age;
-};
+/* Bleps are appended to a linear buffer twice the maximum size and expire
+ * from its head, so the buffer only needs to be compacted once every
+ * MAX_BLEPS insertions.
+ */
+#define BLEP_BUFFER_SIZE (MAX_BLEPS * 2)
 
 struct paula_state {
 	/* the instantenous value of Paula output */
 	int16 global_output_level;
 
-	/* count of simultaneous bleps to keep track of */
-	unsigned int active_bleps;
+	/* Paula clock counter, blep ages are measured against it */
+	uint32 clock;
 
-	/* place to keep our bleps in. MAX_BLEPS should be
-	 * defined as a BLEP_SIZE / MINIMUM_EVENT_INTERVAL.
+	/* active bleps, oldest first, are in [first, last). MAX_BLEPS
+	 * should be defined as a BLEP_SIZE / MINIMUM_EVENT_INTERVAL.
 	 * For Paula, minimum event interval could be even 1, but it makes
 	 * sense to limit it to some higher value such as 16. */
-	struct blep_state blepstate[MAX_BLEPS];
-
-	double remainder;
-	double fdiv;
+	unsigned int first;
+	unsigned int last;
+	int32 blep_level[BLEP_BUFFER_SIZE];
+	uint32 blep_clock[BLEP_BUFFER_SIZE];	/* clock at blep start */
+
+	/* Paula clocks until the next output sample, in units of
+	 * 1/freq clocks to keep it exact with integer arithmetic */
+	int remainder;
+	int freq;
 };
 
 
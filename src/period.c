@@ -25,6 +25,7 @@
 
 #include "common.h"
 #include "period.h"
+#include "precomp_pitch.h"
 
 #include <math.h>
 
@@ -144,6 +145,55 @@ static inline double libxmp_round(double val)
 #define libxmp_round round
 #endif
 
+/* Get 2^(-x / (12 * PITCH_STEPS)) from the pitch table. x is the distance
+ * from C0 in 1/PITCH_STEPS semitone units, so integer note and finetune
+ * values hit table entries exactly. Fractional steps (pitchbends) are
+ * corrected with a truncated series for 2^(-frac / PITCH_LUTLEN).
+ */
+static inline double pitch_scale(double x)
+{
+	double u, val;
+	int i, oct;
+
+	i = (int)floor(x);
+	u = (x - i) * (-M_LN2 / PITCH_LUTLEN);
+
+	oct = i / PITCH_LUTLEN;
+	i %= PITCH_LUTLEN;
+	if (i < 0) {
+		i += PITCH_LUTLEN;
+		oct--;
+	}
+
+	val = pitch_table[i];
+	if (u != 0.0) {
+		val *= 1.0 + u * (1.0 + u * (0.5 + u * (1.0 / 6)));
+	}
+
+	return ldexp(val, -oct);
+}
+
+/* Get log2(x) from the mantissa table and a truncated series for
+ * log2(1 + e), with e the distance to the nearest lower table entry.
+ */
+static inline double log2_lookup(double x)
+{
+	double m, t, e;
+	int i, ex;
+
+	if (!(x > 0.0 && x < HUGE_VAL)) {
+		return log(x) / M_LN2;
+	}
+
+	m = frexp(x, &ex) * 2.0;		/* mantissa in [1, 2) */
+	i = (int)ldexp(m - 1.0, LOG2_FRACBITS);
+	t = 1.0 + ldexp((double)i, -LOG2_FRACBITS);
+	e = (m - t) / t;
+
+	return log2_table[i] + (ex - 1) +
+		e * (1.0 + e * (-0.5 + e * (1.0 / 3 - e * 0.25))) / M_LN2;
+}
+
 #ifdef LIBXMP_PAULA_SIMULATOR
 /* Get period from note using Protracker tuning */
 static inline int libxmp_note_to_period_pt(int n, int f)
@@ -169,7 +219,7 @@ static inline int libxmp_note_to_period_pt(int n, int f)
 /* Get period from note */
 double libxmp_note_to_period(struct context_data *ctx, int n, int f, double adj)
 {
-	double d, per;
+	double per;
 	struct module_data *m = &ctx->m;
 #ifdef LIBXMP_PAULA_SIMULATOR
 	struct player_data *p = &ctx->p;
@@ -182,17 +232,16 @@ double libxmp_note_to_period(struct context_data *ctx, int n, int f, double adj)
 	}
 #endif
 
-	d = (double)n + (double)f / 128;
-
 	switch (m->period_type) {
 	case PERIOD_LINEAR:
-		per = (240.0 - d) * 16;			/* Linear */
+		per = (240.0 - ((double)n + (double)f / 128)) * 16; /* Linear */
 		break;
 	case PERIOD_CSPD:
-		per = 8363.0 * pow(2, n / 12) / 32 + f;	/* Hz */
+		per = ldexp(8363.0, n / 12) / 32 + f;	/* Hz */
 		break;
-	default:
-		per = PERIOD_BASE / pow(2, d / 12);	/* Amiga */
+	default:					/* Amiga */
+		per = PERIOD_BASE * pitch_scale((double)n * PITCH_STEPS +
+					f * (PITCH_STEPS / 128.0));
 	}
 
 #ifndef LIBXMP_CORE_PLAYER
@@ -207,8 +256,8 @@ double libxmp_note_to_period(struct context_data *ctx, int n, int f, double adj)
 /* For the software mixer */
 double libxmp_note_to_period_mix(int n, int b)
 {
-	double d = (double)n + (double)b / 12800;
-	return PERIOD_BASE / pow(2, d / 12);
+	double x = (double)n * PITCH_STEPS + (double)b * PITCH_STEPS / 12800;
+	return PERIOD_BASE * pitch_scale(x);
 }
 
 /* Get note from period */
@@ -237,11 +286,11 @@ int libxmp_period_to_bend(struct context_data *ctx, double p, int n, double adj)
 		return 100 * (8 * (((240 - n) << 4) - p));
 	case PERIOD_CSPD:
 		d = libxmp_note_to_period(ctx, n, 0, adj);
-		return libxmp_round(100.0 * (1536.0 / M_LN2) * log(p / d));
+		return libxmp_round(100.0 * 1536.0 * log2_lookup(p / d));
 	default:
 		/* Amiga */
 		d = libxmp_note_to_period(ctx, n, 0, adj);
-		return libxmp_round(100.0 * (1536.0 / M_LN2) * log(d / p));
+		return libxmp_round(100.0 * 1536.0 * log2_lookup(d / p));
 	}
 }
 
@@ -42,6 +42,8 @@
 #include "effects.h"
 #include "player.h"
 #include "mixer.h"
+#include "profile.h"
+#include "command.h"
 #ifndef LIBXMP_CORE_PLAYER
 #include "extras.h"
 #endif
@@ -115,6 +117,113 @@ static int get_envelope(struct xmp_envelope *env, int x, int def)
 	return x2 == x1 ? y2 : ((y2 - y1) * (x - x1) / (x2 - x1)) + y1;
 }
 
+/* Same as get_envelope(), but keep the current segment and interpolation
+ * state in a per-channel cursor. Moving one tick ahead adds the segment
+ * slope to the cursor, so neither the node search nor the division are
+ * needed unless the envelope position jumps.
+ */
+static int get_envelope_cursor(struct xmp_envelope *env,
+			       struct envelope_slopes *es,
+			       struct envelope_cursor *cur, int x, int def)
+{
+	int x1, x2, y1, y2, dx, dy;
+	int16 *data = env->data;
+	int index, last;
+
+	if (x < 0 || ~env->flg & XMP_ENVELOPE_ON || env->npt <= 0)
+		return def;
+
+	if (es == NULL || !es->ok)
+		return get_envelope(env, x, def);
+
+	last = (env->npt - 1) * 2;
+
+	if (cur->env == env) {
+		if (x == cur->x) {
+			return cur->val;
+		}
+
+		index = cur->index;
+		if (x == cur->x + 1 && index < last) {
+			x1 = data[index];
+			x2 = data[index + 2];
+
+			if (x < x2) {
+				/* Still in the same segment */
+				dx = x2 - x1;
+				cur->q += es->q[index >> 1];
+				cur->r += es->r[index >> 1];
+				if (cur->r >= dx) {
+					cur->r -= dx;
+					cur->q++;
+				}
+				y1 = data[index + 1];
+				y2 = data[index + 3];
+				cur->val = y2 < y1 ? y1 - cur->q : y1 + cur->q;
+				cur->x = x;
+				return cur->val;
+			}
+
+			if (index + 2 < last && x < data[index + 4]) {
+				/* Start of the next segment */
+				cur->index = index + 2;
+				cur->q = cur->r = 0;
+				cur->val = data[index + 3];
+				cur->x = x;
+				return cur->val;
+			}
+		}
+	}
+
+	/* Find the segment as get_envelope() does */
+	index = last;
+	cur->env = env;
+	cur->x = x;
+	cur->q = cur->r = 0;
+
+	if (x >= data[index] || index == 0) {
+		cur->index = index;
+		cur->val = data[index + 1];
+		return cur->val;
+	}
+
+	do {
+		index -= 2;
+		x1 = data[index];
+	} while (index > 0 && x1 > x);
+
+	y1 = data[index + 1];
+	x2 = data[index + 2];
+	y2 = data[index + 3];
+
+	cur->index = index;
+
+	if (x < x1 || x2 == x1) {
+		/* Before the first node, don't advance from here */
+		cur->env = NULL;
+		return x2 == x1 ? y2 : ((y2 - y1) * (x - x1) / (x2 - x1)) + y1;
+	}
+
+	dx = x2 - x1;
+	dy = y2 < y1 ? y1 - y2 : y2 - y1;
+	cur->q = dy * (x - x1) / dx;
+	cur->r = dy * (x - x1) % dx;
+	cur->val = y2 < y1 ? y1 - cur->q : y1 + cur->q;
+
+	return cur->val;
+}
+
+static struct instrument_slopes *get_slopes(struct module_data *m,
+					    struct xmp_instrument *xxi)
+{
+	struct xmp_module *mod = &m->mod;
+
+	if (m->env_slopes == NULL || xxi < mod->xxi || xxi >= mod->xxi + mod->ins)
+		return NULL;
+
+	return &m->env_slopes[xxi - mod->xxi];
+}
+
 static int update_envelope_xm(struct xmp_envelope *env, int x, int release)
 {
 	int16 *data = env->data;
@@ -283,7 +392,9 @@ static void update_invloop(struct module_data *m, struct channel_data *xc)
 			xc->invloop.pos = 0;
 		}
 
-		if (~xxs->flg & XMP_SAMPLE_16BIT) {
+		/* Shared sample data is also used by other contexts */
+		if (~xxs->flg & XMP_SAMPLE_16BIT &&
+		    (m->shared == NULL || !m->shared[xc->smp])) {
 			xxs->data[xxs->lps + xc->invloop.pos] ^= 0xff;
 		}
 	}
@@ -440,6 +551,11 @@ static void reset_channels(struct context_data *ctx)
 			xc->pan.surround = 1;
 		}
 	}
+
+	/* Channel info was cleared */
+	for (i = 0; i < mod->chn; i++) {
+		SET_CHANNEL_CHANGED(i);
+	}
 }
 
 static int check_delay(struct context_data *ctx, struct xmp_event *e, int chn)
@@ -502,12 +618,19 @@ static inline void read_row(struct context_data *ctx, int pat, int row)
 
 	for (chn = 0; chn < mod->chn; chn++) {
 		const int num_rows = mod->xxt[TRACK_NUM(pat, chn)]->rows;
+		struct channel_data *xc = &p->xc_data[chn];
+
 		if (row < num_rows) {
 			memcpy(&ev, &EVENT(pat, chn, row), sizeof(ev));
 		} else {
 			memset(&ev, 0, sizeof(ev));
 		}
 
+		if (memcmp(&xc->info_event, &ev, sizeof(ev)) != 0) {
+			memcpy(&xc->info_event, &ev, sizeof(ev));
+			SET_CHANNEL_CHANGED(chn);
+		}
+
 		if (ev.note == XMP_KEY_OFF) {
 			int env_on = 0;
 			int ins = ev.ins - 1;
@@ -542,7 +665,7 @@ static inline void read_row(struct context_data *ctx, int pat, int row)
 		} else {
 			if (IS_PLAYER_MODE_IT()) {
 				/* Reset flags. See SlideDelay.it */
-				p->xc_data[chn].flags = 0;
+				xc->flags = 0;
 			}
 		}
 	}
@@ -624,6 +747,21 @@ static int tremor_s3m(struct context_data *ctx, int chn, int finalvol)
  * Update channel data
  */
 
+/* Store a value reported by xmp_get_channel_info() and flag the channel
+ * for xmp_get_frame_status() if it changed. Bits below shift are not
+ * reported.
+ */
+static void set_channel_info(struct context_data *ctx, int chn, int *info,
+			     int val, int shift)
+{
+	struct player_data *p = &ctx->p;
+
+	if ((*info >> shift) != (val >> shift) && chn < ctx->m.mod.chn) {
+		SET_CHANNEL_CHANGED(chn);
+	}
+	*info = val;
+}
+
 #define DOENV_RELEASE ((TEST_NOTE(NOTE_RELEASE) || act == VIRT_ACTION_OFF))
 
 static void process_volume(struct context_data *ctx, int chn, int act)
@@ -632,11 +770,13 @@ static void process_volume(struct context_data *ctx, int chn, int act)
 	struct module_data *m = &ctx->m;
 	struct channel_data *xc = &p->xc_data[chn];
 	struct xmp_instrument *instrument;
+	struct instrument_slopes *es;
 	int finalvol;
 	uint16 vol_envelope;
 	int fade = 0;
 
 	instrument = libxmp_get_instrument(ctx, xc->ins);
+	es = get_slopes(m, instrument);
 
 	/* Keyoff and fadeout */
 
@@ -699,7 +839,8 @@ static void process_volume(struct context_data *ctx, int chn, int act)
 			DOENV_RELEASE, TEST(KEY_OFF), IS_PLAYER_MODE_IT());
 	}
 
-	vol_envelope = get_envelope(&instrument->aei, xc->v_idx, 64);
+	vol_envelope = get_envelope_cursor(&instrument->aei,
+			es ? &es->aei : NULL, &xc->v_cur, xc->v_idx, 64);
 	if (check_envelope_end(&instrument->aei, xc->v_idx)) {
 		if (vol_envelope == 0) {
 			SET_NOTE(NOTE_END);
@@ -769,7 +910,8 @@ static void process_volume(struct context_data *ctx, int chn, int act)
 		finalvol = finalvol * p->smix_vol / 100;
 	}
 
-	xc->info_finalvol = TEST_NOTE(NOTE_SAMPLE_END) ? 0 : finalvol;
+	set_channel_info(ctx, chn, &xc->info_finalvol,
+			TEST_NOTE(NOTE_SAMPLE_END) ? 0 : finalvol, 4);
 
 	libxmp_virt_setvol(ctx, chn, finalvol);
 
@@ -781,29 +923,30 @@ static void process_volume(struct context_data *ctx, int chn, int act)
 
 static void process_frequency(struct context_data *ctx, int chn, int act)
 {
-#ifndef LIBXMP_CORE_DISABLE_IT
-	struct mixer_data *s = &ctx->s;
-#endif
 	struct player_data *p = &ctx->p;
 	struct module_data *m = &ctx->m;
 	struct channel_data *xc = &p->xc_data[chn];
 	struct xmp_instrument *instrument;
+	struct instrument_slopes *es;
 	double period, vibrato;
 	double final_period;
 	int linear_bend;
 	int frq_envelope;
 	int arp;
+	int info_period;
 #ifndef LIBXMP_CORE_DISABLE_IT
 	int cutoff, resonance;
 #endif
 
 	instrument = libxmp_get_instrument(ctx, xc->ins);
+	es = get_slopes(m, instrument);
 
 	if (!TEST_PER(FENV_PAUSE)) {
 		xc->f_idx = update_envelope(&instrument->fei, xc->f_idx,
 			DOENV_RELEASE, TEST(KEY_OFF), IS_PLAYER_MODE_IT());
 	}
-	frq_envelope = get_envelope(&instrument->fei, xc->f_idx, 0);
+	frq_envelope = get_envelope_cursor(&instrument->fei,
+			es ? &es->fei : NULL, &xc->f_cur, xc->f_idx, 0);
 
 #ifndef LIBXMP_CORE_PLAYER
 	/* Do note slide */
@@ -945,17 +1088,19 @@ static void process_frequency(struct context_data *ctx, int chn, int act)
 	libxmp_virt_setperiod(ctx, chn, final_period);
 
 	/* For xmp_get_frame_info() */
-	xc->info_pitchbend = linear_bend >> 7;
-	xc->info_period = final_period * 4096;
+	info_period = final_period * 4096;
 
 	if (IS_PERIOD_MODRNG()) {
-		CLAMP(xc->info_period,
+		CLAMP(info_period,
 			libxmp_note_to_period(ctx, MAX_NOTE_MOD, xc->finetune, 0) * 4096,
 			libxmp_note_to_period(ctx, MIN_NOTE_MOD, xc->finetune, 0) * 4096);
-	} else if (xc->info_period < (1 << 12)) {
-		xc->info_period = (1 << 12);
+	} else if (info_period < (1 << 12)) {
+		info_period = (1 << 12);
 	}
 
+	set_channel_info(ctx, chn, &xc->info_pitchbend, linear_bend >> 7, 0);
+	set_channel_info(ctx, chn, &xc->info_period, info_period, 0);
+
 
 #ifndef LIBXMP_CORE_DISABLE_IT
 
@@ -979,7 +1124,7 @@ static void process_frequency(struct context_data *ctx, int chn, int act)
 		cutoff = 0xff;
 	} else if (cutoff < 0xff) {
 		int a0, b0, b1;
-		libxmp_filter_setup(s->freq, cutoff, resonance, &a0, &b0, &b1);
+		libxmp_filter_coef(ctx, cutoff, resonance, &a0, &b0, &b1);
 		libxmp_virt_seteffect(ctx, chn, DSP_EFFECT_FILTER_A0, a0);
 		libxmp_virt_seteffect(ctx, chn, DSP_EFFECT_FILTER_B0, b0);
 		libxmp_virt_seteffect(ctx, chn, DSP_EFFECT_FILTER_B1, b1);
@@ -999,17 +1144,20 @@ static void process_pan(struct context_data *ctx, int chn, int act)
 	struct mixer_data *s = &ctx->s;
 	struct channel_data *xc = &p->xc_data[chn];
 	struct xmp_instrument *instrument;
+	struct instrument_slopes *es;
 	int finalpan, panbrello = 0;
 	int pan_envelope;
 	int channel_pan;
 
 	instrument = libxmp_get_instrument(ctx, xc->ins);
+	es = get_slopes(m, instrument);
 
 	if (!TEST_PER(PENV_PAUSE)) {
 		xc->p_idx = update_envelope(&instrument->pei, xc->p_idx,
 			DOENV_RELEASE, TEST(KEY_OFF), IS_PLAYER_MODE_IT());
 	}
-	pan_envelope = get_envelope(&instrument->pei, xc->p_idx, 32);
+	pan_envelope = get_envelope_cursor(&instrument->pei,
+			es ? &es->pei : NULL, &xc->p_cur, xc->p_idx, 32);
 
 #ifndef LIBXMP_CORE_DISABLE_IT
 	if (TEST(PANBRELLO)) {
@@ -1048,7 +1196,7 @@ static void process_pan(struct context_data *ctx, int chn, int act)
 		finalpan = (finalpan - 0x80) * s->mix / 100;
 	}
 
-	xc->info_finalpan = finalpan + 0x80;
+	set_channel_info(ctx, chn, &xc->info_finalpan, finalpan + 0x80, 0);
 
 	if (xc->pan.surround) {
 		libxmp_virt_setpan(ctx, chn, PAN_SURROUND);
@@ -1244,8 +1392,6 @@ static void play_channel(struct context_data *ctx, int chn)
 	struct channel_data *xc = &p->xc_data[chn];
 	int act;
 
-	xc->info_finalvol = 0;
-
 #ifndef LIBXMP_CORE_DISABLE_IT
 	/* IT tempo slide */
 	if (!is_first_frame(ctx) && TEST(TEMPO_SLIDE)) {
@@ -1265,18 +1411,22 @@ static void play_channel(struct context_data *ctx, int chn)
 	if (act == VIRT_INVALID) {
 		/* We need this to keep processing global volume slides */
 		update_volume(ctx, chn);
+		set_channel_info(ctx, chn, &xc->info_finalvol, 0, 4);
 		return;
 	}
 
 	if (p->frame == 0 && act != VIRT_ACTIVE) {
 		if (!IS_VALID_INSTRUMENT_OR_SFX(xc->ins) || act == VIRT_ACTION_CUT) {
 			libxmp_virt_resetchannel(ctx, chn);
+			set_channel_info(ctx, chn, &xc->info_finalvol, 0, 4);
 			return;
 		}
 	}
 
-	if (!IS_VALID_INSTRUMENT_OR_SFX(xc->ins))
+	if (!IS_VALID_INSTRUMENT_OR_SFX(xc->ins)) {
+		set_channel_info(ctx, chn, &xc->info_finalvol, 0, 4);
 		return;
+	}
 
 #ifndef LIBXMP_CORE_PLAYER
 	libxmp_play_extras(ctx, xc, chn);
@@ -1331,6 +1481,28 @@ static void play_channel(struct context_data *ctx, int chn)
 	xc->info_position = libxmp_virt_getvoicepos(ctx, chn);
 }
 
+/*
+ * Get the channel info reported by xmp_get_channel_info() from the
+ * current channel state. The track event is updated in read_row().
+ */
+static void get_channel_info(struct context_data *ctx, int chn,
+			     struct xmp_channel_info *ci)
+{
+	struct player_data *p = &ctx->p;
+	struct channel_data *xc = &p->xc_data[chn];
+
+	ci->note = xc->key;
+	ci->pitchbend = xc->info_pitchbend;
+	ci->period = xc->info_period;
+	ci->position = xc->info_position;
+	ci->instrument = xc->ins;
+	ci->sample = xc->smp;
+	ci->volume = xc->info_finalvol >> 4;
+	ci->pan = xc->info_finalpan;
+	ci->reserved = 0;
+	memcpy(&ci->event, &xc->info_event, sizeof(struct xmp_event));
+}
+
 /*
  * Event injection
  */
@@ -1347,6 +1519,7 @@ static void inject_event(struct context_data *ctx)
 		struct xmp_event *e = &p->inject_event[chn];
 		if (e->_flag > 0) {
 			libxmp_read_event(ctx, e, chn);
+			libxmp_smix_voice_start(ctx, chn);
 			e->_flag = 0;
 		}
 	}
@@ -1356,6 +1529,32 @@ static void inject_event(struct context_data *ctx)
  * Sequencing
  */
 
+/*
+ * Player event callbacks
+ */
+
+void libxmp_player_event(struct context_data *ctx, int type, int chn,
+			 int note, int ins)
+{
+	struct player_data *p = &ctx->p;
+	struct xmp_player_event ev;
+
+	if (p->event_callback.func == NULL || (~p->event_callback.mask & type)) {
+		return;
+	}
+
+	ev.type = type;
+	ev.offset = p->event_callback.offset;
+	ev.pos = p->pos;
+	ev.row = p->row;
+	ev.loop_count = p->loop_count;
+	ev.channel = chn;
+	ev.note = note;
+	ev.instrument = ins;
+
+	p->event_callback.func(&ev, p->event_callback.priv);
+}
+
 static void next_order(struct context_data *ctx)
 {
 	struct player_data *p = &ctx->p;
@@ -1397,6 +1596,8 @@ static void next_order(struct context_data *ctx)
 	p->pos = p->ord;
 	p->frame = 0;
 
+	libxmp_player_event(ctx, XMP_EVENT_ORDER, -1, -1, -1);
+
 #ifndef LIBXMP_CORE_PLAYER
 	/* Reset persistent effects at new pattern */
 	if (HAS_QUIRK(QUIRK_PERPAT)) {
@@ -1486,7 +1687,7 @@ static void update_from_ord_info(struct context_data *ctx)
 #endif
 }
 
-int xmp_start_player(xmp_context opaque, int rate, int format)
+static int start_player(xmp_context opaque, int rate, int format)
 {
 	struct context_data *ctx = (struct context_data *)opaque;
 	struct player_data *p = &ctx->p;
@@ -1557,24 +1758,38 @@ int xmp_start_player(xmp_context opaque, int rate, int format)
 		goto err;
 	}
 
+	/* Keep the voices as mixed in each tick, to replace them when
+	 * injected events restart them in the middle of the frame */
+	if (libxmp_mixer_start_split(ctx) < 0) {
+		ret = -XMP_ERROR_SYSTEM;
+		goto err;
+	}
+
+	libxmp_smix_reset_voices(ctx);
+	libxmp_smix_resample(ctx);
+
 	f->delay = 0;
 	f->jumpline = 0;
 	f->jump = -1;
 	f->pbreak = 0;
 	f->rowdelay_set = 0;
 
-	f->loop = calloc(p->virt.virt_channels, sizeof(struct pattern_loop));
+	f->loop = libxmp_calloc(p->virt.virt_channels, sizeof(struct pattern_loop));
 	if (f->loop == NULL) {
 		ret = -XMP_ERROR_SYSTEM;
 		goto err;
 	}
 
-	p->xc_data = calloc(p->virt.virt_channels, sizeof(struct channel_data));
+	p->xc_data = libxmp_calloc(p->virt.virt_channels, sizeof(struct channel_data));
 	if (p->xc_data == NULL) {
 		ret = -XMP_ERROR_SYSTEM;
 		goto err1;
 	}
 
+#ifndef LIBXMP_CORE_DISABLE_IT
+	libxmp_filter_init(ctx);
+#endif
+
 	/* Reset our buffer pointers */
 	xmp_play_buffer(opaque, NULL, 0, 0);
 
@@ -1593,16 +1808,29 @@ int xmp_start_player(xmp_context opaque, int rate, int format)
 
 #ifndef LIBXMP_CORE_PLAYER
     err2:
-	free(p->xc_data);
+	libxmp_free(p->xc_data);
 	p->xc_data = NULL;
 #endif
     err1:
-	free(f->loop);
+	libxmp_free(f->loop);
 	f->loop = NULL;
     err:
 	return ret;
 }
 
+int xmp_start_player(xmp_context opaque, int rate, int format)
+{
+	struct context_data *ctx = (struct context_data *)opaque;
+	struct alloc_class *old;
+	int ret;
+
+	old = libxmp_enter_allocator(ctx, ALLOC_PLAYER);
+	ret = start_player(opaque, rate, format);
+	libxmp_leave_allocator(old);
+
+	return ret;
+}
+
 static void check_end_of_module(struct context_data *ctx)
 {
 	struct player_data *p = &ctx->p;
@@ -1614,13 +1842,14 @@ static void check_end_of_module(struct context_data *ctx)
 		if (f->end_point == 0) {
 			p->loop_count++;
 			f->end_point = p->scan[p->sequence].num;
+			libxmp_player_event(ctx, XMP_EVENT_LOOP, -1, -1, -1);
 			/* return -1; */
 		}
 		f->end_point--;
 	}
 }
 
-int xmp_play_frame(xmp_context opaque)
+static int play_frame(xmp_context opaque)
 {
 	struct context_data *ctx = (struct context_data *)opaque;
 	struct player_data *p = &ctx->p;
@@ -1632,6 +1861,8 @@ int xmp_play_frame(xmp_context opaque)
 	if (ctx->state < XMP_STATE_PLAYING)
 		return -XMP_ERROR_STATE;
 
+	libxmp_drain_commands(ctx);
+
 	if (mod->len <= 0) {
 		return -XMP_END;
 	}
@@ -1679,6 +1910,11 @@ int xmp_play_frame(xmp_context opaque)
 		libxmp_virt_reset(ctx);
 		reset_channels(ctx);
 	} else {
+		/* First frame after xmp_start_player() */
+		if (p->frame < 0) {
+			libxmp_player_event(ctx, XMP_EVENT_ORDER, -1, -1, -1);
+		}
+
 		p->frame++;
 		if (p->frame >= (p->speed * (1 + f->delay))) {
 			/* If break during pattern delay, next row is skipped.
@@ -1702,8 +1938,11 @@ int xmp_play_frame(xmp_context opaque)
 
 	/* check new row */
 
+	PROFILE_START(ctx, read_time);
+
 	if (p->frame == 0) {			/* first frame in row */
 		check_end_of_module(ctx);
+		libxmp_player_event(ctx, XMP_EVENT_ROW, -1, -1, -1);
 		read_row(ctx, mod->xxo[p->ord], p->row);
 
 #ifndef LIBXMP_CORE_PLAYER
@@ -1720,11 +1959,17 @@ int xmp_play_frame(xmp_context opaque)
 
 	inject_event(ctx);
 
+	PROFILE_STOP(ctx, read_time);
+	PROFILE_START(ctx, play_time);
+
 	/* play_frame */
 	for (i = 0; i < p->virt.virt_channels; i++) {
 		play_channel(ctx, i);
 	}
 
+	PROFILE_STOP(ctx, play_time);
+	PROFILE_COUNT(ctx, frames, 1);
+
 	f->rowdelay_set &= ~ROWDELAY_FIRST_FRAME;
 
 	p->frame_time = m->time_factor * m->rrate / p->bpm;
@@ -1735,12 +1980,112 @@ int xmp_play_frame(xmp_context opaque)
 	return 0;
 }
 
+int xmp_play_frame(xmp_context opaque)
+{
+	struct context_data *ctx = (struct context_data *)opaque;
+	struct alloc_class *old;
+	int ret;
+
+	old = libxmp_enter_allocator(ctx, ALLOC_PLAYER);
+	ret = play_frame(opaque);
+	libxmp_leave_allocator(old);
+
+	return ret;
+}
+
+/* Size in bytes of one output sample, including all channels */
+static int get_sample_size(struct mixer_data *s)
+{
+	int size = 1;
+
+	if (~s->format & XMP_FORMAT_MONO) {
+		size *= 2;
+	}
+	if (~s->format & XMP_FORMAT_8BIT) {
+		size *= 2;
+	}
+
+	return size;
+}
+
+/* Size in bytes of the mixed frame */
+static int get_buffer_size(struct mixer_data *s)
+{
+	return s->ticksize * get_sample_size(s);
+}
+
+/* Set up the voice of a note injected in the middle of a frame. The
+ * slides, envelopes and LFOs of the channel were already advanced for
+ * this frame, so only the voice parameters and the channel information
+ * are kept; the channel state is restored as read from the event.
+ */
+static void start_injected_channel(struct context_data *ctx, int chn)
+{
+	struct player_data *p = &ctx->p;
+	struct smix_data *smix = &ctx->smix;
+	struct module_data *m = &ctx->m;
+	struct xmp_module *mod = &m->mod;
+	struct channel_data *xc = &p->xc_data[chn];
+	struct channel_data save;
+	int act;
+
+	act = libxmp_virt_cstat(ctx, chn);
+	if (act == VIRT_INVALID || !IS_VALID_INSTRUMENT_OR_SFX(xc->ins))
+		return;
+
+	memcpy(&save, xc, sizeof(struct channel_data));
+
+	process_volume(ctx, chn, act);
+	process_frequency(ctx, chn, act);
+	process_pan(ctx, chn, act);
+
+	save.info_period = xc->info_period;
+	save.info_pitchbend = xc->info_pitchbend;
+	save.info_finalvol = xc->info_finalvol;
+	save.info_finalpan = xc->info_finalpan;
+	save.info_position = libxmp_virt_getvoicepos(ctx, chn);
+	memcpy(xc, &save, sizeof(struct channel_data));
+}
+
+/* Apply events injected while the current frame is being played back by
+ * xmp_play_buffer() and start their notes at the given sample offset,
+ * instead of waiting for the next frame.
+ */
+static void split_frame(struct context_data *ctx, int offset)
+{
+	struct player_data *p = &ctx->p;
+	struct module_data *m = &ctx->m;
+	struct xmp_module *mod = &m->mod;
+	struct smix_data *smix = &ctx->smix;
+	int chn, inject = 0;
+
+	/* Notes start at the split point */
+	p->event_callback.offset = offset;
+
+	for (chn = 0; chn < mod->chn + smix->chn; chn++) {
+		struct xmp_event *e = &p->inject_event[chn];
+		if (e->_flag > 0) {
+			libxmp_read_event(ctx, e, chn);
+			libxmp_smix_voice_start(ctx, chn);
+			e->_flag = 0;
+			start_injected_channel(ctx, chn);
+			inject = 1;
+		}
+	}
+
+	p->event_callback.offset = 0;
+
+	if (inject) {
+		libxmp_mixer_split_tick(ctx, offset);
+	}
+}
+
 int xmp_play_buffer(xmp_context opaque, void *out_buffer, int size, int loop)
 {
 	struct context_data *ctx = (struct context_data *)opaque;
 	struct player_data *p = &ctx->p;
+	struct mixer_data *s = &ctx->s;
 	int ret = 0, filled = 0, copy_size;
-	struct xmp_frame_info fi;
 
 	/* Reset internal state
 	 * Syncs buffer start with frame start */
@@ -1754,15 +2099,22 @@ int xmp_play_buffer(xmp_context opaque, void *out_buffer, int size, int loop)
 	if (ctx->state < XMP_STATE_PLAYING)
 		return -XMP_ERROR_STATE;
 
+	/* Start injected events in the part of the frame not played yet */
+	if (p->buffer_data.consumed < p->buffer_data.in_size) {
+		libxmp_drain_commands(ctx);
+		split_frame(ctx, p->buffer_data.consumed / get_sample_size(s));
+	}
+
 	/* Fill buffer */
 	while (filled < size) {
 		/* Check if buffer full */
 		if (p->buffer_data.consumed == p->buffer_data.in_size) {
+			p->event_callback.offset = filled / get_sample_size(s);
 			ret = xmp_play_frame(opaque);
-			xmp_get_frame_info(opaque, &fi);
+			p->event_callback.offset = 0;
 
 			/* Check end of module */
-			if (ret < 0 || (loop > 0 && fi.loop_count >= loop)) {
+			if (ret < 0 || (loop > 0 && p->loop_count >= loop)) {
 				/* Start of frame, return end of replay */
 				if (filled == 0) {
 					p->buffer_data.consumed = 0;
@@ -1776,8 +2128,8 @@ int xmp_play_buffer(xmp_context opaque, void *out_buffer, int size, int loop)
 			}
 
 			p->buffer_data.consumed = 0;
-			p->buffer_data.in_buffer = fi.buffer;
-			p->buffer_data.in_size = fi.buffer_size;
+			p->buffer_data.in_buffer = s->buffer;
+			p->buffer_data.in_size = get_buffer_size(s);
 		}
 
 		/* Copy frame data to user buffer */
@@ -1792,7 +2144,7 @@ int xmp_play_buffer(xmp_context opaque, void *out_buffer, int size, int loop)
 	return ret;
 }
     
-void xmp_end_player(xmp_context opaque)
+static void end_player(xmp_context opaque)
 {
 	struct context_data *ctx = (struct context_data *)opaque;
 	struct player_data *p = &ctx->p;
@@ -1805,6 +2157,9 @@ void xmp_end_player(xmp_context opaque)
 	if (ctx->state < XMP_STATE_PLAYING)
 		return;
 
+	xmp_end_render_ahead(opaque);
+	xmp_end_command_queue(opaque);
+
 	ctx->state = XMP_STATE_LOADED;
 
 #ifndef LIBXMP_CORE_PLAYER
@@ -1817,15 +2172,29 @@ void xmp_end_player(xmp_context opaque)
 
 	libxmp_virt_off(ctx);
 
-	free(p->xc_data);
-	free(f->loop);
+	libxmp_free(p->xc_data);
+	libxmp_free(f->loop);
 
 	p->xc_data = NULL;
 	f->loop = NULL;
 
+#ifndef LIBXMP_CORE_DISABLE_IT
+	libxmp_filter_deinit(ctx);
+#endif
+
 	libxmp_mixer_off(ctx);
 }
 
+void xmp_end_player(xmp_context opaque)
+{
+	struct context_data *ctx = (struct context_data *)opaque;
+	struct alloc_class *old;
+
+	old = libxmp_enter_allocator(ctx, ALLOC_PLAYER);
+	end_player(opaque);
+	libxmp_leave_allocator(old);
+}
+
 void xmp_get_module_info(xmp_context opaque, struct xmp_module_info *info)
 {
 	struct context_data *ctx = (struct context_data *)opaque;
@@ -1880,14 +2249,8 @@ void xmp_get_frame_info(xmp_context opaque, struct xmp_frame_info *info)
 	info->time = p->current_time;
 	info->buffer = s->buffer;
 
-	info->total_size = XMP_MAX_FRAMESIZE;
-	info->buffer_size = s->ticksize;
-	if (~s->format & XMP_FORMAT_MONO) {
-		info->buffer_size *= 2;
-	}
-	if (~s->format & XMP_FORMAT_8BIT) {
-		info->buffer_size *= 2;
-	}
+	info->total_size = s->framesize;
+	info->buffer_size = get_buffer_size(s);
 
 	info->volume = p->gvol;
 	info->loop_count = p->loop_count;
@@ -1926,3 +2289,87 @@ void xmp_get_frame_info(xmp_context opaque, struct xmp_frame_info *info)
 		}
 	}
 }
+
+void xmp_get_frame_status(xmp_context opaque, struct xmp_frame_status *info)
+{
+	struct context_data *ctx = (struct context_data *)opaque;
+	struct player_data *p = &ctx->p;
+	struct mixer_data *s = &ctx->s;
+	struct module_data *m = &ctx->m;
+	struct xmp_module *mod = &m->mod;
+	int i;
+
+	if (ctx->state < XMP_STATE_LOADED)
+		return;
+
+	if (p->pos >= 0 && p->pos < mod->len) {
+		info->pos = p->pos;
+	} else {
+		info->pos = 0;
+	}
+
+	info->pattern = mod->xxo[info->pos];
+
+	if (info->pattern < mod->pat) {
+		info->num_rows = mod->xxp[info->pattern]->rows;
+	} else {
+		info->num_rows = 0;
+	}
+
+	info->row = p->row;
+	info->frame = p->frame;
+	info->speed = p->speed;
+	info->bpm = p->bpm;
+	info->total_time = p->scan[p->sequence].time;
+	info->frame_time = p->frame_time * 1000;
+	info->time = p->current_time;
+	info->buffer = s->buffer;
+
+	info->total_size = s->framesize;
+	info->buffer_size = get_buffer_size(s);
+
+	info->volume = p->gvol;
+	info->loop_count = p->loop_count;
+	info->virt_channels = p->virt.virt_channels;
+	info->virt_used = p->virt.virt_used;
+
+	info->sequence = p->sequence;
+
+	for (i = 0; i < XMP_MAX_CHANNELS / 32; i++) {
+		info->changed[i] = p->channel_changed[i];
+		p->channel_changed[i] = 0;
+	}
+}
+
+int xmp_get_channel_info(xmp_context opaque, int chn, struct xmp_channel_info *info)
+{
+	struct context_data *ctx = (struct context_data *)opaque;
+	struct module_data *m = &ctx->m;
+	struct xmp_module *mod = &m->mod;
+
+	if (ctx->state < XMP_STATE_PLAYING)
+		return -XMP_ERROR_STATE;
+
+	if (chn < 0 || chn >= mod->chn)
+		return -XMP_ERROR_INVALID;
+
+	get_channel_info(ctx, chn, info);
+
+	return 0;
+}
+
+int xmp_set_event_callback(xmp_context opaque, int events,
+			   xmp_event_callback callback, void *priv)
+{
+	struct context_data *ctx = (struct context_data *)opaque;
+	struct player_data *p = &ctx->p;
+
+	if (events & ~XMP_EVENT_ALL)
+		return -XMP_ERROR_INVALID;
+
+	p->event_callback.func = callback;
+	p->event_callback.priv = priv;
+	p->event_callback.mask = callback != NULL ? events : 0;
+
+	return 0;
+}
@@ -21,12 +21,24 @@
 #define RESET_NOTE(f)	RESET_FLAG(xc->note_flags,(f))
 #define TEST_NOTE(f)	TEST_FLAG(xc->note_flags,(f))
 
+/* Channel info change mask */
+#define SET_CHANNEL_CHANGED(c) (p->channel_changed[(c) >> 5] |= 1U << ((c) & 31))
+
 struct retrig_control {
 	int s;
 	int m;
 	int d;
 };
 
+/* Interpolation state of the last evaluated envelope position */
+struct envelope_cursor {
+	struct xmp_envelope *env;	/* NULL if not valid */
+	int x;				/* envelope position */
+	int index;			/* segment start node */
+	int q, r;			/* |y2 - y1| * (x - x1) / (x2 - x1) */
+	int val;			/* envelope value at x */
+};
+
 /* The following macros are used to set the flags for each channel */
 #define VOL_SLIDE	(1 << 0)
 #define PAN_SLIDE	(1 << 1)
@@ -106,6 +118,10 @@ struct channel_data {
 	int p_idx;		/* Pan envelope index */
 	int f_idx;		/* Freq envelope index */
 
+	struct envelope_cursor v_cur;	/* Volume envelope cursor */
+	struct envelope_cursor p_cur;	/* Pan envelope cursor */
+	struct envelope_cursor f_cur;	/* Freq envelope cursor */
+
 	int key_porta;		/* Key number for portamento target
 				 * -- needed to handle IT portamento xpo */
 	struct {
@@ -247,12 +263,33 @@ struct channel_data {
 	int info_position;	/* Position before mixing */
 	int info_finalvol;	/* Final volume including envelopes */
 	int info_finalpan;	/* Final pan including envelopes */
+
+	struct xmp_event info_event;	/* Current track event */
+};
+
+/* Resonant filter coefficients for a cutoff/resonance pair. Only the
+ * upper 7 bits of the resonance are significant, and cutoff 0xff
+ * disables the filter. Pairs are cached as they occur in a direct
+ * mapped table indexed by cutoff, offset by resonance.
+ */
+#define FILTER_NUM_CUTOFF	255
+#define FILTER_CACHE_SIZE	256	/* must be a power of 2 */
+
+struct filter_coef {
+	int key;		/* cutoff << 7 | resonance >> 1, -1 if unused */
+	int a0;
+	int b0;
+	int b1;
 };
 
 
 void	libxmp_process_fx	(struct context_data *, struct channel_data *,
 				 int, struct xmp_event *, int);
 void	libxmp_filter_setup	(int, int, int, int*, int*, int *);
+void	libxmp_filter_init	(struct context_data *);
+void	libxmp_filter_deinit	(struct context_data *);
+void	libxmp_filter_coef	(struct context_data *, int, int, int*, int*, int *);
 int	libxmp_read_event	(struct context_data *, struct xmp_event *, int);
+void	libxmp_player_event	(struct context_data *, int, int, int, int);
 
 #endif /* LIBXMP_PLAYER_H */
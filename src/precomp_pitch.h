@@ -0,0 +1,650 @@
+#define PITCH_STEPS	128
+#define PITCH_LUTLEN	1536
+#define LOG2_FRACBITS	10
+
+static const double pitch_table[1536] = {
+	 1, 0.99954883411027506, 0.99909787177121012, 0.99864711289097019,
+	 0.99819655737776147, 0.9977462051398317, 0.99729605608547012, 0.99684611012300717,
+	 0.99639636716081459, 0.99594682710730575, 0.99549748987093523, 0.99504835536019864,
+	 0.99459942348363317, 0.99415069414981727, 0.99370216726737048, 0.99325384274495365,
+	 0.99280572049126892, 0.9923578004150595, 0.9919100824251097, 0.99146256643024522,
+	 0.99101525233933274, 0.99056814006128002, 0.99012122950503612, 0.98967452057959093,
+	 0.98922801319397546, 0.988781707257262, 0.98833560267856346, 0.98788969936703419,
+	 0.98744399723186915, 0.9869984961823044, 0.98655319612761716, 0.9861080969771252,
+	 0.98566319864018759, 0.9852185010262039, 0.9847740040446149, 0.98432970760490213,
+	 0.98388561161658794, 0.98344171598923535, 0.98299802063244834, 0.98255452545587185,
+	 0.98211123036919135, 0.98166813528213293, 0.98122524010446366, 0.98078254474599136,
+	 0.98034004911656436, 0.97989775312607164, 0.97945565668444312, 0.97901375970164894,
+	 0.97857206208770009, 0.9781305637526484, 0.97768926460658567, 0.97724816455964492,
+	 0.97680726352199931, 0.97636656140386258, 0.97592605811548916, 0.97548575356717371,
+	 0.9750456476692515, 0.97460574033209846, 0.97416603146613046, 0.97372652098180423,
+	 0.97328720878961661, 0.97284809480010515, 0.97240917892384748, 0.97197046107146157,
+	 0.97153194115360586, 0.97109361908097913, 0.97065549476432023, 0.9702175681144084,
+	 0.96977983904206333, 0.96934230745814454, 0.96890497327355218, 0.96846783639922629,
+	 0.96803089674614717, 0.96759415422533546, 0.96715760874785173, 0.96672126022479676,
+	 0.96628510856731142, 0.96584915368657664, 0.96541339549381355, 0.96497783390028324,
+	 0.96454246881728678, 0.9641073001561653, 0.96367232782830003, 0.96323755174511205,
+	 0.96280297181806251, 0.96236858795865232, 0.96193440007842257, 0.96150040808895421,
+	 0.96106661190186782, 0.96063301142882418, 0.9601996065815237, 0.95976639727170687,
+	 0.9593333834111536, 0.95890056491168407, 0.95846794168515792, 0.95803551364347472,
+	 0.9576032806985737, 0.9571712427624337, 0.95673939974707367, 0.95630775156455183,
+	 0.95587629812696639, 0.95544503934645497, 0.95501397513519493, 0.95458310540540325,
+	 0.95415243006933659, 0.95372194903929119, 0.95329166222760264, 0.95286156954664636,
+	 0.95243167090883707, 0.95200196622662925, 0.95157245541251678, 0.95114313837903275,
+	 0.95071401503875019, 0.95028508530428135, 0.94985634908827765, 0.94942780630343027,
+	 0.94899945686246978, 0.94857130067816597, 0.94814333766332792, 0.94771556773080423,
+	 0.9472879907934828, 0.94686060676429074, 0.94643341555619442, 0.94600641708219957,
+	 0.94557961125535117, 0.94515299798873331, 0.9447265771954696, 0.94430034878872238,
+	 0.94387431268169353, 0.9434484687876239, 0.94302281701979374, 0.94259735729152205,
+	 0.94217208951616727, 0.94174701360712665, 0.94132212947783678, 0.94089743704177309,
+	 0.94047293621245021, 0.94004862690342172, 0.9396245090282801, 0.93920058250065697,
+	 0.93877684723422283, 0.93835330314268728, 0.93792995013979852, 0.93750678813934407,
+	 0.93708381705514998, 0.93666103680108137, 0.93623844729104233, 0.93581604843897559,
+	 0.93539384015886273, 0.9349718223647242, 0.9345499949706193, 0.93412835789064586,
+	 0.93370691103894088, 0.93328565432967958, 0.93286458767707647, 0.93244371099538415,
+	 0.93202302419889449, 0.9316025272019377, 0.93118221991888261, 0.9307621022641368,
+	 0.93034217415214659, 0.92992243549739662, 0.92950288621441024, 0.92908352621774937,
+	 0.92866435542201453, 0.92824537374184468, 0.9278265810919174, 0.92740797738694858,
+	 0.92698956254169274, 0.92657133647094292, 0.92615329908953037, 0.92573545031232496,
+	 0.92531779005423487, 0.92490031823020669, 0.92448303475522542, 0.92406593954431449,
+	 0.92364903251253549, 0.92323231357498836, 0.92281578264681141, 0.92239943964318138,
+	 0.92198328447931299, 0.92156731707045936, 0.9211515373319118, 0.92073594517899993,
+	 0.92032054052709145, 0.91990532329159247, 0.91949029338794686, 0.91907545073163699,
+	 0.91866079523818334, 0.91824632682314422, 0.91783204540211638, 0.91741795089073452,
+	 0.91700404320467122, 0.91659032225963744, 0.91617678797138191, 0.91576344025569145,
+	 0.91535027902839083, 0.91493730420534303, 0.91452451570244864, 0.91411191343564646,
+	 0.91369949732091316, 0.91328726727426313, 0.91287522321174885, 0.91246336504946057,
+	 0.91205169270352671, 0.91164020609011287, 0.91122890512542321, 0.91081778972569927,
+	 0.91040685980722036, 0.90999611528630364, 0.90958555607930425, 0.90917518210261483,
+	 0.90876499327266558, 0.90835498950592486, 0.90794517071889835, 0.90753553682812949,
+	 0.90712608775019943, 0.90671682340172688, 0.90630774369936817, 0.9058988485598175,
+	 0.90549013789980615, 0.90508161163610346, 0.90467326968551598, 0.9042651119648879,
+	 0.90385713839110104, 0.90344934888107453, 0.90304174335176512, 0.90263432172016711,
+	 0.90222708390331197, 0.90182002981826881, 0.90141315938214395, 0.90100647251208155,
+	 0.90059996912526274, 0.90019364913890609, 0.89978751247026756, 0.89938155903664052,
+	 0.89897578875535555, 0.89857020154378053, 0.89816479731932064, 0.89775957599941847,
+	 0.89735453750155358, 0.89694968174324297, 0.89654500864204079, 0.8961405181155383,
+	 0.89573621008136417, 0.89533208445718393, 0.89492814116070052, 0.89452438010965385,
+	 0.89412080122182103, 0.89371740441501613, 0.89331418960709064, 0.89291115671593257,
+	 0.89250830565946748, 0.89210563635565776, 0.89170314872250267, 0.89130084267803877,
+	 0.89089871814033927, 0.89049677502751468, 0.89009501325771223, 0.88969343274911605,
+	 0.88929203341994734, 0.88889081518846413, 0.88848977797296125, 0.88808892169177056,
+	 0.88768824626326059, 0.88728775160583684, 0.88688743763794153, 0.88648730427805378,
+	 0.88608735144468931, 0.88568757905640072, 0.88528798703177736, 0.88488857528944542,
+	 0.88448934374806742, 0.88409029232634317, 0.88369142094300857, 0.88329272951683646,
+	 0.88289421796663636, 0.88249588621125452, 0.88209773416957338, 0.88169976176051235,
+	 0.88130196890302737, 0.8809043555161109, 0.88050692151879195, 0.88010966683013592,
+	 0.87971259136924496, 0.87931569505525764, 0.87891897780734884, 0.8785224395447303,
+	 0.87812608018664973, 0.87772989965239168, 0.8773338978612768, 0.87693807473266228,
+	 0.87654243018594191, 0.87614696414054538, 0.8757516765159391, 0.87535656723162569,
+	 0.87496163620714396, 0.87456688336206945, 0.87417230861601336, 0.87377791188862375,
+	 0.87338369309958452, 0.8729896521686159, 0.87259578901547463, 0.8722021035599532,
+	 0.87180859572188063, 0.8714152654211218, 0.87102211257757822, 0.87062913711118706,
+	 0.87023633894192176, 0.8698437179897921, 0.86945127417484358, 0.86905900741715791,
+	 0.86866691763685311, 0.86827500475408281, 0.86788326868903709, 0.86749170936194153,
+	 0.86710032669305825, 0.86670912060268501, 0.86631809101115553, 0.86592723783883963,
+	 0.86553656100614307, 0.86514606043350717, 0.86475573604140965, 0.86436558775036376,
+	 0.86397561548091883, 0.86358581915365962, 0.86319619868920738, 0.86280675400821849,
+	 0.86241748503138571, 0.86202839167943712, 0.861639473873137, 0.8612507315332848,
+	 0.86086216458071629, 0.86047377293630278, 0.86008555652095098, 0.85969751525560356,
+	 0.85930964906123897, 0.85892195785887104, 0.85853444156954928, 0.85814710011435902,
+	 0.85775993341442114, 0.85737294139089171, 0.85698612396496299, 0.85659948105786243,
+	 0.85621301259085303, 0.8558267184852334, 0.85544059866233757, 0.85505465304353523,
+	 0.85466888155023146, 0.85428328410386656, 0.85389786062591666, 0.85351261103789322,
+	 0.85312753526134277, 0.85274263321784771, 0.85235790482902563, 0.8519733500165293,
+	 0.85158896870204714, 0.85120476080730278, 0.85082072625405503, 0.8504368649640982,
+	 0.85005317685926174, 0.84966966186141046, 0.84928631989244452, 0.84890315087429902,
+	 0.84852015472894449, 0.84813733137838665, 0.84775468074466631, 0.84737220274985969,
+	 0.84698989731607788, 0.84660776436546714, 0.84622580382020918, 0.84584401560252043,
+	 0.84546239963465264, 0.84508095583889242, 0.8446996841375618, 0.84431858445301744,
+	 0.84393765670765142, 0.84355690082389045, 0.84317631672419668, 0.84279590433106677,
+	 0.84241566356703268, 0.84203559435466124, 0.84165569661655415, 0.84127597027534806,
+	 0.8408964152537145, 0.84051703147436008, 0.84013781886002603, 0.83975877733348836,
+	 0.83937990681755836, 0.83900120723508176, 0.83862267850893923, 0.83824432056204623,
+	 0.83786613331735305, 0.83748811669784451, 0.83711027062654042, 0.83673259502649533,
+	 0.83635508982079831, 0.83597775493257331, 0.83560059028497891, 0.8352235958012082,
+	 0.83484677140448926, 0.8344701170180846, 0.83409363256529123, 0.83371731796944104,
+	 0.83334117315390022, 0.83296519804206981, 0.83258939255738518, 0.83221375662331654,
+	 0.83183829016336819, 0.83146299310107941, 0.83108786536002355, 0.83071290686380883,
+	 0.83033811753607756, 0.82996349730050689, 0.82958904608080808, 0.8292147638007269,
+	 0.82884065038404375, 0.82846670575457293, 0.82809292983616367, 0.8277193225526992,
+	 0.82734588382809715, 0.82697261358630958, 0.82659951175132274, 0.82622657824715728,
+	 0.82585381299786798, 0.82548121592754409, 0.82510878696030887, 0.82473652602031999,
+	 0.82436443303176943, 0.82399250791888301, 0.8236207506059211, 0.82324916101717804,
+	 0.82287773907698247, 0.82250648470969689, 0.82213539783971834, 0.82176447839147759,
+	 0.82139372628943974, 0.82102314145810384, 0.82065272382200316, 0.8202824733057047,
+	 0.81991238983380998, 0.81954247333095409, 0.81917272372180638, 0.81880314093106998,
+	 0.81843372488348221, 0.81806447550381423, 0.81769539271687119, 0.81732647644749212,
+	 0.81695772662054988, 0.81658914316095155, 0.81622072599363749, 0.8158524750435826,
+	 0.81548439023579533, 0.81511647149531774, 0.8147487187472261, 0.81438113191663031,
+	 0.81401371092867392, 0.81364645570853444, 0.81327936618142316, 0.81291244227258497,
+	 0.81254568390729853, 0.81217909101087638, 0.81181266350866443, 0.81144640132604251,
+	 0.81108030438842416, 0.81071437262125634, 0.8103486059500199, 0.80998300430022907,
+	 0.80961756759743186, 0.80925229576720981, 0.80888718873517806, 0.80852224642698522,
+	 0.80815746876831351, 0.80779285568487891, 0.80742840710243036, 0.80706412294675078,
+	 0.80670000314365642, 0.80633604761899691, 0.80597225629865565, 0.80560862910854902,
+	 0.80524516597462714, 0.80488186682287344, 0.80451873157930487, 0.80415576016997148,
+	 0.80379295252095695, 0.80343030855837816, 0.80306782820838551, 0.80270551139716229,
+	 0.80234335805092571, 0.8019813680959258, 0.80161954145844594, 0.80125787806480298,
+	 0.80089637784134671, 0.80053504071446036, 0.80017386661056045, 0.79981285545609648,
+	 0.79945200717755116, 0.79909132170144048, 0.79873079895431354, 0.79837043886275261,
+	 0.79801024135337295, 0.79765020635282313, 0.79729033378778469, 0.79693062358497224,
+	 0.7965710756711335, 0.79621168997304914, 0.79585246641753304, 0.79549340493143195,
+	 0.79513450544162567, 0.79477576787502713, 0.79441719215858198, 0.79405877821926896,
+	 0.79370052598409979, 0.79334243538011895, 0.79298450633440409, 0.79262673877406564,
+	 0.79226913262624687, 0.79191168781812393, 0.79155440427690593, 0.79119728192983463,
+	 0.79084032070418475, 0.79048352052726389, 0.79012688132641229, 0.78977040302900303,
+	 0.78941408556244197, 0.78905792885416781, 0.7887019328316518, 0.78834609742239803,
+	 0.78799042255394325, 0.78763490815385695, 0.78727955414974127, 0.78692436046923109,
+	 0.78656932703999372, 0.78621445378972932, 0.7858597406461707, 0.78550518753708298,
+	 0.78515079439026436, 0.78479656113354501, 0.78444248769478808, 0.78408857400188914,
+	 0.7837348199827765, 0.78338122556541046, 0.7830277906777845, 0.78267451524792397,
+	 0.7823213992038871, 0.7819684424737644, 0.78161564498567881, 0.78126300666778592,
+	 0.78091052744827349, 0.78055820725536174, 0.78020604601730326, 0.77985404366238309,
+	 0.77950220011891846, 0.77915051531525925, 0.7787989891797874, 0.77844762164091719,
+	 0.77809641262709528, 0.77774536206680067, 0.77739446988854433, 0.77704373602086974,
+	 0.7766931603923527, 0.77634274293160099, 0.7759924835672547, 0.77564238222798632,
+	 0.77529243884249999, 0.77494265333953261, 0.77459302564785282, 0.77424355569626169,
+	 0.77389424341359214, 0.77354508872870942, 0.77319609157051072, 0.77284725186792547,
+	 0.77249856954991503, 0.77215004454547276, 0.77180167678362421, 0.77145346619342703,
+	 0.77110541270397037, 0.77075751624437605, 0.77040977674379751, 0.77006219413142007,
+	 0.76971476833646124, 0.76936749928817028, 0.76902038691582841, 0.76867343114874898,
+	 0.76832663191627681, 0.76797998914778887, 0.76763350277269404, 0.76728717272043301,
+	 0.76694099892047796, 0.7665949813023335, 0.76624911979553556, 0.76590341432965203,
+	 0.76555786483428256, 0.76521247123905878, 0.76486723347364349, 0.76452215146773195,
+	 0.76417722515105058, 0.76383245445335768, 0.76348783930444342, 0.76314337963412948,
+	 0.76279907537226921, 0.76245492644874746, 0.76211093279348108, 0.76176709433641809,
+	 0.76142341100753863, 0.76107988273685401, 0.76073650945440729, 0.76039329109027298,
+	 0.76005022757455742, 0.75970731883739806, 0.75936456480896419, 0.75902196541945666,
+	 0.75867952059910737, 0.75833723027818012, 0.7579950943869701, 0.75765311285580383,
+	 0.75731128561503935, 0.75696961259506612, 0.75662809372630491, 0.75628672893920801,
+	 0.75594551816425903, 0.75560446133197279, 0.75526355837289583, 0.75492280921760568,
+	 0.75458221379671142, 0.75424177204085319, 0.75390148388070266, 0.75356134924696261,
+	 0.75322136807036721, 0.75288154028168197, 0.75254186581170324, 0.75220234459125901,
+	 0.75186297655120837, 0.75152376162244139, 0.75118469973587954, 0.75084579082247538,
+	 0.75050703481321279, 0.7501684316391064, 0.74982998123120237, 0.74949168352057771,
+	 0.74915353843834076, 0.7488155459156306, 0.74847770588361773, 0.7481400182735034,
+	 0.74780248301652019, 0.74746510004393152, 0.7471278692870319, 0.74679079067714671,
+	 0.74645386414563242, 0.74611708962387657, 0.74578046704329737, 0.74544399633534431,
+	 0.74510767743149753, 0.74477151026326827, 0.7444354947621985, 0.74409963085986131,
+	 0.74376391848786039, 0.74342835757783055, 0.74309294806143711, 0.74275768987037671,
+	 0.7424225829363762, 0.74208762719119381, 0.74175282256661823, 0.741418168994469,
+	 0.7410836664065964, 0.74074931473488137, 0.74041511391123593, 0.74008106386760231,
+	 0.7397471645359539, 0.73941341584829456, 0.73907981773665876, 0.73874637013311184,
+	 0.73841307296974967, 0.73807992617869866, 0.73774692969211619, 0.73741408344218973,
+	 0.73708138736113782, 0.73674884138120944, 0.73641644543468376, 0.73608419945387116,
+	 0.73575210337111208, 0.73542015711877762, 0.73508836062926952, 0.73475671383501973,
+	 0.73442521666849092, 0.73409386906217622, 0.73376267094859926, 0.73343162226031378,
+	 0.73310072292990425, 0.73276997288998558, 0.73243937207320287, 0.73210892041223186,
+	 0.7317786178397786, 0.73144846428857913, 0.73111845969140044, 0.73078860398103951,
+	 0.73045889709032352, 0.73012933895211019, 0.72979992949928763, 0.72947066866477384,
+	 0.72914155638151745, 0.7288125925824972, 0.72848377720072188, 0.72815511016923096,
+	 0.72782659142109374, 0.72749822088940974, 0.72716999850730879, 0.72684192420795102,
+	 0.72651399792452631, 0.72618621959025498, 0.72585858913838763, 0.72553110650220443,
+	 0.72520377161501626, 0.72487658441016367, 0.72454954482101752, 0.72422265278097853,
+	 0.7238959082234776, 0.72356931108197575, 0.72324286128996373, 0.72291655878096261,
+	 0.72259040348852333, 0.72226439534622666, 0.72193853428768362, 0.72161282024653506,
+	 0.72128725315645159, 0.72096183295113392, 0.72063655956431283, 0.72031143292974864,
+	 0.71998645298123187, 0.71966161965258268, 0.71933693287765121, 0.71901239259031746,
+	 0.71868799872449118, 0.718363751214112, 0.71803964999314929, 0.71771569499560239,
+	 0.71739188615550009, 0.71706822340690135, 0.71674470668389445, 0.71642133592059776,
+	 0.71609811105115917, 0.71577503200975645, 0.71545209873059679, 0.71512931114791745,
+	 0.71480666919598501, 0.71448417280909582, 0.71416182192157607, 0.71383961646778116,
+	 0.71351755638209657, 0.71319564159893711, 0.7128738720527471, 0.71255224767800074,
+	 0.71223076840920163, 0.71190943418088282, 0.71158824492760697, 0.71126720058396642,
+	 0.71094630108458279, 0.71062554636410724, 0.7103049363572207, 0.70998447099863304,
+	 0.70966415022308404, 0.70934397396534277, 0.70902394216020759, 0.70870405474250664,
+	 0.70838431164709703, 0.70806471280886552, 0.70774525816272826, 0.70742594764363065,
+	 0.70710678118654757, 0.70678775872648292, 0.70646888019847043, 0.70615014553757272,
+	 0.70583155467888181, 0.70551310755751917, 0.70519480410863533, 0.70487664426741026,
+	 0.704558627969053, 0.70424075514880191, 0.70392302574192467, 0.70360543968371791,
+	 0.70328799690950772, 0.70297069735464923, 0.70265354095452659, 0.70233652764455345,
+	 0.70201965736017236, 0.70170293003685502, 0.70138634561010238, 0.70106990401544422,
+	 0.70075360518843965, 0.70043744906467686, 0.70012143557977302, 0.69980556466937405,
+	 0.69948983626915562, 0.69917425031482161, 0.69885880674210554, 0.69854350548676969,
+	 0.69822834648460519, 0.69791332967143216, 0.69759845498310014, 0.69728372235548686,
+	 0.69696913172449959, 0.69665468302607436, 0.69634037619617584, 0.69602621117079788,
+	 0.69571218788596312, 0.69539830627772303, 0.69508456628215798, 0.69477096783537728,
+	 0.6944575108735187, 0.69414419533274929, 0.69383102114926454, 0.69351798825928901,
+	 0.6932050965990757, 0.69289234610490669, 0.6925797367130927, 0.6922672683599731,
+	 0.69195494098191601, 0.69164275451531831, 0.69133070889660553, 0.69101880406223204,
+	 0.69070703994868066, 0.69039541649246283, 0.690083933630119, 0.68977259129821789,
+	 0.689461389433357, 0.68915032797216225, 0.68883940685128853, 0.68852862600741882,
+	 0.68821798537726508, 0.68790748489756759, 0.68759712450509536, 0.68728690413664562,
+	 0.68697682372904456, 0.68666688321914637, 0.68635708254383421, 0.68604742164001931,
+	 0.68573790044464156, 0.68542851889466927, 0.6851192769270994, 0.68481017447895676,
+	 0.68450121148729526, 0.6841923878891969, 0.68388370362177175, 0.6835751586221589,
+	 0.68326675282752525, 0.68295848617506627, 0.68265035860200596, 0.68234237004559617,
+	 0.68203452044311752, 0.68172680973187871, 0.68141923784921665, 0.68111180473249666,
+	 0.68080451031911238, 0.68049735454648552, 0.68019033735206602, 0.67988345867333233,
+	 0.67957671844779066, 0.67927011661297576, 0.67896365310645057, 0.6786573278658059,
+	 0.67835114082866088, 0.67804509193266305, 0.67773918111548759, 0.67743340831483811,
+	 0.67712777346844633, 0.67682227651407201, 0.67651691738950281, 0.67621169603255482,
+	 0.67590661238107186, 0.67560166637292596, 0.67529685794601724, 0.67499218703827357,
+	 0.67468765358765093, 0.67438325753213368, 0.67407899880973365, 0.67377487735849062,
+	 0.6734708931164729, 0.67316704602177613, 0.67286333601252424, 0.67255976302686882,
+	 0.67225632700298965, 0.67195302787909406, 0.67164986559341766, 0.67134684008422352,
+	 0.67104395128980288, 0.67074119914847463, 0.67043858359858566, 0.67013610457851047,
+	 0.66983376202665146, 0.66953155588143898, 0.6692294860813307, 0.66892755256481273,
+	 0.66862575527039825, 0.66832409413662863, 0.66802256910207292, 0.66772118010532766,
+	 0.66741992708501718, 0.66711880997979367, 0.66681782872833695, 0.66651698326935427,
+	 0.66621627354158075, 0.66591569948377916, 0.66561526103473967, 0.66531495813328045,
+	 0.66501479071824687, 0.66471475872851227, 0.66441486210297718, 0.66411510078057001,
+	 0.6638154747002466, 0.66351598380099031, 0.66321662802181192, 0.66291740730175008,
+	 0.66261832157987066, 0.66231937079526704, 0.66202055488706002, 0.66172187379439829,
+	 0.66142332745645738, 0.66112491581244059, 0.66082663880157877, 0.66052849636312994,
+	 0.66023048843637955, 0.6599326149606406, 0.65963487587525338, 0.65933727111958551,
+	 0.65903980063303202, 0.65874246435501527, 0.6584452622249849, 0.65814819418241799,
+	 0.65785126016681883, 0.6575544601177189, 0.65725779397467732, 0.65696126167728008,
+	 0.65666486316514061, 0.65636859837789963, 0.65607246725522494, 0.6557764697368117,
+	 0.65548060576238221, 0.6551848752716859, 0.6548892782044996, 0.65459381450062715,
+	 0.65429848409989955, 0.65400328694217491, 0.65370822296733866, 0.65341329211530308,
+	 0.65311849432600766, 0.65282382953941931, 0.65252929769553147, 0.65223489873436513,
+	 0.65194063259596791, 0.65164649922041495, 0.65135249854780797, 0.65105863051827606,
+	 0.65076489507197521, 0.65047129214908828, 0.6501778216898253, 0.64988448363442319,
+	 0.64959127792314586, 0.64929820449628406, 0.64900526329415575, 0.64871245425710533,
+	 0.64841977732550482, 0.64812723243975257, 0.64783481954027389, 0.6475425385675212,
+	 0.64725038946197366, 0.6469583721641371, 0.64666648661454473, 0.64637473275375601,
+	 0.64608311052235734, 0.64579161986096234, 0.64550026071021083, 0.64520903301076982,
+	 0.64491793670333286, 0.6446269717286206, 0.64433613802737988, 0.64404543554038485,
+	 0.64375486420843597, 0.64346442397236059, 0.64317411477301278, 0.64288393655127318,
+	 0.64259388924804905, 0.64230397280427465, 0.64201418716091063, 0.6417245322589441,
+	 0.64143500803938913, 0.64114561444328633, 0.64085635141170272, 0.6405672188857322,
+	 0.64027821680649499, 0.63998934511513794, 0.63970060375283466, 0.63941199266078486,
+	 0.6391235117802152, 0.63883516105237881, 0.63854694041855509, 0.63825884982004988,
+	 0.637970889198196, 0.63768305849435236, 0.63739535764990418, 0.63710778660626355,
+	 0.63682034530486864, 0.63653303368718417, 0.63624585169470138, 0.63595879926893772,
+	 0.63567187635143707, 0.63538508288376994, 0.63509841880753271, 0.63481188406434841,
+	 0.63452547859586661, 0.63423920234376274, 0.63395305524973888, 0.63366703725552331,
+	 0.63338114830287051, 0.63309538833356138, 0.63280975728940314, 0.63252425511222909,
+	 0.63223888174389875, 0.63195363712629804, 0.63166852120133909, 0.63138353391095992,
+	 0.63109867519712537, 0.63081394500182586, 0.6305293432670781, 0.63024486993492534,
+	 0.6299605249474366, 0.62967630824670706, 0.62939221977485826, 0.62910825947403759,
+	 0.62882442728641863, 0.62854072315420118, 0.62825714701961088, 0.62797369882489973,
+	 0.62769037851234555, 0.62740718602425227, 0.6271241213029497, 0.62684118429079416,
+	 0.62655837493016731, 0.62627569316347731, 0.62599313893315811, 0.62571071218166963,
+	 0.62542841285149775, 0.62514624088515436, 0.62486419622517719, 0.62458227881412998,
+	 0.62430048859460241, 0.62401882550920984, 0.62373728950059382, 0.62345588051142176,
+	 0.6231745984843865, 0.62289344336220731, 0.62261241508762899, 0.6223315136034222,
+	 0.62205073885238338, 0.62177009077733503, 0.62148956932112509, 0.62120917442662749,
+	 0.620928906036742, 0.62064876409439407, 0.62036874854253465, 0.62008885932414093,
+	 0.61980909638221549, 0.61952945965978645, 0.61924994909990827, 0.61897056464566047,
+	 0.61869130624014856, 0.6184121738265036, 0.61813316734788248, 0.61785428674746745,
+	 0.61757553196846671, 0.61729690295411377, 0.61701839964766791, 0.61674002199241429,
+	 0.61646176993166313, 0.61618364340875043, 0.61590564236703793, 0.61562776674991282,
+	 0.61535001650078769, 0.6150723915631009, 0.61479489188031611, 0.61451751739592253,
+	 0.61424026805343501, 0.61396314379639383, 0.61368614456836457, 0.61340927031293846,
+	 0.61313252097373228, 0.61285589649438776, 0.61257939681857276, 0.61230302188997987,
+	 0.61202677165232755, 0.61175064604935958, 0.61147464502484494, 0.61119876852257804,
+	 0.61092301648637881, 0.61064738886009229, 0.61037188558758892, 0.61009650661276471,
+	 0.60982125187954073, 0.60954612133186326, 0.60927111491370423, 0.60899623256906044,
+	 0.60872147424195422, 0.60844683987643322, 0.60817232941657007, 0.6078979428064627,
+	 0.60762367999023448, 0.60734954091203375, 0.60707552551603405, 0.60680163374643437,
+	 0.60652786554745863, 0.6062542208633559, 0.60598069963840062, 0.60570730181689214,
+	 0.60543402734315499, 0.60516087616153891, 0.60488784821641883, 0.60461494345219435,
+	 0.60434216181329081, 0.60406950324415798, 0.60379696768927116, 0.60352455509313041,
+	 0.60325226540026089, 0.60298009855521295, 0.60270805450256193, 0.60243613318690792,
+	 0.6021643345528761, 0.60189265854511698, 0.60162110510830558, 0.60134967418714202,
+	 0.60107836572635154, 0.6008071796706842, 0.60053611596491496, 0.60026517455384365,
+	 0.59999435538229517, 0.59972365839511921, 0.59945308353719029, 0.59918263075340783,
+	 0.59891229998869622, 0.5986420911880046, 0.59837200429630699, 0.59810203925860206,
+	 0.59783219601991366, 0.5975624745252901, 0.59729287471980463, 0.59702339654855541,
+	 0.59675403995666487, 0.59648480488928091, 0.59621569129157559, 0.59594669910874609,
+	 0.59567782828601401, 0.59540907876862592, 0.59514045050185294, 0.59487194343099092,
+	 0.59460355750136051, 0.59433529265830687, 0.59406714884719969, 0.59379912601343365,
+	 0.59353122410242798, 0.59326344305962619, 0.59299578283049692, 0.59272824336053309,
+	 0.59246082459525218, 0.59219352648019652, 0.59192634896093266, 0.59165929198305212,
+	 0.59139235549217051, 0.59112553943392832, 0.59085884375399045, 0.59059226839804635,
+	 0.59032581331180989, 0.59005947844101947, 0.58979326373143792, 0.58952716912885283,
+	 0.58926119457907578, 0.58899534002794307, 0.58872960542131558, 0.58846399070507815,
+	 0.58819849582514061, 0.58793312072743686, 0.58766786535792503, 0.58740272966258811,
+	 0.58713771358743305, 0.58687281707849126, 0.58660804008181866, 0.58634338254349527,
+	 0.58607884440962565, 0.58581442562633868, 0.5855501261397873, 0.5852859458961488,
+	 0.58502188484162509, 0.58475794292244199, 0.58449412008484958, 0.58423041627512251,
+	 0.58396683143955941, 0.5837033655244831, 0.58344001847624083, 0.58317679024120384,
+	 0.58291368076576766, 0.58265068999635217, 0.58238781787940108, 0.58212506436138256,
+	 0.58186242938878874, 0.58159991290813606, 0.58133751486596486, 0.58107523520883986,
+	 0.5808130738833498, 0.58055103083610726, 0.58028910601374939, 0.58002729936293695,
+	 0.57976561083035516, 0.57950404036271297, 0.57924258790674354, 0.57898125340920392,
+	 0.57872003681687556, 0.57845893807656334, 0.5781979571350967, 0.57793709393932868,
+	 0.57767634843613647, 0.57741572057242119, 0.57715521029510797, 0.5768948175511458,
+	 0.57663454228750766, 0.57637438445119038, 0.57611434398921479, 0.57585442084862559,
+	 0.57559461497649134, 0.57533492631990457, 0.5750753548259816, 0.5748159004418627,
+	 0.57455656311471182, 0.57429734279171674, 0.57403823942008947, 0.57377925294706544,
+	 0.57352038331990385, 0.57326163048588785, 0.5730029943923246, 0.57274447498654446,
+	 0.57248607221590209, 0.57222778602777569, 0.57196961636956711, 0.57171156318870209,
+	 0.57145362643263009, 0.57119580604882403, 0.57093810198478079, 0.57068051418802102,
+	 0.57042304260608867, 0.5701656871865517, 0.56990844787700146, 0.5696513246250533,
+	 0.56939431737834578, 0.56913742608454154, 0.56888065069132632, 0.56862399114640982,
+	 0.56836744739752532, 0.56811101939242947, 0.56785470707890273, 0.56759851040474907,
+	 0.56734242931779566, 0.56708646376589378, 0.5668306136969179, 0.56657487905876591,
+	 0.5663192597993596, 0.56606375586664393, 0.56580836720858718, 0.56555309377318175,
+	 0.56529793550844287, 0.56504289236240945, 0.56478796428314404, 0.56453315121873238,
+	 0.56427845311728353, 0.56402386992693021, 0.56376940159582856, 0.5635150480721578,
+	 0.56326080930412092, 0.56300668523994413, 0.56275267582787669, 0.56249878101619166,
+	 0.56224500075318529, 0.56199133498717713, 0.56173778366650995, 0.56148434673954994,
+	 0.56123102415468651, 0.56097781586033246, 0.56072472180492394, 0.56047174193691995,
+	 0.56021887620480337, 0.55996612455707973, 0.55971348694227807, 0.55946096330895068,
+	 0.55920855360567301, 0.55895625778104374, 0.55870407578368464, 0.55845200756224067,
+	 0.55820005306538012, 0.55794821224179447, 0.55769648504019798, 0.5574448714093283,
+	 0.55719337129794622, 0.5569419846548358, 0.55669071142880378, 0.55643955156868041,
+	 0.55618850502331874, 0.55593757174159508, 0.55568675167240877, 0.55543604476468211,
+	 0.55518545096736061, 0.55493497022941252, 0.55468460249982954, 0.5544343477276259,
+	 0.55418420586183936, 0.55393417685153012, 0.5536842606457818, 0.55343445719370088,
+	 0.55318476644441672, 0.55293518834708144, 0.55268572285087059, 0.55243636990498235,
+	 0.55218712945863768, 0.55193800146108085, 0.55168898586157866, 0.5514400826094209,
+	 0.55119129165392045, 0.55094261294441282, 0.55069404643025632, 0.55044559206083243,
+	 0.55019724978554507, 0.54994901955382136, 0.54970090131511096, 0.54945289501888661,
+	 0.54920500061464339, 0.54895721805189968, 0.54870954728019639, 0.54846198824909709,
+	 0.54821454090818844, 0.54796720520707942, 0.5477199810954021, 0.54747286852281107,
+	 0.54722586743898372, 0.54697897779362004, 0.54673219953644292, 0.54648553261719779,
+	 0.54623897698565271, 0.54599253259159852, 0.5457461993848487, 0.54549997731523914,
+	 0.54525386633262884, 0.54500786638689891, 0.54476197742795329, 0.54451619940571871,
+	 0.54427053227014421, 0.54402497597120147, 0.54377953045888483, 0.54353419568321115,
+	 0.54328897159421974, 0.54304385814197276, 0.54279885527655447, 0.5425539629480719,
+	 0.5423091811066546, 0.54206450970245468, 0.54181994868564642, 0.5415754980064269,
+	 0.5413311576150156, 0.54108692746165432, 0.54084280749660762, 0.54059879767016206,
+	 0.54035489793262692, 0.54011110823433395, 0.53986742852563707, 0.53962385875691277,
+	 0.53938039887855993, 0.53913704884099967, 0.53889380859467562, 0.53865067809005374,
+	 0.5384076572776223, 0.53816474610789189, 0.53792194453139552, 0.53767925249868842,
+	 0.53743666996034822, 0.53719419686697478, 0.53695183316919015, 0.53670957881763892,
+	 0.53646743376298778, 0.53622539795592561, 0.53598347134716373, 0.53574165388743555,
+	 0.53549994552749669, 0.53525834621812507, 0.53501685591012094, 0.53477547455430641,
+	 0.53453420210152591, 0.53429303850264642, 0.53405198370855655, 0.53381103767016724,
+	 0.53357020033841185, 0.53332947166424538, 0.5330888515986455, 0.53284834009261151,
+	 0.53260793709716514, 0.53236764256335012, 0.53212745644223225, 0.53188737868489944,
+	 0.53164740924246157, 0.53140754806605073, 0.53116779510682099, 0.53092815031594831,
+	 0.53068861364463105, 0.53044918504408922, 0.53020986446556484, 0.52997065186032233,
+	 0.52973154717964765, 0.52949255037484888, 0.52925366139725638, 0.52901488019822185,
+	 0.52877620672911951, 0.52853764094134514, 0.52829918278631671, 0.52806083221547395,
+	 0.52782258918027858, 0.52758445363221418, 0.5273464255227861, 0.52710850480352178,
+	 0.52687069142597054, 0.52663298534170333, 0.52639538650231321, 0.52615789485941478,
+	 0.52592051036464471, 0.52568323296966146, 0.52544606262614513, 0.5252089992857979,
+	 0.52497204290034361, 0.52473519342152775, 0.52449845080111779, 0.52426181499090274,
+	 0.52402528594269349, 0.52378886360832277, 0.5235525479396449, 0.52331633888853601,
+	 0.52308023640689372, 0.52284424044663769, 0.52260835095970903, 0.52237256789807052,
+	 0.52213689121370688, 0.52190132085862428, 0.52166585678485045, 0.52143049894443494,
+	 0.52119524728944899, 0.52096010177198526, 0.52072506234415805, 0.52049012895810354,
+	 0.52025530156597899, 0.52002058011996388, 0.51978596457225879, 0.51955145487508603,
+	 0.51931705098068937, 0.51908275284133432, 0.51884856040930782, 0.51861447363691826,
+	 0.51838049247649565, 0.51814661688039132, 0.5179128468009786, 0.51767918219065168,
+	 0.5174456230018265, 0.51721216918694057, 0.5169788206984528, 0.51674557748884342,
+	 0.51651243951061421, 0.51627940671628836, 0.51604647905841061, 0.5158136564895468,
+	 0.51558093896228441, 0.51534832642923223, 0.51511581884302049, 0.51488341615630084,
+	 0.51465111832174604, 0.51441892529205047, 0.51418683701992973, 0.51395485345812075,
+	 0.51372297455938187, 0.51349120027649264, 0.51325953056225393, 0.51302796536948803,
+	 0.51279650465103832, 0.51256514835976952, 0.51233389644856786, 0.51210274887034035,
+	 0.51187170557801565, 0.51164076652454349, 0.51140993166289495, 0.51117920094606206,
+	 0.51094857432705831, 0.51071805175891838, 0.51048763319469792, 0.51025731858747414,
+	 0.51002710789034489, 0.50979700105642967, 0.50956699803886896, 0.50933709879082434,
+	 0.50910730326547837, 0.50887761141603516, 0.50864802319571956, 0.50841853855777763,
+	 0.50818915745547655, 0.50795987984210456, 0.50773070567097101, 0.50750163489540623,
+	 0.50727266746876187, 0.50704380334441013, 0.50681504247574471, 0.50658638481618012,
+	 0.50635783031915205, 0.50612937893811683, 0.50590103062655234, 0.5056727853379569,
+	 0.50544464302585024, 0.50521660364377274, 0.50498866714528601, 0.50476083348397238,
+	 0.50453310261343531, 0.50430547448729901, 0.50407794905920877, 0.50385052628283078,
+	 0.50362320611185196, 0.50339598849998035, 0.50316887340094485, 0.5029418607684949,
+	 0.50271495055640136, 0.50248814271845565, 0.50226143720846972, 0.50203483398027704,
+	 0.50180833298773142, 0.50158193418470765, 0.50135563752510126, 0.50112944296282858,
+	 0.50090335045182688, 0.50067735994605411, 0.50045147139948887, 0.50022568476613072,
+};
+
+static const double log2_table[1024] = {
+	 0, 0.0014081943928083891, 0.0028150156070540383, 0.0042204663181950848,
+	 0.0056245491938781067, 0.0070272668939685033, 0.008428622070580729, 0.0098286173681083767,
+	 0.011227255423254121, 0.012624538865059513, 0.014020470314934629, 0.015415052386687583,
+	 0.016808287686553892, 0.018200178813225686, 0.019590728357880817, 0.020979938904211775,
+	 0.02236781302845451, 0.023754353299417091, 0.025139562278508231, 0.02652344251976568,
+	 0.027905996569884486, 0.029287226968245102, 0.030667136246941378, 0.032045726930808413,
+	 0.03342300153745028, 0.034798962577267598, 0.036173612553484981, 0.037546953962178407,
+	 0.03891898929230235, 0.040289721025716888, 0.04165915163721462, 0.04302728359454748,
+	 0.044394119358453436, 0.045759661382683017, 0.047123912114025744, 0.048486873992336477,
+	 0.049848549450561531, 0.051208940914764793, 0.052568050804153624, 0.053925881531104683,
+	 0.055282435501189608, 0.056637715113200593, 0.05799172275917585, 0.05934446082442494,
+	 0.060695931687553946, 0.062046137720490599, 0.063395081288509292, 0.06474276475025588,
+	 0.066089190457772437, 0.067434360756521913, 0.068778277985412611, 0.070120944476822641,
+	 0.071462362556624137, 0.072802534544207528, 0.07414146275250548, 0.075479149488016914,
+	 0.076815597050830894, 0.078150807734650246, 0.079484783826815258, 0.08081752760832718,
+	 0.082149041353871563, 0.083479327331841671, 0.084808387804361549, 0.086136225027309166,
+	 0.087462841250339401, 0.088788238716906873, 0.090112419664288707, 0.091435386323607218,
+	 0.092757140919852446, 0.094077685671904651, 0.09539702279255656, 0.096715154488535751,
+	 0.09803208296052672, 0.09934781040319289, 0.10066233900519864, 0.10197567094923111,
+	 0.10328780841202195, 0.10459875356436894, 0.10590850857115762, 0.1072170755913826,
+	 0.10852445677816906, 0.10983065427879393, 0.11113567023470704, 0.11243950678155223,
+	 0.11374216604918833, 0.11504365016170993, 0.11634396123746832, 0.11764310138909199,
+	 0.11894107272350743, 0.12023787734195948, 0.12153351734003176, 0.1228279948076671,
+	 0.12412131182918758, 0.12541347048331486, 0.12670447284319011, 0.12799432097639396,
+	 0.12928301694496647, 0.13057056280542675, 0.13185696060879284, 0.13314221240060117,
+	 0.13442632022092613, 0.13570928610439942, 0.13699111208022957, 0.1382718001722211,
+	 0.13955135239879357, 0.14082977077300085, 0.14210705730255008, 0.14338321398982046,
+	 0.14465824283188233, 0.14593214582051564, 0.14720492494222884, 0.14847658217827733,
+	 0.14974711950468206, 0.15101653889224789, 0.15228484230658193, 0.15355203170811185,
+	 0.15481810905210402, 0.15608307628868168, 0.1573469353628428, 0.15860968821447824,
+	 0.15987133677838941, 0.16113188298430628, 0.16239132875690487, 0.163649676015825,
+	 0.16490692667568779, 0.16616308264611329, 0.16741814583173756, 0.16867211813223043,
+	 0.16992500144231237, 0.17117679765177185, 0.17242750864548248, 0.17367713630341991,
+	 0.1749256825006788, 0.17617314910748991, 0.1774195379892366, 0.17866485100647178,
+	 0.17990909001493449, 0.18115225686556649, 0.18239435340452886, 0.1836353814732184,
+	 0.18487534290828386, 0.18611423954164261, 0.18735207320049643, 0.1885888457073481,
+	 0.18982455888001723, 0.19105921453165634, 0.19229281447076688, 0.1935253605012151,
+	 0.19475685442224785, 0.19598729802850848, 0.19721669311005219, 0.19844504145236208,
+	 0.1996723448363644, 0.2008986050384442, 0.20212382383046074, 0.20334800297976263,
+	 0.20457114424920358, 0.20579324939715726, 0.20701432017753246, 0.20823435833978843,
+	 0.20945336562894978, 0.21067134378562147, 0.21188829454600366, 0.21310421964190671,
+	 0.21431912080076582, 0.21553299974565582, 0.21674585819530587, 0.21795769786411395,
+	 0.21916852046216156, 0.22037832769522805, 0.22158712126480504, 0.22279490286811091,
+	 0.22400167419810504, 0.22520743694350198, 0.22641219278878569, 0.22761594341422361,
+	 0.22881869049588086, 0.23002043570563407, 0.23122118071118544, 0.23242092717607649,
+	 0.23361967675970205, 0.23481743111732398, 0.2360141919000848, 0.23720996075502146,
+	 0.23840473932507894, 0.23959852924912353, 0.24079133216195689, 0.24198314969432877,
+	 0.24317398347295094, 0.2443638351205103, 0.24555270625568207, 0.24674059849314328,
+	 0.24792751344358552, 0.24911345271372839, 0.25029841790633245, 0.25148241062021204,
+	 0.25266543245024864, 0.25384748498740323, 0.25502856981872957, 0.25620868852738665,
+	 0.2573878426926518, 0.25856603388993293, 0.25974326369078149, 0.26091953366290505,
+	 0.26209484537017941, 0.26326920037266166, 0.26444260022660221, 0.26561504648445733,
+	 0.26678654069490138, 0.26795708440283905, 0.2691266791494179, 0.27029532647204002,
+	 0.2714630279043746, 0.27262978497636975, 0.27379559921426466, 0.27496047214060154,
+	 0.27612440527423759, 0.27728740013035663, 0.27844945822048139, 0.27961058105248499,
+	 0.28077077013060259, 0.28193002695544328, 0.28308835302400187, 0.28424574982967005,
+	 0.28540221886224831, 0.28655776160795737, 0.28771237954944939, 0.28886607416581983,
+	 0.29001884693261831, 0.29117069932186057, 0.29232163280203893, 0.29347164883813437,
+	 0.29462074889162704, 0.29576893442050778, 0.29691620687928921, 0.29806256771901651,
+	 0.29920801838727884, 0.30035256032821989, 0.30149619498254904, 0.30263892378755231,
+	 0.30378074817710293, 0.30492166958167249, 0.30606168942834133, 0.30720080914080949,
+	 0.30833903013940722, 0.30947635384110589, 0.31061278165952821, 0.31174831500495892,
+	 0.31288295528435539, 0.31401670390135794, 0.31514956225630042, 0.31628153174622031,
+	 0.3174126137648694, 0.31854280970272381, 0.31967212094699443, 0.320800548881637,
+	 0.32192809488736235, 0.32305476034164654, 0.32418054661874102, 0.3253054550896825,
+	 0.32642948712230313, 0.32755264408124046, 0.32867492732794734, 0.32979633822070176,
+	 0.33091687811461695, 0.33203654836165097, 0.33315535031061649, 0.33427328530719069,
+	 0.33539035469392492, 0.33650655981025435, 0.33762190199250752, 0.33873638257391625,
+	 0.33985000288462475, 0.34096276425169947, 0.34207466799913855, 0.34318571544788112,
+	 0.34429590791581688, 0.34540524671779543, 0.3465137331656355, 0.34762136856813453,
+	 0.34872815423107756, 0.34983409145724681, 0.35093918154643078, 0.35204342579543324,
+	 0.35314682549808257, 0.3542493819452408, 0.35535109642481266, 0.35645197022175457,
+	 0.35755200461808373, 0.35865120089288688, 0.35974956032232958, 0.36084708417966466,
+	 0.3619437737352415, 0.36303963025651437, 0.36413465500805176, 0.36522884925154475,
+	 0.36632221424581579, 0.36741475124682765, 0.36850646150769167, 0.3695973462786768,
+	 0.37068740680721768, 0.3717766443379239, 0.37286506011258774, 0.37395265537019334,
+	 0.37503943134692475, 0.3761253892761745, 0.37721053038855196, 0.37829485591189177,
+	 0.37937836707126216, 0.38046106508897315, 0.38154295118458498, 0.38262402657491629,
+	 0.38370429247405224, 0.38478375009335281, 0.38586240064146093, 0.38694024532431054,
+	 0.38801728534513474, 0.38909352190447399, 0.39016895620018355, 0.39124358942744231,
+	 0.39231742277876031, 0.39339045744398649, 0.39446269461031708, 0.39553413546230315,
+	 0.39660478118185843, 0.3976746329482676, 0.39874369193819326, 0.39981195932568453,
+	 0.40087943628218431, 0.40194612397653712, 0.40301202357499677, 0.40407713624123393,
+	 0.40514146313634392, 0.40620500541885418, 0.40726776424473182, 0.40832974076739126,
+	 0.40939093613770178, 0.4104513515039947, 0.4115109880120712, 0.41256984680520953,
+	 0.4136279290241725, 0.41468523580721478, 0.41574176829009046, 0.41679752760606004,
+	 0.41785251488589786, 0.41890673125789957, 0.41996017784788908, 0.42101285577922593,
+	 0.42206476617281236, 0.42311591014710065, 0.42416628881810015, 0.42521590329938436,
+	 0.42626475470209796, 0.42731284413496418, 0.42836017270429139, 0.42940674151398034,
+	 0.43045255166553142, 0.43149760425805089, 0.43254190038825852, 0.43358544115049419,
+	 0.43462822763672465, 0.4356702609365507, 0.43671154213721375, 0.43775207232360275,
+	 0.43879185257826092, 0.43983088398139258, 0.44086916761086981, 0.44190670454223913,
+	 0.44294349584872833, 0.443979542601253, 0.4450148458684231, 0.44604940671654997,
+	 0.4470832262096523, 0.44811630540946312, 0.44914864537543642, 0.45018024716475336,
+	 0.45121111183232882, 0.45224124043081809, 0.45327063401062317, 0.45429929361989912,
+	 0.45532722030456074, 0.45635441510828845, 0.45738087907253533, 0.45840661323653276,
+	 0.45943161863729726, 0.46045589630963663, 0.46147944728615592, 0.46250227259726417,
+	 0.46352437327118035, 0.46454575033393936, 0.46556640480939881, 0.46658633771924468,
+	 0.46760555008299748, 0.46862404291801851, 0.46964181723951615, 0.4706588740605514,
+	 0.47167521439204446, 0.47269083924278033, 0.47370574961941531, 0.47471994652648236,
+	 0.47573343096639775, 0.47674620393946637, 0.47775826644388808, 0.47876961947576352,
+	 0.47978026402909973, 0.48079020109581649, 0.48179943166575179, 0.48280795672666776,
+	 0.4838157772642564, 0.4848228942621457, 0.48582930870190472, 0.48683502156305014,
+	 0.48784003382305141, 0.48884434645733643, 0.48984796043929779, 0.49085087674029787,
+	 0.49185309632967472, 0.49285462017474752, 0.49385544924082253, 0.49485558449119815,
+	 0.49585502688717104, 0.49685377738804115, 0.49785183695111779, 0.4988492065317246,
+	 0.49984588708320538, 0.50084187955692938, 0.5018371849022969, 0.50283180406674444,
+	 0.5038257379957507, 0.50481898763284128, 0.50581155391959443, 0.50680343779564618,
+	 0.50779464019869636, 0.50878516206451263, 0.50977500432693712, 0.51076416791789092,
+	 0.51175265376737966, 0.51274046280349828, 0.51372759595243733, 0.51471405413848681,
+	 0.51569983828404253, 0.51668494930961029, 0.51766938813381191, 0.51865315567338999,
+	 0.5196362528432128, 0.52061868055627991, 0.52160043972372672, 0.52258153125483009,
+	 0.52356195605701294, 0.52454171503584923, 0.52552080909506971, 0.52649923913656604,
+	 0.52747700606039605, 0.52845411076478921, 0.52943055414615092, 0.53040633709906782,
+	 0.53138146051631208, 0.53235592528884768, 0.5333297323058338, 0.53430288245463053,
+	 0.53527537662080338, 0.53624721568812816, 0.53721840053859626, 0.53818893205241869,
+	 0.53915881110803132, 0.5401280385820999, 0.54109661534952391, 0.54206454228344236,
+	 0.54303182025523777, 0.54399845013454129, 0.54496443278923712, 0.54592976908546742,
+	 0.54689445988763663, 0.54785850605841668, 0.54882190845875112, 0.54978466794785963,
+	 0.55074678538324329, 0.55170826162068842, 0.55266909751427185, 0.55362929391636462,
+	 0.55458885167763738, 0.55554777164706448, 0.55650605467192815, 0.55746370159782399,
+	 0.55842071326866438, 0.55937709052668327, 0.56033283421244129, 0.56128794516482916,
+	 0.56224242422107262, 0.56319627221673718, 0.56414948998573167, 0.56510207836031334,
+	 0.56605403817109179, 0.56700537024703346, 0.56795607541546633, 0.56890615450208348,
+	 0.56985560833094784, 0.57080443772449663, 0.57175264350354549, 0.57270022648729224,
+	 0.573647187493322, 0.57459352733761093, 0.5755392468345305, 0.57648434679685157,
+	 0.57742882803574869, 0.57837269136080471, 0.5793159375800141, 0.58025856749978788,
+	 0.58120058192495716, 0.58214198165877751, 0.58308276750293342, 0.58402294025754176,
+	 0.58496250072115619, 0.58590144969077129, 0.58683978796182656, 0.58777751632821029,
+	 0.58871463558226367, 0.58965114651478534, 0.5905870499150343, 0.59152234657073488,
+	 0.59245703726808041, 0.59339112279173689, 0.59432460392484743, 0.59525748144903579,
+	 0.59618975614441028, 0.59712142878956842, 0.59805250016159994, 0.59898297103609088,
+	 0.5999128421871277, 0.60084211438730117, 0.60177078840771014, 0.60269886501796488,
+	 0.60362634498619194, 0.60455322907903697, 0.60547951806166922, 0.60640521269778469,
+	 0.60733031374961066, 0.60825482197790892, 0.60917873814197931, 0.61010206299966441,
+	 0.61102479730735226, 0.61194694181998077, 0.61286849729104065, 0.61378946447258032,
+	 0.61470984411520824, 0.61562963696809758, 0.61654884377898933, 0.61746746529419638,
+	 0.61838550225860656, 0.6193029554156867, 0.62021982550748644, 0.62113611327464113,
+	 0.62205181945637622, 0.62296694479051029, 0.6238814900134585, 0.62479545586023699,
+	 0.62570884306446528, 0.62662165235837075, 0.62753388447279179, 0.62844554013718112,
+	 0.62935662007960969, 0.63026712502676963, 0.63117705570397842, 0.63208641283518197,
+	 0.63299519714295782, 0.63390340934851919, 0.63481105017171768, 0.63571812033104769,
+	 0.63662462054364888, 0.6375305515253098, 0.63843591399047184, 0.63934070865223169,
+	 0.6402449362223458, 0.64114859741123265, 0.64205169292797681, 0.64295422348033204,
+	 0.6438561897747247, 0.64475759251625697, 0.64565843240871013, 0.64655871015454813,
+	 0.64745842645492035, 0.64835758200966553, 0.64925617751731446, 0.65015421367509385,
+	 0.65105169117892858, 0.65194861072344634, 0.65284497300197941, 0.65374077870656877,
+	 0.65463602852796743, 0.65553072315564265, 0.65642486327778027, 0.65731844958128727,
+	 0.65821148275179475, 0.65910396347366174, 0.65999589242997758, 0.660887270302566,
+	 0.66177809777198715, 0.66266837551754154, 0.66355810421727301, 0.66444728454797153,
+	 0.66533591718517626, 0.66622400280317928, 0.66711154207502776, 0.66799853567252787,
+	 0.6688849842662471, 0.6697708885255178, 0.67065624911843991, 0.67154106671188429,
+	 0.67242534197149562, 0.67330907556169495, 0.67419226814568345, 0.67507492038544492,
+	 0.6759570329417488, 0.6768386064741535, 0.67771964164100862, 0.67860013909945893,
+	 0.67948009950544608, 0.68035952351371276, 0.68123841177780486, 0.68211676495007445,
+	 0.68299458368168287, 0.68387186862260385, 0.68474862042162565, 0.6856248397263548,
+	 0.68650052718321841, 0.68737568343746713, 0.6882503091331782, 0.68912440491325799,
+	 0.68999797141944541, 0.69087100929231382, 0.69174351917127475, 0.69261550169458008,
+	 0.69348695749932521, 0.69435788722145186, 0.69522829149575038, 0.69609817095586324,
+	 0.69696752623428715, 0.6978363579623762, 0.69870466677034448, 0.69957245328726902,
+	 0.70043971814109218, 0.70130646195862456, 0.70217268536554767, 0.7030383889864168,
+	 0.7039035734446637, 0.7047682393625988, 0.70563238736141465, 0.706496018061188,
+	 0.70735913208088275, 0.70822173003835276, 0.70908381255034381, 0.70994538023249709,
+	 0.71080643369935159, 0.71166697356434627, 0.71252700043982331, 0.71338651493703009,
+	 0.71424551766612265, 0.71510400923616746, 0.71596199025514429, 0.71681946132994911,
+	 0.71767642306639612, 0.71853287606922078, 0.71938882094208234, 0.72024425828756578,
+	 0.72109918870718515, 0.7219536128013857, 0.72280753116954666, 0.72366094440998319,
+	 0.72451385311994976, 0.7253662578956418, 0.72621815933219869, 0.72706955802370632,
+	 0.7279204545631992, 0.72877084954266336, 0.72962074355303863, 0.7304701371842206,
+	 0.73131903102506413, 0.732167425663385, 0.73301532168596262, 0.73386271967854244,
+	 0.73470962022583819, 0.73555602391153474, 0.73640193131829024, 0.7372473430277382,
+	 0.73809225962049041, 0.73893668167613946, 0.73978060977326021, 0.74062404448941344,
+	 0.74146698640114694, 0.74230943608399902, 0.74315139411249975, 0.7439928610601747,
+	 0.74483383749954557, 0.74567432400213418, 0.74651432113846361, 0.74735382947806106,
+	 0.74819284958946031, 0.74903138204020359, 0.74986942739684403, 0.75070698622494825,
+	 0.75154405908909816, 0.75238064655289383, 0.75321674917895498, 0.75405236752892424,
+	 0.75488750216346856, 0.75572215364228168, 0.756556322524087, 0.75739000936663869,
+	 0.75822321472672494, 0.75905593916016978, 0.75988818322183505, 0.76071994746562333,
+	 0.76155123244447931, 0.76238203871039278, 0.76321236681440019, 0.76404221730658717,
+	 0.76487159073609068, 0.76570048765110121, 0.76652890859886458, 0.76735685412568511,
+	 0.76818432477692633, 0.76901132109701453, 0.76983784362944019, 0.77066389291675963,
+	 0.77148946950059838, 0.7723145739216527, 0.77313920671969116, 0.77396336843355773,
+	 0.77478705960117333, 0.7756102807595382, 0.77643303244473305, 0.77725531519192304,
+	 0.77807712953535824, 0.77889847600837614, 0.77971935514340407, 0.78053976747196108,
+	 0.78135971352465972, 0.78217919383120837, 0.78299820892041372, 0.78381675932018169,
+	 0.78463484555752061, 0.78545246815854275, 0.78626962764846609, 0.78708632455161698,
+	 0.78790255939143161, 0.78871833269045843, 0.78953364497035983, 0.79034849675191432,
+	 0.79116288855501837, 0.79197682089868859, 0.79279029430106396, 0.7936033092794067,
+	 0.79441586635010597, 0.79522796602867818, 0.79603960882976987, 0.79685079526715985,
+	 0.79766152585376016, 0.79847180110161886, 0.79928162152192206, 0.80009098762499486,
+	 0.80089989992030475, 0.80170835891646208, 0.80251636512122282, 0.80332391904149048,
+	 0.80413102118331781, 0.80493767205190825, 0.80574387215161891, 0.80654962198596114,
+	 0.80735492205760406, 0.80815977286837481, 0.8089641749192612, 0.8097681287104137,
+	 0.81057163474114691, 0.81137469350994185, 0.81217730551444733, 0.81297947125148229,
+	 0.81378119121703718, 0.81458246590627603, 0.81538329581353863, 0.81618368143234155,
+	 0.81698362325538099, 0.81778312177453327, 0.81858217748085815, 0.81938079086459958,
+	 0.82017896241518784, 0.82097669262124096, 0.82177398197056772, 0.82257083095016792,
+	 0.82336724004623518, 0.82416320974415802, 0.82495874052852247, 0.8257538328831131,
+	 0.82654848729091501, 0.82734270423411582, 0.82813648419410701, 0.82892982765148648,
+	 0.82972273508605865, 0.83051520697683823, 0.83130724380205079, 0.83209884603913442,
+	 0.83289001416474173, 0.83368074865474195, 0.83447104998422206, 0.83526091862748864,
+	 0.83605035505806979, 0.83683935974871648, 0.83762793317140483, 0.83841607579733712,
+	 0.83920378809694396, 0.83999107053988564, 0.84077792359505443, 0.84156434773057509,
+	 0.84235034341380799, 0.84313591111134956, 0.84392105128903461, 0.84470576441193768,
+	 0.84549005094437524, 0.84627391134990648, 0.84705734609133554, 0.84784035563071325,
+	 0.84862294042933806, 0.84940510094775845, 0.8501868376457743, 0.85096815098243817,
+	 0.85174904141605756, 0.85252950940419592, 0.85330955540367459, 0.85408917987057409,
+	 0.8548683832602364, 0.85564716602726576, 0.85642552862553079, 0.85720347150816567,
+	 0.85798099512757209, 0.85875809993542085, 0.8595347863826529, 0.86031105491948168,
+	 0.86108690599539373, 0.86186234005915141, 0.86263735755879367, 0.86341195894163769,
+	 0.86418614465428023, 0.86495991514260007, 0.86573327085175877, 0.86650621222620205,
+	 0.86727873970966196, 0.86805085374515811, 0.86882255477499903, 0.86959384324078404,
+	 0.87036471958340456, 0.87113518424304548, 0.87190523765918682, 0.87267488027060558,
+	 0.87344411251537657, 0.87421293483087426, 0.87498134765377455, 0.87574935142005561,
+	 0.87651694656499979, 0.87728413352319512, 0.87805091272853686, 0.87881728461422826,
+	 0.87958324961278322, 0.88034880815602667, 0.88111396067509662, 0.8818787076004454,
+	 0.88264304936184135, 0.88340698638836967, 0.88417051910843503, 0.88493364794976159,
+	 0.88569637333939533, 0.88645869570370528, 0.88722061546838493, 0.88798213305845408,
+	 0.88874324889825917, 0.88950396341147564, 0.89026427702110944, 0.89102419014949752,
+	 0.89178370321831024, 0.89254281664855206, 0.89330153086056341, 0.89405984627402202,
+	 0.8948177633079436, 0.89557528238068451, 0.89633240390994195, 0.89708912831275633,
+	 0.89784545600551169, 0.89860138740393769, 0.89935692292311109, 0.9001120629774565,
+	 0.90086680798074859, 0.90162115834611234, 0.90237511448602559, 0.90312867681231945,
+	 0.90388184573618024, 0.90463462166815056, 0.90538700501813074, 0.9061389961953803,
+	 0.90689059560851848, 0.90764180366552716, 0.90839262077375049, 0.90914304733989726,
+	 0.90989308377004197, 0.91064273046962607, 0.91139198784345932, 0.91214085629572106,
+	 0.9128893362299616, 0.91363742804910353, 0.91438513215544293, 0.91513244895065038,
+	 0.91587937883577319, 0.91662592221123584, 0.91737207947684118, 0.91811785103177257,
+	 0.91886323727459451, 0.91960823860325369, 0.92035285541508105, 0.92109708810679247,
+	 0.92184093707449, 0.92258440271366382, 0.92332748541919218, 0.92407018558534459,
+	 0.92481250360578082, 0.92555443987355424, 0.92629599478111158, 0.92703716872029474,
+	 0.92777796208234209, 0.92851837525788994, 0.92925840863697307, 0.9299980626090264,
+	 0.93073733756288635, 0.93147623388679179, 0.93221475196838532, 0.93295289219471467,
+	 0.9336906549522338, 0.93442804062680396, 0.93516504960369506, 0.93590168226758697,
+	 0.93663793900257064, 0.9373738201921491, 0.93810932621923881, 0.93884445746617107,
+	 0.93957921431469305, 0.94031359714596885, 0.9410476063405806, 0.94178124227853022,
+	 0.94251450533923997, 0.9432473959015536, 0.94397991434373862, 0.94471206104348582,
+	 0.94544383637791163, 0.94617524072355874, 0.94690627445639763, 0.94763693795182768,
+	 0.94836723158467762, 0.94909715572920805, 0.94982671075911096, 0.95055589704751209,
+	 0.95128471496697198, 0.95201316488948651, 0.95274124718648823, 0.95346896222884792,
+	 0.95419631038687525, 0.95492329203032023, 0.95564990752837398, 0.95637615724967007,
+	 0.95710204156228629, 0.95782756083374387, 0.95855271543101117, 0.95927750572050263,
+	 0.96000193206808104, 0.96072599483905807, 0.96144969439819594, 0.96217303110970809,
+	 0.9628960053372605, 0.9636186174439727, 0.96434086779241845, 0.9650627567446276,
+	 0.96578428466208699, 0.96650545190574122, 0.96722625883599367, 0.9679467058127077,
+	 0.96866679319520854, 0.96938652134228265, 0.97010589061218067, 0.97082490136261701,
+	 0.97154355395077197, 0.97226184873329191, 0.97297978606629099, 0.97369736630535197,
+	 0.97441458980552709, 0.97513145692133973, 0.97584796800678475, 0.97656412341532972,
+	 0.97727992349991655, 0.97799536861296155, 0.97871045910635723, 0.97942519533147332,
+	 0.98013957763915716, 0.9808536063797354, 0.98156728190301468, 0.98228060455828292,
+	 0.98299357469431026, 0.98370619265934944, 0.98441845880113821, 0.98513037346689902,
+	 0.98584193700334044, 0.98655314975665898, 0.98726401207253867, 0.98797452429615296,
+	 0.98868468677216581, 0.98939449984473249, 0.9901039638575001, 0.99081307915360939,
+	 0.99152184607569538, 0.99223026496588806, 0.99293833616581384, 0.99364606001659661,
+	 0.99435343685885802, 0.99506046703271922, 0.99576715087780143, 0.99647348873322739,
+	 0.99717948093762143, 0.99788512782911121, 0.99859042974532874, 0.9992953870234107,
+};
+
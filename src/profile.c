@@ -0,0 +1,75 @@
+/* Extended Module Player
+ * Copyright (C) 1996-2021 Claudio Matsuoka and Hipolito Carraro Jr
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "common.h"
+#include "profile.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+/* Get a monotonic timestamp in nanoseconds. Also used by the mixer to
+ * measure its cost against the CPU budget.
+ */
+double libxmp_profile_time(void)
+{
+#if defined(_WIN32)
+	LARGE_INTEGER count, freq;
+
+	QueryPerformanceCounter(&count);
+	QueryPerformanceFrequency(&freq);
+
+	return (double)count.QuadPart * 1e9 / freq.QuadPart;
+#elif defined(HAVE_CLOCK_GETTIME)
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (double)ts.tv_sec * 1e9 + ts.tv_nsec;
+#else
+	return (double)clock() * 1e9 / CLOCKS_PER_SEC;
+#endif
+}
+
+int xmp_get_profile(xmp_context opaque, struct xmp_profile *info)
+{
+#ifdef LIBXMP_PROFILE
+	struct context_data *ctx = (struct context_data *)opaque;
+
+	memcpy(info, &ctx->prof.data, sizeof(struct xmp_profile));
+
+	return 0;
+#else
+	return -XMP_ERROR_INVALID;
+#endif
+}
+
+void xmp_reset_profile(xmp_context opaque)
+{
+#ifdef LIBXMP_PROFILE
+	struct context_data *ctx = (struct context_data *)opaque;
+
+	memset(&ctx->prof.data, 0, sizeof(struct xmp_profile));
+#endif
+}
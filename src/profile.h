@@ -0,0 +1,26 @@
+#ifndef LIBXMP_PROFILE_H
+#define LIBXMP_PROFILE_H
+
+/* Player profiling counters, enabled with LIBXMP_PROFILE. Stage start
+ * times are kept in struct profile_data with the same name as the
+ * corresponding xmp_profile total.
+ */
+
+double	libxmp_profile_time	(void);
+
+#ifdef LIBXMP_PROFILE
+
+#define PROFILE_START(ctx,x) ((ctx)->prof.x = libxmp_profile_time())
+#define PROFILE_STOP(ctx,x) \
+	((ctx)->prof.data.x += libxmp_profile_time() - (ctx)->prof.x)
+#define PROFILE_COUNT(ctx,x,n) ((ctx)->prof.data.x += (n))
+
+#else
+
+#define PROFILE_START(ctx,x) ((void)0)
+#define PROFILE_STOP(ctx,x) ((void)0)
+#define PROFILE_COUNT(ctx,x,n) ((void)0)
+
+#endif
+
+#endif /* LIBXMP_PROFILE_H */
@@ -354,6 +354,7 @@ static int read_event_mod(struct context_data *ctx, struct xmp_event *e, int chn
 
 	if (note >= 0) {
 		xc->note = note;
+		libxmp_player_event(ctx, XMP_EVENT_NOTE, chn, xc->key, xc->ins);
 		libxmp_virt_voicepos(ctx, chn, xc->offset.val);
 	}
 
@@ -708,6 +709,7 @@ static int read_event_ft2(struct context_data *ctx, struct xmp_event *e, int chn
 
 	if (note >= 0) {
 		xc->note = note;
+		libxmp_player_event(ctx, XMP_EVENT_NOTE, chn, xc->key, xc->ins);
 
 		/* From the OpenMPT test cases (3xx-no-old-samp.xm):
 		 * "An offset effect that points beyond the sample end should
@@ -866,6 +868,7 @@ static int read_event_st3(struct context_data *ctx, struct xmp_event *e, int chn
 
 	if (note >= 0) {
 		xc->note = note;
+		libxmp_player_event(ctx, XMP_EVENT_NOTE, chn, xc->key, xc->ins);
 		libxmp_virt_voicepos(ctx, chn, xc->offset.val);
 	}
 
@@ -1336,6 +1339,7 @@ static int read_event_it(struct context_data *ctx, struct xmp_event *e, int chn)
 
 	if (note >= 0) {
 		xc->note = note;
+		libxmp_player_event(ctx, XMP_EVENT_NOTE, chn, xc->key, xc->ins);
 		libxmp_virt_voicepos(ctx, chn, xc->offset.val);
 	}
 
@@ -1490,6 +1494,7 @@ static int read_event_med(struct context_data *ctx, struct xmp_event *e, int chn
 
 	if (note >= 0) {
 		xc->note = note;
+		libxmp_player_event(ctx, XMP_EVENT_NOTE, chn, xc->key, xc->ins);
 		libxmp_virt_voicepos(ctx, chn, xc->offset.val);
 	}
 
@@ -1590,18 +1595,9 @@ static int read_event_smix(struct context_data *ctx, struct xmp_event *e, int ch
 	return 0;
 }
 
-int libxmp_read_event(struct context_data *ctx, struct xmp_event *e, int chn)
+static int read_event(struct context_data *ctx, struct xmp_event *e, int chn)
 {
-	struct player_data *p = &ctx->p;
 	struct module_data *m = &ctx->m;
-	struct channel_data *xc = &p->xc_data[chn];
-
-	if (e->ins != 0)
-		xc->old_ins = e->ins;
-
-	if (TEST_NOTE(NOTE_SAMPLE_END)) {
-		SET_NOTE(NOTE_END);
-	}
 
 	if (chn >= m->mod.chn) {
 		return read_event_smix(ctx, e, chn);
@@ -1624,3 +1620,32 @@ int libxmp_read_event(struct context_data *ctx, struct xmp_event *e, int chn)
 		return read_event_mod(ctx, e, chn);
 	}
 }
+
+int libxmp_read_event(struct context_data *ctx, struct xmp_event *e, int chn)
+{
+	struct player_data *p = &ctx->p;
+	struct module_data *m = &ctx->m;
+	struct channel_data *xc = &p->xc_data[chn];
+	int key, ins, smp, ret;
+
+	if (e->ins != 0)
+		xc->old_ins = e->ins;
+
+	if (TEST_NOTE(NOTE_SAMPLE_END)) {
+		SET_NOTE(NOTE_END);
+	}
+
+	key = xc->key;
+	ins = xc->ins;
+	smp = xc->smp;
+
+	ret = read_event(ctx, e, chn);
+
+	/* For xmp_get_frame_status() */
+	if (chn < m->mod.chn &&
+	    (xc->key != key || xc->ins != ins || xc->smp != smp)) {
+		SET_CHANNEL_CHANGED(chn);
+	}
+
+	return ret;
+}
@@ -0,0 +1,334 @@
+/* Extended Module Player
+ * Copyright (C) 1996-2021 Claudio Matsuoka and Hipolito Carraro Jr
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/* Render-ahead playback. A player thread renders frames into a single
+ * producer, single consumer ring buffer while the application reads
+ * them from its audio callback without taking any lock. Other player
+ * calls are serialized with the player thread by a mutex and take
+ * effect after the audio already in the ring has been read.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "common.h"
+
+#if defined(HAVE_PTHREAD_H) && defined(HAVE_PTHREAD_CREATE)
+#define RENDER_AHEAD_THREADS
+#include <pthread.h>
+#include <time.h>
+#endif
+
+#ifdef RENDER_AHEAD_THREADS
+
+#if defined(__GNUC__) || defined(__clang__)
+#define LOAD_ACQUIRE(x)		__atomic_load_n(&(x), __ATOMIC_ACQUIRE)
+#define STORE_RELEASE(x,v)	__atomic_store_n(&(x), (v), __ATOMIC_RELEASE)
+#else
+#define LOAD_ACQUIRE(x)		(x)
+#define STORE_RELEASE(x,v)	((x) = (v))
+#endif
+
+struct render_ahead {
+	struct context_data *ctx;
+	pthread_t thread;
+	pthread_mutex_t lock;
+	uint8 *ring;
+	uint32 size;		/* ring size, a power of two */
+	uint32 lead;		/* bytes to keep rendered ahead */
+	uint32 frame_bytes;	/* bytes per sample frame */
+	volatile uint32 head;	/* written by the player thread only */
+	volatile uint32 tail;	/* written by the reader only */
+	volatile int end;	/* module ended, set by the player thread */
+	volatile int quit;
+};
+
+static int sample_frame_bytes(struct mixer_data *s)
+{
+	int size = 1;
+
+	if (~s->format & XMP_FORMAT_8BIT) {
+		size *= 2;
+	}
+	if (~s->format & XMP_FORMAT_MONO) {
+		size *= 2;
+	}
+
+	return size;
+}
+
+/* Copy rendered data to the ring, which has room for it */
+static void ring_write(struct render_ahead *ra, const void *data, uint32 len)
+{
+	uint32 head = ra->head;
+	uint32 pos = head & (ra->size - 1);
+	uint32 n = ra->size - pos;
+
+	if (n > len) {
+		n = len;
+	}
+	memcpy(ra->ring + pos, data, n);
+	memcpy(ra->ring, (const uint8 *)data + n, len - n);
+
+	STORE_RELEASE(ra->head, head + len);
+}
+
+static void *render_thread(void *arg)
+{
+	struct render_ahead *ra = (struct render_ahead *)arg;
+	struct context_data *ctx = ra->ctx;
+	struct mixer_data *s = &ctx->s;
+	struct timespec ts;
+	uint32 used, len;
+	int ret;
+
+	while (!LOAD_ACQUIRE(ra->quit)) {
+		used = ra->head - LOAD_ACQUIRE(ra->tail);
+
+		/* Keep the lead time, and room for a full frame */
+		if (used >= ra->lead || ra->size - used < s->framesize * 2) {
+			ts.tv_sec = 0;
+			ts.tv_nsec = 1000000;
+			nanosleep(&ts, NULL);
+			continue;
+		}
+
+		pthread_mutex_lock(&ra->lock);
+		ret = xmp_play_frame((xmp_context)ctx);
+		len = s->ticksize * ra->frame_bytes;
+		if (len > s->framesize * 2) {
+			len = s->framesize * 2;
+		}
+		if (ret == 0) {
+			ring_write(ra, s->buffer, len);
+		}
+		pthread_mutex_unlock(&ra->lock);
+
+		if (ret < 0) {
+			STORE_RELEASE(ra->end, 1);
+			break;
+		}
+	}
+
+	return NULL;
+}
+
+#endif /* RENDER_AHEAD_THREADS */
+
+static int start_render_ahead(xmp_context opaque, int lead)
+{
+#ifdef RENDER_AHEAD_THREADS
+	struct context_data *ctx = (struct context_data *)opaque;
+	struct player_data *p = &ctx->p;
+	struct mixer_data *s = &ctx->s;
+	struct render_ahead *ra;
+	uint32 size;
+
+	if (ctx->state < XMP_STATE_PLAYING) {
+		return -XMP_ERROR_STATE;
+	}
+
+	if (p->render_ahead != NULL || lead < 1 || lead > 10000) {
+		return -XMP_ERROR_INVALID;
+	}
+
+	ra = libxmp_calloc(1, sizeof(struct render_ahead));
+	if (ra == NULL) {
+		goto err;
+	}
+
+	ra->ctx = ctx;
+	ra->frame_bytes = sample_frame_bytes(s);
+	ra->lead = (uint32)((double)s->freq * lead / 1000) * ra->frame_bytes;
+
+	/* Room for the lead time and one more frame */
+	for (size = 1; size < ra->lead + s->framesize * 2; size <<= 1);
+	ra->size = size;
+
+	ra->ring = libxmp_malloc(size);
+	if (ra->ring == NULL) {
+		goto err1;
+	}
+
+	if (pthread_mutex_init(&ra->lock, NULL) != 0) {
+		goto err2;
+	}
+
+	if (pthread_create(&ra->thread, NULL, render_thread, ra) != 0) {
+		goto err3;
+	}
+
+	p->render_ahead = ra;
+
+	return 0;
+
+    err3:
+	pthread_mutex_destroy(&ra->lock);
+    err2:
+	libxmp_free(ra->ring);
+    err1:
+	libxmp_free(ra);
+    err:
+	return -XMP_ERROR_SYSTEM;
+#else
+	return -XMP_ERROR_SYSTEM;
+#endif
+}
+
+int xmp_start_render_ahead(xmp_context opaque, int lead)
+{
+	struct context_data *ctx = (struct context_data *)opaque;
+	struct alloc_class *old;
+	int ret;
+
+	old = libxmp_enter_allocator(ctx, ALLOC_PLAYER);
+	ret = start_render_ahead(opaque, lead);
+	libxmp_leave_allocator(old);
+
+	return ret;
+}
+
+static void end_render_ahead(xmp_context opaque)
+{
+#ifdef RENDER_AHEAD_THREADS
+	struct context_data *ctx = (struct context_data *)opaque;
+	struct player_data *p = &ctx->p;
+	struct render_ahead *ra = p->render_ahead;
+
+	if (ra == NULL) {
+		return;
+	}
+
+	STORE_RELEASE(ra->quit, 1);
+	pthread_join(ra->thread, NULL);
+	pthread_mutex_destroy(&ra->lock);
+
+	libxmp_free(ra->ring);
+	libxmp_free(ra);
+	p->render_ahead = NULL;
+#endif
+}
+
+void xmp_end_render_ahead(xmp_context opaque)
+{
+	struct context_data *ctx = (struct context_data *)opaque;
+	struct alloc_class *old;
+
+	old = libxmp_enter_allocator(ctx, ALLOC_PLAYER);
+	end_render_ahead(opaque);
+	libxmp_leave_allocator(old);
+}
+
+/* Called from the audio callback: never blocks */
+int xmp_read_render_ahead(xmp_context opaque, void *buffer, int size)
+{
+#ifdef RENDER_AHEAD_THREADS
+	struct context_data *ctx = (struct context_data *)opaque;
+	struct player_data *p = &ctx->p;
+	struct render_ahead *ra = p->render_ahead;
+	uint32 head, tail, pos, len, n;
+
+	if (ra == NULL || size < 0) {
+		return -XMP_ERROR_STATE;
+	}
+
+	/* Read the end flag first, so no data written before it is lost */
+	n = LOAD_ACQUIRE(ra->end);
+	head = LOAD_ACQUIRE(ra->head);
+	tail = ra->tail;
+
+	len = head - tail;
+	if (len == 0 && n) {
+		return -XMP_END;
+	}
+
+	/* Only copy whole sample frames */
+	if (len > (uint32)size) {
+		len = size;
+	}
+	len -= len % ra->frame_bytes;
+
+	pos = tail & (ra->size - 1);
+	n = ra->size - pos;
+	if (n > len) {
+		n = len;
+	}
+	memcpy(buffer, ra->ring + pos, n);
+	memcpy((uint8 *)buffer + n, ra->ring, len - n);
+
+	STORE_RELEASE(ra->tail, tail + len);
+
+	/* Underrun: pad with silence (unsigned output is 8 bit only) */
+	if (len < (uint32)size) {
+		int fill = ctx->s.format & XMP_FORMAT_UNSIGNED ? 0x80 : 0;
+		memset((uint8 *)buffer + len, fill, size - len);
+	}
+
+	return len;
+#else
+	return -XMP_ERROR_STATE;
+#endif
+}
+
+int xmp_render_ahead_latency(xmp_context opaque)
+{
+#ifdef RENDER_AHEAD_THREADS
+	struct context_data *ctx = (struct context_data *)opaque;
+	struct player_data *p = &ctx->p;
+	struct mixer_data *s = &ctx->s;
+	struct render_ahead *ra = p->render_ahead;
+	uint32 used;
+
+	if (ra == NULL) {
+		return -XMP_ERROR_STATE;
+	}
+
+	used = LOAD_ACQUIRE(ra->head) - LOAD_ACQUIRE(ra->tail);
+
+	return (int)((double)used / ra->frame_bytes * 1000 / s->freq);
+#else
+	return -XMP_ERROR_STATE;
+#endif
+}
+
+void xmp_lock_render_ahead(xmp_context opaque)
+{
+#ifdef RENDER_AHEAD_THREADS
+	struct context_data *ctx = (struct context_data *)opaque;
+	struct render_ahead *ra = ctx->p.render_ahead;
+
+	if (ra != NULL) {
+		pthread_mutex_lock(&ra->lock);
+	}
+#endif
+}
+
+void xmp_unlock_render_ahead(xmp_context opaque)
+{
+#ifdef RENDER_AHEAD_THREADS
+	struct context_data *ctx = (struct context_data *)opaque;
+	struct render_ahead *ra = ctx->p.render_ahead;
+
+	if (ra != NULL) {
+		pthread_mutex_unlock(&ra->lock);
+	}
+#endif
+}
@@ -0,0 +1,244 @@
+/* Extended Module Player
+ * Copyright (C) 1996-2021 Claudio Matsuoka and Hipolito Carraro Jr
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/* Process-wide store of converted sample data. Identical sample buffers,
+ * including the interpolation guard areas, are kept once and shared by
+ * reference count between samples of the same module and between modules
+ * loaded in different player contexts.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "common.h"
+#include "effects.h"
+#include "loaders/loader.h"
+#include "sample_store.h"
+
+#if defined(HAVE_PTHREAD_H) && defined(HAVE_PTHREAD_CREATE)
+#include <pthread.h>
+
+static pthread_mutex_t store_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+#define STORE_LOCK()	pthread_mutex_lock(&store_mutex)
+#define STORE_UNLOCK()	pthread_mutex_unlock(&store_mutex)
+
+#elif defined(_WIN32)
+#include <windows.h>
+
+static volatile LONG store_mutex;
+
+#define STORE_LOCK() do { \
+	while (InterlockedExchange(&store_mutex, 1)) Sleep(0); \
+} while (0)
+#define STORE_UNLOCK()	InterlockedExchange(&store_mutex, 0)
+
+#else
+#define STORE_LOCK()
+#define STORE_UNLOCK()
+#endif
+
+#define STORE_BUCKETS	256
+
+struct sample_block {
+	struct sample_block *next;
+	uint32 hash;
+	int refs;
+	int size;		/* buffer size including guard bytes */
+	int pad;
+	/* buffer follows */
+};
+
+static struct sample_block *store[STORE_BUCKETS];
+
+#define BLOCK_BUFFER(b)	((uint8 *)((b) + 1))
+
+/* Size of the sample buffer allocated by libxmp_load_sample(), including
+ * four guard bytes before the data and four extra samples after it.
+ */
+static int buffer_size(struct xmp_sample *xxs)
+{
+	int size = xxs->len + 4;
+
+	if (xxs->flg & XMP_SAMPLE_16BIT) {
+		size *= 2;
+	}
+
+	return size + 4;
+}
+
+/* 32-bit FNV-1a */
+static uint32 buffer_hash(const uint8 *buf, int size)
+{
+	uint32 hash = 2166136261U;
+	int i;
+
+	for (i = 0; i < size; i++) {
+		hash ^= buf[i];
+		hash *= 16777619U;
+	}
+
+	return hash;
+}
+
+static struct sample_block *find_block(uint8 *buf, int size, uint32 hash)
+{
+	struct sample_block *b;
+
+	for (b = store[hash % STORE_BUCKETS]; b != NULL; b = b->next) {
+		if (b->hash == hash && b->size == size &&
+				memcmp(BLOCK_BUFFER(b), buf, size) == 0) {
+			return b;
+		}
+	}
+
+	return NULL;
+}
+
+/* Replace the sample data with a shared copy from the store. The private
+ * buffer is released on success.
+ */
+static int share_sample(struct xmp_sample *xxs)
+{
+	struct sample_block *b;
+	uint8 *buf = xxs->data - 4;
+	int size = buffer_size(xxs);
+	uint32 hash = buffer_hash(buf, size);
+
+	STORE_LOCK();
+
+	/* Blocks outlive the context that created them, so they always
+	 * come from the C library
+	 */
+	b = find_block(buf, size, hash);
+	if (b == NULL) {
+		b = malloc(sizeof(struct sample_block) + size);
+		if (b == NULL) {
+			STORE_UNLOCK();
+			return -1;
+		}
+		memcpy(BLOCK_BUFFER(b), buf, size);
+		b->hash = hash;
+		b->size = size;
+		b->refs = 0;
+		b->next = store[hash % STORE_BUCKETS];
+		store[hash % STORE_BUCKETS] = b;
+	}
+	b->refs++;
+
+	STORE_UNLOCK();
+
+	libxmp_free_sample(xxs);
+	xxs->data = BLOCK_BUFFER(b) + 4;
+
+	return 0;
+}
+
+static void release_sample(struct xmp_sample *xxs)
+{
+	struct sample_block *b, **prev;
+
+	b = (struct sample_block *)(xxs->data - 4) - 1;
+
+	STORE_LOCK();
+
+	if (--b->refs == 0) {
+		prev = &store[b->hash % STORE_BUCKETS];
+		while (*prev != b) {
+			prev = &(*prev)->next;
+		}
+		*prev = b->next;
+		free(b);
+	}
+
+	STORE_UNLOCK();
+
+	xxs->data = NULL;
+}
+
+static int is_invloop(int fxt, int fxp)
+{
+	return fxt == FX_EXTENDED && MSN(fxp) == EX_INVLOOP && LSN(fxp) != 0;
+}
+
+/* The invert loop effect writes to the sample data while playing, so
+ * samples of modules using it can't be shared.
+ */
+static int uses_invloop(struct xmp_module *mod)
+{
+	int i, j;
+
+	for (i = 0; i < mod->trk; i++) {
+		struct xmp_track *xxt = mod->xxt[i];
+
+		if (xxt == NULL) {
+			continue;
+		}
+		for (j = 0; j < xxt->rows; j++) {
+			struct xmp_event *e = &xxt->event[j];
+
+			if (is_invloop(e->fxt, e->fxp) ||
+			    is_invloop(e->f2t, e->f2p)) {
+				return 1;
+			}
+		}
+	}
+
+	return 0;
+}
+
+void libxmp_share_samples(struct context_data *ctx)
+{
+	struct module_data *m = &ctx->m;
+	struct xmp_module *mod = &m->mod;
+	int i;
+
+	if (mod->smp <= 0 || uses_invloop(mod)) {
+		return;
+	}
+
+	m->shared = libxmp_calloc(mod->smp, 1);
+	if (m->shared == NULL) {
+		return;
+	}
+
+	for (i = 0; i < mod->smp; i++) {
+		struct xmp_sample *xxs = &mod->xxs[i];
+
+		if (xxs->data == NULL || xxs->flg & XMP_SAMPLE_SYNTH) {
+			continue;
+		}
+		if (share_sample(xxs) == 0) {
+			m->shared[i] = 1;
+		}
+	}
+}
+
+void libxmp_release_sample(struct module_data *m, int num)
+{
+	struct xmp_sample *xxs = &m->mod.xxs[num];
+
+	if (m->shared != NULL && m->shared[num] && xxs->data != NULL) {
+		release_sample(xxs);
+	} else {
+		libxmp_free_sample(xxs);
+	}
+}
@@ -0,0 +1,7 @@
+#ifndef LIBXMP_SAMPLE_STORE_H
+#define LIBXMP_SAMPLE_STORE_H
+
+void	libxmp_share_samples	(struct context_data *);
+void	libxmp_release_sample	(struct module_data *, int);
+
+#endif /* LIBXMP_SAMPLE_STORE_H */
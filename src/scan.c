@@ -526,26 +526,55 @@ int libxmp_scan_sequences(struct context_data *ctx)
 	struct module_data *m = &ctx->m;
 	struct xmp_module *mod = &m->mod;
 	struct scan_data *s;
-	int i, ep;
+	struct ord_data *oinfo;
+	struct xmp_sequence *sd;
+	unsigned char *sc;
+	int i, ep, len;
 	int seq;
 	unsigned char temp_ep[XMP_MAX_MOD_LENGTH];
 
-	s = realloc(p->scan, MAX(1, mod->len) * sizeof(struct scan_data));
+	/* Order and sequence data are sized by the module length, with an
+	 * extra order for the restart position check at the end of the
+	 * module. There can't be more sequences than orders.
+	 */
+	len = mod->len + 1;
+
+	s = libxmp_realloc(p->scan, MAX(1, mod->len) * sizeof(struct scan_data));
 	if (!s) {
 		D_(D_CRIT "failed to allocate scan data");
 		return -1;
 	}
 	p->scan = s;
 
+	oinfo = libxmp_realloc(m->xxo_info, len * sizeof(struct ord_data));
+	if (oinfo == NULL) {
+		return -1;
+	}
+	m->xxo_info = oinfo;
+
+	sd = libxmp_realloc(m->seq_data, MIN(MAX(1, mod->len), MAX_SEQUENCES) *
+					sizeof(struct xmp_sequence));
+	if (sd == NULL) {
+		return -1;
+	}
+	m->seq_data = sd;
+
+	sc = libxmp_realloc(p->sequence_control, len);
+	if (sc == NULL) {
+		return -1;
+	}
+	p->sequence_control = sc;
+
 	/* Initialize order data to prevent overwrite when a position is used
 	 * multiple times at different starting points (see janosik.xm).
 	 */
-	for (i = 0; i < XMP_MAX_MOD_LENGTH; i++) {
+	memset(m->xxo_info, 0, len * sizeof(struct ord_data));
+	for (i = 0; i < len; i++) {
 		m->xxo_info[i].time = -1;
 	}
 
 	ep = 0;
-	memset(p->sequence_control, 0xff, XMP_MAX_MOD_LENGTH);
+	memset(p->sequence_control, 0xff, len);
 	temp_ep[0] = 0;
 	p->scan[0].time = scan_module(ctx, ep, 0);
 	seq = 1;
@@ -576,7 +605,7 @@ int libxmp_scan_sequences(struct context_data *ctx)
 	}
 
 	if (seq < mod->len) {
-		s = realloc(p->scan, seq * sizeof(struct scan_data));
+		s = libxmp_realloc(p->scan, seq * sizeof(struct scan_data));
 		if (s != NULL) {
 			p->scan = s;
 		}
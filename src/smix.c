@@ -20,12 +20,17 @@
  * THE SOFTWARE.
  */
 
+#include <math.h>
 #include "common.h"
-#include "period.h"
 #include "player.h"
+#include "virtual.h"
 #include "hio.h"
 #include "loaders/loader.h"
 
+#define SMIX_VOICE_FREE		0
+#define SMIX_VOICE_PENDING	1
+#define SMIX_VOICE_PLAYING	2
+
 
 struct xmp_instrument *libxmp_get_instrument(struct context_data *ctx, int ins)
 {
@@ -63,7 +68,7 @@ struct xmp_sample *libxmp_get_sample(struct context_data *ctx, int smp)
 	return xxs;
 }
 
-int xmp_start_smix(xmp_context opaque, int chn, int smp)
+static int start_smix(xmp_context opaque, int chn, int smp)
 {
 	struct context_data *ctx = (struct context_data *)opaque;
 	struct smix_data *smix = &ctx->smix;
@@ -72,27 +77,63 @@ int xmp_start_smix(xmp_context opaque, int chn, int smp)
 		return -XMP_ERROR_STATE;
 	}
 
-	smix->xxi = calloc(sizeof (struct xmp_instrument), smp);
+	smix->xxi = libxmp_calloc(sizeof (struct xmp_instrument), smp);
 	if (smix->xxi == NULL) {
 		goto err;
 	}
-	smix->xxs = calloc(sizeof (struct xmp_sample), smp);
+	smix->xxs = libxmp_calloc(sizeof (struct xmp_sample), smp);
 	if (smix->xxs == NULL) {
 		goto err1;
 	}
+	smix->xtra = libxmp_calloc(sizeof (struct smix_sample), smp);
+	if (smix->xtra == NULL) {
+		goto err2;
+	}
+	smix->voice = libxmp_calloc(sizeof (struct smix_voice), chn);
+	if (smix->voice == NULL) {
+		goto err3;
+	}
+	smix->free_voice = libxmp_calloc(sizeof (int), chn);
+	if (smix->free_voice == NULL) {
+		goto err4;
+	}
 
 	smix->chn = chn;
 	smix->ins = smix->smp = smp;
+	smix->serial = 0;
+	libxmp_smix_reset_voices(ctx);
 
 	return 0;
 
+    err4:
+	libxmp_free(smix->voice);
+	smix->voice = NULL;
+    err3:
+	libxmp_free(smix->xtra);
+	smix->xtra = NULL;
+    err2:
+	libxmp_free(smix->xxs);
+	smix->xxs = NULL;
     err1:
-	free(smix->xxi);
+	libxmp_free(smix->xxi);
 	smix->xxi = NULL;
     err:
 	return -XMP_ERROR_INTERNAL;
 }
 
+int xmp_start_smix(xmp_context opaque, int chn, int smp)
+{
+	struct context_data *ctx = (struct context_data *)opaque;
+	struct alloc_class *old;
+	int ret;
+
+	old = libxmp_enter_allocator(ctx, ALLOC_SMIX);
+	ret = start_smix(opaque, chn, smp);
+	libxmp_leave_allocator(old);
+
+	return ret;
+}
+
 int xmp_smix_play_instrument(xmp_context opaque, int ins, int note, int vol, int chn)
 {
 	struct context_data *ctx = (struct context_data *)opaque;
@@ -155,6 +196,211 @@ int xmp_smix_play_sample(xmp_context opaque, int ins, int note, int vol, int chn
 	return 0;
 }
 
+/*
+ * Voice pool
+ *
+ * Channels used by xmp_smix_play_voice() are kept in a stack of free
+ * channels and, while in use, in one list per priority ordered from the
+ * oldest to the newest voice. Both finding a free channel and choosing a
+ * voice to steal take constant time.
+ */
+
+static void unlink_voice(struct smix_data *smix, int chn)
+{
+	struct smix_voice *sv = &smix->voice[chn];
+
+	if (sv->prev >= 0) {
+		smix->voice[sv->prev].next = sv->next;
+	} else {
+		smix->first[sv->priority] = sv->next;
+	}
+
+	if (sv->next >= 0) {
+		smix->voice[sv->next].prev = sv->prev;
+	} else {
+		smix->last[sv->priority] = sv->prev;
+	}
+}
+
+static void free_pool_voice(struct smix_data *smix, int chn)
+{
+	unlink_voice(smix, chn);
+	smix->voice[chn].state = SMIX_VOICE_FREE;
+	smix->free_voice[smix->num_free++] = chn;
+}
+
+void libxmp_smix_reset_voices(struct context_data *ctx)
+{
+	struct smix_data *smix = &ctx->smix;
+	int i;
+
+	if (smix->voice == NULL) {
+		return;
+	}
+
+	for (i = 0; i < SMIX_PRIORITIES; i++) {
+		smix->first[i] = smix->last[i] = -1;
+	}
+
+	/* Voices still waiting for their event keep their slots */
+	smix->num_free = 0;
+	for (i = smix->chn - 1; i >= 0; i--) {
+		struct smix_voice *sv = &smix->voice[i];
+
+		if (sv->state == SMIX_VOICE_PENDING) {
+			sv->prev = smix->last[sv->priority];
+			sv->next = -1;
+			if (sv->prev >= 0) {
+				smix->voice[sv->prev].next = i;
+			} else {
+				smix->first[sv->priority] = i;
+			}
+			smix->last[sv->priority] = i;
+		} else {
+			sv->state = SMIX_VOICE_FREE;
+			smix->free_voice[smix->num_free++] = i;
+		}
+	}
+}
+
+void libxmp_smix_voice_start(struct context_data *ctx, int chn)
+{
+	struct smix_data *smix = &ctx->smix;
+	struct xmp_module *mod = &ctx->m.mod;
+
+	chn -= mod->chn;
+	if (smix->voice == NULL || chn < 0 || chn >= smix->chn) {
+		return;
+	}
+
+	if (smix->voice[chn].state == SMIX_VOICE_PENDING) {
+		smix->voice[chn].state = SMIX_VOICE_PLAYING;
+	}
+}
+
+void libxmp_smix_voice_end(struct context_data *ctx, int chn)
+{
+	struct smix_data *smix = &ctx->smix;
+	struct xmp_module *mod = &ctx->m.mod;
+
+	chn -= mod->chn;
+	if (smix->voice == NULL || chn < 0 || chn >= smix->chn) {
+		return;
+	}
+
+	/* A stolen voice may end before the new note starts */
+	if (smix->voice[chn].state == SMIX_VOICE_PLAYING) {
+		free_pool_voice(smix, chn);
+	}
+}
+
+static int steal_voice(struct smix_data *smix, int priority)
+{
+	int i, chn;
+
+	for (i = 0; i <= priority; i++) {
+		chn = smix->first[i];
+		if (chn >= 0) {
+			unlink_voice(smix, chn);
+			return chn;
+		}
+	}
+
+	return -1;
+}
+
+int xmp_smix_play_voice(xmp_context opaque, int ins, int note, int vol, int priority)
+{
+	struct context_data *ctx = (struct context_data *)opaque;
+	struct player_data *p = &ctx->p;
+	struct smix_data *smix = &ctx->smix;
+	struct module_data *m = &ctx->m;
+	struct xmp_module *mod = &m->mod;
+	struct smix_voice *sv;
+	struct xmp_event *event;
+	int chn;
+
+	if (ctx->state < XMP_STATE_PLAYING) {
+		return -XMP_ERROR_STATE;
+	}
+
+	if (ins < 0 || ins >= smix->ins) {
+		return -XMP_ERROR_INVALID;
+	}
+
+	if (priority < 0) {
+		priority = 0;
+	} else if (priority > XMP_SMIX_MAX_PRIORITY) {
+		priority = XMP_SMIX_MAX_PRIORITY;
+	}
+
+	if (smix->num_free > 0) {
+		chn = smix->free_voice[--smix->num_free];
+	} else if ((chn = steal_voice(smix, priority)) < 0) {
+		return -XMP_ERROR_STATE;
+	}
+
+	if (note == 0) {
+		note = 60;		/* middle C note number */
+	}
+
+	event = &p->inject_event[mod->chn + chn];
+	memset(event, 0, sizeof (struct xmp_event));
+	event->note = note + 1;
+	event->ins = mod->ins + ins + 1;
+	event->vol = vol + 1;
+	event->_flag = 1;
+
+	/* Append to the priority list as the newest voice */
+	sv = &smix->voice[chn];
+	sv->state = SMIX_VOICE_PENDING;
+	sv->priority = priority;
+	sv->prev = smix->last[priority];
+	sv->next = -1;
+	if (sv->prev >= 0) {
+		smix->voice[sv->prev].next = chn;
+	} else {
+		smix->first[priority] = chn;
+	}
+	smix->last[priority] = chn;
+
+	smix->serial = (smix->serial + 1) & 0x3fffff;
+	sv->handle = (smix->serial << 8) | chn;
+
+	return sv->handle;
+}
+
+int xmp_smix_stop_voice(xmp_context opaque, int handle)
+{
+	struct context_data *ctx = (struct context_data *)opaque;
+	struct player_data *p = &ctx->p;
+	struct smix_data *smix = &ctx->smix;
+	struct module_data *m = &ctx->m;
+	struct xmp_module *mod = &m->mod;
+	int chn;
+
+	if (ctx->state < XMP_STATE_PLAYING) {
+		return -XMP_ERROR_STATE;
+	}
+
+	chn = handle & 0xff;
+	if (handle < 0 || chn >= smix->chn || smix->voice == NULL) {
+		return -XMP_ERROR_INVALID;
+	}
+
+	/* The voice already ended or was stolen */
+	if (smix->voice[chn].state == SMIX_VOICE_FREE ||
+	    smix->voice[chn].handle != handle) {
+		return 0;
+	}
+
+	p->inject_event[mod->chn + chn]._flag = 0;
+	free_pool_voice(smix, chn);
+	libxmp_virt_resetchannel(ctx, mod->chn + chn);
+
+	return 0;
+}
+
 int xmp_smix_channel_pan(xmp_context opaque, int chn, int pan)
 {
 	struct context_data *ctx = (struct context_data *)opaque;
@@ -173,38 +419,288 @@ int xmp_smix_channel_pan(xmp_context opaque, int chn, int pan)
 	return 0;
 }
 
-int xmp_smix_load_sample(xmp_context opaque, int num, const char *path)
+#define WAVE_FORMAT_PCM		0x0001
+#define WAVE_FORMAT_IEEE_FLOAT	0x0003
+#define WAVE_FORMAT_EXTENSIBLE	0xfffe
+
+/* Convert 24 and 32-bit integer or floating point PCM to 16-bit */
+static int16 *convert_pcm(const uint8 *data, int len, int fmt, int bits)
+{
+	union { uint32 i; float f; } f32;
+	union { uint64 i; double d; } f64;
+	int16 *pcm;
+	double x;
+	int i;
+
+	pcm = libxmp_malloc(len * sizeof(int16));
+	if (pcm == NULL) {
+		return NULL;
+	}
+
+	for (i = 0; i < len; i++) {
+		if (fmt == WAVE_FORMAT_PCM) {
+			pcm[i] = (int16)readmem16l(data + bits / 8 - 2);
+			data += bits / 8;
+			continue;
+		}
+
+		if (bits == 32) {
+			f32.i = readmem32l(data);
+			x = f32.f;
+			data += 4;
+		} else {
+			f64.i = readmem32l(data) |
+				((uint64)readmem32l(data + 4) << 32);
+			x = f64.d;
+			data += 8;
+		}
+
+		/* Also catches NaN */
+		if (!(x > -1.0)) {
+			x = -1.0;
+		} else if (x > 1.0) {
+			x = 1.0;
+		}
+		x = floor(x * 32768.0 + 0.5);
+		pcm[i] = x > 32767.0 ? 32767 : (int16)x;
+	}
+
+	return pcm;
+}
+
+/* Flags for libxmp_load_sample() to read host order 16-bit data */
+static int host_order_flags(void)
+{
+#ifdef WORDS_BIGENDIAN
+	return SAMPLE_FLAG_NOLOAD | SAMPLE_FLAG_BIGEND;
+#else
+	return SAMPLE_FLAG_NOLOAD;
+#endif
+}
+
+static int get_sample_value(struct xmp_sample *xxs, int i)
+{
+	if (i < 0) {
+		i = 0;
+	} else if (i >= xxs->len) {
+		i = xxs->len - 1;
+	}
+
+	if (xxs->flg & XMP_SAMPLE_16BIT) {
+		return ((int16 *)xxs->data)[i];
+	} else {
+		return (int8)xxs->data[i] << 8;
+	}
+}
+
+/* Resample an external sample to the output rate using cubic
+ * interpolation, so it plays at step 1.0 when the note is not changed.
+ */
+static int resample_sample(struct context_data *ctx, int num)
+{
+	struct mixer_data *s = &ctx->s;
+	struct smix_data *smix = &ctx->smix;
+	struct smix_sample *sx = &smix->xtra[num];
+	struct xmp_sample *src = &sx->src;
+	struct xmp_sample xxs;
+	int16 *pcm;
+	double step, pos, t, v;
+	int i, x, len, y0, y1, y2, y3;
+
+	if (src->data == NULL || sx->rate == s->freq) {
+		return 0;
+	}
+
+	step = (double)sx->src_rate / s->freq;
+	len = (int)ceil(src->len / step);
+
+	pcm = libxmp_malloc(len * sizeof(int16));
+	if (pcm == NULL) {
+		return -1;
+	}
+
+	for (i = 0; i < len; i++) {
+		pos = i * step;
+		x = (int)pos;
+		t = pos - x;
+
+		y0 = get_sample_value(src, x - 1);
+		y1 = get_sample_value(src, x);
+		y2 = get_sample_value(src, x + 1);
+		y3 = get_sample_value(src, x + 2);
+
+		v = y1 + 0.5 * t * (y2 - y0 + t * (2.0 * y0 - 5.0 * y1 +
+			4.0 * y2 - y3 + t * (3.0 * (y1 - y2) + y3 - y0)));
+		v = floor(v + 0.5);
+		CLAMP(v, -32768.0, 32767.0);
+		pcm[i] = (int16)v;
+	}
+
+	memset(&xxs, 0, sizeof(struct xmp_sample));
+	xxs.len = len;
+	xxs.flg = XMP_SAMPLE_16BIT;
+
+	if (libxmp_load_sample(NULL, NULL, host_order_flags(), &xxs, pcm) < 0) {
+		libxmp_free(pcm);
+		return -1;
+	}
+	libxmp_free(pcm);
+
+	libxmp_free_sample(&smix->xxs[num]);
+	smix->xxs[num] = xxs;
+	sx->rate = s->freq;
+
+	return 0;
+}
+
+void libxmp_smix_resample(struct context_data *ctx)
+{
+	struct smix_data *smix = &ctx->smix;
+	int i;
+
+	for (i = 0; i < smix->smp; i++) {
+		resample_sample(ctx, i);
+	}
+}
+
+static int load_wav(struct context_data *ctx, int num, HIO_HANDLE *h)
 {
-	struct context_data *ctx = (struct context_data *)opaque;
 	struct smix_data *smix = &ctx->smix;
 	struct module_data *m = &ctx->m;
-	struct xmp_instrument *xxi;
-	struct xmp_sample *xxs;
-	HIO_HANDLE *h;
-	uint32 magic;
-	int chn, rate, bits, size;
-	int retval = -XMP_ERROR_INTERNAL;
+	struct xmp_instrument *xxi = &smix->xxi[num];
+	struct smix_sample *sx = &smix->xtra[num];
+	struct xmp_sample xxs;
+	uint32 id, size;
+	long pos, data_pos = -1, data_size = 0;
+	int fmt = -1, chn = 0, rate = 0, bits = 0;
+	int len, ret;
+
+	if (hio_read32b(h) != 0x52494646) {	/* RIFF */
+		return -XMP_ERROR_FORMAT;
+	}
+	hio_read32l(h);
+	if (hio_read32b(h) != 0x57415645) {	/* WAVE */
+		return -XMP_ERROR_FORMAT;
+	}
 
-	if (num >= smix->ins) {
-		retval = -XMP_ERROR_INVALID;
-		goto err;
+	/* Find the format and data chunks */
+	while (fmt < 0 || data_pos < 0) {
+		id = hio_read32b(h);
+		size = hio_read32l(h);
+		if (hio_eof(h)) {
+			break;
+		}
+		pos = hio_tell(h);
+
+		if (id == 0x666d7420 && size >= 16) {	/* "fmt " */
+			fmt = hio_read16l(h);
+			chn = hio_read16l(h);
+			rate = hio_read32l(h);
+			hio_read32l(h);			/* byte rate */
+			hio_read16l(h);			/* block align */
+			bits = hio_read16l(h);
+
+			if (fmt == WAVE_FORMAT_EXTENSIBLE && size >= 40) {
+				hio_read16l(h);		/* extension size */
+				hio_read16l(h);		/* valid bits */
+				hio_read32l(h);		/* channel mask */
+				fmt = hio_read16l(h);	/* sub format */
+			}
+		} else if (id == 0x64617461) {		/* "data" */
+			data_pos = pos;
+			data_size = size;
+			if (data_size > hio_size(h) - pos) {
+				data_size = hio_size(h) - pos;
+			}
+		}
+
+		if (fmt >= 0 && data_pos >= 0) {
+			break;
+		}
+
+		/* Chunks are word aligned */
+		if (size > hio_size(h) - pos ||
+		    hio_seek(h, pos + size + (size & 1), SEEK_SET) < 0) {
+			break;
+		}
 	}
 
-	xxi = &smix->xxi[num];
-	xxs = &smix->xxs[num];
+	if (fmt < 0 || data_pos < 0 || chn != 1 || rate <= 0) {
+		return -XMP_ERROR_FORMAT;
+	}
 
-	h = hio_open(path, "rb");
-	if (h == NULL) {
-		retval = -XMP_ERROR_SYSTEM;
-		goto err;
+	switch (fmt) {
+	case WAVE_FORMAT_PCM:
+		if (bits != 8 && bits != 16 && bits != 24 && bits != 32) {
+			return -XMP_ERROR_FORMAT;
+		}
+		break;
+	case WAVE_FORMAT_IEEE_FLOAT:
+		if (bits != 32 && bits != 64) {
+			return -XMP_ERROR_FORMAT;
+		}
+		break;
+	default:
+		return -XMP_ERROR_FORMAT;
 	}
-		
+
+	len = data_size / (bits / 8);
+	if (len <= 0) {
+		return -XMP_ERROR_FORMAT;
+	}
+
+	if (hio_seek(h, data_pos, SEEK_SET) < 0) {
+		return -XMP_ERROR_SYSTEM;
+	}
+
+	/* Load sample */
+
+	memset(&xxs, 0, sizeof(struct xmp_sample));
+	xxs.len = len;
+
+	if (bits == 8) {
+		ret = libxmp_load_sample(NULL, h, SAMPLE_FLAG_UNS, &xxs, NULL);
+	} else if (bits == 16) {
+		xxs.flg = XMP_SAMPLE_16BIT;
+		ret = libxmp_load_sample(NULL, h, 0, &xxs, NULL);
+	} else {
+		uint8 *buf;
+		int16 *pcm;
+
+		buf = libxmp_malloc(len * (bits / 8));
+		if (buf == NULL) {
+			return -XMP_ERROR_SYSTEM;
+		}
+		len = hio_read(buf, bits / 8, len, h);
+		if (len <= 0) {
+			libxmp_free(buf);
+			return -XMP_ERROR_FORMAT;
+		}
+		pcm = convert_pcm(buf, len, fmt, bits);
+		libxmp_free(buf);
+		if (pcm == NULL) {
+			return -XMP_ERROR_SYSTEM;
+		}
+
+		xxs.len = len;
+		xxs.flg = XMP_SAMPLE_16BIT;
+		ret = libxmp_load_sample(NULL, NULL, host_order_flags(), &xxs, pcm);
+		libxmp_free(pcm);
+	}
+
+	if (ret < 0) {
+		return -XMP_ERROR_SYSTEM;
+	}
+	if (xxs.data == NULL) {
+		return -XMP_ERROR_FORMAT;
+	}
+
 	/* Init instrument */
 
-	xxi->sub = calloc(sizeof(struct xmp_subinstrument), 1);
+	xxi->sub = libxmp_calloc(sizeof(struct xmp_subinstrument), 1);
 	if (xxi->sub == NULL) {
-		retval = -XMP_ERROR_SYSTEM;
-		goto err1;
+		libxmp_free_sample(&xxs);
+		return -XMP_ERROR_SYSTEM;
 	}
 
 	xxi->vol = m->volbase;
@@ -213,90 +709,134 @@ int xmp_smix_load_sample(xmp_context opaque, int num, const char *path)
 	xxi->sub[0].vol = xxi->vol;
 	xxi->sub[0].pan = 0x80;
 
-	/* Load sample */
-
-	magic = hio_read32b(h);
-	if (magic != 0x52494646) {	/* RIFF */
-		retval = -XMP_ERROR_FORMAT;
-		goto err2;
+	/* The mixer plays the sample at its own rate for note 60, so
+	 * no transpose or finetune is needed.
+	 */
+	sx->src_rate = rate;
+
+	if (m->smpctl & XMP_SMPCTL_RESAMPLE) {
+		sx->src = xxs;
+		sx->rate = 0;
+		memset(&smix->xxs[num], 0, sizeof(struct xmp_sample));
+		if (ctx->state >= XMP_STATE_PLAYING) {
+			resample_sample(ctx, num);
+		}
+	} else {
+		smix->xxs[num] = xxs;
+		sx->rate = rate;
 	}
 
-	if (hio_seek(h, 22, SEEK_SET) < 0) {
-		retval = -XMP_ERROR_SYSTEM;
-		goto err2;
-	}
-	chn = hio_read16l(h);
-	if (chn != 1) {
-		retval = -XMP_ERROR_FORMAT;
-		goto err2;
-	}
+	return 0;
+}
 
-	rate = hio_read32l(h);
-	if (rate == 0) {
-		retval = -XMP_ERROR_FORMAT;
-		goto err2;
-	}
+static int smix_load_sample(xmp_context opaque, int num, const char *path)
+{
+	struct context_data *ctx = (struct context_data *)opaque;
+	struct smix_data *smix = &ctx->smix;
+	HIO_HANDLE *h;
+	int ret;
 
-	if (hio_seek(h, 34, SEEK_SET) < 0) {
-		retval = -XMP_ERROR_SYSTEM;
-		goto err2;
+	if (num >= smix->ins) {
+		return -XMP_ERROR_INVALID;
 	}
-	bits = hio_read16l(h);
-	if (bits == 0) {
-		retval = -XMP_ERROR_FORMAT;
-		goto err2;
+
+	h = hio_open(path, "rb");
+	if (h == NULL) {
+		return -XMP_ERROR_SYSTEM;
 	}
 
-	if (hio_seek(h, 40, SEEK_SET) < 0) {
-		retval = -XMP_ERROR_SYSTEM;
-		goto err2;
+	ret = load_wav(ctx, num, h);
+	hio_close(h);
+
+	return ret;
+}
+
+int xmp_smix_load_sample(xmp_context opaque, int num, const char *path)
+{
+	struct context_data *ctx = (struct context_data *)opaque;
+	struct alloc_class *old;
+	int ret;
+
+	old = libxmp_enter_allocator(ctx, ALLOC_SMIX);
+	ret = smix_load_sample(opaque, num, path);
+	libxmp_leave_allocator(old);
+
+	return ret;
+}
+
+static int smix_load_sample_from_memory(xmp_context opaque, int num, const void *mem, long size)
+{
+	struct context_data *ctx = (struct context_data *)opaque;
+	struct smix_data *smix = &ctx->smix;
+	HIO_HANDLE *h;
+	int ret;
+
+	if (num >= smix->ins || size <= 0) {
+		return -XMP_ERROR_INVALID;
 	}
-	size = hio_read32l(h);
-	if (size == 0) {
-		retval = -XMP_ERROR_FORMAT;
-		goto err2;
+
+	h = hio_open_mem(mem, size);
+	if (h == NULL) {
+		return -XMP_ERROR_SYSTEM;
 	}
 
-	libxmp_c2spd_to_note(rate, &xxi->sub[0].xpo, &xxi->sub[0].fin);
+	ret = load_wav(ctx, num, h);
+	hio_close(h);
 
-	xxs->len = 8 * size / bits;
-	xxs->lps = 0;
-	xxs->lpe = 0;
-	xxs->flg = bits == 16 ? XMP_SAMPLE_16BIT : 0;
+	return ret;
+}
 
-	xxs->data = malloc(size + 8);
-	if (xxs->data == NULL) {
-		retval = -XMP_ERROR_SYSTEM;
-		goto err2;
-	}
+int xmp_smix_load_sample_from_memory(xmp_context opaque, int num, const void *mem, long size)
+{
+	struct context_data *ctx = (struct context_data *)opaque;
+	struct alloc_class *old;
+	int ret;
 
-	/* ugly hack to make the interpolator happy */
-	memset(xxs->data, 0, 4);
-	memset(xxs->data + 4 + size, 0, 4);
-	xxs->data += 4;
+	old = libxmp_enter_allocator(ctx, ALLOC_SMIX);
+	ret = smix_load_sample_from_memory(opaque, num, mem, size);
+	libxmp_leave_allocator(old);
 
-	if (hio_seek(h, 44, SEEK_SET) < 0) {
-		retval = -XMP_ERROR_SYSTEM;
-		goto err2;
+	return ret;
+}
+
+static int smix_load_sample_from_callbacks(xmp_context opaque, int num, void *priv,
+					struct xmp_callbacks callbacks)
+{
+	struct context_data *ctx = (struct context_data *)opaque;
+	struct smix_data *smix = &ctx->smix;
+	HIO_HANDLE *h;
+	int ret;
+
+	if (num >= smix->ins) {
+		return -XMP_ERROR_INVALID;
 	}
-	if (hio_read(xxs->data, 1, size, h) != size) {
-		retval = -XMP_ERROR_SYSTEM;
-		goto err2;
+
+	h = hio_open_callbacks(priv, callbacks);
+	if (h == NULL) {
+		return -XMP_ERROR_SYSTEM;
 	}
-	hio_close(h);
 
-	return 0;
-	
-    err2:
-	free(xxi->sub);
-	xxi->sub = NULL;
-    err1:
+	ret = load_wav(ctx, num, h);
 	hio_close(h);
-    err:
-	return retval;
+
+	return ret;
 }
 
-int xmp_smix_release_sample(xmp_context opaque, int num)
+int xmp_smix_load_sample_from_callbacks(xmp_context opaque, int num, void *priv,
+					struct xmp_callbacks callbacks)
+{
+	struct context_data *ctx = (struct context_data *)opaque;
+	struct alloc_class *old;
+	int ret;
+
+	old = libxmp_enter_allocator(ctx, ALLOC_SMIX);
+	ret = smix_load_sample_from_callbacks(opaque, num, priv, callbacks);
+	libxmp_leave_allocator(old);
+
+	return ret;
+}
+
+static int smix_release_sample(xmp_context opaque, int num)
 {
 	struct context_data *ctx = (struct context_data *)opaque;
 	struct smix_data *smix = &ctx->smix;
@@ -306,15 +846,30 @@ int xmp_smix_release_sample(xmp_context opaque, int num)
 	}
 
 	libxmp_free_sample(&smix->xxs[num]);
-	free(smix->xxi[num].sub);
+	libxmp_free_sample(&smix->xtra[num].src);
+	libxmp_free(smix->xxi[num].sub);
 
 	smix->xxs[num].data = NULL;
 	smix->xxi[num].sub = NULL;
+	smix->xtra[num].rate = 0;
 
 	return 0;
 }
 
-void xmp_end_smix(xmp_context opaque)
+int xmp_smix_release_sample(xmp_context opaque, int num)
+{
+	struct context_data *ctx = (struct context_data *)opaque;
+	struct alloc_class *old;
+	int ret;
+
+	old = libxmp_enter_allocator(ctx, ALLOC_SMIX);
+	ret = smix_release_sample(opaque, num);
+	libxmp_leave_allocator(old);
+
+	return ret;
+}
+
+static void end_smix(xmp_context opaque)
 {
 	struct context_data *ctx = (struct context_data *)opaque;
 	struct smix_data *smix = &ctx->smix;
@@ -324,8 +879,24 @@ void xmp_end_smix(xmp_context opaque)
 		xmp_smix_release_sample(opaque, i);
 	}
 
-	free(smix->xxs);
-	free(smix->xxi);
+	libxmp_free(smix->xxs);
+	libxmp_free(smix->xxi);
+	libxmp_free(smix->xtra);
+	libxmp_free(smix->voice);
+	libxmp_free(smix->free_voice);
 	smix->xxs = NULL;
 	smix->xxi = NULL;
+	smix->xtra = NULL;
+	smix->voice = NULL;
+	smix->free_voice = NULL;
+}
+
+void xmp_end_smix(xmp_context opaque)
+{
+	struct context_data *ctx = (struct context_data *)opaque;
+	struct alloc_class *old;
+
+	old = libxmp_enter_allocator(ctx, ALLOC_SMIX);
+	end_smix(opaque);
+	libxmp_leave_allocator(old);
 }
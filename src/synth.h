@@ -0,0 +1,25 @@
+#ifndef LIBXMP_SYNTH_H
+#define LIBXMP_SYNTH_H
+
+#include "common.h"
+
+/* Synthesizer driver for synth instruments (samples flagged with
+ * XMP_SAMPLE_SYNTH, holding a patch instead of PCM data). The mixer
+ * hands the state of each synth voice to the driver once per tick and
+ * the driver renders all of them into the tick buffer in one block.
+ */
+
+struct synth_info {
+	int (*init)(struct context_data *, int);
+	void (*deinit)(struct context_data *);
+	void (*setpatch)(struct context_data *, int, const uint8 *);
+	void (*setvoice)(struct context_data *, int, double, int, int);
+	void (*mixer)(struct context_data *, int32 *, int, int);
+};
+
+/* AdLib patches hold 11 register values in S3M instrument order */
+#define ADLIB_PATCH_SIZE	11
+
+extern const struct synth_info synth_adlib;
+
+#endif /* LIBXMP_SYNTH_H */
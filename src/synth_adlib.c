@@ -0,0 +1,246 @@
+/* Extended Module Player
+ * Copyright (C) 1996-2021 Claudio Matsuoka and Hipolito Carraro Jr
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/* AdLib (OPL2) synth driver. Each synth voice gets one of the nine
+ * melodic channels of an emulated YM3812 and the whole chip is rendered
+ * once per tick. Patches are the 11 register values of an S3M AdLib
+ * instrument.
+ */
+
+#include "common.h"
+#include "mixer.h"
+#include "synth.h"
+#include "fmopl.h"
+
+#define OPL_CLOCK	3579545
+#define OPL_RATE	(OPL_CLOCK / 72)
+#define OPL_CHANNELS	9
+
+struct adlib_chip {
+	FM_OPL *opl;
+	uint8 reg[256];			/* last values written */
+	int voice[OPL_CHANNELS];	/* mixer voice using each channel */
+	uint8 level[OPL_CHANNELS][2];	/* patch modulator and carrier levels */
+};
+
+/* Operator registers for each patch byte, in S3M order */
+static const uint8 patch_reg[10] = {
+	0x20, 0x23, 0x40, 0x43, 0x60, 0x63, 0x80, 0x83, 0xe0, 0xe3
+};
+
+/* Modulator operator offset for each channel, carrier is 3 above */
+static const uint8 op_offset[OPL_CHANNELS] = {
+	0x00, 0x01, 0x02, 0x08, 0x09, 0x0a, 0x10, 0x11, 0x12
+};
+
+static void opl_write(struct adlib_chip *chip, int reg, int val)
+{
+	if (chip->reg[reg] == val) {
+		return;
+	}
+
+	chip->reg[reg] = val;
+	OPLWrite(chip->opl, 0, reg);
+	OPLWrite(chip->opl, 1, val);
+}
+
+static void key_off(struct adlib_chip *chip, int ch)
+{
+	opl_write(chip, 0xb0 + ch, chip->reg[0xb0 + ch] & ~0x20);
+}
+
+/* Check if the mixer voice using a channel still plays a synth patch */
+static int voice_active(struct context_data *ctx, int voc)
+{
+	struct mixer_voice *vi = &ctx->p.virt.voice_array[voc];
+	struct xmp_sample *xxs;
+
+	if (vi->chn < 0) {
+		return 0;
+	}
+
+	xxs = libxmp_get_sample(ctx, vi->smp);
+
+	return (xxs->flg & XMP_SAMPLE_SYNTH) != 0;
+}
+
+static int find_channel(struct adlib_chip *chip, int voc)
+{
+	int i;
+
+	for (i = 0; i < OPL_CHANNELS; i++) {
+		if (chip->voice[i] == voc) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+static int synth_init(struct context_data *ctx, int freq)
+{
+	struct mixer_data *s = &ctx->s;
+	struct adlib_chip *chip;
+	int i;
+
+	chip = libxmp_calloc(1, sizeof(struct adlib_chip));
+	if (chip == NULL) {
+		goto err;
+	}
+
+	chip->opl = OPLCreate(OPL_TYPE_YM3812, OPL_CLOCK, freq);
+	if (chip->opl == NULL) {
+		goto err1;
+	}
+
+	for (i = 0; i < OPL_CHANNELS; i++) {
+		chip->voice[i] = -1;
+	}
+
+	/* Enable waveform select */
+	opl_write(chip, 0x01, 0x20);
+
+	s->synth_chip = chip;
+
+	return 0;
+
+    err1:
+	libxmp_free(chip);
+    err:
+	return -1;
+}
+
+static void synth_deinit(struct context_data *ctx)
+{
+	struct mixer_data *s = &ctx->s;
+	struct adlib_chip *chip = (struct adlib_chip *)s->synth_chip;
+
+	if (chip == NULL) {
+		return;
+	}
+
+	OPLDestroy(chip->opl);
+	libxmp_free(chip);
+	s->synth_chip = NULL;
+}
+
+static void synth_setpatch(struct context_data *ctx, int voc, const uint8 *data)
+{
+	struct adlib_chip *chip = (struct adlib_chip *)ctx->s.synth_chip;
+	int i, ch, ofs;
+
+	ch = find_channel(chip, voc);
+
+	/* Take a free channel, or one left by a voice that stopped */
+	for (i = 0; ch < 0 && i < OPL_CHANNELS; i++) {
+		if (chip->voice[i] < 0 || !voice_active(ctx, chip->voice[i])) {
+			ch = i;
+		}
+	}
+	if (ch < 0) {
+		return;
+	}
+
+	chip->voice[ch] = voc;
+	key_off(chip, ch);
+
+	ofs = op_offset[ch];
+	for (i = 0; i < 10; i++) {
+		opl_write(chip, patch_reg[i] + ofs, data[i]);
+	}
+	opl_write(chip, 0xc0 + ch, data[10]);
+
+	chip->level[ch][0] = data[2];
+	chip->level[ch][1] = data[3];
+}
+
+/* Update a voice playing at the given sample rate and volume (0 to
+ * 1024). The note frequency is the rate / 32, so a C-4 at 8363 Hz plays
+ * middle C like in Scream Tracker 3.
+ */
+static void synth_setvoice(struct context_data *ctx, int voc, double rate,
+			   int vol, int release)
+{
+	struct adlib_chip *chip = (struct adlib_chip *)ctx->s.synth_chip;
+	int ch, ofs, block, fnum, level;
+	double freq;
+
+	ch = find_channel(chip, voc);
+	if (ch < 0) {
+		return;
+	}
+
+	ofs = op_offset[ch];
+
+	/* Scale the output operator levels, and the modulator level in
+	 * additive synthesis mode
+	 */
+	level = chip->level[ch][1];
+	opl_write(chip, 0x43 + ofs, (level & 0xc0) |
+			(63 - (63 - (level & 0x3f)) * vol / 1024));
+	if (chip->reg[0xc0 + ch] & 0x01) {
+		level = chip->level[ch][0];
+		opl_write(chip, 0x40 + ofs, (level & 0xc0) |
+			(63 - (63 - (level & 0x3f)) * vol / 1024));
+	}
+
+	/* Use the lowest block that fits the frequency number */
+	freq = rate / 32;
+	for (block = 0; block < 7; block++) {
+		if (freq * (1 << (20 - block)) / OPL_RATE < 1024) {
+			break;
+		}
+	}
+	fnum = freq * (1 << (20 - block)) / OPL_RATE;
+	if (fnum > 1023) {
+		fnum = 1023;
+	}
+
+	opl_write(chip, 0xa0 + ch, fnum & 0xff);
+	opl_write(chip, 0xb0 + ch, (release ? 0 : 0x20) | (block << 2) |
+			(fnum >> 8));
+}
+
+static void synth_mixer(struct context_data *ctx, int32 *buf, int count,
+			int stereo)
+{
+	struct adlib_chip *chip = (struct adlib_chip *)ctx->s.synth_chip;
+	int i;
+
+	/* Release the notes of voices that stopped */
+	for (i = 0; i < OPL_CHANNELS; i++) {
+		if (chip->voice[i] >= 0 && !voice_active(ctx, chip->voice[i])) {
+			key_off(chip, i);
+			chip->voice[i] = -1;
+		}
+	}
+
+	YM3812UpdateOne(chip->opl, buf, count, stereo);
+}
+
+const struct synth_info synth_adlib = {
+	synth_init,
+	synth_deinit,
+	synth_setpatch,
+	synth_setvoice,
+	synth_mixer
+};
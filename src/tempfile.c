@@ -124,7 +124,7 @@ FILE *make_temp_file(char **filename) {
 
 	strncat(tmp, "xmp_XXXXXX", PATH_MAX - 10);
 
-	if ((*filename = strdup(tmp)) == NULL)
+	if ((*filename = libxmp_strdup(tmp)) == NULL)
 		goto err;
 
 #ifdef HAVE_UMASK
@@ -141,7 +141,7 @@ FILE *make_temp_file(char **filename) {
     err3:
 	close(fd);
     err2:
-	free(*filename);
+	libxmp_free(*filename);
     err:
 	return NULL;
 }
@@ -154,7 +154,7 @@ void unlink_temp_file(char *temp)
 {
 	if (temp) {
 		unlink(temp);
-		free(temp);
+		libxmp_free(temp);
 	}
 }
 
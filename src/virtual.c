@@ -31,6 +31,11 @@
 
 #define	FREE	-1
 
+/* Free voice bitmap, searched a word at a time in alloc_voice() */
+#define FREE_MAP_WORDS(x)	(((x) + 31) >> 5)
+#define SET_FREE(p,v)	((p)->virt.free_map[(v) >> 5] |= 1U << ((v) & 31))
+#define CLEAR_FREE(p,v)	((p)->virt.free_map[(v) >> 5] &= ~(1U << ((v) & 31)))
+
 /* For virt_pastnote() */
 void libxmp_player_set_release(struct context_data *, int);
 void libxmp_player_set_fadeout(struct context_data *, int);
@@ -69,6 +74,8 @@ void libxmp_virt_resetvoice(struct context_data *ctx, int voc, int mute)
 		libxmp_mixer_setvol(ctx, voc, 0);
 	}
 
+	libxmp_smix_voice_end(ctx, vi->chn);
+
 	p->virt.virt_used--;
 	p->virt.virt_channel[vi->root].count--;
 	p->virt.virt_channel[vi->chn].map = FREE;
@@ -80,6 +87,7 @@ void libxmp_virt_resetvoice(struct context_data *ctx, int voc, int mute)
 	vi->paula = paula;
 #endif
 	vi->chn = vi->root = FREE;
+	SET_FREE(p, voc);
 }
 
 /* virt_on (number of tracks) */
@@ -102,21 +110,27 @@ int libxmp_virt_on(struct context_data *ctx, int num)
 
 	p->virt.maxvoc = libxmp_mixer_numvoices(ctx, num);
 
-	p->virt.voice_array = calloc(p->virt.maxvoc,
+	p->virt.voice_array = libxmp_calloc(p->virt.maxvoc,
 				sizeof(struct mixer_voice));
 	if (p->virt.voice_array == NULL)
 		goto err;
 
+	p->virt.free_map = libxmp_calloc(FREE_MAP_WORDS(p->virt.maxvoc),
+				sizeof(uint32));
+	if (p->virt.free_map == NULL)
+		goto err1;
+
 	for (i = 0; i < p->virt.maxvoc; i++) {
 		p->virt.voice_array[i].chn = FREE;
 		p->virt.voice_array[i].root = FREE;
+		SET_FREE(p, i);
 	}
 
 #ifdef LIBXMP_PAULA_SIMULATOR
 	/* Initialize Paula simulator */
 	if (IS_AMIGA_MOD()) {
 		for (i = 0; i < p->virt.maxvoc; i++) {
-			p->virt.voice_array[i].paula = calloc(1, sizeof (struct paula_state));
+			p->virt.voice_array[i].paula = libxmp_calloc(1, sizeof (struct paula_state));
 			if (p->virt.voice_array[i].paula == NULL) {
 				goto err2;
 			}
@@ -125,7 +139,7 @@ int libxmp_virt_on(struct context_data *ctx, int num)
 	}
 #endif
 
-	p->virt.virt_channel = malloc(p->virt.virt_channels *
+	p->virt.virt_channel = libxmp_malloc(p->virt.virt_channels *
 				sizeof(struct virt_channel));
 	if (p->virt.virt_channel == NULL)
 		goto err2;
@@ -143,11 +157,14 @@ int libxmp_virt_on(struct context_data *ctx, int num)
 #ifdef LIBXMP_PAULA_SIMULATOR
 	if (IS_AMIGA_MOD()) {
 		for (i = 0; i < p->virt.maxvoc; i++) {
-			free(p->virt.voice_array[i].paula);
+			libxmp_free(p->virt.voice_array[i].paula);
 		}
 	}
 #endif
-	free(p->virt.voice_array);
+	libxmp_free(p->virt.free_map);
+	p->virt.free_map = NULL;
+      err1:
+	libxmp_free(p->virt.voice_array);
 	p->virt.voice_array = NULL;
       err:
 	return -1;
@@ -165,7 +182,7 @@ void libxmp_virt_off(struct context_data *ctx)
 	/* Free Paula simulator state */
 	if (IS_AMIGA_MOD()) {
 		for (i = 0; i < p->virt.maxvoc; i++) {
-			free(p->virt.voice_array[i].paula);
+			libxmp_free(p->virt.voice_array[i].paula);
 		}
 	}
 #endif
@@ -174,10 +191,12 @@ void libxmp_virt_off(struct context_data *ctx)
 	p->virt.virt_channels = 0;
 	p->virt.num_tracks = 0;
 
-	free(p->virt.voice_array);
-	free(p->virt.virt_channel);
+	libxmp_free(p->virt.voice_array);
+	libxmp_free(p->virt.virt_channel);
+	libxmp_free(p->virt.free_map);
 	p->virt.voice_array = NULL;
 	p->virt.virt_channel = NULL;
+	p->virt.free_map = NULL;
 }
 
 void libxmp_virt_reset(struct context_data *ctx)
@@ -206,6 +225,7 @@ void libxmp_virt_reset(struct context_data *ctx)
 #endif
 		vi->chn = FREE;
 		vi->root = FREE;
+		SET_FREE(p, i);
 	}
 
 	for (i = 0; i < p->virt.virt_channels; i++) {
@@ -214,14 +234,15 @@ void libxmp_virt_reset(struct context_data *ctx)
 	}
 
 	p->virt.virt_used = 0;
+
+	libxmp_smix_reset_voices(ctx);
 }
 
-static int free_voice(struct context_data *ctx)
+/* Find background voice with lowest volume */
+static int quietest_background_voice(struct player_data *p)
 {
-	struct player_data *p = &ctx->p;
 	int i, num, vol;
 
-	/* Find background voice with lowest volume*/
 	num = FREE;
 	vol = INT_MAX;
 	for (i = 0; i < p->virt.maxvoc; i++) {
@@ -233,6 +254,16 @@ static int free_voice(struct context_data *ctx)
 		}
 	}
 
+	return num;
+}
+
+static int free_voice(struct context_data *ctx)
+{
+	struct player_data *p = &ctx->p;
+	int num;
+
+	num = quietest_background_voice(p);
+
 	/* Free voice */
 	if (num >= 0) {
 		p->virt.virt_channel[p->virt.voice_array[num].chn].map = FREE;
@@ -243,23 +274,62 @@ static int free_voice(struct context_data *ctx)
 	return num;
 }
 
+/* Stop the background voice that would be reused first, to reduce the
+ * mixer load. Returns the culled voice or -1 if there are none.
+ */
+int libxmp_virt_cull(struct context_data *ctx)
+{
+	int num;
+
+	num = quietest_background_voice(&ctx->p);
+	if (num >= 0) {
+		libxmp_virt_resetvoice(ctx, num, 1);
+	}
+
+	return num;
+}
+
+/* Find the lowest numbered free voice */
+static int find_free_voice(struct player_data *p)
+{
+	int i, num;
+	uint32 w;
+
+	num = FREE_MAP_WORDS(p->virt.maxvoc);
+
+	for (i = 0; i < num; i++) {
+		w = p->virt.free_map[i];
+		if (w != 0) {
+#if defined(__GNUC__) || defined(__clang__)
+			return (i << 5) + __builtin_ctz(w);
+#else
+			int b = 0;
+			while ((w & 1) == 0) {
+				w >>= 1;
+				b++;
+			}
+			return (i << 5) + b;
+#endif
+		}
+	}
+
+	return FREE;
+}
+
 static int alloc_voice(struct context_data *ctx, int chn)
 {
 	struct player_data *p = &ctx->p;
 	int i;
 
-	/* Find free voice */
-	for (i = 0; i < p->virt.maxvoc; i++) {
-		if (p->virt.voice_array[i].chn == FREE)
-			break;
-	}
+	i = find_free_voice(p);
 
 	/* not found */
-	if (i == p->virt.maxvoc) {
+	if (i < 0) {
 		i = free_voice(ctx);
 	}
 
 	if (i >= 0) {
+		CLEAR_FREE(p, i);
 		p->virt.virt_channel[chn].count++;
 		p->virt.virt_used++;
 
@@ -305,6 +375,8 @@ void libxmp_virt_resetchannel(struct context_data *ctx, int chn)
 
 	libxmp_mixer_setvol(ctx, voc, 0);
 
+	libxmp_smix_voice_end(ctx, chn);
+
 	p->virt.virt_used--;
 	p->virt.virt_channel[p->virt.voice_array[voc].root].count--;
 	p->virt.virt_channel[chn].map = FREE;
@@ -318,6 +390,7 @@ void libxmp_virt_resetchannel(struct context_data *ctx, int chn)
 	vi->paula = paula;
 #endif
 	vi->chn = vi->root = FREE;
+	SET_FREE(p, voc);
 }
 
 void libxmp_virt_setvol(struct context_data *ctx, int chn, int vol)
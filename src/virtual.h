@@ -34,5 +34,6 @@ void	libxmp_virt_resetvoice	(struct context_data *, int, int);
 void	libxmp_virt_reset	(struct context_data *);
 void	libxmp_virt_release	(struct context_data *, int, int);
 int	libxmp_virt_getroot	(struct context_data *, int);
+int	libxmp_virt_cull	(struct context_data *);
 
 #endif /* LIBXMP_VIRTUAL_H */
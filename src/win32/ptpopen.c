@@ -97,7 +97,7 @@ FILE * pt_popen(const char *cmd, const char *mode, struct pt_popen_data **data)
   BOOL user_data = FALSE;
 
   if (data) {
-    my_data = malloc(sizeof(struct pt_popen_data));
+    my_data = libxmp_malloc(sizeof(struct pt_popen_data));
     if (!my_data)
       return NULL;
 
@@ -189,7 +189,7 @@ finito:
 
     if (user_data)
     {
-      free(my_data);
+      libxmp_free(my_data);
       my_data = NULL;
     }
   }
@@ -226,7 +226,7 @@ int pt_pclose(FILE *fle, struct pt_popen_data **data)
 
     if (free_data)
     {
-      free(my_data);
+      libxmp_free(my_data);
       *data = NULL;
     }
     return 0;
@@ -0,0 +1,139 @@
+/* Extended Module Player
+ * Copyright (C) 1996-2021 Claudio Matsuoka and Hipolito Carraro Jr
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "common.h"
+#include "worker.h"
+
+#if defined(HAVE_PTHREAD_H) && defined(HAVE_PTHREAD_CREATE)
+#define WORKER_THREADS
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#ifdef WORKER_THREADS
+
+struct worker_queue {
+	pthread_mutex_t lock;
+	worker_func func;
+	void *data;
+	int num;
+	int next;
+	struct alloc_class *alloc;	/* allocations are charged to the caller */
+};
+
+static int get_job(struct worker_queue *q)
+{
+	int job = -1;
+
+	pthread_mutex_lock(&q->lock);
+	if (q->next < q->num) {
+		job = q->next++;
+	}
+	pthread_mutex_unlock(&q->lock);
+
+	return job;
+}
+
+static void *worker(void *arg)
+{
+	struct worker_queue *q = (struct worker_queue *)arg;
+	int job;
+
+	/* Select the allocator of the thread that queued the jobs */
+	libxmp_leave_allocator(q->alloc);
+
+	while ((job = get_job(q)) >= 0) {
+		q->func(q->data, job);
+	}
+
+	return NULL;
+}
+
+static int get_num_threads(void)
+{
+#ifdef _SC_NPROCESSORS_ONLN
+	long num = sysconf(_SC_NPROCESSORS_ONLN);
+
+	if (num > WORKER_MAX_THREADS) {
+		return WORKER_MAX_THREADS;
+	}
+	if (num > 0) {
+		return num;
+	}
+#endif
+	return 1;
+}
+
+#endif
+
+/* Call func(data, n) for each job n from 0 to num - 1. Jobs are spread
+ * over worker threads if available, so they must not share state. If
+ * threads can't be created, the remaining jobs run in the caller. Jobs
+ * also run in the caller if the context has its own allocator, which
+ * isn't required to be thread-safe.
+ */
+void libxmp_run_jobs(worker_func func, void *data, int num)
+{
+	int i;
+
+#ifdef WORKER_THREADS
+	pthread_t thread[WORKER_MAX_THREADS - 1];
+	struct worker_queue q;
+	int num_threads;
+
+	num_threads = get_num_threads();
+	if (num_threads > num) {
+		num_threads = num;
+	}
+
+	if (libxmp_custom_allocator()) {
+		num_threads = 1;
+	}
+
+	if (num_threads > 1 && pthread_mutex_init(&q.lock, NULL) == 0) {
+		q.func = func;
+		q.data = data;
+		q.num = num;
+		q.next = 0;
+		q.alloc = libxmp_get_allocator();
+
+		for (i = 0; i < num_threads - 1; i++) {
+			if (pthread_create(&thread[i], NULL, worker, &q) != 0) {
+				break;
+			}
+		}
+
+		/* The calling thread also takes jobs */
+		worker(&q);
+
+		while (--i >= 0) {
+			pthread_join(thread[i], NULL);
+		}
+		pthread_mutex_destroy(&q.lock);
+		return;
+	}
+#endif
+
+	for (i = 0; i < num; i++) {
+		func(data, i);
+	}
+}
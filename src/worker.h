@@ -0,0 +1,10 @@
+#ifndef LIBXMP_WORKER_H
+#define LIBXMP_WORKER_H
+
+#define WORKER_MAX_THREADS 8
+
+typedef void (*worker_func)(void *, int);
+
+void	libxmp_run_jobs		(worker_func, void *, int);
+
+#endif /* LIBXMP_WORKER_H */
@@ -0,0 +1,711 @@
+
+declare_test(test_read_file_32bit_little_endian);
+declare_test(test_read_file_32bit_big_endian);
+declare_test(test_read_file_24bit_little_endian);
+declare_test(test_read_file_24bit_big_endian);
+declare_test(test_read_file_16bit_little_endian);
+declare_test(test_read_file_16bit_big_endian);
+declare_test(test_read_file_8bit);
+declare_test(test_read_mem_32bit_little_endian);
+declare_test(test_read_mem_32bit_big_endian);
+declare_test(test_read_mem_16bit_little_endian);
+declare_test(test_read_mem_16bit_big_endian);
+declare_test(test_read_mem_hio);
+declare_test(test_read_mem_hio_nosize);
+declare_test(test_read_file_hio_pipe);
+declare_test(test_write_file_32bit_little_endian);
+declare_test(test_write_file_32bit_big_endian);
+declare_test(test_write_file_16bit_little_endian);
+declare_test(test_write_file_16bit_big_endian);
+declare_test(test_write_file_8bit);
+declare_test(test_write_file_move_data);
+declare_test(test_sample_load_8bit);
+declare_test(test_sample_load_16bit);
+declare_test(test_sample_load_delta);
+declare_test(test_sample_load_signal);
+declare_test(test_sample_load_endian);
+declare_test(test_sample_load_skip);
+declare_test(test_sample_load_fused);
+declare_test(test_depack_pp);
+declare_test(test_depack_sqsh);
+declare_test(test_depack_s404);
+declare_test(test_depack_mmcmp);
+declare_test(test_depack_zip);
+declare_test(test_depack_zip_filtered);
+declare_test(test_depack_zip_store);
+declare_test(test_depack_arcfs);
+declare_test(test_depack_gzip);
+declare_test(test_depack_inflate_memory);
+declare_test(test_depack_compress);
+declare_test(test_depack_arc_method2);
+declare_test(test_depack_arc_method8);
+declare_test(test_depack_rar);
+declare_test(test_depack_spark);
+declare_test(test_depack_j2b);
+declare_test(test_depack_lzx);
+declare_test(test_depack_bzip2);
+declare_test(test_depack_xz);
+declare_test(test_depack_lha_l0_lzhuff1);
+declare_test(test_depack_lha_l0_lzhuff5);
+declare_test(test_depack_lha_l1_lzhuff5);
+declare_test(test_depack_lha_l1_lzhuff6);
+declare_test(test_depack_lha_l1_lzhuff7);
+declare_test(test_depack_lha_l2_lzhuff7);
+declare_test(test_depack_lha_l0_filtered);
+declare_test(test_depack_lha_l1_filtered);
+declare_test(test_depack_lha_l2_filtered);
+declare_test(test_depack_vorbis);
+declare_test(test_depack_vorbis_8bit);
+declare_test(test_depack_it_sample_8bit);
+declare_test(test_depack_it_sample_16bit);
+declare_test(test_depack_nested);
+declare_test(test_depack_mfp);
+declare_test(test_prowizard_zen);
+declare_test(test_prowizard_fuchs);
+declare_test(test_prowizard_starpack);
+declare_test(test_string_adjustment);
+declare_test(test_loader_6chn);
+declare_test(test_loader_mod_adpcm4);
+declare_test(test_loader_mod_noterange);
+declare_test(test_loader_mod_noterange2);
+declare_test(test_loader_mod_scrm);
+declare_test(test_loader_mod_notawow);
+declare_test(test_loader_mod_invalid);
+declare_test(test_loader_nst);
+declare_test(test_loader_ust);
+declare_test(test_loader_wow);
+declare_test(test_loader_wow_extra);
+declare_test(test_loader_m15);
+declare_test(test_loader_m15_invalid);
+declare_test(test_loader_m15_invalid2);
+declare_test(test_loader_m15_short_rip);
+declare_test(test_loader_s3m);
+declare_test(test_loader_s3m_adpcm);
+declare_test(test_loader_s3m_schism);
+declare_test(test_loader_xm102);
+declare_test(test_loader_xm_adpcm);
+declare_test(test_loader_xm_xmlite);
+declare_test(test_loader_xm_short);
+declare_test(test_loader_xm_instsamples);
+declare_test(test_loader_it);
+declare_test(test_loader_it_oldins);
+declare_test(test_loader_it_schism);
+declare_test(test_loader_it_invalid_fx);
+declare_test(test_loader_669);
+declare_test(test_loader_abk);
+declare_test(test_loader_asylum);
+declare_test(test_loader_chiptracker);
+declare_test(test_loader_coco);
+declare_test(test_loader_dbm);
+declare_test(test_loader_dbm_rows);
+declare_test(test_loader_dbm_penv);
+declare_test(test_loader_dbm_venv);
+declare_test(test_loader_digi);
+declare_test(test_loader_dsmi);
+declare_test(test_loader_dsmi_08);
+declare_test(test_loader_dsmi_09);
+declare_test(test_loader_dsmi_10);
+declare_test(test_loader_dsmi_10_trunc);
+declare_test(test_loader_dsmi_track0);
+declare_test(test_loader_dsmi_note7f);
+declare_test(test_loader_dsmi_pan);
+declare_test(test_loader_dsmi_vol);
+declare_test(test_loader_dtm);
+declare_test(test_loader_emod);
+declare_test(test_loader_far);
+declare_test(test_loader_flt);
+declare_test(test_loader_flt8);
+declare_test(test_loader_fnk);
+declare_test(test_loader_gdm);
+declare_test(test_loader_gdm_fx);
+declare_test(test_loader_gdm_fx2);
+declare_test(test_loader_ice);
+declare_test(test_loader_imf);
+declare_test(test_loader_ims);
+declare_test(test_loader_j2b);
+declare_test(test_loader_liq);
+declare_test(test_loader_liq_no);
+declare_test(test_loader_masi);
+declare_test(test_loader_mdl0);
+declare_test(test_loader_mdl);
+declare_test(test_loader_med2);
+declare_test(test_loader_med3);
+declare_test(test_loader_med4);
+declare_test(test_loader_mmd0);
+declare_test(test_loader_mmd0_compattempo);
+declare_test(test_loader_mmd1_longpat);
+declare_test(test_loader_mmd3);
+declare_test(test_loader_mmd_iff3oct);
+declare_test(test_loader_mfp);
+declare_test(test_loader_mgt);
+declare_test(test_loader_mtm);
+declare_test(test_loader_okt);
+declare_test(test_loader_psm);
+declare_test(test_loader_ptm);
+declare_test(test_loader_pt36);
+declare_test(test_loader_rtm);
+declare_test(test_loader_sfx);
+declare_test(test_loader_stim);
+declare_test(test_loader_stm);
+declare_test(test_loader_stm_v1);
+declare_test(test_loader_stx);
+declare_test(test_loader_ult);
+declare_test(test_loader_ac1d);
+declare_test(test_loader_crb);
+declare_test(test_loader_crb2);
+declare_test(test_loader_di);
+declare_test(test_loader_eureka);
+declare_test(test_loader_fc_m);
+declare_test(test_loader_fuchs);
+declare_test(test_loader_fuzzac);
+declare_test(test_loader_gmc);
+declare_test(test_loader_hrt);
+declare_test(test_loader_ksm);
+declare_test(test_loader_mp_noid);
+declare_test(test_loader_novotrade);
+declare_test(test_loader_np1);
+declare_test(test_loader_np2);
+declare_test(test_loader_np3);
+declare_test(test_loader_nru);
+declare_test(test_loader_p40a);
+declare_test(test_loader_p40b);
+declare_test(test_loader_p41a);
+declare_test(test_loader_p50a);
+declare_test(test_loader_p60);
+declare_test(test_loader_p61);
+declare_test(test_loader_pha);
+declare_test(test_loader_pha_short);
+declare_test(test_loader_pm10);
+declare_test(test_loader_pm18);
+declare_test(test_loader_pp10_1);
+declare_test(test_loader_pp10_2);
+declare_test(test_loader_pp10_3);
+declare_test(test_loader_pp10_4);
+declare_test(test_loader_pp21_1);
+declare_test(test_loader_pp21_2);
+declare_test(test_loader_pp30_1);
+declare_test(test_loader_pp30_2);
+declare_test(test_loader_pru1);
+declare_test(test_loader_pru2);
+declare_test(test_loader_skyt);
+declare_test(test_loader_starpack);
+declare_test(test_loader_tdd);
+declare_test(test_loader_titanics);
+declare_test(test_loader_tp1);
+declare_test(test_loader_tp2);
+declare_test(test_loader_tp3);
+declare_test(test_loader_unic);
+declare_test(test_loader_unic_id0);
+declare_test(test_loader_unic2);
+declare_test(test_loader_wn);
+declare_test(test_loader_xann);
+declare_test(test_api_get_format_list);
+declare_test(test_api_create_context);
+declare_test(test_api_free_context);
+declare_test(test_api_create_context_with_allocator);
+declare_test(test_api_test_module);
+declare_test(test_api_load_module);
+declare_test(test_api_load_module_from_memory);
+declare_test(test_api_load_module_from_file);
+declare_test(test_api_load_module_from_callbacks);
+declare_test(test_api_test_module_from_file);
+declare_test(test_api_test_module_from_memory);
+declare_test(test_api_test_module_from_callbacks);
+declare_test(test_api_list_archive);
+declare_test(test_api_load_module_from_archive);
+declare_test(test_api_start_player);
+declare_test(test_api_play_buffer);
+declare_test(test_api_get_frame_status);
+declare_test(test_api_set_event_callback);
+declare_test(test_api_get_profile);
+declare_test(test_api_share_samples);
+declare_test(test_api_share_samples_invloop);
+declare_test(test_api_set_position);
+declare_test(test_api_prev_position);
+declare_test(test_api_set_position_midfx);
+declare_test(test_api_set_row);
+declare_test(test_api_set_player);
+declare_test(test_api_stop_module);
+declare_test(test_api_restart_module);
+declare_test(test_api_seek_time);
+declare_test(test_api_channel_mute);
+declare_test(test_api_channel_vol);
+declare_test(test_api_inject_event);
+declare_test(test_api_scan_module);
+declare_test(test_api_start_stems);
+declare_test(test_api_render_ahead);
+declare_test(test_api_command_queue);
+declare_test(test_api_get_memory_info);
+declare_test(test_api_set_tempo_factor);
+declare_test(test_api_smix_play_instrument);
+declare_test(test_api_smix_load_sample);
+declare_test(test_api_smix_play_sample);
+declare_test(test_api_smix_play_buffer);
+declare_test(test_api_smix_play_voice);
+declare_test(test_api_smix_load_sample_from_memory);
+declare_test(test_api_smix_load_sample_from_callbacks);
+declare_test(test_api_smix_channel_pan);
+declare_test(test_new_note_no_ins_mod);
+declare_test(test_new_note_no_ins_ft2);
+declare_test(test_new_note_no_ins_st3);
+declare_test(test_new_note_no_ins_it);
+declare_test(test_new_note_same_ins_mod);
+declare_test(test_new_note_same_ins_ft2);
+declare_test(test_new_note_same_ins_st3);
+declare_test(test_new_note_same_ins_it);
+declare_test(test_new_note_valid_ins_mod);
+declare_test(test_new_note_valid_ins_ft2);
+declare_test(test_new_note_valid_ins_st3);
+declare_test(test_new_note_valid_ins_it);
+declare_test(test_new_note_invalid_ins_mod);
+declare_test(test_new_note_invalid_ins_ft2);
+declare_test(test_new_note_invalid_ins_st3);
+declare_test(test_new_note_invalid_ins_it);
+declare_test(test_no_note_same_ins_mod);
+declare_test(test_no_note_same_ins_ft2);
+declare_test(test_no_note_same_ins_st3);
+declare_test(test_no_note_same_ins_it);
+declare_test(test_no_note_valid_ins_mod);
+declare_test(test_no_note_valid_ins_ft2);
+declare_test(test_no_note_valid_ins_st3);
+declare_test(test_no_note_valid_ins_it);
+declare_test(test_no_note_invalid_ins_mod);
+declare_test(test_no_note_invalid_ins_ft2);
+declare_test(test_no_note_invalid_ins_st3);
+declare_test(test_no_note_invalid_ins_it);
+declare_test(test_porta_no_ins_mod);
+declare_test(test_porta_no_ins_ft2);
+declare_test(test_porta_no_ins_st3);
+declare_test(test_porta_no_ins_it);
+declare_test(test_porta_same_ins_mod);
+declare_test(test_porta_same_ins_ft2);
+declare_test(test_porta_same_ins_st3);
+declare_test(test_porta_same_ins_it);
+declare_test(test_porta_valid_ins_mod);
+declare_test(test_porta_valid_ins_ft2);
+declare_test(test_porta_valid_ins_st3);
+declare_test(test_porta_valid_ins_it);
+declare_test(test_porta_invalid_ins_mod);
+declare_test(test_porta_invalid_ins_ft2);
+declare_test(test_porta_invalid_ins_st3);
+declare_test(test_porta_invalid_ins_it);
+declare_test(test_effect_0_arpeggio);
+declare_test(test_effect_1_slide_up);
+declare_test(test_effect_2_slide_down);
+declare_test(test_effect_4_vibrato);
+declare_test(test_effect_a_volslide);
+declare_test(test_effect_8_setpan);
+declare_test(test_effect_c_volset);
+declare_test(test_effect_e9_retrig);
+declare_test(test_effect_ed_delay);
+declare_test(test_effect_ef_invert_loop);
+declare_test(test_effect_f_set_speed);
+declare_test(test_effect_volslide);
+declare_test(test_effect_track_volslide);
+declare_test(test_effect_okt_arpeggio);
+declare_test(test_effect_per_slide);
+declare_test(test_effect_per_toneporta);
+declare_test(test_effect_panbrello);
+declare_test(test_effect_globalvol);
+declare_test(test_effect_gvol_slide);
+declare_test(test_effect_s3m_bpm);
+declare_test(test_effect_it_bpm);
+declare_test(test_effect_fine_vibrato);
+declare_test(test_effect_it_panslide);
+declare_test(test_effect_it_vcol_g);
+declare_test(test_effect_it_break_to_row);
+declare_test(test_effect_it_multi_retrig);
+declare_test(test_effect_pastnote_cut);
+declare_test(test_effect_pastnote_off);
+declare_test(test_effect_pastnote_fade);
+declare_test(test_effect_set_nna_cut);
+declare_test(test_effect_set_nna_cont);
+declare_test(test_effect_set_nna_off);
+declare_test(test_effect_set_nna_fade);
+declare_test(test_effect_note_slide);
+declare_test(test_effect_note_slide_retrig);
+declare_test(test_effect_persistent_slide);
+declare_test(test_effect_persistent_vslide);
+declare_test(test_effect_persistent_vibrato);
+declare_test(test_effect_it_g00_nosuck);
+declare_test(test_effect_it_l00_nosuck);
+declare_test(test_effect_it_fine_vol_row_delay);
+declare_test(test_effect_it_filter_cache);
+declare_test(test_prev_order_start);
+declare_test(test_prev_order_skip);
+declare_test(test_prev_order_start_seq);
+declare_test(test_next_order_skip);
+declare_test(test_storlek_01_arpeggio_pitch_slide);
+declare_test(test_storlek_02_arpeggio_no_value);
+declare_test(test_storlek_03_compatible_gxx_off);
+declare_test(test_storlek_04_compatible_gxx_on);
+declare_test(test_storlek_05_gxx_fine_slides_memory);
+declare_test(test_storlek_06_volume_column_and_fine_slides);
+declare_test(test_storlek_07_note_cut_with_sample);
+declare_test(test_storlek_08_out_of_range_delays);
+declare_test(test_storlek_09_sample_change_no_note);
+declare_test(test_storlek_10_pattern_loop);
+declare_test(test_storlek_11_infinite_pattern_loop);
+declare_test(test_storlek_12_tremor);
+declare_test(test_storlek_13_tremor_with_old_effects);
+declare_test(test_storlek_14_pingpong_loop_and_sample_number);
+declare_test(test_storlek_15_retrigger);
+declare_test(test_storlek_16_global_volume);
+declare_test(test_storlek_17_pattern_row_delay);
+declare_test(test_storlek_18_sample_number_new_note);
+declare_test(test_storlek_19_random_waveform);
+declare_test(test_storlek_20_pan_swing_and_set_pan);
+declare_test(test_storlek_21_pitch_slide_limits);
+declare_test(test_storlek_22_zero_cut_and_delay);
+declare_test(test_storlek_23_portamento_with_no_note);
+declare_test(test_storlek_24_short_envelope_loops);
+declare_test(test_storlek_25_portamento_and_pitch_slide);
+declare_test(test_openmpt_xm_3xxins);
+declare_test(test_openmpt_xm_3xx_no_old_samp);
+declare_test(test_openmpt_xm_3xx_no_old_samp_noft);
+declare_test(test_openmpt_xm_arpeggio);
+declare_test(test_openmpt_xm_arpeggioclamp);
+declare_test(test_openmpt_xm_arpslide);
+declare_test(test_openmpt_xm_delay1);
+declare_test(test_openmpt_xm_delay2);
+declare_test(test_openmpt_xm_delay3);
+declare_test(test_openmpt_xm_delaycombination);
+declare_test(test_openmpt_xm_delaycut);
+declare_test(test_openmpt_xm_e90);
+declare_test(test_openmpt_xm_envloops);
+declare_test(test_openmpt_xm_envoff);
+declare_test(test_openmpt_xm_envretrig);
+declare_test(test_openmpt_xm_finetune);
+declare_test(test_openmpt_xm_finevol_linkmem);
+declare_test(test_openmpt_xm_glissando);
+declare_test(test_openmpt_xm_key_off);
+declare_test(test_openmpt_xm_keyoff2);
+declare_test(test_openmpt_xm_keyoff_instr);
+declare_test(test_openmpt_xm_notelimit);
+declare_test(test_openmpt_xm_notelimit2);
+declare_test(test_openmpt_xm_noteoff);
+declare_test(test_openmpt_xm_noteoff2);
+declare_test(test_openmpt_xm_noteofffade);
+declare_test(test_openmpt_xm_noteoffvolume);
+declare_test(test_openmpt_xm_offdelay);
+declare_test(test_openmpt_xm_offsetrange);
+declare_test(test_openmpt_xm_panmemory);
+declare_test(test_openmpt_xm_panmemory2);
+declare_test(test_openmpt_xm_panoff);
+declare_test(test_openmpt_xm_panslidemem);
+declare_test(test_openmpt_xm_pathead);
+declare_test(test_openmpt_xm_patterndelays);
+declare_test(test_openmpt_xm_patterndelaysretrig);
+declare_test(test_openmpt_xm_patloop_break);
+declare_test(test_openmpt_xm_patloop_weird);
+declare_test(test_openmpt_xm_pickup);
+declare_test(test_openmpt_xm_porta_linkmem);
+declare_test(test_openmpt_xm_porta_offset);
+declare_test(test_openmpt_xm_porta_pickup);
+declare_test(test_openmpt_xm_setenvpos);
+declare_test(test_openmpt_xm_toneportamentomemory);
+declare_test(test_openmpt_xm_tremolowaveforms);
+declare_test(test_openmpt_xm_tremor);
+declare_test(test_openmpt_xm_tremorinstr);
+declare_test(test_openmpt_xm_tremorrecover);
+declare_test(test_openmpt_xm_vibratowaveforms);
+declare_test(test_openmpt_it_autovibrato_reset);
+declare_test(test_openmpt_it_bidi_loops);
+declare_test(test_openmpt_it_carrynna);
+declare_test(test_openmpt_it_cut_carry);
+declare_test(test_openmpt_it_emptyslot);
+declare_test(test_openmpt_it_envloopescape);
+declare_test(test_openmpt_it_envloops);
+declare_test(test_openmpt_it_envofflength);
+declare_test(test_openmpt_it_envreset);
+declare_test(test_openmpt_it_extreme_filter_test_1);
+declare_test(test_openmpt_it_fade_porta);
+declare_test(test_openmpt_it_filter_7f);
+declare_test(test_openmpt_it_filterenvreset);
+declare_test(test_openmpt_it_filter_nna);
+declare_test(test_openmpt_it_filter_reset);
+declare_test(test_openmpt_it_filter_reset_carry);
+declare_test(test_openmpt_it_finevolcolslide);
+declare_test(test_openmpt_it_flt_env_carry);
+declare_test(test_openmpt_it_freqreset_noins);
+declare_test(test_openmpt_it_globalvol_invalid);
+declare_test(test_openmpt_it_gxsmp);
+declare_test(test_openmpt_it_gxsmp2);
+declare_test(test_openmpt_it_gxxtest);
+declare_test(test_openmpt_it_ins_flt_porta_reset);
+declare_test(test_openmpt_it_instrumentnumberchange);
+declare_test(test_openmpt_it_linearslides);
+declare_test(test_openmpt_it_nomap);
+declare_test(test_openmpt_it_noteoff2);
+declare_test(test_openmpt_it_noteoff3);
+declare_test(test_openmpt_it_noteoffinstr);
+declare_test(test_openmpt_it_off_porta);
+declare_test(test_openmpt_it_off_porta_compatgxx);
+declare_test(test_openmpt_it_panreset);
+declare_test(test_openmpt_it_porta_offset);
+declare_test(test_openmpt_it_portainsnum);
+declare_test(test_openmpt_it_portainsnumcompat);
+declare_test(test_openmpt_it_portajuststoppednote);
+declare_test(test_openmpt_it_portareset);
+declare_test(test_openmpt_it_portasample);
+declare_test(test_openmpt_it_portasamplecompat);
+declare_test(test_openmpt_it_randompan);
+declare_test(test_openmpt_it_retrig);
+declare_test(test_openmpt_it_retrig_short);
+declare_test(test_openmpt_it_s77);
+declare_test(test_openmpt_it_s7xinsnum);
+declare_test(test_openmpt_it_samplenumberchange);
+declare_test(test_openmpt_it_scx);
+declare_test(test_openmpt_it_smpinspansurround);
+declare_test(test_openmpt_it_stoppedinstrswap);
+declare_test(test_openmpt_it_susafterloop);
+declare_test(test_openmpt_it_swaptest);
+declare_test(test_openmpt_it_swing1);
+declare_test(test_openmpt_it_swing2);
+declare_test(test_openmpt_it_swing3);
+declare_test(test_openmpt_it_vol_env_carry);
+declare_test(test_openmpt_it_volcolmemory);
+declare_test(test_openmpt_it_wnoteoff);
+declare_test(test_openmpt_s3m_amigalimits);
+declare_test(test_openmpt_s3m_freqlimits);
+declare_test(test_openmpt_s3m_parammemory);
+declare_test(test_openmpt_s3m_patterndelaysretrig);
+declare_test(test_openmpt_s3m_periodlimit);
+declare_test(test_openmpt_s3m_portasmpchange);
+declare_test(test_openmpt_mod_amigalimitsfinetune);
+declare_test(test_openmpt_mod_arpwraparound);
+declare_test(test_openmpt_mod_delaybreak);
+declare_test(test_openmpt_mod_finetune);
+declare_test(test_openmpt_mod_patternjump);
+declare_test(test_openmpt_mod_portasmpchange);
+declare_test(test_openmpt_mod_portatarget);
+declare_test(test_openmpt_mod_ptoffset);
+declare_test(test_openmpt_mod_vibratoreset);
+declare_test(test_player_read_event);
+declare_test(test_player_scan);
+declare_test(test_player_period_amiga);
+declare_test(test_player_period_mod_range);
+declare_test(test_player_pan);
+declare_test(test_player_med_hold);
+declare_test(test_player_med_synth);
+declare_test(test_player_med_synth_2);
+declare_test(test_player_hmn_extras);
+declare_test(test_player_note_off_ft2);
+declare_test(test_player_note_off_it);
+declare_test(test_player_virtual_channel);
+declare_test(test_player_nna_cut);
+declare_test(test_player_nna_cont);
+declare_test(test_player_nna_off);
+declare_test(test_player_nna_fade);
+declare_test(test_player_dct_note);
+declare_test(test_player_s3m_sample_porta);
+declare_test(test_player_it_keyoff);
+declare_test(test_player_it_note_after_cut);
+declare_test(test_player_it_sample_porta);
+declare_test(test_player_it_portamento_after_keyoff);
+declare_test(test_player_it_portamento_after_keyoff_cg);
+declare_test(test_player_it_portamento_after_cut_fade);
+declare_test(test_player_it_portamento_after_cut_fade_cg);
+declare_test(test_player_it_portamento_envelope_reset);
+declare_test(test_player_it_portamento_envelope_reset_cg);
+declare_test(test_player_xm_portamento_envelope_reset);
+declare_test(test_player_xm_portamento_target);
+declare_test(test_player_xm_keyoff_with_instrument);
+declare_test(test_player_ft2_note_noins_after_keyoff);
+declare_test(test_player_ft2_note_noins_after_invalid_ins);
+declare_test(test_player_invalid_period);
+declare_test(test_player_invalid_mod_length);
+declare_test(test_player_invalid_mod_channels);
+declare_test(test_player_it_noteoff_nosuck);
+declare_test(test_player_mdl_period);
+declare_test(test_mixer_interpolation_default);
+declare_test(test_mixer_mono_8bit_nearest);
+declare_test(test_mixer_mono_16bit_nearest);
+declare_test(test_mixer_stereo_8bit_nearest);
+declare_test(test_mixer_stereo_16bit_nearest);
+declare_test(test_mixer_mono_8bit_linear);
+declare_test(test_mixer_mono_16bit_linear);
+declare_test(test_mixer_stereo_8bit_linear);
+declare_test(test_mixer_stereo_16bit_linear);
+declare_test(test_mixer_mono_8bit_linear_filter);
+declare_test(test_mixer_mono_16bit_linear_filter);
+declare_test(test_mixer_stereo_8bit_linear_filter);
+declare_test(test_mixer_stereo_16bit_linear_filter);
+declare_test(test_mixer_mono_8bit_spline);
+declare_test(test_mixer_mono_16bit_spline);
+declare_test(test_mixer_stereo_8bit_spline);
+declare_test(test_mixer_stereo_16bit_spline);
+declare_test(test_mixer_mono_8bit_spline_filter);
+declare_test(test_mixer_mono_16bit_spline_filter);
+declare_test(test_mixer_stereo_8bit_spline_filter);
+declare_test(test_mixer_stereo_16bit_spline_filter);
+declare_test(test_mixer_downmix_8bit);
+declare_test(test_mixer_downmix_16bit);
+declare_test(test_mixer_cpu_budget);
+declare_test(test_mixer_synth_adlib);
+declare_test(test_fuzzer_mod_no_null_terminator);
+declare_test(test_fuzzer_mod_no_valid_orders);
+declare_test(test_fuzzer_mod_scan_row_limit);
+declare_test(test_fuzzer_st_invalid_sample_count);
+declare_test(test_fuzzer_st_truncated);
+declare_test(test_fuzzer_s3m_invalid_sample_size);
+declare_test(test_fuzzer_s3m_invalid_sample_size2);
+declare_test(test_fuzzer_xm_zero_samples);
+declare_test(test_fuzzer_it_dca_3);
+declare_test(test_fuzzer_it_invalid_compressed);
+declare_test(test_fuzzer_it_long_patterns);
+declare_test(test_fuzzer_it_truncated_header);
+declare_test(test_fuzzer_it_truncated_pattern);
+declare_test(test_fuzzer_669_truncated);
+declare_test(test_fuzzer_abk_0_instruments);
+declare_test(test_fuzzer_amf_truncated);
+declare_test(test_fuzzer_arch_invalid_patterns);
+declare_test(test_fuzzer_chip_truncated);
+declare_test(test_fuzzer_dbm_chunk_order);
+declare_test(test_fuzzer_dbm_invalid_instruments);
+declare_test(test_fuzzer_dbm_name_buffer_overflow);
+declare_test(test_fuzzer_dbm_sample_count);
+declare_test(test_fuzzer_dbm_truncated);
+declare_test(test_fuzzer_digi_truncated);
+declare_test(test_fuzzer_dt_channels_bound);
+declare_test(test_fuzzer_dt_duplicate_chunk);
+declare_test(test_fuzzer_dt_instrument_count);
+declare_test(test_fuzzer_emod_duplicate_chunk);
+declare_test(test_fuzzer_far_truncated);
+declare_test(test_fuzzer_flt_umr);
+declare_test(test_fuzzer_fnk_channels_bound);
+declare_test(test_fuzzer_fnk_invalid_sample_size);
+declare_test(test_fuzzer_fnk_patterns_bound);
+declare_test(test_fuzzer_gal4_duplicate_instrument);
+declare_test(test_fuzzer_gal4_env_point_bound);
+declare_test(test_fuzzer_gal4_env_point_bound_repacked);
+declare_test(test_fuzzer_gal4_invalid_sample_num);
+declare_test(test_fuzzer_gal5_channels_bound);
+declare_test(test_fuzzer_gal5_channels_bound_repacked);
+declare_test(test_fuzzer_gal5_duplicate_instrument);
+declare_test(test_fuzzer_gal5_invalid_sample_num);
+declare_test(test_fuzzer_gal5_truncated_info);
+declare_test(test_fuzzer_gdm_invalid_sample_size);
+declare_test(test_fuzzer_gdm_samples_bound);
+declare_test(test_fuzzer_gdm_truncated);
+declare_test(test_fuzzer_gdm_truncated_header);
+declare_test(test_fuzzer_hmn_truncated);
+declare_test(test_fuzzer_ice_truncated);
+declare_test(test_fuzzer_imf_truncated);
+declare_test(test_fuzzer_ims_scan_loop);
+declare_test(test_fuzzer_ims_truncated_magic);
+declare_test(test_fuzzer_liq_no_valid_orders);
+declare_test(test_fuzzer_liq_truncated);
+declare_test(test_fuzzer_masi_invalid_length);
+declare_test(test_fuzzer_masi_seek_loop);
+declare_test(test_fuzzer_masi_truncated);
+declare_test(test_fuzzer_mdl_duplicate_chunk);
+declare_test(test_fuzzer_mdl_duplicate_is_chunk);
+declare_test(test_fuzzer_mdl_duplicate_pa_chunk);
+declare_test(test_fuzzer_mdl_duplicate_sa_chunk);
+declare_test(test_fuzzer_mdl_ii_after_is);
+declare_test(test_fuzzer_mdl_invalid_chunk_order);
+declare_test(test_fuzzer_mdl_invalid_run);
+declare_test(test_fuzzer_mdl_invalid_sample);
+declare_test(test_fuzzer_mdl_truncated);
+declare_test(test_fuzzer_mdl_umr);
+declare_test(test_fuzzer_med3_invalid_pattern);
+declare_test(test_fuzzer_med4_instrument_name);
+declare_test(test_fuzzer_mfp_truncated);
+declare_test(test_fuzzer_mgt_patterns_bound);
+declare_test(test_fuzzer_mmd0_sample_count);
+declare_test(test_fuzzer_mmd1_channel_count);
+declare_test(test_fuzzer_mmd1_truncated);
+declare_test(test_fuzzer_mmd3_invalid_blockarr);
+declare_test(test_fuzzer_mmd3_invalid_mmdinfo);
+declare_test(test_fuzzer_mmd3_invalid_sample_size);
+declare_test(test_fuzzer_mmd3_invalid_text_size);
+declare_test(test_fuzzer_mmd3_truncated);
+declare_test(test_fuzzer_mtm_channels_bound);
+declare_test(test_fuzzer_okt_duplicate_chunk);
+declare_test(test_fuzzer_okt_invalid_chunk_order);
+declare_test(test_fuzzer_okt_sbod_leak);
+declare_test(test_fuzzer_psm_samples_bound);
+declare_test(test_fuzzer_pt3_ptdt_leak);
+declare_test(test_fuzzer_pt3_truncated);
+declare_test(test_fuzzer_rtm_zero_samples);
+declare_test(test_fuzzer_sfx_truncated);
+declare_test(test_fuzzer_stm_patterns_bound);
+declare_test(test_fuzzer_stx_instruments_bound);
+declare_test(test_fuzzer_stx_truncated);
+declare_test(test_fuzzer_sym_truncated_lzw);
+declare_test(test_fuzzer_ult_channels_bound);
+declare_test(test_fuzzer_ult_invalid_tracks);
+declare_test(test_fuzzer_ult_truncated);
+declare_test(test_fuzzer_ult_v000);
+declare_test(test_fuzzer_prowizard_ac1d_invalid_note);
+declare_test(test_fuzzer_prowizard_di_patterns_bound);
+declare_test(test_fuzzer_prowizard_di_patterns_test);
+declare_test(test_fuzzer_prowizard_di_truncated);
+declare_test(test_fuzzer_prowizard_eureka_truncated);
+declare_test(test_fuzzer_prowizard_fuchs_pattern_length);
+declare_test(test_fuzzer_prowizard_heatseek_truncated);
+declare_test(test_fuzzer_prowizard_ksm_invalid_pattern);
+declare_test(test_fuzzer_prowizard_noiserun_truncated);
+declare_test(test_fuzzer_prowizard_novotrade_invalid_order);
+declare_test(test_fuzzer_prowizard_novotrade_orders_bound);
+declare_test(test_fuzzer_prowizard_novotrade_patterns_bound);
+declare_test(test_fuzzer_prowizard_np2_patterns_bound);
+declare_test(test_fuzzer_prowizard_np3_invalid_note);
+declare_test(test_fuzzer_prowizard_np3_patterns_bound);
+declare_test(test_fuzzer_prowizard_p40_invalid_packing);
+declare_test(test_fuzzer_prowizard_p40_zero_length);
+declare_test(test_fuzzer_prowizard_p61a_invalid_note);
+declare_test(test_fuzzer_prowizard_p61a_invalid_sample_dup);
+declare_test(test_fuzzer_prowizard_p61a_truncated);
+declare_test(test_fuzzer_prowizard_pha_invalid_note);
+declare_test(test_fuzzer_prowizard_pha_invalid_offset);
+declare_test(test_fuzzer_prowizard_pha_patterns_bound);
+declare_test(test_fuzzer_prowizard_pha_truncated);
+declare_test(test_fuzzer_prowizard_pm10c_invalid_note);
+declare_test(test_fuzzer_prowizard_pm10c_invalid_pattern);
+declare_test(test_fuzzer_prowizard_pm10c_invalid_psize);
+declare_test(test_fuzzer_prowizard_pm10c_zero_length);
+declare_test(test_fuzzer_prowizard_pm18a_invalid_note);
+declare_test(test_fuzzer_prowizard_pm18a_zero_length);
+declare_test(test_fuzzer_prowizard_pp10_invalid_pattern);
+declare_test(test_fuzzer_prowizard_pp21_truncated);
+declare_test(test_fuzzer_prowizard_pp30_invalid);
+declare_test(test_fuzzer_prowizard_starpack_junk_orders);
+declare_test(test_fuzzer_prowizard_theplayer_invalid_note);
+declare_test(test_fuzzer_prowizard_theplayer_invalid_sample_dup);
+declare_test(test_fuzzer_prowizard_titanics_truncated);
+declare_test(test_fuzzer_prowizard_tp1_invalid_length);
+declare_test(test_fuzzer_prowizard_tp3_patterns_bound);
+declare_test(test_fuzzer_prowizard_tp3_samples_bound);
+declare_test(test_fuzzer_prowizard_unic_truncated);
+declare_test(test_fuzzer_prowizard_zen_invalid_note);
+declare_test(test_fuzzer_depack_arcfs_lzw_leak);
+declare_test(test_fuzzer_depack_arcfs_negative_header_size);
+declare_test(test_fuzzer_depack_arcfs_negative_size);
+declare_test(test_fuzzer_depack_arcfs_zero_length);
+declare_test(test_fuzzer_depack_bz2_invalid_selector);
+declare_test(test_fuzzer_depack_gzip_invalid_name);
+declare_test(test_fuzzer_depack_gzip_truncated);
+declare_test(test_fuzzer_depack_lha_invalid_tree);
+declare_test(test_fuzzer_depack_lha_truncated);
+declare_test(test_fuzzer_depack_lzx_invalid);
+declare_test(test_fuzzer_depack_muse_truncated);
+declare_test(test_fuzzer_depack_muse_truncated2);
+declare_test(test_fuzzer_depack_oxm_invalid);
+declare_test(test_fuzzer_depack_oxm_pcm_leak);
+declare_test(test_fuzzer_depack_oxm_truncated);
+declare_test(test_fuzzer_depack_sqsh_invalid_verbatim);
+declare_test(test_fuzzer_depack_sqsh_truncated);
+declare_test(test_fuzzer_depack_sqsh_truncated2);
+declare_test(test_fuzzer_depack_zip_truncated);
+declare_test(test_fuzzer_depack_zip_truncated2);
+declare_test(test_fuzzer_depack_zip_truncated3);
+declare_test(test_fuzzer_depack_zip_truncated4);
+declare_test(test_module_length_data_jack);
+declare_test(test_module_length_condom_corruption);
+declare_test(test_module_length_klisje_paa_klisje);
+declare_test(test_module_length_killvictor);
+declare_test(test_module_length_nebulos);
+declare_test(test_module_length_roadblast);
+declare_test(test_module_length_ode2ptk);
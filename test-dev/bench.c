@@ -0,0 +1,360 @@
+/* Load and render benchmark
+ *
+ * Loads every module in a directory and renders a fixed length of audio
+ * under each interpolation mode, output format and Amiga mixer setting.
+ * Results are written as tab separated lines that can be compared
+ * between builds:
+ *
+ *   load     <file> <format> -            <ms>          ms
+ *   depack   <file> <format> -            <MB/s>        MB/s
+ *   render   <file> <format> <interp/fmt> <x realtime>  x
+ *   memory   <file> <format> load|play    <bytes>       bytes
+ *   total    -      <format> load         <ms>          ms
+ *
+ * Load times are the best of several runs. Depacking speed is measured
+ * for compressed files only, as the unpacked size over the time taken
+ * by xmp_test_module() to depack and identify the file. Peak memory is
+ * tracked by a counting allocator in a separate run.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include "../include/xmp.h"
+#include "../src/common.h"
+
+#define RATE		44100
+#define MAX_FILES	4096
+#define MAX_FORMATS	256
+
+static int load_runs = 3;
+static int render_seconds = 10;
+
+struct counter {
+	unsigned long size;
+	unsigned long peak;
+};
+
+struct block {
+	unsigned long size;
+	double align;
+};
+
+struct format_total {
+	char name[XMP_NAME_SIZE];
+	double time;
+};
+
+static struct format_total totals[MAX_FORMATS];
+static int num_totals;
+
+static double now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void *count_malloc(unsigned long size, void *priv)
+{
+	struct counter *cnt = (struct counter *)priv;
+	struct block *b = malloc(sizeof(struct block) + size);
+
+	if (b == NULL) {
+		return NULL;
+	}
+	b->size = size;
+	cnt->size += size;
+	if (cnt->size > cnt->peak) {
+		cnt->peak = cnt->size;
+	}
+
+	return b + 1;
+}
+
+static void count_free(void *ptr, void *priv)
+{
+	struct counter *cnt = (struct counter *)priv;
+	struct block *b;
+
+	if (ptr == NULL) {
+		return;
+	}
+	b = (struct block *)ptr - 1;
+	cnt->size -= b->size;
+	free(b);
+}
+
+static void *count_realloc(void *ptr, unsigned long size, void *priv)
+{
+	struct counter *cnt = (struct counter *)priv;
+	struct block *b;
+
+	if (ptr == NULL) {
+		return count_malloc(size, priv);
+	}
+	b = (struct block *)ptr - 1;
+	cnt->size -= b->size;
+	b = realloc(b, sizeof(struct block) + size);
+	if (b == NULL) {
+		return NULL;
+	}
+	b->size = size;
+	cnt->size += size;
+	if (cnt->size > cnt->peak) {
+		cnt->peak = cnt->size;
+	}
+
+	return b + 1;
+}
+
+static void add_total(const char *type, double t)
+{
+	int i;
+
+	for (i = 0; i < num_totals; i++) {
+		if (strcmp(totals[i].name, type) == 0) {
+			break;
+		}
+	}
+	if (i == num_totals) {
+		if (num_totals >= MAX_FORMATS) {
+			return;
+		}
+		snprintf(totals[i].name, XMP_NAME_SIZE, "%s", type);
+		num_totals++;
+	}
+	totals[i].time += t;
+}
+
+/* Render a fixed length of audio, return the speed as a multiple of
+ * real time, or 0 if the setting doesn't apply to this module
+ */
+static double render(xmp_context c, int interp, int format, int a500)
+{
+	struct context_data *ctx = (struct context_data *)c;
+	long frames, total;
+	double t;
+
+	if (xmp_start_player(c, RATE, format) != 0) {
+		return -1;
+	}
+	xmp_set_player(c, XMP_PLAYER_INTERP, interp);
+	if (a500) {
+		xmp_set_player(c, XMP_PLAYER_CFLAGS,
+			xmp_get_player(c, XMP_PLAYER_CFLAGS) | XMP_FLAGS_A500);
+		if (xmp_get_player(c, XMP_PLAYER_MIXER_TYPE) == XMP_MIXER_STANDARD) {
+			xmp_end_player(c);
+			return 0;
+		}
+	}
+
+	total = (long)render_seconds * RATE;
+	frames = 0;
+	t = now();
+	while (frames < total && xmp_play_frame(c) == 0) {
+		frames += ctx->s.ticksize;
+	}
+	t = now() - t;
+	xmp_end_player(c);
+
+	if (frames == 0 || t <= 0) {
+		return -1;
+	}
+
+	return (double)frames / RATE / t;
+}
+
+static void bench_file(const char *dir, const char *name)
+{
+	static const struct {
+		const char *name;
+		int interp;
+	} interp_mode[] = {
+		{ "nearest", XMP_INTERP_NEAREST },
+		{ "linear", XMP_INTERP_LINEAR },
+		{ "spline", XMP_INTERP_SPLINE }
+	};
+	static const struct {
+		const char *name;
+		int format;
+	} out_format[] = {
+		{ "s16", 0 },
+		{ "s16mono", XMP_FORMAT_MONO },
+		{ "s8", XMP_FORMAT_8BIT }
+	};
+	char path[1024];
+	struct xmp_test_info ti;
+	struct xmp_allocator alloc;
+	struct counter cnt;
+	struct stat st;
+	xmp_context c;
+	unsigned long load_peak;
+	double t, t_test, t_load;
+	long size;
+	int i, j, k;
+
+	snprintf(path, sizeof(path), "%s/%s", dir, name);
+	if (stat(path, &st) < 0 || !S_ISREG(st.st_mode)) {
+		return;
+	}
+
+	/* Identify the file, depacking it if needed */
+	t = now();
+	if (xmp_test_module(path, &ti) != 0) {
+		return;
+	}
+	t_test = now() - t;
+
+	c = xmp_create_context();
+	if (c == NULL) {
+		return;
+	}
+
+	t_load = -1;
+	for (i = 0; i < load_runs; i++) {
+		t = now();
+		if (xmp_load_module(c, path) != 0) {
+			fprintf(stderr, "%s: can't load\n", path);
+			xmp_free_context(c);
+			return;
+		}
+		t = now() - t;
+		if (t_load < 0 || t < t_load) {
+			t_load = t;
+		}
+		if (i < load_runs - 1) {
+			xmp_release_module(c);
+		}
+	}
+
+	printf("load\t%s\t%s\t-\t%.3f\tms\n", name, ti.type, t_load * 1000);
+	add_total(ti.type, t_load);
+
+	size = ((struct context_data *)c)->m.size;
+	if (size != (long)st.st_size && t_test > 0) {
+		printf("depack\t%s\t%s\t-\t%.2f\tMB/s\n", name, ti.type,
+			size / t_test / 1e6);
+	}
+
+	for (i = 0; i < 3; i++) {
+		for (j = 0; j < 3; j++) {
+			for (k = 0; k < 2; k++) {
+				t = render(c, interp_mode[i].interp,
+					out_format[j].format, k);
+				if (t == 0) {
+					continue;
+				}
+				printf("render\t%s\t%s\t%s/%s%s\t%.1f\tx\n",
+					name, ti.type, interp_mode[i].name,
+					out_format[j].name, k ? "/a500" : "", t);
+			}
+		}
+	}
+
+	xmp_free_context(c);
+
+	/* Peak memory, including the context itself */
+	memset(&cnt, 0, sizeof(cnt));
+	alloc.malloc_func = count_malloc;
+	alloc.realloc_func = count_realloc;
+	alloc.free_func = count_free;
+	alloc.priv = &cnt;
+
+	c = xmp_create_context_with_allocator(&alloc);
+	if (c == NULL) {
+		return;
+	}
+	if (xmp_load_module(c, path) == 0) {
+		load_peak = cnt.peak;
+		if (xmp_start_player(c, RATE, 0) == 0) {
+			for (i = 0; i < 50; i++) {
+				xmp_play_frame(c);
+			}
+			xmp_end_player(c);
+		}
+		printf("memory\t%s\t%s\tload\t%lu\tbytes\n", name, ti.type,
+			load_peak);
+		printf("memory\t%s\t%s\tplay\t%lu\tbytes\n", name, ti.type,
+			cnt.peak);
+	}
+	xmp_free_context(c);
+
+	fflush(stdout);
+}
+
+static int compare_names(const void *a, const void *b)
+{
+	return strcmp(*(char * const *)a, *(char * const *)b);
+}
+
+static void usage(const char *cmd)
+{
+	fprintf(stderr, "usage: %s [-n load runs] [-t render seconds] "
+		"[directory]\n", cmd);
+	exit(1);
+}
+
+int main(int argc, char **argv)
+{
+	const char *dir = "data";
+	char *name[MAX_FILES];
+	struct dirent *d;
+	DIR *dp;
+	int i, num;
+
+	for (i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+			load_runs = atoi(argv[++i]);
+		} else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+			render_seconds = atoi(argv[++i]);
+		} else if (argv[i][0] == '-') {
+			usage(argv[0]);
+		} else {
+			dir = argv[i];
+		}
+	}
+	if (load_runs < 1 || render_seconds < 1) {
+		usage(argv[0]);
+	}
+
+	dp = opendir(dir);
+	if (dp == NULL) {
+		perror(dir);
+		return 1;
+	}
+
+	/* Sort the file names so runs can be compared line by line */
+	num = 0;
+	while ((d = readdir(dp)) != NULL && num < MAX_FILES) {
+		if (d->d_name[0] == '.') {
+			continue;
+		}
+		name[num] = strdup(d->d_name);
+		if (name[num] != NULL) {
+			num++;
+		}
+	}
+	closedir(dp);
+
+	qsort(name, num, sizeof(char *), compare_names);
+
+	printf("# libxmp %s, %d load runs, %d s render at %d Hz\n",
+		xmp_version, load_runs, render_seconds, RATE);
+
+	for (i = 0; i < num; i++) {
+		bench_file(dir, name[i]);
+		free(name[i]);
+	}
+
+	for (i = 0; i < num_totals; i++) {
+		printf("total\t-\t%s\tload\t%.3f\tms\n", totals[i].name,
+			totals[i].time * 1000);
+	}
+
+	return 0;
+}
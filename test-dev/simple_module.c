@@ -45,7 +45,7 @@ void create_simple_module(struct context_data *ctx, int ins, int pat)
 		mod->xxs[i].lps = 0;
 		mod->xxs[i].lpe = 10000;
 		mod->xxs[i].flg = XMP_SAMPLE_LOOP;
-		mod->xxs[i].data = calloc(1, 11000);
+		mod->xxs[i].data = libxmp_calloc(1, 11000);
 		mod->xxs[i].data += 4;
 	}
 
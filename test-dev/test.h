@@ -55,6 +55,10 @@ void set_quirk(struct context_data *, int, int);
 void reset_quirk(struct context_data *, int);
 void new_event(struct context_data *, int, int, int, int, int, int, int, int, int, int);
 
+/* From player.h, whose TEST() macro clashes with ours */
+void libxmp_filter_setup(int, int, int, int *, int *, int *);
+void libxmp_filter_coef(struct context_data *, int, int, int *, int *, int *);
+
 #define declare_test(x) TEST_FUNC(x)
 #include "all_tests.c"
 #undef declare_test
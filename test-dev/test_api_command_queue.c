@@ -0,0 +1,100 @@
+#include "test.h"
+
+TEST(test_api_command_queue)
+{
+	xmp_context c;
+	struct xmp_frame_info fi;
+	struct xmp_event ev;
+	int i, ret;
+
+	c = xmp_create_context();
+
+	ret = xmp_load_module(c, "data/ode2ptk.mod");
+	fail_unless(ret == 0, "load module");
+
+	/* not playing */
+	ret = xmp_start_command_queue(c, 16);
+	fail_unless(ret == -XMP_ERROR_STATE, "invalid state");
+
+	xmp_start_player(c, 44100, 0);
+
+	ret = xmp_start_command_queue(c, 0);
+	fail_unless(ret == -XMP_ERROR_INVALID, "invalid size");
+	ret = xmp_start_command_queue(c, 6);
+	fail_unless(ret == 0, "start command queue");
+	ret = xmp_start_command_queue(c, 6);
+	fail_unless(ret == -XMP_ERROR_INVALID, "already started");
+
+	/* commands are applied by the player, previous values returned */
+	ret = xmp_channel_mute(c, 0, 1);
+	fail_unless(ret == 0, "mute previous status");
+	ret = xmp_channel_mute(c, 0, -1);
+	fail_unless(ret == 0, "mute applied too early");
+	ret = xmp_channel_vol(c, 1, 50);
+	fail_unless(ret == 100, "volume previous value");
+	ret = xmp_set_position(c, 2);
+	fail_unless(ret == 2, "set position");
+	ret = xmp_set_player(c, XMP_PLAYER_VOLUME, 80);
+	fail_unless(ret == 0, "set player");
+	ret = xmp_get_player(c, XMP_PLAYER_VOLUME);
+	fail_unless(ret == 100, "player volume applied too early");
+
+	memset(&ev, 0, sizeof(ev));
+	ev.note = 61;
+	ev.ins = 1;
+	xmp_inject_event(c, 3, &ev);
+
+	/* queue size is rounded up to 8 */
+	ret = xmp_channel_vol(c, 2, 10);
+	fail_unless(ret == 100, "volume previous value");
+	ret = xmp_channel_vol(c, 2, 20);
+	fail_unless(ret == 100, "volume previous value");
+	ret = xmp_channel_vol(c, 2, 30);
+	fail_unless(ret == 100, "volume previous value");
+	ret = xmp_channel_vol(c, 2, 40);
+	fail_unless(ret == -XMP_ERROR_SYSTEM, "queue should be full");
+
+	/* invalid values are still rejected */
+	ret = xmp_set_position(c, 1000);
+	fail_unless(ret == -XMP_ERROR_INVALID, "invalid position");
+	ret = xmp_channel_mute(c, XMP_MAX_CHANNELS, 1);
+	fail_unless(ret == -XMP_ERROR_INVALID, "invalid channel");
+	ret = xmp_set_player(c, XMP_PLAYER_AMP, 99);
+	fail_unless(ret == -XMP_ERROR_INVALID, "invalid amplification");
+	ret = xmp_set_player(c, XMP_PLAYER_INTERP, 7);
+	fail_unless(ret == -XMP_ERROR_INVALID, "invalid interpolation");
+	ret = xmp_set_player(c, XMP_PLAYER_QUALITY, 1);
+	fail_unless(ret == -XMP_ERROR_INVALID, "read only parameter");
+
+	xmp_play_frame(c);
+	xmp_get_frame_info(c, &fi);
+
+	fail_unless(xmp_channel_mute(c, 0, -1) == 1, "mute not applied");
+	fail_unless(xmp_channel_vol(c, 1, -1) == 50, "volume not applied");
+	fail_unless(xmp_channel_vol(c, 2, -1) == 30, "commands out of order");
+	fail_unless(xmp_get_player(c, XMP_PLAYER_VOLUME) == 80, "player volume");
+	fail_unless(fi.pos == 2, "position not applied");
+	fail_unless(fi.channel_info[3].note == 60, "event not injected");
+
+	/* the queue wraps around */
+	for (i = 0; i < 100; i++) {
+		ret = xmp_channel_vol(c, 4, i);
+		fail_unless(ret >= 0, "queue command");
+		xmp_play_frame(c);
+		fail_unless(xmp_channel_vol(c, 4, -1) == i, "volume not applied");
+	}
+
+	/* pending commands are applied when the queue ends */
+	xmp_channel_mute(c, 5, 1);
+	xmp_end_command_queue(c);
+	fail_unless(xmp_channel_mute(c, 5, -1) == 1, "pending command lost");
+
+	/* direct calls again */
+	xmp_channel_mute(c, 6, 1);
+	fail_unless(xmp_channel_mute(c, 6, -1) == 1, "direct call");
+
+	xmp_end_player(c);
+	xmp_release_module(c);
+	xmp_free_context(c);
+}
+END_TEST
@@ -0,0 +1,149 @@
+#include "test.h"
+
+/* Allocator that tags its blocks, so we can tell if the library frees
+ * memory with the wrong allocator
+ */
+
+#define MAGIC 0x584d5041
+
+struct block {
+	unsigned long magic;
+	unsigned long size;
+	double align;
+};
+
+struct arena {
+	long count;
+	long total;
+	int bad_free;
+};
+
+static void *test_malloc(unsigned long size, void *priv)
+{
+	struct arena *a = (struct arena *)priv;
+	struct block *b = malloc(sizeof(struct block) + size);
+
+	if (b == NULL) {
+		return NULL;
+	}
+	b->magic = MAGIC;
+	b->size = size;
+	a->count++;
+	a->total++;
+
+	return b + 1;
+}
+
+static void test_free(void *ptr, void *priv)
+{
+	struct arena *a = (struct arena *)priv;
+	struct block *b;
+
+	if (ptr == NULL) {
+		return;
+	}
+
+	b = (struct block *)ptr - 1;
+	if (b->magic != MAGIC) {
+		a->bad_free++;
+		return;
+	}
+	b->magic = 0;
+	a->count--;
+	free(b);
+}
+
+static void *test_realloc(void *ptr, unsigned long size, void *priv)
+{
+	struct block *b;
+	void *new_ptr;
+
+	if (ptr == NULL) {
+		return test_malloc(size, priv);
+	}
+
+	b = (struct block *)ptr - 1;
+	new_ptr = test_malloc(size, priv);
+	if (new_ptr != NULL) {
+		memcpy(new_ptr, ptr, b->size < size ? b->size : size);
+		test_free(ptr, priv);
+	}
+
+	return new_ptr;
+}
+
+static void play_module(xmp_context c, const char *path)
+{
+	int i, ret;
+
+	ret = xmp_load_module(c, path);
+	fail_unless(ret == 0, "load module");
+
+	ret = xmp_start_player(c, 44100, 0);
+	fail_unless(ret == 0, "start player");
+	for (i = 0; i < 20; i++) {
+		xmp_play_frame(c);
+	}
+	xmp_end_player(c);
+}
+
+TEST(test_api_create_context_with_allocator)
+{
+	xmp_context c;
+	struct xmp_allocator alloc;
+	struct arena arena;
+	int ret;
+
+	memset(&arena, 0, sizeof(arena));
+	alloc.malloc_func = test_malloc;
+	alloc.realloc_func = NULL;
+	alloc.free_func = test_free;
+	alloc.priv = &arena;
+
+	/* all callbacks are required */
+	c = xmp_create_context_with_allocator(&alloc);
+	fail_unless(c == NULL, "incomplete allocator accepted");
+
+	alloc.realloc_func = test_realloc;
+	c = xmp_create_context_with_allocator(&alloc);
+	fail_unless(c != NULL, "create context");
+	fail_unless(arena.count == 1, "context not allocated by the allocator");
+
+	play_module(c, "data/mod.loving_is_easy.pp");
+	play_module(c, "data/storlek_01.it");
+	play_module(c, "data/format_s3m_schism.s3m");
+	play_module(c, "data/set_position_mid_pattdelay.xm");
+	play_module(c, "data/hold.med");
+	play_module(c, "data/feel it dance!.zip");
+	play_module(c, "data/test.mmcmp");
+
+	/* start_player with smix, stems and a module still loaded */
+	ret = xmp_start_smix(c, 2, 2);
+	fail_unless(ret == 0, "start smix");
+	ret = xmp_smix_load_sample(c, 0, "data/blip.wav");
+	fail_unless(ret == 0, "load sample");
+	ret = xmp_set_instrument_path(c, "data");
+	fail_unless(ret == 0, "set instrument path");
+	ret = xmp_start_player(c, 44100, 0);
+	fail_unless(ret == 0, "start player");
+	ret = xmp_start_stems(c, 2, NULL, 0);
+	fail_unless(ret == 0, "start stems");
+	xmp_smix_play_sample(c, 0, 60, 64, 0);
+	xmp_play_frame(c);
+	xmp_end_stems(c);
+	xmp_end_player(c);
+	xmp_smix_release_sample(c, 0);
+	xmp_end_smix(c);
+
+	/* loading over a loaded module */
+	ret = xmp_load_module(c, "data/storlek_01.it");
+	fail_unless(ret == 0, "load module");
+
+	fail_unless(arena.total > 100, "library didn't use the allocator");
+
+	xmp_free_context(c);
+
+	fail_unless(arena.bad_free == 0, "memory freed with the wrong allocator");
+	fail_unless(arena.count == 0, "memory leak");
+}
+END_TEST
@@ -0,0 +1,116 @@
+#include "test.h"
+#include "effects.h"
+
+TEST(test_api_get_frame_status)
+{
+	xmp_context opaque;
+	struct xmp_frame_info fi;
+	struct xmp_frame_status fs;
+	struct xmp_channel_info ci;
+	int i, j, pos, ret;
+
+	opaque = xmp_create_context();
+	ret = xmp_load_module(opaque, "data/ode2ptk.mod");
+	fail_unless(ret == 0, "load error");
+
+	/* state check */
+	ret = xmp_get_channel_info(opaque, 0, &ci);
+	fail_unless(ret == -XMP_ERROR_STATE, "state check error");
+
+	xmp_start_player(opaque, 8000, 0);
+
+	/* invalid channel */
+	ret = xmp_get_channel_info(opaque, -1, &ci);
+	fail_unless(ret == -XMP_ERROR_INVALID, "invalid channel error");
+	ret = xmp_get_channel_info(opaque, 4, &ci);
+	fail_unless(ret == -XMP_ERROR_INVALID, "invalid channel error");
+
+	xmp_play_frame(opaque);
+
+	/* all channels changed after start */
+	xmp_get_frame_status(opaque, &fs);
+	fail_unless(fs.changed[0] == 0x0f, "channel mask error");
+	fail_unless(fs.changed[1] == 0, "channel mask error");
+
+	/* mask is cleared after each call */
+	xmp_get_frame_status(opaque, &fs);
+	fail_unless(fs.changed[0] == 0, "channel mask not cleared");
+
+	for (i = 0; i < 200; i++) {
+		xmp_play_frame(opaque);
+		xmp_get_frame_status(opaque, &fs);
+		xmp_get_frame_info(opaque, &fi);
+
+		fail_unless(fs.pos == fi.pos, "position error");
+		fail_unless(fs.pattern == fi.pattern, "pattern error");
+		fail_unless(fs.row == fi.row, "row error");
+		fail_unless(fs.num_rows == fi.num_rows, "num rows error");
+		fail_unless(fs.frame == fi.frame, "frame error");
+		fail_unless(fs.speed == fi.speed, "speed error");
+		fail_unless(fs.bpm == fi.bpm, "bpm error");
+		fail_unless(fs.time == fi.time, "time error");
+		fail_unless(fs.total_time == fi.total_time, "total time error");
+		fail_unless(fs.frame_time == fi.frame_time, "frame time error");
+		fail_unless(fs.buffer == fi.buffer, "buffer error");
+		fail_unless(fs.buffer_size == fi.buffer_size, "buffer size error");
+		fail_unless(fs.total_size == fi.total_size, "total size error");
+		fail_unless(fs.volume == fi.volume, "volume error");
+		fail_unless(fs.loop_count == fi.loop_count, "loop count error");
+		fail_unless(fs.virt_channels == fi.virt_channels, "virt channels error");
+		fail_unless(fs.virt_used == fi.virt_used, "virt used error");
+		fail_unless(fs.sequence == fi.sequence, "sequence error");
+
+		for (j = 0; j < 4; j++) {
+			ret = xmp_get_channel_info(opaque, j, &ci);
+			fail_unless(ret == 0, "channel info error");
+			fail_unless(memcmp(&ci, &fi.channel_info[j], sizeof(ci)) == 0,
+						"channel info mismatch");
+		}
+	}
+
+	xmp_end_player(opaque);
+	xmp_release_module(opaque);
+	xmp_free_context(opaque);
+
+	/* silent channels and channels playing without changes stay clear */
+	opaque = xmp_create_context();
+	create_simple_module((struct context_data *)opaque, 2, 2);
+	new_event((struct context_data *)opaque, 0, 0, 0, 49, 1, 0, 0, 0, 0, 0);
+	new_event((struct context_data *)opaque, 0, 1, 0, 0, 0, 0, FX_VOLSLIDE, 0x04, 0, 0);
+	new_event((struct context_data *)opaque, 0, 2, 0, 0, 0, 0, FX_VOLSLIDE, 0x04, 0, 0);
+	new_event((struct context_data *)opaque, 0, 2, 2, 49, 1, 0, 0, 0, 0, 0);
+
+	xmp_start_player(opaque, 8000, 0);
+	xmp_play_frame(opaque);
+	xmp_get_frame_status(opaque, &fs);
+	fail_unless(fs.changed[0] == 0x0f, "channel mask error");
+	xmp_get_channel_info(opaque, 0, &ci);
+	pos = ci.position;
+
+	for (i = 1; i < 6; i++) {
+		xmp_play_frame(opaque);
+		xmp_get_frame_status(opaque, &fs);
+		fail_unless(fs.changed[0] == 0, "unchanged channel flagged");
+
+		xmp_get_channel_info(opaque, 0, &ci);
+		fail_unless(ci.position > pos, "sample not playing");
+		pos = ci.position;
+	}
+
+	/* volume slide changes channel 0 on every frame */
+	for (i = 0; i < 6; i++) {
+		xmp_play_frame(opaque);
+		xmp_get_frame_status(opaque, &fs);
+		fail_unless(fs.changed[0] == 0x01, "changed channel not flagged");
+	}
+
+	/* new note in channel 2, no slide in the first frame of the row */
+	xmp_play_frame(opaque);
+	xmp_get_frame_status(opaque, &fs);
+	fail_unless(fs.changed[0] == 0x04, "new note not flagged");
+
+	xmp_end_player(opaque);
+	xmp_release_module(opaque);
+	xmp_free_context(opaque);
+}
+END_TEST
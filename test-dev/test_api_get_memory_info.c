@@ -0,0 +1,135 @@
+#include "test.h"
+
+/* Allocator that counts the bytes it holds */
+
+struct block {
+	unsigned long size;
+	double align;
+};
+
+static void *count_malloc(unsigned long size, void *priv)
+{
+	struct block *b = malloc(sizeof(struct block) + size);
+
+	if (b == NULL) {
+		return NULL;
+	}
+	b->size = size;
+	*(long *)priv += size;
+
+	return b + 1;
+}
+
+static void count_free(void *ptr, void *priv)
+{
+	struct block *b = (struct block *)ptr - 1;
+
+	*(long *)priv -= b->size;
+	free(b);
+}
+
+static void *count_realloc(void *ptr, unsigned long size, void *priv)
+{
+	struct block *b = (struct block *)ptr - 1;
+
+	*(long *)priv -= b->size;
+	b = realloc(b, sizeof(struct block) + size);
+	if (b == NULL) {
+		return NULL;
+	}
+	b->size = size;
+	*(long *)priv += size;
+
+	return b + 1;
+}
+
+TEST(test_api_get_memory_info)
+{
+	xmp_context opaque;
+	struct xmp_memory_info info;
+	struct xmp_allocator alloc;
+	long loaded, playing, held;
+	int ret;
+
+	opaque = xmp_create_context();
+	fail_unless(opaque != NULL, "can't create context");
+
+	/* An idle context only holds the context structure */
+	ret = xmp_get_memory_info(opaque, &info);
+	fail_unless(ret == 0, "can't get memory info");
+	fail_unless(info.context > 0, "context size");
+	fail_unless(info.context < 4096, "context too large");
+	fail_unless(info.module == 0, "module size without module");
+	fail_unless(info.player == 0, "player size without player");
+	fail_unless(info.smix == 0, "smix size without smix");
+	fail_unless(info.total == info.context, "total size");
+
+	ret = xmp_load_module(opaque, "data/ode2ptk.mod");
+	fail_unless(ret == 0, "can't load module");
+
+	xmp_get_memory_info(opaque, &info);
+	fail_unless(info.module > 0, "module size");
+	fail_unless(info.player == 0, "player size without player");
+	loaded = info.total;
+
+	/* Mixer buffers are sized by the sampling rate */
+	xmp_start_player(opaque, 44100, 0);
+	xmp_get_memory_info(opaque, &info);
+	fail_unless(info.player > 0, "player size");
+	fail_unless(info.total == loaded + info.player, "total size");
+	playing = info.player;
+	xmp_end_player(opaque);
+
+	xmp_start_player(opaque, 8000, 0);
+	xmp_get_memory_info(opaque, &info);
+	fail_unless(info.player > 0, "player size");
+	fail_unless(info.player < playing, "player size not sized by rate");
+	xmp_end_player(opaque);
+
+	xmp_get_memory_info(opaque, &info);
+	fail_unless(info.player == 0, "player size after end");
+
+	xmp_release_module(opaque);
+	xmp_get_memory_info(opaque, &info);
+	fail_unless(info.module == 0, "module size after release");
+	fail_unless(info.total == info.context, "total size after release");
+
+	xmp_free_context(opaque);
+
+	/* Reported sizes match the memory held by the allocator */
+	held = 0;
+	alloc.malloc_func = count_malloc;
+	alloc.realloc_func = count_realloc;
+	alloc.free_func = count_free;
+	alloc.priv = &held;
+
+	opaque = xmp_create_context_with_allocator(&alloc);
+	fail_unless(opaque != NULL, "can't create context");
+	xmp_get_memory_info(opaque, &info);
+	fail_unless(info.total == held, "context size mismatch");
+
+	xmp_start_smix(opaque, 2, 2);
+	ret = xmp_smix_load_sample(opaque, 0, "data/blip.wav");
+	fail_unless(ret == 0, "can't load sample");
+	ret = xmp_load_module(opaque, "data/storlek_01.it");
+	fail_unless(ret == 0, "can't load module");
+	xmp_get_memory_info(opaque, &info);
+	fail_unless(info.smix > 0, "smix size");
+	fail_unless(info.total == held, "module size mismatch");
+
+	xmp_start_player(opaque, 44100, 0);
+	xmp_play_frame(opaque);
+	xmp_get_memory_info(opaque, &info);
+	fail_unless(info.total == held, "player size mismatch");
+	xmp_end_player(opaque);
+
+	xmp_end_smix(opaque);
+	xmp_release_module(opaque);
+	xmp_get_memory_info(opaque, &info);
+	fail_unless(info.smix == 0, "smix size after end");
+	fail_unless(info.total == held, "size mismatch after release");
+
+	xmp_free_context(opaque);
+	fail_unless(held == 0, "memory leak");
+}
+END_TEST
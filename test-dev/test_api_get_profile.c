@@ -0,0 +1,43 @@
+#include "test.h"
+
+TEST(test_api_get_profile)
+{
+	xmp_context opaque;
+	struct xmp_profile prof;
+	int i, ret;
+
+	opaque = xmp_create_context();
+
+	ret = xmp_load_module(opaque, "data/ode2ptk.mod");
+	fail_unless(ret == 0, "load module");
+	xmp_start_player(opaque, 44100, 0);
+
+	for (i = 0; i < 100; i++) {
+		xmp_play_frame(opaque);
+	}
+
+	ret = xmp_get_profile(opaque, &prof);
+	if (ret == 0) {
+		/* profiling counters built in */
+		fail_unless(prof.frames == 100, "frame count");
+		fail_unless(prof.voices_mixed > 0, "voices mixed");
+		fail_unless(prof.samples > 0, "samples mixed");
+		fail_unless(prof.read_time >= 0, "read time");
+		fail_unless(prof.mix_time >= 0, "mix time");
+
+		xmp_reset_profile(opaque);
+		ret = xmp_get_profile(opaque, &prof);
+		fail_unless(ret == 0, "get profile after reset");
+		fail_unless(prof.frames == 0, "frame count after reset");
+		fail_unless(prof.voices_mixed == 0, "voices after reset");
+		fail_unless(prof.samples == 0, "samples after reset");
+	} else {
+		fail_unless(ret == -XMP_ERROR_INVALID, "return value");
+		xmp_reset_profile(opaque);
+	}
+
+	xmp_end_player(opaque);
+	xmp_release_module(opaque);
+	xmp_free_context(opaque);
+}
+END_TEST
@@ -0,0 +1,70 @@
+#include "test.h"
+#include <errno.h>
+
+TEST(test_api_list_archive)
+{
+	struct xmp_archive_entry entries[16];
+	int ret;
+
+	/* nonexistent file */
+	ret = xmp_list_archive("foo--bar", entries, 16);
+	fail_unless(ret == -XMP_ERROR_SYSTEM, "nonexistent file fail");
+	fail_unless(xmp_syserrno() == ENOENT, "errno list archive fail");
+
+	/* not an archive */
+	ret = xmp_list_archive("data/storlek_01.it", entries, 16);
+	fail_unless(ret == -XMP_ERROR_FORMAT, "not an archive fail");
+
+	/* compressed file that isn't an archive */
+	ret = xmp_list_archive("data/gzipdata", entries, 16);
+	fail_unless(ret == -XMP_ERROR_FORMAT, "gzip file fail");
+
+	/* invalid parameters */
+	ret = xmp_list_archive("data/zipdata1", NULL, 16);
+	fail_unless(ret == -XMP_ERROR_INVALID, "null entries fail");
+
+	/* count only */
+	ret = xmp_list_archive("data/zipdata1", NULL, 0);
+	fail_unless(ret == 2, "zip count fail");
+
+	/* ZIP */
+	ret = xmp_list_archive("data/zipdata1", entries, 16);
+	fail_unless(ret == 2, "zip list fail");
+	fail_unless(strcmp(entries[0].name, "storlek/07.it") == 0, "zip name fail");
+	fail_unless(entries[0].size == 13845, "zip size fail");
+	fail_unless(entries[0].offset == 0, "zip offset fail");
+	fail_unless(strcmp(entries[1].name, "storlek/11.it") == 0, "zip name fail");
+	fail_unless(entries[1].size == 8354, "zip size fail");
+
+	/* more members than entries */
+	memset(entries, 0, sizeof(entries));
+	ret = xmp_list_archive("data/zipdata2", entries, 4);
+	fail_unless(ret == 14, "zip partial list fail");
+	fail_unless(strcmp(entries[3].name, "Bla.NFO") == 0, "zip partial name fail");
+	fail_unless(entries[4].name[0] == 0, "zip partial overflow");
+
+	/* LHA */
+	ret = xmp_list_archive("data/l2_data", entries, 16);
+	fail_unless(ret == 14, "lha list fail");
+	fail_unless(strcmp(entries[12].name, "mod.ok") == 0, "lha name fail");
+	fail_unless(entries[12].size == 8378, "lha size fail");
+
+	/* ArcFS */
+	ret = xmp_list_archive("data/arcfsdata", entries, 16);
+	fail_unless(ret == 1, "arcfs list fail");
+	fail_unless(strcmp(entries[0].name, "GuessWho") == 0, "arcfs name fail");
+	fail_unless(entries[0].size == 15346, "arcfs size fail");
+
+	/* LZX */
+	ret = xmp_list_archive("data/lzxdata", entries, 16);
+	fail_unless(ret == 2, "lzx list fail");
+	fail_unless(strcmp(entries[1].name, "Ooze.txt") == 0, "lzx name fail");
+	fail_unless(entries[1].size == 339, "lzx size fail");
+
+	/* ARC */
+	ret = xmp_list_archive("data/arc-method8-rle", entries, 16);
+	fail_unless(ret == 1, "arc list fail");
+	fail_unless(strcmp(entries[0].name, "DreamAlone") == 0, "arc name fail");
+	fail_unless(entries[0].size == 108648, "arc size fail");
+}
+END_TEST
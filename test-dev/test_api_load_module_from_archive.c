@@ -0,0 +1,72 @@
+#include "test.h"
+
+TEST(test_api_load_module_from_archive)
+{
+	xmp_context c;
+	struct xmp_archive_entry entries[16];
+	struct xmp_module_info info;
+	int ret, i;
+
+	c = xmp_create_context();
+	fail_unless(c != NULL, "can't create context");
+
+	/* invalid offset */
+	ret = xmp_load_module_from_archive(c, "data/zipdata1", -1);
+	fail_unless(ret == -XMP_ERROR_INVALID, "invalid offset fail");
+
+	/* not an archive */
+	ret = xmp_load_module_from_archive(c, "data/storlek_01.it", 0);
+	fail_unless(ret == -XMP_ERROR_DEPACK, "not an archive fail");
+
+	/* bad member offset */
+	ret = xmp_load_module_from_archive(c, "data/zipdata1", 1);
+	fail_unless(ret == -XMP_ERROR_DEPACK, "bad offset fail");
+
+	/* load the second module in the archive */
+	ret = xmp_list_archive("data/zipdata1", entries, 16);
+	fail_unless(ret == 2, "zip list fail");
+	ret = xmp_load_module_from_archive(c, "data/zipdata1", entries[1].offset);
+	fail_unless(ret == 0, "can't load zip member");
+	xmp_get_module_info(c, &info);
+	ret = compare_md5(info.md5, "26886caa86e0e1d77dfce31622d4c864");
+	fail_unless(ret == 0, "zip member MD5 error");
+	xmp_release_module(c);
+
+	/* load a module after other files, without extracting them */
+	ret = xmp_list_archive("data/l1_data", entries, 16);
+	fail_unless(ret == 14, "lha list fail");
+	for (i = 0; i < ret; i++) {
+		if (strcmp(entries[i].name, "mod.ok") == 0)
+			break;
+	}
+	fail_unless(i < ret, "lha member not found");
+	ret = xmp_load_module_from_archive(c, "data/l1_data", entries[i].offset);
+	fail_unless(ret == 0, "can't load lha member");
+	xmp_get_module_info(c, &info);
+	ret = compare_md5(info.md5, "c993a848f57227660f8b10db1d4d874f");
+	fail_unless(ret == 0, "lha member MD5 error");
+	xmp_release_module(c);
+
+	/* LZX */
+	ret = xmp_list_archive("data/lzxdata", entries, 16);
+	fail_unless(ret == 2, "lzx list fail");
+	ret = xmp_load_module_from_archive(c, "data/lzxdata", entries[0].offset);
+	fail_unless(ret == 0, "can't load lzx member");
+	xmp_get_module_info(c, &info);
+	ret = compare_md5(info.md5, "6e4226be5a72fe3770550ced7a2022de");
+	fail_unless(ret == 0, "lzx member MD5 error");
+	xmp_release_module(c);
+
+	/* ArcFS */
+	ret = xmp_list_archive("data/arcfsdata", entries, 16);
+	fail_unless(ret == 1, "arcfs list fail");
+	ret = xmp_load_module_from_archive(c, "data/arcfsdata", entries[0].offset);
+	fail_unless(ret == 0, "can't load arcfs member");
+	xmp_get_module_info(c, &info);
+	ret = compare_md5(info.md5, "1c41df267ebb8febe5e3d8a7e45bad61");
+	fail_unless(ret == 0, "arcfs member MD5 error");
+
+	xmp_release_module(c);
+	xmp_free_context(c);
+}
+END_TEST
@@ -0,0 +1,99 @@
+#include "test.h"
+
+#define REF_SIZE (44100 * 4 * 2)
+
+TEST(test_api_render_ahead)
+{
+	xmp_context c1, c2;
+	struct xmp_frame_info fi;
+	char *ref, *buf;
+	int ret, len, pos;
+
+	ref = malloc(REF_SIZE);
+	buf = malloc(REF_SIZE);
+	fail_unless(ref != NULL && buf != NULL, "alloc");
+
+	c1 = xmp_create_context();
+	c2 = xmp_create_context();
+
+	ret = xmp_load_module(c1, "data/mod.loving_is_easy.pp");
+	fail_unless(ret == 0, "load module");
+	ret = xmp_load_module(c2, "data/mod.loving_is_easy.pp");
+	fail_unless(ret == 0, "load module");
+
+	/* not playing */
+	ret = xmp_start_render_ahead(c2, 100);
+	fail_unless(ret == -XMP_ERROR_STATE, "invalid state");
+	ret = xmp_read_render_ahead(c2, buf, 1024);
+	fail_unless(ret == -XMP_ERROR_STATE, "read without thread");
+
+	xmp_start_player(c1, 44100, 0);
+	xmp_start_player(c2, 44100, 0);
+
+	/* reference output */
+	for (pos = 0; pos < REF_SIZE; pos += len) {
+		xmp_play_frame(c1);
+		xmp_get_frame_info(c1, &fi);
+		len = fi.buffer_size;
+		if (len > REF_SIZE - pos) {
+			len = REF_SIZE - pos;
+		}
+		memcpy(ref + pos, fi.buffer, len);
+	}
+
+	ret = xmp_start_render_ahead(c2, 0);
+	fail_unless(ret == -XMP_ERROR_INVALID, "invalid lead time");
+	ret = xmp_start_render_ahead(c2, 100);
+	fail_unless(ret == 0, "start render ahead");
+	ret = xmp_start_render_ahead(c2, 100);
+	fail_unless(ret == -XMP_ERROR_INVALID, "already running");
+
+	/* read in odd sized chunks until we have the same amount of data */
+	for (pos = 0; pos < REF_SIZE; pos += ret) {
+		len = 1000;
+		if (len > REF_SIZE - pos) {
+			len = REF_SIZE - pos;
+		}
+		ret = xmp_read_render_ahead(c2, buf + pos, len);
+		fail_unless(ret >= 0, "read");
+		fail_unless(ret % 4 == 0, "partial sample frame");
+		fail_unless(xmp_render_ahead_latency(c2) <= 200, "latency");
+	}
+
+	ret = memcmp(ref, buf, REF_SIZE);
+	fail_unless(ret == 0, "render ahead output differs");
+
+	/* control calls under the lock, end of module */
+	xmp_lock_render_ahead(c2);
+	xmp_stop_module(c2);
+	xmp_unlock_render_ahead(c2);
+
+	for (;;) {
+		ret = xmp_read_render_ahead(c2, buf, 1024);
+		if (ret == -XMP_END) {
+			break;
+		}
+		fail_unless(ret >= 0, "read");
+	}
+
+	xmp_end_render_ahead(c2);
+	ret = xmp_read_render_ahead(c2, buf, 1024);
+	fail_unless(ret == -XMP_ERROR_STATE, "read after end");
+
+	/* thread is stopped by xmp_end_player() */
+	xmp_restart_module(c2);
+	ret = xmp_start_render_ahead(c2, 20);
+	fail_unless(ret == 0, "restart render ahead");
+	xmp_end_player(c2);
+	ret = xmp_read_render_ahead(c2, buf, 1024);
+	fail_unless(ret == -XMP_ERROR_STATE, "read after end player");
+
+	xmp_end_player(c1);
+	xmp_release_module(c1);
+	xmp_release_module(c2);
+	xmp_free_context(c1);
+	xmp_free_context(c2);
+	free(ref);
+	free(buf);
+}
+END_TEST
@@ -0,0 +1,140 @@
+#include "test.h"
+#include "effects.h"
+
+struct event_count {
+	int row;
+	int order;
+	int loop;
+	int note;
+	int last_row;
+	int last_pos;
+	int max_offset;
+};
+
+static void callback(const struct xmp_player_event *ev, void *priv)
+{
+	struct event_count *c = (struct event_count *)priv;
+
+	switch (ev->type) {
+	case XMP_EVENT_ROW:
+		c->row++;
+		c->last_row = ev->row;
+		break;
+	case XMP_EVENT_ORDER:
+		c->order++;
+		c->last_pos = ev->pos;
+		break;
+	case XMP_EVENT_LOOP:
+		c->loop++;
+		fail_unless(ev->loop_count == 1, "loop count");
+		break;
+	case XMP_EVENT_NOTE:
+		c->note++;
+		fail_unless(ev->channel == 0 || ev->channel == 3, "note channel");
+		fail_unless(ev->note == 48, "note number");
+		fail_unless(ev->instrument == 0, "note instrument");
+		break;
+	}
+
+	if (ev->offset > c->max_offset) {
+		c->max_offset = ev->offset;
+	}
+}
+
+TEST(test_api_set_event_callback)
+{
+	xmp_context opaque;
+	struct context_data *ctx;
+	struct event_count c;
+	char buffer[1000];
+	int i, ret;
+
+	opaque = xmp_create_context();
+	ctx = (struct context_data *)opaque;
+
+	create_simple_module(ctx, 2, 2);
+	new_event(ctx, 0, 0, 0, 49, 1, 0, 0, 0, 0, 0);
+	new_event(ctx, 1, 5, 3, 49, 1, 0, 0, 0, 0, 0);
+
+	/* tone portamento and key off don't trigger notes */
+	new_event(ctx, 0, 10, 0, 61, 1, 0, FX_TONEPORTA, 4, 0, 0);
+	new_event(ctx, 0, 20, 0, XMP_KEY_OFF, 0, 0, 0, 0, 0, 0);
+
+	/* invalid event mask */
+	ret = xmp_set_event_callback(opaque, 1 << 10, callback, &c);
+	fail_unless(ret == -XMP_ERROR_INVALID, "invalid event mask");
+
+	memset(&c, 0, sizeof(c));
+	ret = xmp_set_event_callback(opaque, XMP_EVENT_ALL, callback, &c);
+	fail_unless(ret == 0, "can't set callback");
+
+	xmp_start_player(opaque, 8000, 0);
+
+	/* play both patterns and the first frame after the loop */
+	for (i = 0; i < 2 * 64 * 6 + 1; i++) {
+		xmp_play_frame(opaque);
+	}
+
+	fail_unless(c.row == 129, "row events");
+	fail_unless(c.order == 3, "order events");
+	fail_unless(c.loop == 1, "loop events");
+	fail_unless(c.note == 3, "note events");
+	fail_unless(c.last_row == 0, "last row");
+	fail_unless(c.last_pos == 0, "last position");
+	fail_unless(c.max_offset == 0, "offset in play_frame");
+
+	/* events only in the selected mask */
+	memset(&c, 0, sizeof(c));
+	xmp_set_event_callback(opaque, XMP_EVENT_ROW, callback, &c);
+	for (i = 0; i < 6; i++) {
+		xmp_play_frame(opaque);
+	}
+	fail_unless(c.row == 1, "row events");
+	fail_unless(c.order + c.loop + c.note == 0, "unselected events");
+
+	/* offsets in play_buffer are relative to the user buffer */
+	memset(&c, 0, sizeof(c));
+	xmp_set_event_callback(opaque, XMP_EVENT_ROW, callback, &c);
+	for (i = 0; i < 100; i++) {
+		xmp_play_buffer(opaque, buffer, sizeof(buffer), 0);
+	}
+	fail_unless(c.row > 0, "no row events");
+	fail_unless(c.max_offset > 0, "no offset in play_buffer");
+	fail_unless(c.max_offset < sizeof(buffer) / 4, "invalid offset");
+
+	/* disable callback */
+	memset(&c, 0, sizeof(c));
+	xmp_set_event_callback(opaque, XMP_EVENT_ALL, NULL, NULL);
+	for (i = 0; i < 100; i++) {
+		xmp_play_frame(opaque);
+	}
+	fail_unless(c.row == 0, "callback not disabled");
+
+	xmp_end_player(opaque);
+	xmp_release_module(opaque);
+	xmp_free_context(opaque);
+
+	/* sound effect channels don't report notes */
+	opaque = xmp_create_context();
+	ctx = (struct context_data *)opaque;
+
+	xmp_start_smix(opaque, 1, 1);
+	create_simple_module(ctx, 2, 2);
+
+	memset(&c, 0, sizeof(c));
+	xmp_set_event_callback(opaque, XMP_EVENT_NOTE, callback, &c);
+	xmp_start_player(opaque, 8000, 0);
+
+	ret = xmp_smix_play_instrument(opaque, 0, 48, 64, 0);
+	fail_unless(ret == 0, "play instrument");
+	for (i = 0; i < 6; i++) {
+		xmp_play_frame(opaque);
+	}
+	fail_unless(c.note == 0, "sound effect note event");
+
+	xmp_end_player(opaque);
+	xmp_release_module(opaque);
+	xmp_end_smix(opaque);
+	xmp_free_context(opaque);
+}
+END_TEST
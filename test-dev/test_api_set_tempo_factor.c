@@ -0,0 +1,47 @@
+#include "test.h"
+#include "../src/effects.h"
+
+TEST(test_api_set_tempo_factor)
+{
+	xmp_context opaque;
+	struct context_data *ctx;
+	struct xmp_frame_info info;
+	int i, ret;
+
+	opaque = xmp_create_context();
+	ctx = (struct context_data *)opaque;
+
+	create_simple_module(ctx, 2, 2);
+	set_quirk(ctx, QUIRKS_IT, READ_EVENT_IT);
+	new_event(ctx, 0, 0, 0, 0, 0, 0, FX_IT_BPM, 0x20, 0, 0);
+	libxmp_scan_sequences(ctx);
+
+	ret = xmp_set_tempo_factor(opaque, 0.0);
+	fail_unless(ret == -1, "invalid factor accepted");
+
+	/* Buffers are too short for the lowest tempo at this factor */
+	xmp_start_player(opaque, 8000, 0);
+	ret = xmp_set_tempo_factor(opaque, 6.0);
+	fail_unless(ret == -1, "factor too large for the buffers");
+	ret = xmp_set_tempo_factor(opaque, 1.5);
+	fail_unless(ret == 0, "can't set tempo factor");
+	xmp_end_player(opaque);
+
+	/* Buffers are sized for the factor set before starting */
+	ret = xmp_set_tempo_factor(opaque, 6.0);
+	fail_unless(ret == 0, "can't set tempo factor");
+	xmp_start_player(opaque, 8000, 0);
+
+	for (i = 0; i < 10; i++) {
+		xmp_play_frame(opaque);
+		xmp_get_frame_info(opaque, &info);
+		fail_unless(info.bpm == 32, "tempo not set");
+		fail_unless(info.buffer_size == 8000 * 60 * 250 / 32 / 1000 * 4,
+							"tick size");
+	}
+
+	xmp_end_player(opaque);
+	xmp_release_module(opaque);
+	xmp_free_context(opaque);
+}
+END_TEST
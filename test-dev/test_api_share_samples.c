@@ -0,0 +1,76 @@
+#include "test.h"
+
+static int sample_size(struct xmp_sample *xxs)
+{
+	return xxs->flg & XMP_SAMPLE_16BIT ? xxs->len * 2 : xxs->len;
+}
+
+TEST(test_api_share_samples)
+{
+	xmp_context c1, c2, c3;
+	struct xmp_module_info mi1, mi2, mi3;
+	struct xmp_frame_info fi2, fi3;
+	int i, ret;
+
+	c1 = xmp_create_context();
+	c2 = xmp_create_context();
+	c3 = xmp_create_context();
+
+	xmp_set_player(c1, XMP_PLAYER_SMPCTL, XMP_SMPCTL_SHARE);
+	xmp_set_player(c2, XMP_PLAYER_SMPCTL, XMP_SMPCTL_SHARE);
+
+	ret = xmp_load_module(c1, "data/test.xm");
+	fail_unless(ret == 0, "can't load module");
+	ret = xmp_load_module(c2, "data/test.xm");
+	fail_unless(ret == 0, "can't load module");
+	ret = xmp_load_module(c3, "data/test.xm");
+	fail_unless(ret == 0, "can't load module");
+
+	xmp_get_module_info(c1, &mi1);
+	xmp_get_module_info(c2, &mi2);
+	xmp_get_module_info(c3, &mi3);
+
+	/* shared across contexts, private without XMP_SMPCTL_SHARE */
+	for (i = 0; i < mi1.mod->smp; i++) {
+		struct xmp_sample *xxs = &mi1.mod->xxs[i];
+		if (xxs->data == NULL)
+			continue;
+		fail_unless(xxs->data == mi2.mod->xxs[i].data, "data not shared");
+		fail_unless(xxs->data != mi3.mod->xxs[i].data, "data shared");
+		fail_unless(memcmp(xxs->data, mi3.mod->xxs[i].data,
+				sample_size(xxs)) == 0, "sample data");
+	}
+
+	/* shared data must survive releasing one of the modules */
+	xmp_release_module(c1);
+
+	for (i = 0; i < mi2.mod->smp; i++) {
+		struct xmp_sample *xxs = &mi2.mod->xxs[i];
+		if (xxs->data == NULL)
+			continue;
+		fail_unless(memcmp(xxs->data, mi3.mod->xxs[i].data,
+				sample_size(xxs)) == 0, "sample data after release");
+	}
+
+	xmp_start_player(c2, 44100, 0);
+	xmp_start_player(c3, 44100, 0);
+
+	for (i = 0; i < 100; i++) {
+		xmp_play_frame(c2);
+		xmp_play_frame(c3);
+		xmp_get_frame_info(c2, &fi2);
+		xmp_get_frame_info(c3, &fi3);
+		fail_unless(fi2.buffer_size == fi3.buffer_size, "buffer size");
+		fail_unless(memcmp(fi2.buffer, fi3.buffer, fi2.buffer_size) == 0,
+							"mixed output");
+	}
+
+	xmp_end_player(c2);
+	xmp_end_player(c3);
+	xmp_release_module(c2);
+	xmp_release_module(c3);
+	xmp_free_context(c1);
+	xmp_free_context(c2);
+	xmp_free_context(c3);
+}
+END_TEST
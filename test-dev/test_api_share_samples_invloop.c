@@ -0,0 +1,107 @@
+#include "test.h"
+#include "effects.h"
+
+/* The invert loop effect writes to the sample data, so it must not change
+ * samples shared with other contexts.
+ */
+
+#define LOOP_SMP	0	/* 8-bit looped sample in ode2ptk.mod */
+
+static void check_unchanged(struct xmp_sample *xxs, uint8 *ref, const char *msg)
+{
+	fail_unless(memcmp(xxs->data, ref, xxs->len) == 0, msg);
+}
+
+TEST(test_api_share_samples_invloop)
+{
+	xmp_context c1, c2, c3;
+	struct xmp_module_info mi1, mi2, mi3;
+	struct xmp_sample *xxs;
+	struct xmp_event event;
+	uint8 *ref, *cell;
+	void *buffer;
+	long size;
+	int i, ret;
+
+	read_file_to_memory("data/ode2ptk.mod", &buffer, &size);
+	fail_unless(buffer != NULL, "can't read module");
+
+	/* Pattern 1, row 0, channel 0: C-2, sample 1, EFF */
+	cell = (uint8 *)buffer + 1084 + 1024;
+	cell[0] = 0x01;
+	cell[1] = 0xac;
+	cell[2] = 0x1e;
+	cell[3] = 0xff;
+
+	c1 = xmp_create_context();
+	c2 = xmp_create_context();
+	c3 = xmp_create_context();
+
+	xmp_set_player(c1, XMP_PLAYER_SMPCTL, XMP_SMPCTL_SHARE);
+	xmp_set_player(c2, XMP_PLAYER_SMPCTL, XMP_SMPCTL_SHARE);
+	xmp_set_player(c3, XMP_PLAYER_SMPCTL, XMP_SMPCTL_SHARE);
+
+	ret = xmp_load_module(c1, "data/ode2ptk.mod");
+	fail_unless(ret == 0, "can't load module");
+	ret = xmp_load_module_from_memory(c2, buffer, size);
+	fail_unless(ret == 0, "can't load module");
+	ret = xmp_load_module(c3, "data/ode2ptk.mod");
+	fail_unless(ret == 0, "can't load module");
+
+	xmp_get_module_info(c1, &mi1);
+	xmp_get_module_info(c2, &mi2);
+	xmp_get_module_info(c3, &mi3);
+
+	/* ode2ptk.mod is detected as Fast Tracker, invert loop needs
+	 * Protracker quirks */
+	((struct context_data *)c2)->m.quirk |= QUIRK_PROTRACK;
+	((struct context_data *)c3)->m.quirk |= QUIRK_PROTRACK;
+
+	xxs = &mi1.mod->xxs[LOOP_SMP];
+	fail_unless(xxs->flg & XMP_SAMPLE_LOOP, "sample not looped");
+	fail_unless(xxs->data == mi3.mod->xxs[LOOP_SMP].data, "data not shared");
+	fail_unless(xxs->data != mi2.mod->xxs[LOOP_SMP].data, "data shared");
+
+	ref = malloc(xxs->len);
+	fail_unless(ref != NULL, "can't allocate");
+	memcpy(ref, xxs->data, xxs->len);
+
+	/* Module using invert loop, samples not shared */
+	xmp_start_player(c2, 44100, 0);
+	for (i = 0; i < 50; i++) {
+		xmp_play_frame(c2);
+	}
+	xmp_end_player(c2);
+
+	check_unchanged(xxs, ref, "shared data changed by module");
+	fail_unless(memcmp(mi2.mod->xxs[LOOP_SMP].data, ref, xxs->len) != 0,
+						"invert loop not played");
+
+	/* Effect injected in a module with shared samples */
+	xmp_start_player(c3, 44100, 0);
+	xmp_play_frame(c3);
+
+	memset(&event, 0, sizeof(event));
+	event.note = 49;
+	event.ins = LOOP_SMP + 1;
+	event.fxt = FX_EXTENDED;
+	event.fxp = (EX_INVLOOP << 4) | 0x0f;
+	xmp_inject_event(c3, 0, &event);
+
+	for (i = 0; i < 50; i++) {
+		xmp_play_frame(c3);
+	}
+	xmp_end_player(c3);
+
+	check_unchanged(xxs, ref, "shared data changed by injected event");
+
+	free(ref);
+	free(buffer);
+	xmp_release_module(c1);
+	xmp_release_module(c2);
+	xmp_release_module(c3);
+	xmp_free_context(c1);
+	xmp_free_context(c2);
+	xmp_free_context(c3);
+}
+END_TEST
@@ -0,0 +1,69 @@
+#include "test.h"
+
+static unsigned long read_func(void *dest, unsigned long len, unsigned long nmemb, void *priv)
+{
+	FILE *f = (FILE *)priv;
+	return fread(dest, len, nmemb, f);
+};
+
+static int seek_func(void *priv, long offset, int whence)
+{
+	FILE *f = (FILE *)priv;
+	return fseek(f, offset, whence);
+}
+
+static long tell_func(void *priv)
+{
+	FILE *f = (FILE *)priv;
+	return ftell(f);
+}
+
+static const struct xmp_callbacks file_callbacks =
+{
+	read_func,
+	seek_func,
+	tell_func,
+	NULL
+};
+
+TEST(test_api_smix_load_sample_from_callbacks)
+{
+	xmp_context opaque;
+	struct context_data *ctx;
+	struct xmp_callbacks t1;
+	FILE *f;
+	int ret;
+
+	opaque = xmp_create_context();
+	ctx = (struct context_data *)opaque;
+
+	ret = xmp_load_module(opaque, "data/mod.loving_is_easy.pp");
+	fail_unless(ret == 0, "load module");
+
+	xmp_start_smix(opaque, 1, 2);
+
+	f = fopen("data/buzz.wav", "rb");
+	fail_unless(f != NULL, "open file");
+
+	/* null callback */
+	t1 = file_callbacks;
+	t1.read_func = NULL;
+	ret = xmp_smix_load_sample_from_callbacks(opaque, 0, f, t1);
+	fail_unless(ret == -XMP_ERROR_SYSTEM, "null read_func fail");
+
+	/* invalid slot */
+	ret = xmp_smix_load_sample_from_callbacks(opaque, 2, f, file_callbacks);
+	fail_unless(ret == -XMP_ERROR_INVALID, "invalid slot");
+
+	ret = xmp_smix_load_sample_from_callbacks(opaque, 0, f, file_callbacks);
+	fail_unless(ret == 0, "load sample");
+	fail_unless(ctx->smix.xxs[0].len == 7965, "sample length");
+	fail_unless(ctx->smix.xtra[0].rate == 22050, "sample rate");
+
+	fclose(f);
+
+	xmp_smix_release_sample(opaque, 0);
+	xmp_end_smix(opaque);
+	xmp_free_context(opaque);
+}
+END_TEST
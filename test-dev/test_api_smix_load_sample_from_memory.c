@@ -0,0 +1,164 @@
+#include "test.h"
+#include "../src/mixer.h"
+#include "../src/virtual.h"
+
+static void put16l(unsigned char *b, int v)
+{
+	b[0] = v & 0xff;
+	b[1] = (v >> 8) & 0xff;
+}
+
+static void put32l(unsigned char *b, unsigned int v)
+{
+	put16l(b, v & 0xffff);
+	put16l(b + 2, v >> 16);
+}
+
+/* Build a mono WAV file with a LIST chunk before the format chunk */
+static int make_wav(unsigned char *b, int fmt, int bits, int rate, const void *data, int size)
+{
+	memcpy(b, "RIFF", 4);
+	put32l(b + 4, 4 + 12 + 24 + 8 + size);
+	memcpy(b + 8, "WAVE", 4);
+	memcpy(b + 12, "LIST", 4);
+	put32l(b + 16, 3);
+	memcpy(b + 20, "abc\0", 4);		/* odd size, padded */
+	memcpy(b + 24, "fmt ", 4);
+	put32l(b + 28, 16);
+	put16l(b + 32, fmt);
+	put16l(b + 34, 1);
+	put32l(b + 36, rate);
+	put32l(b + 40, rate * bits / 8);
+	put16l(b + 44, bits / 8);
+	put16l(b + 46, bits);
+	memcpy(b + 48, "data", 4);
+	put32l(b + 52, size);
+	memcpy(b + 56, data, size);
+
+	return 56 + size;
+}
+
+TEST(test_api_smix_load_sample_from_memory)
+{
+	xmp_context opaque;
+	struct context_data *ctx;
+	struct player_data *p;
+	struct mixer_data *s;
+	struct xmp_sample *xxs;
+	struct mixer_voice *vi;
+	unsigned char wav[256], pcm[64];
+	float f[4] = { 0.5f, -0.5f, 1.5f, -1.0f };
+	int16 *d;
+	int i, voc, len, ret;
+
+	opaque = xmp_create_context();
+	ctx = (struct context_data *)opaque;
+	p = &ctx->p;
+	s = &ctx->s;
+
+	ret = xmp_load_module(opaque, "data/mod.loving_is_easy.pp");
+	fail_unless(ret == 0, "load module");
+
+	xmp_start_smix(opaque, 1, 2);
+
+	len = make_wav(wav, 1, 16, 22050, "\x00\x10\x00\xf0", 4);
+
+	/* invalid size */
+	ret = xmp_smix_load_sample_from_memory(opaque, 0, wav, 0);
+	fail_unless(ret == -XMP_ERROR_INVALID, "invalid size");
+
+	/* invalid slot */
+	ret = xmp_smix_load_sample_from_memory(opaque, 2, wav, len);
+	fail_unless(ret == -XMP_ERROR_INVALID, "invalid slot");
+
+	/* truncated header */
+	ret = xmp_smix_load_sample_from_memory(opaque, 0, wav, 40);
+	fail_unless(ret == -XMP_ERROR_FORMAT, "truncated header");
+
+	/* 16-bit PCM */
+	ret = xmp_smix_load_sample_from_memory(opaque, 0, wav, len);
+	fail_unless(ret == 0, "load 16-bit sample");
+	xxs = &ctx->smix.xxs[0];
+	d = (int16 *)xxs->data;
+	fail_unless(xxs->len == 2, "16-bit length");
+	fail_unless(d[0] == 0x1000 && d[1] == -0x1000, "16-bit data");
+	xmp_smix_release_sample(opaque, 0);
+
+	/* 24-bit PCM */
+	memcpy(pcm, "\xff\x00\x10\x00\x00\xf0", 6);
+	len = make_wav(wav, 1, 24, 22050, pcm, 6);
+	ret = xmp_smix_load_sample_from_memory(opaque, 0, wav, len);
+	fail_unless(ret == 0, "load 24-bit sample");
+	d = (int16 *)xxs->data;
+	fail_unless(xxs->len == 2, "24-bit length");
+	fail_unless(xxs->flg & XMP_SAMPLE_16BIT, "24-bit flags");
+	fail_unless(d[0] == 0x1000 && d[1] == -0x1000, "24-bit data");
+	xmp_smix_release_sample(opaque, 0);
+
+	/* 32-bit float PCM */
+	for (i = 0; i < 4; i++) {
+		union { float f; unsigned int i; } u;
+		u.f = f[i];
+		put32l(pcm + i * 4, u.i);
+	}
+	len = make_wav(wav, 3, 32, 22050, pcm, 16);
+	ret = xmp_smix_load_sample_from_memory(opaque, 0, wav, len);
+	fail_unless(ret == 0, "load float sample");
+	d = (int16 *)xxs->data;
+	fail_unless(xxs->len == 4, "float length");
+	fail_unless(d[0] == 16384 && d[1] == -16384, "float data");
+	fail_unless(d[2] == 32767 && d[3] == -32768, "float clamp");
+	xmp_smix_release_sample(opaque, 0);
+
+	/* 8-bit PCM is unsigned */
+	len = make_wav(wav, 1, 8, 22050, "\x80\xc0", 2);
+	ret = xmp_smix_load_sample_from_memory(opaque, 0, wav, len);
+	fail_unless(ret == 0, "load 8-bit sample");
+	fail_unless(xxs->data[0] == 0 && xxs->data[1] == 0x40, "8-bit data");
+	xmp_smix_release_sample(opaque, 0);
+
+	/* unsupported format */
+	len = make_wav(wav, 2, 4, 22050, pcm, 16);
+	ret = xmp_smix_load_sample_from_memory(opaque, 0, wav, len);
+	fail_unless(ret == -XMP_ERROR_FORMAT, "ADPCM sample");
+
+	xmp_end_smix(opaque);
+	xmp_release_module(opaque);
+
+	/* resample to the output rate */
+	xmp_set_player(opaque, XMP_PLAYER_SMPCTL, XMP_SMPCTL_RESAMPLE);
+	ret = xmp_load_module(opaque, "data/mod.loving_is_easy.pp");
+	fail_unless(ret == 0, "load module");
+	xmp_start_smix(opaque, 1, 2);
+
+	ret = xmp_smix_load_sample(opaque, 0, "data/buzz.wav");
+	fail_unless(ret == 0, "load sample");
+	fail_unless(ctx->smix.xxs[0].data == NULL, "resampled before start");
+
+	xmp_start_player(opaque, 44100, 0);
+	xxs = &ctx->smix.xxs[0];
+	fail_unless(xxs->len == ctx->smix.xtra[0].src.len * 2, "resampled length");
+	fail_unless(ctx->smix.xtra[0].rate == 44100, "resampled rate");
+
+	ret = xmp_smix_play_sample(opaque, 0, 60, 64, 0);
+	fail_unless(ret == 0, "play sample");
+	xmp_play_frame(opaque);
+	xmp_play_frame(opaque);
+
+	voc = map_channel(p, 4);
+	fail_unless(voc >= 0, "virtual map");
+	vi = &p->virt.voice_array[voc];
+	fail_unless(vi->pos == vi->pos0 + s->ticksize, "play at step 1.0");
+
+	/* samples loaded while playing are resampled at once */
+	ret = xmp_smix_load_sample(opaque, 1, "data/blip.wav");
+	fail_unless(ret == 0, "load sample");
+	fail_unless(ctx->smix.xtra[1].rate == 44100, "resampled rate");
+
+	xmp_end_player(opaque);
+	xmp_smix_release_sample(opaque, 0);
+	xmp_smix_release_sample(opaque, 1);
+	xmp_end_smix(opaque);
+	xmp_free_context(opaque);
+}
+END_TEST
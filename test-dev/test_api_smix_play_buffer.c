@@ -0,0 +1,87 @@
+#include "test.h"
+
+static xmp_context create_player(void)
+{
+	xmp_context opaque;
+	struct context_data *ctx;
+	int ret;
+
+	opaque = xmp_create_context();
+
+	xmp_start_smix(opaque, 1, 1);
+	ret = xmp_load_module(opaque, "data/mod.loving_is_easy.pp");
+	fail_unless(ret == 0, "load module");
+	ret = xmp_smix_load_sample(opaque, 0, "data/blip.wav");
+	fail_unless(ret == 0, "load sample");
+
+	ret = xmp_start_player(opaque, 44100, 0);
+	fail_unless(ret == 0, "start player");
+
+	/* allocated before playing, not in the audio thread */
+	ctx = (struct context_data *)opaque;
+	fail_unless(ctx->s.tick_voice != NULL, "split state not allocated");
+
+	return opaque;
+}
+
+TEST(test_api_smix_play_buffer)
+{
+	xmp_context c1, c2;
+	char buf1[1024], buf2[1024];
+	int ret;
+
+	c1 = create_player();
+	c2 = create_player();
+
+	/* one buffer ends in the middle of the first frame */
+	xmp_play_buffer(c1, buf1, 1024, 0);
+	xmp_play_buffer(c2, buf2, 1024, 0);
+	fail_unless(memcmp(buf1, buf2, 1024) == 0, "output mismatch");
+
+	/* sample must start in the next buffer, not in the next frame */
+	ret = xmp_smix_play_sample(c1, 0, 60, 64, 0);
+	fail_unless(ret == 0, "play sample");
+
+	xmp_play_buffer(c1, buf1, 1024, 0);
+	xmp_play_buffer(c2, buf2, 1024, 0);
+	fail_unless(memcmp(buf1, buf2, 1024) != 0, "sample not started");
+
+	xmp_end_player(c1);
+	xmp_end_player(c2);
+	xmp_release_module(c1);
+	xmp_release_module(c2);
+	xmp_end_smix(c1);
+	xmp_end_smix(c2);
+	xmp_free_context(c1);
+	xmp_free_context(c2);
+
+	/* restarted sample must replace the sound already mixed */
+	c1 = create_player();
+	c2 = create_player();
+	xmp_set_player(c1, XMP_PLAYER_INTERP, XMP_INTERP_NEAREST);
+	xmp_set_player(c2, XMP_PLAYER_INTERP, XMP_INTERP_NEAREST);
+
+	ret = xmp_smix_play_sample(c1, 0, 60, 64, 0);
+	fail_unless(ret == 0, "play sample");
+	xmp_play_buffer(c1, buf1, 1024, 0);
+	xmp_play_buffer(c2, buf2, 1024, 0);
+
+	ret = xmp_smix_play_sample(c1, 0, 60, 64, 0);
+	fail_unless(ret == 0, "play sample");
+	ret = xmp_smix_play_sample(c2, 0, 60, 64, 0);
+	fail_unless(ret == 0, "play sample");
+
+	xmp_play_buffer(c1, buf1, 1024, 0);
+	xmp_play_buffer(c2, buf2, 1024, 0);
+	fail_unless(memcmp(buf1, buf2, 1024) == 0, "previous sound not replaced");
+
+	xmp_end_player(c1);
+	xmp_end_player(c2);
+	xmp_release_module(c1);
+	xmp_release_module(c2);
+	xmp_end_smix(c1);
+	xmp_end_smix(c2);
+	xmp_free_context(c1);
+	xmp_free_context(c2);
+}
+END_TEST
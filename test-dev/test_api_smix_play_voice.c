@@ -0,0 +1,87 @@
+#include "test.h"
+#include "../src/mixer.h"
+#include "../src/virtual.h"
+
+TEST(test_api_smix_play_voice)
+{
+	xmp_context opaque;
+	struct context_data *ctx;
+	struct player_data *p;
+	int h1, h2, h3, h4, ret, i;
+
+	opaque = xmp_create_context();
+	ctx = (struct context_data *)opaque;
+	p = &ctx->p;
+
+	ret = xmp_load_module(opaque, "data/mod.loving_is_easy.pp");
+	fail_unless(ret == 0, "load module");
+
+	xmp_start_smix(opaque, 3, 2);
+
+	ret = xmp_smix_load_sample(opaque, 0, "data/blip.wav");
+	fail_unless(ret == 0, "load sample 0");
+	ret = xmp_smix_load_sample(opaque, 1, "data/buzz.wav");
+	fail_unless(ret == 0, "load sample 1");
+
+	/* play voice before starting player */
+	ret = xmp_smix_play_voice(opaque, 0, 60, 64, 0);
+	fail_unless(ret == -XMP_ERROR_STATE, "invalid state");
+
+	xmp_start_player(opaque, 44100, 0);
+	xmp_play_frame(opaque);
+
+	/* play invalid sample */
+	ret = xmp_smix_play_voice(opaque, 2, 60, 64, 0);
+	fail_unless(ret == -XMP_ERROR_INVALID, "invalid sample");
+
+	/* fill the pool */
+	h1 = xmp_smix_play_voice(opaque, 1, 60, 64, 1);
+	h2 = xmp_smix_play_voice(opaque, 1, 60, 64, 1);
+	h3 = xmp_smix_play_voice(opaque, 1, 60, 64, 2);
+	fail_unless(h1 >= 0 && h2 >= 0 && h3 >= 0, "play voice");
+	fail_unless(h1 != h2 && h2 != h3 && h1 != h3, "distinct handles");
+	xmp_play_frame(opaque);
+
+	for (i = 4; i < 7; i++) {
+		fail_unless(map_channel(p, i) >= 0, "virtual map");
+	}
+
+	/* lower priority voices can't steal */
+	ret = xmp_smix_play_voice(opaque, 1, 60, 64, 0);
+	fail_unless(ret == -XMP_ERROR_STATE, "steal lower priority");
+
+	/* the oldest voice with the lowest priority is stolen */
+	h4 = xmp_smix_play_voice(opaque, 0, 60, 64, 2);
+	fail_unless(h4 >= 0, "steal voice");
+	fail_unless((h4 & 0xff) == (h1 & 0xff), "steal oldest voice");
+	xmp_play_frame(opaque);
+
+	/* stopping a stolen voice does nothing */
+	ret = xmp_smix_stop_voice(opaque, h1);
+	fail_unless(ret == 0, "stop stolen voice");
+	fail_unless(map_channel(p, 4 + (h4 & 0xff)) >= 0, "stolen voice playing");
+
+	/* stop voice */
+	ret = xmp_smix_stop_voice(opaque, h3);
+	fail_unless(ret == 0, "stop voice");
+	fail_unless(map_channel(p, 4 + (h3 & 0xff)) < 0, "voice stopped");
+
+	ret = xmp_smix_play_voice(opaque, 1, 60, 64, 0);
+	fail_unless(ret >= 0, "reuse stopped voice");
+	fail_unless((ret & 0xff) == (h3 & 0xff), "reuse stopped channel");
+	xmp_play_frame(opaque);
+
+	/* voices are freed when their samples end */
+	for (i = 0; i < 500; i++) {
+		xmp_play_frame(opaque);
+	}
+	fail_unless(ctx->smix.num_free == 3, "free voices");
+
+	xmp_end_player(opaque);
+	xmp_smix_release_sample(opaque, 0);
+	xmp_smix_release_sample(opaque, 1);
+
+	xmp_end_smix(opaque);
+	xmp_free_context(opaque);
+}
+END_TEST
@@ -0,0 +1,91 @@
+#include "test.h"
+
+TEST(test_api_start_stems)
+{
+	xmp_context c1, c2;
+	struct xmp_frame_info fi1, fi2;
+	int map[4] = { 0, 1, 1, -1 };
+	int16 *s0, *s1, *s2, *s3, *b2;
+	int i, j, ret, sum, diff, max;
+
+	c1 = xmp_create_context();
+	c2 = xmp_create_context();
+
+	ret = xmp_load_module(c1, "data/mod.loving_is_easy.pp");
+	fail_unless(ret == 0, "load module");
+	ret = xmp_load_module(c2, "data/mod.loving_is_easy.pp");
+	fail_unless(ret == 0, "load module");
+
+	/* start stems before starting player */
+	ret = xmp_start_stems(c2, 4, NULL, 0);
+	fail_unless(ret == -XMP_ERROR_STATE, "invalid state");
+
+	xmp_start_player(c1, 44100, 0);
+	xmp_start_player(c2, 44100, 0);
+
+	ret = xmp_start_stems(c2, 0, NULL, 0);
+	fail_unless(ret == -XMP_ERROR_INVALID, "invalid number of stems");
+
+	/* one stem per channel */
+	ret = xmp_start_stems(c2, 4, NULL, 0);
+	fail_unless(ret == 0, "start stems");
+	fail_unless(xmp_get_stem_buffer(c2, 4) == NULL, "invalid stem");
+
+	s0 = xmp_get_stem_buffer(c2, 0);
+	s1 = xmp_get_stem_buffer(c2, 1);
+	s2 = xmp_get_stem_buffer(c2, 2);
+	s3 = xmp_get_stem_buffer(c2, 3);
+	fail_unless(s0 && s1 && s2 && s3, "stem buffers");
+
+	max = 0;
+	for (i = 0; i < 200; i++) {
+		xmp_play_frame(c1);
+		xmp_play_frame(c2);
+		xmp_get_frame_info(c1, &fi1);
+		xmp_get_frame_info(c2, &fi2);
+
+		/* the main output doesn't change */
+		fail_unless(fi1.buffer_size == fi2.buffer_size, "buffer size");
+		ret = memcmp(fi1.buffer, fi2.buffer, fi1.buffer_size);
+		fail_unless(ret == 0, "main output");
+
+		/* stems add up to the main output */
+		b2 = fi2.buffer;
+		for (j = 0; j < fi2.buffer_size / 2; j++) {
+			sum = s0[j] + s1[j] + s2[j] + s3[j];
+			diff = abs(sum - b2[j]);
+			if (diff > max) {
+				max = diff;
+			}
+		}
+	}
+	fail_unless(max <= 4, "stem sum");
+
+	/* channel groups without main output */
+	ret = xmp_start_stems(c2, 2, map, XMP_STEMS_NOMIX);
+	fail_unless(ret == 0, "start stems");
+	fail_unless(xmp_get_stem_buffer(c2, 2) == NULL, "invalid stem");
+
+	s0 = xmp_get_stem_buffer(c2, 0);
+	s1 = xmp_get_stem_buffer(c2, 1);
+	max = 0;
+	for (i = 0; i < 50; i++) {
+		xmp_play_frame(c2);
+		xmp_get_frame_info(c2, &fi2);
+		for (j = 0; j < fi2.buffer_size / 2; j++) {
+			max |= s0[j] | s1[j];
+		}
+	}
+	fail_unless(max != 0, "grouped stems");
+
+	xmp_end_stems(c2);
+	fail_unless(xmp_get_stem_buffer(c2, 0) == NULL, "end stems");
+
+	xmp_end_player(c1);
+	xmp_end_player(c2);
+	xmp_release_module(c1);
+	xmp_release_module(c2);
+	xmp_free_context(c1);
+	xmp_free_context(c2);
+}
+END_TEST
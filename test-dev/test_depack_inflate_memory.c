@@ -0,0 +1,35 @@
+#include "test.h"
+#include "../src/depackers/inflate.h"
+#include "../src/depackers/crc32.h"
+
+
+TEST(test_depack_inflate_memory)
+{
+	uint8 *buf, *out;
+	long size, out_size;
+	uint32 crc;
+	int pos, ret;
+
+	read_file_to_memory("data/gzipdata", (void **)&buf, &size);
+	fail_unless(buf != NULL, "can't read file");
+
+	/* skip gzip header and file name */
+	fail_unless(buf[3] == 0x08, "unexpected gzip flags");
+	for (pos = 10; buf[pos] != 0; pos++);
+	pos++;
+
+	libxmp_crc32_init_A();
+
+	ret = libxmp_inflate_mem(buf + pos, size - pos, &out, &out_size, &crc, 1);
+	fail_unless(ret == size - pos - 8, "wrong compressed size");
+	fail_unless(crc == readmem32l(buf + size - 8), "CRC error");
+	fail_unless(out_size == readmem32l(buf + size - 4), "wrong size");
+	libxmp_free(out);
+
+	/* truncated stream */
+	ret = libxmp_inflate_mem(buf + pos, (size - pos) / 2, &out, &out_size, &crc, 1);
+	fail_unless(ret < 0, "truncated stream not detected");
+
+	free(buf);
+}
+END_TEST
@@ -0,0 +1,52 @@
+#include "test.h"
+
+/* Packed modules with companion files must still find them next to
+ * the packed file.
+ */
+
+static void copy_file(const char *src, const char *dest)
+{
+	void *buffer;
+	long size;
+	FILE *f;
+
+	read_file_to_memory(src, &buffer, &size);
+	fail_unless(buffer != NULL, "can't read file");
+
+	f = fopen(dest, "wb");
+	fail_unless(f != NULL, "can't open file");
+	fail_unless(fwrite(buffer, 1, size, f) == (size_t)size, "write error");
+	fclose(f);
+	free(buffer);
+}
+
+TEST(test_depack_mfp)
+{
+	xmp_context c;
+	struct xmp_module_info info;
+	FILE *f;
+	int ret;
+
+	copy_file("data/mfp_gzip", "mfp.depack_test");
+	copy_file("data/m/smp.crystaldragon title", "smp.depack_test");
+
+	f = fopen("data/format_mfp.data", "r");
+
+	c = xmp_create_context();
+	fail_unless(c != NULL, "can't create context");
+	ret = xmp_load_module(c, "mfp.depack_test");
+	fail_unless(ret == 0, "can't load module");
+
+	xmp_get_module_info(c, &info);
+
+	ret = compare_module(info.mod, f);
+	fail_unless(ret == 0, "format not correctly loaded");
+
+	xmp_release_module(c);
+	xmp_free_context(c);
+	fclose(f);
+
+	unlink("mfp.depack_test");
+	unlink("smp.depack_test");
+}
+END_TEST
@@ -0,0 +1,38 @@
+#include "test.h"
+
+/* Cached filter coefficients must match the ones computed directly,
+ * including pairs that share a cache slot.
+ */
+
+TEST(test_effect_it_filter_cache)
+{
+	xmp_context opaque;
+	struct context_data *ctx;
+	int a0, b0, b1, c0, d0, d1;
+	int i, cutoff, res;
+
+	opaque = xmp_create_context();
+	ctx = (struct context_data *)opaque;
+
+	create_simple_module(ctx, 2, 2);
+	set_quirk(ctx, QUIRKS_IT, READ_EVENT_IT);
+
+	xmp_start_player(opaque, 44100, 0);
+	fail_unless(ctx->p.filter_coef != NULL, "no filter cache");
+
+	for (i = 0; i < 2; i++) {
+		for (res = 0; res < 256; res += 3) {
+			for (cutoff = 0; cutoff < 256; cutoff += 5) {
+				libxmp_filter_coef(ctx, cutoff, res, &a0, &b0, &b1);
+				libxmp_filter_setup(44100, cutoff, res, &c0, &d0, &d1);
+				fail_unless(a0 == c0 && b0 == d0 && b1 == d1,
+					    "coefficient mismatch");
+			}
+		}
+	}
+
+	xmp_end_player(opaque);
+	xmp_release_module(opaque);
+	xmp_free_context(opaque);
+}
+END_TEST
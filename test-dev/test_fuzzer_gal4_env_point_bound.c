@@ -1,28 +1,20 @@
 #include "test.h"
 
 /* This input caused out-of-bounds reads in the Galaxy 4.0 loader
- * due to incorrectly bounded envelope point counts.
+ * due to incorrectly bounded envelope point counts. Its deflate
+ * stream has an oversubscribed literal/length code, which inflate
+ * rejects; the loader is tested with the repacked payload.
  */
 
 TEST(test_fuzzer_gal4_env_point_bound)
 {
 	xmp_context opaque;
-	struct xmp_module_info info;
-	FILE *f;
 	int ret;
 
-	f = fopen("data/f/load_gal4_env_point_bound.data", "r");
-
 	opaque = xmp_create_context();
 	ret = xmp_load_module(opaque, "data/f/load_gal4_env_point_bound.j2b");
-	fail_unless(ret == 0, "module load");
-
-	xmp_get_module_info(opaque, &info);
-
-	ret = compare_module(info.mod, f);
-	fail_unless(ret == 0, "format not correctly loaded");
+	fail_unless(ret == -XMP_ERROR_DEPACK, "depacking");
 
-	xmp_release_module(opaque);
 	xmp_free_context(opaque);
 }
 END_TEST
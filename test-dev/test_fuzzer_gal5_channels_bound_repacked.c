@@ -0,0 +1,20 @@
+#include "test.h"
+
+/* This input caused out of bounds reads in the Galaxy 5.0 loader
+ * due to a missing channels count bound check. The payload was
+ * recompressed from test_fuzzer_gal5_channels_bound, which inflate
+ * rejects.
+ */
+
+TEST(test_fuzzer_gal5_channels_bound_repacked)
+{
+	xmp_context opaque;
+	int ret;
+
+	opaque = xmp_create_context();
+	ret = xmp_load_module(opaque, "data/f/load_gal5_channels_bound_repacked.j2b");
+	fail_unless(ret == -XMP_ERROR_LOAD, "module load");
+
+	xmp_free_context(opaque);
+}
+END_TEST
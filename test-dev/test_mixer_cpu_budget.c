@@ -0,0 +1,86 @@
+#include "test.h"
+#include "../src/effects.h"
+#include "../src/mixer.h"
+#include "../src/virtual.h"
+
+
+TEST(test_mixer_cpu_budget)
+{
+	xmp_context opaque;
+	struct context_data *ctx;
+	struct player_data *p;
+	int i, voc, ret;
+
+	opaque = xmp_create_context();
+	ctx = (struct context_data *)opaque;
+	p = &ctx->p;
+
+ 	create_simple_module(ctx, 2, 2);
+	set_instrument_volume(ctx, 0, 0, 22);
+	set_instrument_volume(ctx, 1, 0, 33);
+	set_instrument_fadeout(ctx, 0, 10000);
+
+	/* NNA continue leaves a background voice on row 1 */
+	new_event(ctx, 0, 0, 0, 60, 1, 44, 0x0f, 2, FX_IT_INSTFUNC, 0x04);
+	new_event(ctx, 0, 1, 0, 50, 2,  0, 0x00, 0, 0, 0);
+	set_quirk(ctx, QUIRKS_IT, READ_EVENT_IT);
+
+	xmp_start_player(opaque, 44100, 0);
+
+	ret = xmp_get_player(opaque, XMP_PLAYER_CPU_BUDGET);
+	fail_unless(ret == 0, "default CPU budget");
+	ret = xmp_set_player(opaque, XMP_PLAYER_CPU_BUDGET, -1);
+	fail_unless(ret == -XMP_ERROR_INVALID, "invalid CPU budget");
+	ret = xmp_set_player(opaque, XMP_PLAYER_QUALITY, 0);
+	fail_unless(ret == -XMP_ERROR_INVALID, "quality is read only");
+
+	/* Impossible budget: cull background voices, then reduce quality */
+	ret = xmp_set_player(opaque, XMP_PLAYER_CPU_BUDGET, 1);
+	fail_unless(ret == 0, "set CPU budget");
+
+	xmp_play_frame(opaque);
+	xmp_play_frame(opaque);
+	fail_unless(xmp_get_player(opaque, XMP_PLAYER_CULLED) == 0, "culled too early");
+	fail_unless(xmp_get_player(opaque, XMP_PLAYER_QUALITY) == 1, "quality level");
+
+	/* Row 1 */
+	xmp_play_frame(opaque);
+	fail_unless(xmp_get_player(opaque, XMP_PLAYER_CULLED) == 1, "voice not culled");
+	for (i = 0; i < p->virt.maxvoc; i++) {
+		fail_unless(p->virt.voice_array[i].chn < p->virt.num_tracks,
+						"background voice not culled");
+	}
+	voc = map_channel(p, 0);
+	fail_unless(voc >= 0, "channel voice culled");
+
+	for (i = 0; i < 50; i++) {
+		xmp_play_frame(opaque);
+	}
+	ret = xmp_get_player(opaque, XMP_PLAYER_QUALITY);
+	fail_unless(ret == XMP_INTERP_SPLINE * 2, "quality not reduced");
+
+	/* Quality is restored when the load drops */
+	ret = xmp_set_player(opaque, XMP_PLAYER_CPU_BUDGET, 1000000);
+	fail_unless(ret == 0, "set CPU budget");
+	fail_unless(xmp_get_player(opaque, XMP_PLAYER_CULLED) == 0, "culled count reset");
+
+	for (i = 0; i < 50; i++) {
+		xmp_play_frame(opaque);
+	}
+	ret = xmp_get_player(opaque, XMP_PLAYER_QUALITY);
+	fail_unless(ret == 0, "quality not restored");
+
+	/* Disabling the budget restores quality immediately */
+	xmp_set_player(opaque, XMP_PLAYER_CPU_BUDGET, 1);
+	for (i = 0; i < 10; i++) {
+		xmp_play_frame(opaque);
+	}
+	fail_unless(xmp_get_player(opaque, XMP_PLAYER_QUALITY) > 0, "quality not reduced");
+	xmp_set_player(opaque, XMP_PLAYER_CPU_BUDGET, 0);
+	fail_unless(xmp_get_player(opaque, XMP_PLAYER_QUALITY) == 0, "quality not reset");
+
+	xmp_end_player(opaque);
+	xmp_release_module(opaque);
+	xmp_free_context(opaque);
+}
+END_TEST
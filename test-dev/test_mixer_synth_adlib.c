@@ -0,0 +1,68 @@
+#include "test.h"
+
+static int frame_energy(struct xmp_frame_info *fi)
+{
+	int16 *b = (int16 *)fi->buffer;
+	int i, max = 0;
+
+	for (i = 0; i < fi->buffer_size / 2; i++) {
+		if (abs(b[i]) > max) {
+			max = abs(b[i]);
+		}
+	}
+
+	return max;
+}
+
+TEST(test_mixer_synth_adlib)
+{
+	xmp_context opaque;
+	struct xmp_module_info mi;
+	struct xmp_frame_info fi;
+	int16 *b;
+	int i, ret;
+
+	opaque = xmp_create_context();
+	ret = xmp_load_module(opaque, "data/adlib.s3m");
+	fail_unless(ret == 0, "can't load module");
+
+	/* AdLib instruments hold the patch as sample data */
+	xmp_get_module_info(opaque, &mi);
+	fail_unless(mi.mod->xxs[0].flg & XMP_SAMPLE_SYNTH, "not a synth sample");
+	fail_unless(mi.mod->xxs[0].len == 11, "patch size");
+	fail_unless(mi.mod->xxs[0].data[4] == 0xf2, "patch data");
+
+	xmp_start_player(opaque, 44100, 0);
+
+	/* Row 0: notes are rendered by the synth */
+	xmp_play_frame(opaque);
+	xmp_get_frame_info(opaque, &fi);
+	fail_unless(frame_energy(&fi) > 1000, "no synth output");
+
+	/* OPL2 output is mono */
+	b = (int16 *)fi.buffer;
+	for (i = 0; i < fi.buffer_size / 2; i += 2) {
+		fail_unless(b[i] == b[i + 1], "left and right differ");
+	}
+
+	/* Row 32: note off, the synth is silent after the release */
+	for (i = 1; i < 32 * 6 + 20; i++) {
+		xmp_play_frame(opaque);
+	}
+	xmp_get_frame_info(opaque, &fi);
+	fail_unless(fi.row > 32, "wrong row");
+	fail_unless(frame_energy(&fi) < 16, "note not released");
+
+	xmp_end_player(opaque);
+
+	/* Synth voices also play in mono output */
+	xmp_start_player(opaque, 22050, XMP_FORMAT_MONO);
+	xmp_play_frame(opaque);
+	xmp_get_frame_info(opaque, &fi);
+	fail_unless(frame_energy(&fi) > 1000, "no synth output");
+	xmp_end_player(opaque);
+
+	xmp_release_module(opaque);
+	xmp_free_context(opaque);
+}
+END_TEST
@@ -0,0 +1,21 @@
+#include "test.h"
+
+/*
+ When a sample sustain loop, which is placed partly or completely behind a
+ "normal" sample loop is exited (through a note-off event), and the current
+ sample playback position is past the normal loop's end, it is adjusted to
+ current position - loop end + loop start.
+*/
+
+/* The bidirectional sustain loop in this module used to be mixed with the
+ * bounds of the unrolled loop over the original sample data, reading past
+ * the end of the sample buffer.
+ */
+
+TEST(test_openmpt_it_susafterloop)
+{
+	compare_mixer_data(
+		"openmpt/it/SusAfterLoop.it",
+		"openmpt/it/SusAfterLoop.data");
+}
+END_TEST
@@ -82,11 +82,11 @@ TEST(test_sample_load_16bit)
 	libxmp_load_sample(&m, f, 0, &s, NULL);
 	fail_unless(s.data != NULL, "didn't allocate sample data");
 	fail_unless(s.lpe == 101, "didn't fix invalid loop end");
-	fail_unless(memcmp(s.data, buffer, 404) == 0, "sample unroll error");
-	fail_unless(s.data[404] == s.data[0], "sample adjust error");
-	fail_unless(s.data[405] == s.data[1], "sample adjust error");
-	fail_unless(s.data[406] == s.data[2], "sample adjust error");
-	fail_unless(s.data[407] == s.data[3], "sample adjust error");
+	fail_unless(memcmp(s.data, buffer, 202) == 0, "sample data error");
+	fail_unless(s.data[202] == s.data[200], "sample mirror error");
+	fail_unless(s.data[203] == s.data[201], "sample mirror error");
+	fail_unless(s.data[204] == s.data[198], "sample mirror error");
+	fail_unless(s.data[205] == s.data[199], "sample mirror error");
 	CLEAR();
 
 	hio_close(f);
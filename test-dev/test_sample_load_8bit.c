@@ -75,9 +75,10 @@ TEST(test_sample_load_8bit)
 	libxmp_load_sample(&m, f, 0, &s, NULL);
 	fail_unless(s.data != NULL, "didn't allocate sample data");
 	fail_unless(s.lpe == 101, "didn't fix invalid loop end");
-	fail_unless(memcmp(s.data, buffer, 202) == 0, "sample unroll error");
-	fail_unless(s.data[202] == s.data[201], "sample adjust error");
-	fail_unless(s.data[203] == s.data[0], "sample adjust error");
+	fail_unless(memcmp(s.data, buffer, 101) == 0, "sample data error");
+	fail_unless(s.data[101] == s.data[100], "sample mirror error");
+	fail_unless(s.data[102] == s.data[99], "sample mirror error");
+	fail_unless(s.data[103] == s.data[98], "sample mirror error");
 	CLEAR();
 
 	hio_close(f);
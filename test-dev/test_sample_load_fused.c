@@ -0,0 +1,63 @@
+#include "test.h"
+#include "../src/loaders/loader.h"
+
+/* Several conversion flags applied to the same sample */
+
+TEST(test_sample_load_fused)
+{
+	static struct xmp_sample xxs;
+
+	int8  buffer0[10] = { 0, 1, 2, 3,  4,  5,  6, -7,  8, -29 };
+	uint8 conv_r0[10] = {
+		128, 129, 131, 134, 138, 143, 149, 142, 150, 121
+	};
+	int8  conv_r1[10] = { 0, 2, 6, 12, 20, 30, 42, 28, 44, -14 };
+
+	/* 16-bit input buffer is little-endian */
+	uint8  buffer2[20] = {
+		0, 0, 1, 0, 2, 0, 3, 0, 4, 0, 5, 0,
+		6, 0, 0xf9, 0xff, 8, 0, 0xe3, 0xff
+	};
+	/* 16-bit output buffer is native-endian */
+	uint16 conv_r2[10] = {
+		32768, 32769, 32771, 32774, 32778,
+		32783, 32789, 32782, 32790, 32761
+	};
+
+	/* 16-bit input buffer is big-endian */
+	uint8  buffer3[20] = {
+		0, 0, 0, 1, 0, 2, 0, 3, 0, 4, 0, 5,
+		0, 6, 0xff, 0xf9, 0, 8, 0xff, 0xe3
+	};
+	uint16 conv_r3[10] = { 0, 1, 3, 6, 10, 15, 21, 14, 22, 65529 };
+	struct module_data m;
+
+	memset(&m, 0, sizeof(struct module_data));
+
+	xxs.len = 10;
+	libxmp_load_sample(&m, NULL, SAMPLE_FLAG_NOLOAD | SAMPLE_FLAG_DIFF |
+				SAMPLE_FLAG_UNS, &xxs, buffer0);
+	fail_unless(memcmp(xxs.data, conv_r0, 10) == 0,
+				"Invalid 8-bit delta unsigned conversion");
+	libxmp_free_sample(&xxs);
+
+	libxmp_load_sample(&m, NULL, SAMPLE_FLAG_NOLOAD | SAMPLE_FLAG_DIFF |
+				SAMPLE_FLAG_7BIT, &xxs, buffer0);
+	fail_unless(memcmp(xxs.data, conv_r1, 10) == 0,
+				"Invalid 7-bit delta conversion");
+	libxmp_free_sample(&xxs);
+
+	xxs.flg = XMP_SAMPLE_16BIT;
+	libxmp_load_sample(&m, NULL, SAMPLE_FLAG_NOLOAD | SAMPLE_FLAG_DIFF |
+				SAMPLE_FLAG_UNS, &xxs, buffer2);
+	fail_unless(memcmp(xxs.data, conv_r2, 20) == 0,
+				"Invalid 16-bit delta unsigned conversion");
+	libxmp_free_sample(&xxs);
+
+	libxmp_load_sample(&m, NULL, SAMPLE_FLAG_NOLOAD | SAMPLE_FLAG_DIFF |
+				SAMPLE_FLAG_BIGEND, &xxs, buffer3);
+	fail_unless(memcmp(xxs.data, conv_r3, 20) == 0,
+				"Invalid 16-bit big-endian delta conversion");
+	libxmp_free_sample(&xxs);
+}
+END_TEST